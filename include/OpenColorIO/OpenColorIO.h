@@ -108,6 +108,100 @@ OCIO_NAMESPACE_ENTER
     // restarting.
     
     extern OCIOEXPORT void ClearAllCaches();
+
+    //!cpp:function:: Set the memory budget (in bytes) of the cache holding the files read by
+    // the FileTransforms. The least recently used files are discarded once the budget is
+    // exceeded. A budget of 0 means no limit. Default is 1 GiB.
+    extern OCIOEXPORT void SetFileCacheMemoryBudget(size_t budget);
+    //!cpp:function::
+    extern OCIOEXPORT size_t GetFileCacheMemoryBudget();
+    //!cpp:function:: Approximate memory (in bytes) used by the cached files.
+    extern OCIOEXPORT size_t GetFileCacheMemoryUsage();
+    //!cpp:function::
+    extern OCIOEXPORT size_t GetFileCacheNumEntries();
+    //!cpp:function:: Number of file loads served by the file cache.
+    extern OCIOEXPORT unsigned long GetFileCacheNumHits();
+    //!cpp:function:: Number of file loads which had to read the file.
+    extern OCIOEXPORT unsigned long GetFileCacheNumMisses();
+    //!cpp:function:: Set the minimum interval (in seconds) between two checks that a cached
+    // file was not modified on disk (using its inode, modification time and size). Only the
+    // modified files are then re-read, without flushing the other caches. A negative interval
+    // (the default) disables the checks, ClearAllCaches() is then needed to re-read the files.
+    extern OCIOEXPORT void SetFileCacheCheckInterval(double seconds);
+    //!cpp:function::
+    extern OCIOEXPORT double GetFileCacheCheckInterval();
+    //!cpp:function:: Set the directory of the persistent cache of the parsed LUT files. The
+    // processes sharing the directory then load the LUTs from their compact binary form
+    // (memory-mapped) instead of parsing the files again. The CTF/CLF files are only stored
+    // when they hold nothing but LUT1D and LUT3D ops. The configs created by
+    // Config::CreateFromFile() are also stored in their binary form (refer to
+    // Config::serializeBinary()). A stale or corrupted entry is ignored and the file is
+    // parsed. The directory must exist. An empty directory disables
+    // the persistent cache. The default is the value of the OCIO_FILE_CACHE_DIR environment
+    // variable (i.e. disabled if not set).
+    extern OCIOEXPORT void SetFileCacheDirectory(const char * dirname);
+    //!cpp:function::
+    extern OCIOEXPORT const char * GetFileCacheDirectory();
+    //!cpp:function:: Set the duration (in seconds) during which a file which could not be
+    // found is reported as missing without accessing the file system again. It applies to
+    // the file references resolved by the contexts, to the existence checks of the files and
+    // to the directory index. A duration of 0 disables the caching of the missing files, a
+    // negative duration keeps them until ClearAllCaches(). Default is 0 (i.e. disabled).
+    extern OCIOEXPORT void SetMissingFileCacheTTL(double seconds);
+    //!cpp:function::
+    extern OCIOEXPORT double GetMissingFileCacheTTL();
+    //!cpp:function:: Enable the index of the directories holding the looked up files (e.g. the
+    // search paths). Each directory is listed once per missing file TTL, and the files absent
+    // from its listing are reported as missing without any stat call. This mostly helps with
+    // many file references and search paths on network file systems. The index is only used
+    // with a non-zero missing file TTL (refer to SetMissingFileCacheTTL()). Default is disabled.
+    extern OCIOEXPORT void SetDirectoryIndexEnabled(bool enabled);
+    //!cpp:function::
+    extern OCIOEXPORT bool IsDirectoryIndexEnabled();
+    //!cpp:function:: Defer the loading of the files referenced by the file transforms until
+    // a processor really needs their content (e.g. the CPU or GPU processors, its cache ID
+    // or its group transform). The file references are still resolved when building the
+    // processor, so a missing file is reported right away, but a file followed by its own
+    // inverse (i.e. same file, opposite direction) is then never read by the CPU and GPU
+    // processors. This mostly helps the applications building many processors which are
+    // never used. Default is disabled.
+    extern OCIOEXPORT void SetLazyFileLoadingEnabled(bool enabled);
+    //!cpp:function::
+    extern OCIOEXPORT bool IsLazyFileLoadingEnabled();
+    //!cpp:function:: Set the maximum number of threads reading the files of a processor being
+    // built. The files a transform may need (including the ones of the color spaces and looks
+    // it refers to) which are not in the file cache yet are then read concurrently before
+    // building the ops, instead of one after the other. 1 disables the concurrent reading, 0
+    // (the default) uses the number of cores.
+    extern OCIOEXPORT void SetFileLoadingThreads(unsigned numThreads);
+    //!cpp:function::
+    extern OCIOEXPORT unsigned GetFileLoadingThreads();
+    //!cpp:function:: Set the maximum number of threads evaluating the samples of a bake
+    // (refer to :cpp:class:`Baker`), including the calling thread. 1 evaluates the samples in
+    // the calling thread only, 0 (the default) uses the number of cores.
+    extern OCIOEXPORT void SetBakingThreads(unsigned numThreads);
+    //!cpp:function::
+    extern OCIOEXPORT unsigned GetBakingThreads();
+
+    //!cpp:function:: Number of entries held by the caches of the type (refer to
+    // :cpp:type:`CacheType`).
+    extern OCIOEXPORT size_t GetCacheNumEntries(CacheType type);
+    //!cpp:function:: Approximate memory (in bytes) used by the entries of the caches of the
+    // type. The objects shared with the callers (e.g. the processors) only count for their
+    // key and bookkeeping.
+    extern OCIOEXPORT size_t GetCacheMemoryUsage(CacheType type);
+    //!cpp:function:: Number of lookups served by the caches of the type.
+    extern OCIOEXPORT unsigned long GetCacheNumHits(CacheType type);
+    //!cpp:function:: Number of lookups which had to compute the entry.
+    extern OCIOEXPORT unsigned long GetCacheNumMisses(CacheType type);
+    //!cpp:function:: Number of entries discarded to honor the size limit or the memory budget
+    // of the caches of the type.
+    extern OCIOEXPORT unsigned long GetCacheNumEvictions(CacheType type);
+    //!cpp:function:: Time (in seconds) spent computing the missing entries.
+    extern OCIOEXPORT double GetCacheMissTime(CacheType type);
+    //!cpp:function:: Reset the hits, misses, evictions and miss times of all the caches. The
+    // cached entries are kept.
+    extern OCIOEXPORT void ResetCacheStatistics();
     
     //!cpp:function:: Get the version number for the library, as a
     // dot-delimited string (e.g., "1.0.0"). This is also available
@@ -198,6 +292,11 @@ OCIO_NAMESPACE_ENTER
         static ConstConfigRcPtr CreateFromFile(const char * filename);
         //!cpp:function::
         static ConstConfigRcPtr CreateFromStream(std::istream & istream);
+        //!cpp:function:: Constructor a configuration from its binary form (refer to
+        // serializeBinary()), without any YAML parsing. This throws an exception if the
+        // binary was written by another version of the library, if it is corrupted, or if
+        // the config file it was created from was modified since.
+        static ConstConfigRcPtr CreateFromBinary(std::istream & istream);
         
         //!cpp:function::
         ConfigRcPtr createEditableCopy() const;
@@ -230,6 +329,15 @@ OCIO_NAMESPACE_ENTER
         // This is typically stored on disk in a file with the extension .ocio.
         void serialize(std::ostream & os) const;
         
+        //!cpp:function::
+        // Write the Config in a compact and versioned binary form, for a fast loading with
+        // CreateFromBinary(). The binary also holds the result of sanityCheck() and the
+        // cacheID of the config without its context, so they are not computed again. When
+        // the config was created by CreateFromFile() and not edited since, the binary
+        // records the config file and its fast hash (i.e. mtime, inode and size) so a
+        // binary outdated by an edit of the file is rejected.
+        void serializeBinary(std::ostream & os) const;
+        
         //!cpp:function::
         // This will produce a hash of the all colorspace definitions, etc.
         // All external references, such as files used in FileTransforms, etc.,
@@ -537,6 +645,16 @@ OCIO_NAMESPACE_ENTER
                                          const ConstTransformRcPtr& transform,
                                          TransformDirection direction) const;
 
+        //!cpp:function:: The processors are cached by the config (the cache is enabled by
+        // default) so identical requests return the same processor. The cache is emptied
+        // each time the config is modified. Processors built from LUT transforms or holding
+        // dynamic properties are never cached.
+        void setProcessorCacheEnabled(bool enabled);
+        //!cpp:function::
+        bool isProcessorCacheEnabled() const;
+        //!cpp:function:: Ratio of the cacheable processor requests found in the cache.
+        double getProcessorCacheHitRate() const;
+
     private:
         Config();
         ~Config();
@@ -968,6 +1086,11 @@ OCIO_NAMESPACE_ENTER
         //!cpp:function::        
         ConstGPUProcessorRcPtr getOptimizedGPUProcessor(OptimizationFlags oFlags, 
                                                         FinalizationFlags fFlags) const;
+        //!cpp:function:: Same as above but also records the optimization passes in
+        //                the trace. Refer to :cpp:class:`OptimizationTrace`.
+        ConstGPUProcessorRcPtr getOptimizedGPUProcessor(OptimizationFlags oFlags, 
+                                                        FinalizationFlags fFlags,
+                                                        const OptimizationTraceRcPtr & trace) const;
         
         ///////////////////////////////////////////////////////////////////////////
         //!rst::
@@ -999,6 +1122,11 @@ OCIO_NAMESPACE_ENTER
         //     OCIO::PackedImageDesc img(imgDataPtr, imgWidth, imgHeight, imgChannels);
         //     cpuProcessor->apply(img);
         //     
+        //
+        // ?> **Note:**
+        //    Without dynamic properties, the CPU processors are memoized: identical
+        //    requests return the same instance. A CPU processor may then be shared
+        //    and applied concurrently by several threads.
 
         //!cpp:function::        
         ConstCPUProcessorRcPtr getDefaultCPUProcessor() const;
@@ -1010,6 +1138,13 @@ OCIO_NAMESPACE_ENTER
                                                         BitDepth outBitDepth,
                                                         OptimizationFlags oFlags, 
                                                         FinalizationFlags fFlags) const;
+        //!cpp:function:: Same as above but also records the optimization passes in
+        //                the trace. Refer to :cpp:class:`OptimizationTrace`.
+        ConstCPUProcessorRcPtr getOptimizedCPUProcessor(BitDepth inBitDepth,
+                                                        BitDepth outBitDepth,
+                                                        OptimizationFlags oFlags, 
+                                                        FinalizationFlags fFlags,
+                                                        const OptimizationTraceRcPtr & trace) const;
 
     private:
         Processor();
@@ -1184,6 +1319,66 @@ OCIO_NAMESPACE_ENTER
         Impl * getImpl() { return m_impl; }
         const Impl * getImpl() const { return m_impl; }
     };
+
+
+    //!cpp:class::
+    // This class records the passes of the op list optimization done when
+    // creating an optimized CPU or GPU processor, to help understanding the
+    // performance of a color transformation (e.g. which ops were combined,
+    // which ops remain and what were the LUT sizes).  The trace is opt-in
+    // (refer to `Processor::getOptimizedCPUProcessor`) and it does not impact
+    // the pixel processing.
+    //
+    // For each pass, the trace holds the op list before and after the pass
+    // where each op is described by its information string, its cache
+    // identifier and its LUT size i.e. the length of a 1D LUT, the grid size
+    // of a 3D LUT, and 0 for all other ops.
+
+    class OCIOEXPORT OptimizationTrace
+    {
+    public:
+        //!cpp:function::
+        static OptimizationTraceRcPtr Create();
+
+        //!cpp:function:: Remove all the recorded passes.
+        virtual void clear() = 0;
+
+        //!cpp:function::
+        virtual int getNumPasses() const = 0;
+        //!cpp:function:: Name of the optimization pass (e.g. "CombineOps").
+        virtual const char * getPassName(int passIndex) const = 0;
+        //!cpp:function:: Time spent in the pass, in milliseconds.
+        virtual double getPassDuration(int passIndex) const = 0;
+
+        //!cpp:function::
+        virtual int getNumOpsBefore(int passIndex) const = 0;
+        //!cpp:function::
+        virtual const char * getOpInfoBefore(int passIndex, int opIndex) const = 0;
+        //!cpp:function::
+        virtual const char * getOpCacheIDBefore(int passIndex, int opIndex) const = 0;
+        //!cpp:function::
+        virtual unsigned long getOpLutSizeBefore(int passIndex, int opIndex) const = 0;
+
+        //!cpp:function::
+        virtual int getNumOpsAfter(int passIndex) const = 0;
+        //!cpp:function::
+        virtual const char * getOpInfoAfter(int passIndex, int opIndex) const = 0;
+        //!cpp:function::
+        virtual const char * getOpCacheIDAfter(int passIndex, int opIndex) const = 0;
+        //!cpp:function::
+        virtual unsigned long getOpLutSizeAfter(int passIndex, int opIndex) const = 0;
+
+    protected:
+        OptimizationTrace() = default;
+        virtual ~OptimizationTrace() = default;
+
+    private:
+        OptimizationTrace(const OptimizationTrace &) = delete;
+        OptimizationTrace & operator= (const OptimizationTrace &) = delete;
+    };
+
+    //!cpp:function::
+    extern OCIOEXPORT std::ostream & operator<< (std::ostream &, const OptimizationTrace &);
     
     
     
@@ -80,6 +80,12 @@ OCIO_NAMESPACE_ENTER
     typedef OCIO_SHARED_PTR<const ProcessorMetadata> ConstProcessorMetadataRcPtr;
     //!cpp:type::
     typedef OCIO_SHARED_PTR<ProcessorMetadata> ProcessorMetadataRcPtr;
+
+    class OCIOEXPORT OptimizationTrace;
+    //!cpp:type::
+    typedef OCIO_SHARED_PTR<const OptimizationTrace> ConstOptimizationTraceRcPtr;
+    //!cpp:type::
+    typedef OCIO_SHARED_PTR<OptimizationTrace> OptimizationTraceRcPtr;
     
     class OCIOEXPORT Baker;
     //!cpp:type::
@@ -389,6 +395,22 @@ OCIO_NAMESPACE_ENTER
         DYNAMIC_PROPERTY_BOOL    //! Value is a bool
     };
 
+    //!cpp:type:: Enumeration of the caches reported by :cpp:func:`GetCacheNumEntries` and
+    // the other cache statistics functions. The statistics of a type aggregate all its
+    // instances (e.g. the caches of all the configs).
+    enum CacheType
+    {
+        CACHE_FILE = 0,             //! Files read by the FileTransforms
+        CACHE_FILE_HASH,            //! Fast hashes identifying the versions of the files
+        CACHE_CDL_FILE,             //! Color corrections read from the CDL files
+        CACHE_CONTEXT_RESULTS,      //! Resolved strings and file locations of the contexts
+        CACHE_CONFIG_CACHE_ID,      //! Cache ids of the configs
+        CACHE_PROCESSOR,            //! Processors of the configs
+        CACHE_OPTIMIZED_PROCESSOR,  //! Optimized CPU and GPU processors of the processors
+        CACHE_CPU_ENGINE,           //! CPU renderers shared by the identical CPU processors
+        CACHE_BAKED_SAMPLES         //! LUT samples shared by the bakes of the same transforms
+    };
+
     //!cpp:type:: Provides control over how the ops in a Processor are combined 
     //            in order to improve performance.
     enum OptimizationFlags
@@ -424,9 +446,14 @@ OCIO_NAMESPACE_ENTER
         // For integer input bit-depth only, replace separable ops 
         // (i.e. no channel crosstalk ops) by a single 1D LUT of input bit-depth domain.
         OPTIMIZATION_COMP_SEPARABLE_PREFIX = 0x0400,
+        // Bake the dynamic properties at their current values so that the ops holding
+        // them are optimized like any other op. The CPU processor lazily re-bakes
+        // the op list when a dynamic property value changes.
+        OPTIMIZATION_DYNAMIC_REBAKE        = 0x0800,
 
-        // Can apply all the optimization types.
-        OPTIMIZATION_ALL                   = 0xFFFF,
+        // Can apply all the optimization types. OPTIMIZATION_DYNAMIC_REBAKE is not included as
+        // it changes when the CPU processors are built, it must be requested explicitly.
+        OPTIMIZATION_ALL                   = (0xFFFF & ~OPTIMIZATION_DYNAMIC_REBAKE),
 
         // Below are listed all the optimization grades from the highest to lowest quality.
 
@@ -536,6 +563,11 @@ OCIO_NAMESPACE_ENTER
     //!cpp:function::
     extern OCIOEXPORT ExposureContrastStyle ExposureContrastStyleFromString(const char * style);
 
+    //!cpp:function::
+    extern OCIOEXPORT const char * CacheTypeToString(CacheType type);
+    //!cpp:function::
+    extern OCIOEXPORT CacheType CacheTypeFromString(const char * type);
+
 
     /*!rst::
     Roles
@@ -1,18 +1,317 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
-#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
 #include <iostream>
+#include <list>
+#include <map>
+#include <sstream>
+#include <system_error>
+#include <thread>
+#include <vector>
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "Baker.h"
+#include "CacheStatistics.h"
 #include "transforms/FileTransform.h"
 #include "MathUtils.h"
+#include "Mutex.h"
+#include "ops/Lut1D/Lut1DOp.h"
 #include "pystring/pystring.h"
 
 OCIO_NAMESPACE_ENTER
 {
-    
+    namespace
+    {
+        // Number of pixels evaluated at once by a thread.
+        const long SAMPLES_CHUNK_SIZE = 16384;
+
+        // The samples of a 65^3 cube take about 3MB. The cache is bounded and discards
+        // the least recently used samples.
+        const size_t MAX_BAKED_SAMPLES_CACHE_SIZE = 8;
+
+        // The most recently used samples are at the front.
+        typedef std::list<std::pair<std::string, ConstBakedSamplesRcPtr>> BakedSamplesList;
+        typedef std::map<std::string, BakedSamplesList::iterator> BakedSamplesMap;
+
+        std::atomic<unsigned> g_bakingThreads(0);
+
+        Mutex g_samplesCacheLock;
+        BakedSamplesList g_samplesList;
+        BakedSamplesMap g_samplesMap;
+
+        size_t GetSamplesCacheEntrySize(const BakedSamplesList::value_type & entry)
+        {
+            return sizeof(BakedSamplesList::value_type) + sizeof(BakedSamplesMap::value_type)
+                + 2 * entry.first.size() + entry.second->size() * sizeof(float);
+        }
+
+        ConstBakedSamplesRcPtr GetCachedSamples(const std::string & key)
+        {
+            AutoMutex lock(g_samplesCacheLock);
+
+            BakedSamplesMap::iterator entry = g_samplesMap.find(key);
+            if(entry==g_samplesMap.end())
+            {
+                GetCacheCounters(CACHE_BAKED_SAMPLES).addMiss();
+                return ConstBakedSamplesRcPtr();
+            }
+
+            GetCacheCounters(CACHE_BAKED_SAMPLES).addHit();
+
+            g_samplesList.splice(g_samplesList.begin(), g_samplesList, entry->second);
+            return entry->second->second;
+        }
+
+        void AddCachedSamples(const std::string & key, const ConstBakedSamplesRcPtr & samples)
+        {
+            AutoMutex lock(g_samplesCacheLock);
+
+            if(g_samplesMap.find(key)!=g_samplesMap.end())
+            {
+                // Another bake was faster.
+                return;
+            }
+
+            g_samplesList.push_front(std::make_pair(key, samples));
+            g_samplesMap[key] = g_samplesList.begin();
+            GetCacheCounters(CACHE_BAKED_SAMPLES).addEntries(
+                1, GetSamplesCacheEntrySize(g_samplesList.front()));
+
+            if(g_samplesList.size()>MAX_BAKED_SAMPLES_CACHE_SIZE)
+            {
+                GetCacheCounters(CACHE_BAKED_SAMPLES).removeEntries(
+                    1, GetSamplesCacheEntrySize(g_samplesList.back()));
+                GetCacheCounters(CACHE_BAKED_SAMPLES).addEvictions(1);
+                g_samplesMap.erase(g_samplesList.back().first);
+                g_samplesList.pop_back();
+            }
+        }
+
+        // Compute the key identifying the samples evaluated by the processors. An empty
+        // key means that the samples must not be shared (i.e. a dynamic property could
+        // change between the bakes).
+        std::string ComputeSamplesKey(const ConstProcessorVec & processors,
+                                      const std::string & samplesID)
+        {
+            std::ostringstream oss;
+            oss << samplesID;
+
+            for(const auto & processor : processors)
+            {
+                if(processor->hasDynamicProperty(DYNAMIC_PROPERTY_EXPOSURE)
+                   || processor->hasDynamicProperty(DYNAMIC_PROPERTY_CONTRAST)
+                   || processor->hasDynamicProperty(DYNAMIC_PROPERTY_GAMMA))
+                {
+                    return "";
+                }
+                oss << " " << processor->getCacheID();
+            }
+
+            return oss.str();
+        }
+
+        // Apply the processors to the RGB samples. The chunks of samples are shared by the
+        // calling thread and the worker threads, which all apply the same CPU processors.
+        void EvaluateSamples(const ConstProcessorVec & processors, std::vector<float> & samples)
+        {
+            std::vector<ConstCPUProcessorRcPtr> cpuProcessors;
+            for(const auto & processor : processors)
+            {
+                cpuProcessors.push_back(processor->getDefaultCPUProcessor());
+            }
+
+            const long numPixels = long(samples.size() / 3);
+            if(cpuProcessors.empty() || numPixels==0)
+            {
+                return;
+            }
+
+            const long numChunks = (numPixels + SAMPLES_CHUNK_SIZE - 1) / SAMPLES_CHUNK_SIZE;
+
+            std::atomic<long> nextChunk(0);
+            Mutex errorLock;
+            std::exception_ptr error;
+
+            auto evaluate = [&]()
+            {
+                try
+                {
+                    for(long chunk = nextChunk++; chunk < numChunks; chunk = nextChunk++)
+                    {
+                        const long first = chunk * SAMPLES_CHUNK_SIZE;
+                        const long num = std::min(SAMPLES_CHUNK_SIZE, numPixels - first);
+
+                        PackedImageDesc img(&samples[3 * first], num, 1, 3);
+                        for(const auto & cpu : cpuProcessors)
+                        {
+                            cpu->apply(img);
+                        }
+                    }
+                }
+                catch(...)
+                {
+                    AutoMutex lock(errorLock);
+                    if(!error)
+                    {
+                        error = std::current_exception();
+                    }
+                    // Stop the other threads.
+                    nextChunk = numChunks;
+                }
+            };
+
+            unsigned maxThreads = g_bakingThreads;
+            if(maxThreads==0)
+            {
+                maxThreads = std::thread::hardware_concurrency();
+            }
+            const long numThreads = std::min(long(std::max(1u, maxThreads)), numChunks);
+
+            std::vector<std::thread> threads;
+            for(long t = 1; t < numThreads; ++t)
+            {
+                try
+                {
+                    threads.push_back(std::thread(evaluate));
+                }
+                catch(const std::system_error &)
+                {
+                    // The available threads process the remaining chunks.
+                    break;
+                }
+            }
+
+            evaluate();
+
+            for(auto & thread : threads)
+            {
+                thread.join();
+            }
+
+            if(error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+
+        template<typename Generator>
+        ConstBakedSamplesRcPtr BakeSamples(const ConstProcessorVec & processors,
+                                           const std::string & samplesID,
+                                           Generator generate)
+        {
+            const std::string key = ComputeSamplesKey(processors, samplesID);
+            if(!key.empty())
+            {
+                ConstBakedSamplesRcPtr samples = GetCachedSamples(key);
+                if(samples)
+                {
+                    return samples;
+                }
+            }
+
+            const std::chrono::steady_clock::time_point missStart
+                = std::chrono::steady_clock::now();
+
+            OCIO_SHARED_PTR<std::vector<float>> samples = std::make_shared<std::vector<float>>();
+            generate(*samples);
+            EvaluateSamples(processors, *samples);
+
+            if(!key.empty())
+            {
+                AddCachedSamples(key, samples);
+
+                GetCacheCounters(CACHE_BAKED_SAMPLES).addMissTime(
+                    std::chrono::steady_clock::now() - missStart);
+            }
+
+            return samples;
+        }
+    }
+
+    void SetBakingThreads(unsigned numThreads)
+    {
+        g_bakingThreads = numThreads;
+    }
+
+    unsigned GetBakingThreads()
+    {
+        return g_bakingThreads;
+    }
+
+    ConstBakedSamplesRcPtr BakeLut3DSamples(const ConstProcessorVec & processors,
+                                            int edgeLen,
+                                            Lut3DOrder order)
+    {
+        std::ostringstream samplesID;
+        samplesID << "3D " << edgeLen << " " << order;
+
+        return BakeSamples(processors, samplesID.str(),
+                           [edgeLen, order](std::vector<float> & samples)
+                           {
+                               samples.resize(size_t(edgeLen) * edgeLen * edgeLen * 3);
+                               GenerateIdentityLut3D(&samples[0], edgeLen, 3, order);
+                           });
+    }
+
+    ConstBakedSamplesRcPtr BakeLut1DSamples(const ConstProcessorVec & processors, int size)
+    {
+        std::ostringstream samplesID;
+        samplesID << "1D " << size;
+
+        return BakeSamples(processors, samplesID.str(),
+                           [size](std::vector<float> & samples)
+                           {
+                               samples.resize(size_t(size) * 3);
+                               GenerateIdentityLut1D(&samples[0], size, 3);
+                           });
+    }
+
+    ConstBakedSamplesRcPtr BakeLut1DSamples(const ConstProcessorVec & processors,
+                                            int size,
+                                            float start,
+                                            float end)
+    {
+        std::ostringstream samplesID;
+        // Enough digits to identify the floats.
+        samplesID.precision(9);
+        samplesID << "1D " << size << " " << start << " " << end;
+
+        return BakeSamples(processors, samplesID.str(),
+                           [size, start, end](std::vector<float> & samples)
+                           {
+                               samples.resize(size_t(size) * 3);
+                               for(int i = 0; i < size; ++i)
+                               {
+                                   const float x = (float)(double(i) / double(size - 1));
+                                   const float value = lerpf(start, end, x);
+
+                                   samples[3*i+0] = value;
+                                   samples[3*i+1] = value;
+                                   samples[3*i+2] = value;
+                               }
+                           });
+    }
+
+    void ClearBakerCaches()
+    {
+        AutoMutex lock(g_samplesCacheLock);
+
+        size_t memorySize = 0;
+        for(const auto & entry : g_samplesList)
+        {
+            memorySize += GetSamplesCacheEntrySize(entry);
+        }
+        GetCacheCounters(CACHE_BAKED_SAMPLES).removeEntries(g_samplesList.size(), memorySize);
+
+        g_samplesMap.clear();
+        g_samplesList.clear();
+    }
+
     BakerRcPtr Baker::Create()
     {
         return BakerRcPtr(new Baker(), &deleter);
@@ -388,6 +687,101 @@ OCIO_ADD_TEST(Baker_Unit_Tests, bake)
 
 }
 
+OCIO_ADD_TEST(Baker_Unit_Tests, shared_samples)
+{
+    // The formats baked from the same settings share their evaluated samples.
+
+    static const std::string myProfile =
+        "ocio_profile_version: 1\n"
+        "\n"
+        "colorspaces :\n"
+        "  - !<ColorSpace>\n"
+        "    name : lnh\n"
+        "\n"
+        "  - !<ColorSpace>\n"
+        "    name : test\n"
+        "    to_reference : !<ExponentTransform> {value: [2.2, 2.2, 2.2, 1]}\n";
+
+    std::istringstream is(myProfile);
+    OCIO::ConstConfigRcPtr config;
+    OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
+
+    OCIO::ClearAllCaches();
+    OCIO_CHECK_EQUAL(OCIO::GetCacheNumEntries(OCIO::CACHE_BAKED_SAMPLES), 0);
+    const unsigned long hits = OCIO::GetCacheNumHits(OCIO::CACHE_BAKED_SAMPLES);
+    const unsigned long misses = OCIO::GetCacheNumMisses(OCIO::CACHE_BAKED_SAMPLES);
+
+    OCIO::BakerRcPtr bake = OCIO::Baker::Create();
+    bake->setConfig(config);
+    bake->setInputSpace("lnh");
+    bake->setTargetSpace("test");
+    // Several chunks of samples.
+    bake->setCubeSize(33);
+
+    bake->setFormat("iridas_cube");
+    std::ostringstream cube;
+    OCIO_CHECK_NO_THROW(bake->bake(cube));
+    OCIO_CHECK_EQUAL(OCIO::GetCacheNumEntries(OCIO::CACHE_BAKED_SAMPLES), 1);
+    OCIO_CHECK_EQUAL(OCIO::GetCacheNumMisses(OCIO::CACHE_BAKED_SAMPLES), misses + 1);
+
+    bake->setFormat("iridas_itx");
+    std::ostringstream itx;
+    OCIO_CHECK_NO_THROW(bake->bake(itx));
+    OCIO_CHECK_EQUAL(OCIO::GetCacheNumEntries(OCIO::CACHE_BAKED_SAMPLES), 1);
+    OCIO_CHECK_EQUAL(OCIO::GetCacheNumHits(OCIO::CACHE_BAKED_SAMPLES), hits + 1);
+
+    // Both files have the same cube.
+    const std::string cubeStr = cube.str();
+    const std::string itxStr = itx.str();
+    const std::string values = cubeStr.substr(cubeStr.find("LUT_3D_SIZE"));
+    OCIO_CHECK_EQUAL(itxStr.substr(itxStr.find("LUT_3D_SIZE")), values + "\n");
+
+    // The flame format uses another order of the samples.
+    bake->setFormat("flame");
+    std::ostringstream flame;
+    OCIO_CHECK_NO_THROW(bake->bake(flame));
+    OCIO_CHECK_EQUAL(OCIO::GetCacheNumEntries(OCIO::CACHE_BAKED_SAMPLES), 2);
+
+    // The flame file only holds integers.
+    const std::string flameStr = flame.str();
+    OCIO_CHECK_EQUAL(flameStr.substr(0, 2), "0 ");
+    OCIO_CHECK_EQUAL(flameStr.find('.'), std::string::npos);
+    OCIO_CHECK_EQUAL(flameStr.substr(flameStr.size() - 2), "\n\n");
+
+    // The samples evaluated by chunks are identical to the ones of a single evaluation.
+    OCIO::ConstProcessorRcPtr processor = config->getProcessor("lnh", "test");
+    OCIO::ConstBakedSamplesRcPtr samples;
+    OCIO_CHECK_NO_THROW(samples = OCIO::BakeLut3DSamples({ processor }, 33,
+                                                         OCIO::LUT3DORDER_FAST_RED));
+    OCIO_REQUIRE_EQUAL(samples->size(), 33 * 33 * 33 * 3);
+
+    std::vector<float> expected(samples->size());
+    OCIO::GenerateIdentityLut3D(&expected[0], 33, 3, OCIO::LUT3DORDER_FAST_RED);
+    OCIO::PackedImageDesc img(&expected[0], 33 * 33 * 33, 1, 3);
+    processor->getDefaultCPUProcessor()->apply(img);
+    OCIO_CHECK_ASSERT(*samples == expected);
+
+    // The same samples are evaluated by the calling thread only.
+    OCIO::SetBakingThreads(1);
+    OCIO_CHECK_EQUAL(OCIO::GetBakingThreads(), 1);
+    OCIO::ClearAllCaches();
+    OCIO_CHECK_NO_THROW(samples = OCIO::BakeLut3DSamples({ processor }, 33,
+                                                         OCIO::LUT3DORDER_FAST_RED));
+    OCIO_CHECK_ASSERT(*samples == expected);
+    OCIO::SetBakingThreads(0);
+
+    // A linear ramp of the 1D samples.
+    OCIO_CHECK_NO_THROW(samples = OCIO::BakeLut1DSamples({ }, 5, 0.5f, 2.5f));
+    OCIO_REQUIRE_EQUAL(samples->size(), 15);
+    OCIO_CHECK_EQUAL((*samples)[0], 0.5f);
+    OCIO_CHECK_EQUAL((*samples)[7], 1.5f);
+    OCIO_CHECK_EQUAL((*samples)[14], 2.5f);
+
+    OCIO::ClearAllCaches();
+    OCIO_CHECK_EQUAL(OCIO::GetCacheNumEntries(OCIO::CACHE_BAKED_SAMPLES), 0);
+    OCIO_CHECK_EQUAL(OCIO::GetCacheMemoryUsage(OCIO::CACHE_BAKED_SAMPLES), 0);
+}
+
 #endif // OCIO_BUILD_TESTS
 
     
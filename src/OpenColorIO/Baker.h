@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_BAKER_H
+#define INCLUDED_OCIO_BAKER_H
+
+#include <vector>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "ops/Lut3D/Lut3DOp.h"
+
+OCIO_NAMESPACE_ENTER
+{
+    // Evaluation of the LUT samples baked by the file formats.
+    //
+    // The samples are RGB and evaluated by the processors applied in sequence. The
+    // evaluation is split in chunks processed concurrently by the CPU processors, and the
+    // result is shared by all the bakes of the same processors and sizes (e.g. several
+    // formats baked from the same settings only evaluate their cube once).
+
+    typedef std::vector<ConstProcessorRcPtr> ConstProcessorVec;
+    typedef OCIO_SHARED_PTR<const std::vector<float>> ConstBakedSamplesRcPtr;
+
+    // Samples of the identity 3D LUT of the given edge length and order.
+    ConstBakedSamplesRcPtr BakeLut3DSamples(const ConstProcessorVec & processors,
+                                            int edgeLen,
+                                            Lut3DOrder order);
+
+    // Samples of the identity 1D LUT of the given size (refer to GenerateIdentityLut1D()).
+    ConstBakedSamplesRcPtr BakeLut1DSamples(const ConstProcessorVec & processors, int size);
+
+    // Samples of the 1D LUT of the given size linearly sampling [start, end].
+    ConstBakedSamplesRcPtr BakeLut1DSamples(const ConstProcessorVec & processors,
+                                            int size,
+                                            float start,
+                                            float end);
+
+    // Clear the process-wide cache of baked samples.
+    void ClearBakerCaches();
+}
+OCIO_NAMESPACE_EXIT
+
+#endif
@@ -1,12 +1,19 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <atomic>
+#include <list>
+#include <map>
+#include <memory>
+#include <sstream>
 #include <string.h>
 
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "BitDepthUtils.h"
+#include "CacheStatistics.h"
 #include "CPUProcessor.h"
+#include "Mutex.h"
 #include "ops/Lut1D/Lut1DOpCPU.h"
 #include "ops/Lut3D/Lut3DOpCPU.h"
 #include "ops/Matrix/MatrixOps.h"
@@ -209,8 +216,8 @@ void CreateCPUEngine(const OpRcPtrVec & ops,
 }
 
 
-ScanlineHelper * CreateScanlineHelper(BitDepth in, ConstOpCPURcPtr & inBitDepthOp,
-                                      BitDepth out, ConstOpCPURcPtr & outBitDepthOp)
+ScanlineHelper * CreateScanlineHelper(BitDepth in, const ConstOpCPURcPtr & inBitDepthOp,
+                                      BitDepth out, const ConstOpCPURcPtr & outBitDepthOp)
 {
 
 #define ADD_OUT_BIT_DEPTH(in, out)                    \
@@ -264,14 +271,204 @@ case in:                                              \
     throw Exception("Unsupported bit-depths");
 }
 
+namespace
+{
+
+// Give the scanline helper of the processor to an apply() call, or a temporary one
+// while another thread applies the processor (e.g. different images, or the chunks of
+// the same image, processed concurrently).
+class ScopedScanlineHelper
+{
+public:
+    ScopedScanlineHelper(std::atomic<bool> & inUse,
+                         ScanlineHelper * helper,
+                         BitDepth in, const ConstOpCPURcPtr & inBitDepthOp,
+                         BitDepth out, const ConstOpCPURcPtr & outBitDepthOp)
+        :   m_inUse(inUse)
+        ,   m_helper(helper)
+    {
+        if(m_inUse.exchange(true))
+        {
+            m_temporary.reset(CreateScanlineHelper(in, inBitDepthOp, out, outBitDepthOp));
+            m_helper = m_temporary.get();
+        }
+    }
+
+    ScopedScanlineHelper() = delete;
+    ScopedScanlineHelper(const ScopedScanlineHelper &) = delete;
+    ScopedScanlineHelper & operator=(const ScopedScanlineHelper &) = delete;
+
+    ~ScopedScanlineHelper()
+    {
+        if(!m_temporary)
+        {
+            m_inUse = false;
+        }
+    }
+
+    ScanlineHelper * operator->() const { return m_helper; }
+
+private:
+    std::atomic<bool> & m_inUse;
+    ScanlineHelper * m_helper;
+    std::unique_ptr<ScanlineHelper> m_temporary;
+};
+
+// The CPU engine i.e. the CPU ops built from an optimized & finalized op list.
+struct CPUEngine
+{
+    ConstOpCPURcPtr    m_inBitDepthOp;
+    ConstOpCPURcPtrVec m_cpuOps;
+    ConstOpCPURcPtr    m_outBitDepthOp;
+    bool               m_hasChannelCrosstalk = true;
+    std::string        m_cacheID;
+};
+
+typedef OCIO_SHARED_PTR<const CPUEngine> ConstCPUEngineRcPtr;
+
+// Processors created from the same ops with the same bit-depths and flags share their
+// CPU engine (i.e. the renderers and their LUTs) to avoid optimizing and finalizing
+// the same op list again. The cache is bounded and discards the least recently used
+// engine.
+
+const size_t MAX_CPU_ENGINE_CACHE_SIZE = 64;
+
+// The most recently used engine is at the front.
+typedef std::list<std::pair<std::string, ConstCPUEngineRcPtr>> CPUEngineList;
+typedef std::map<std::string, CPUEngineList::iterator> CPUEngineMap;
+
+Mutex g_engineCacheLock;
+CPUEngineList g_engineList;
+CPUEngineMap g_engineMap;
+
+// The renderers are shared with the processors, only the bookkeeping is accounted.
+size_t GetEngineCacheEntrySize(const std::string & key)
+{
+    return sizeof(CPUEngineList::value_type) + sizeof(CPUEngineMap::value_type)
+        + sizeof(CPUEngine) + 2 * key.size();
+}
+
+ConstCPUEngineRcPtr GetCachedEngine(const std::string & key)
+{
+    AutoMutex lock(g_engineCacheLock);
+
+    CPUEngineMap::iterator entry = g_engineMap.find(key);
+    if(entry==g_engineMap.end())
+    {
+        GetCacheCounters(CACHE_CPU_ENGINE).addMiss();
+        return ConstCPUEngineRcPtr();
+    }
+
+    GetCacheCounters(CACHE_CPU_ENGINE).addHit();
+
+    g_engineList.splice(g_engineList.begin(), g_engineList, entry->second);
+    return entry->second->second;
+}
+
+void AddCachedEngine(const std::string & key, const ConstCPUEngineRcPtr & engine)
+{
+    AutoMutex lock(g_engineCacheLock);
+
+    if(g_engineMap.find(key)!=g_engineMap.end())
+    {
+        // Another processor was faster.
+        return;
+    }
+
+    g_engineList.push_front(std::make_pair(key, engine));
+    g_engineMap[key] = g_engineList.begin();
+    GetCacheCounters(CACHE_CPU_ENGINE).addEntries(1, GetEngineCacheEntrySize(key));
+
+    if(g_engineList.size()>MAX_CPU_ENGINE_CACHE_SIZE)
+    {
+        const std::string & oldestKey = g_engineList.back().first;
+        GetCacheCounters(CACHE_CPU_ENGINE).removeEntries(1, GetEngineCacheEntrySize(oldestKey));
+        GetCacheCounters(CACHE_CPU_ENGINE).addEvictions(1);
+        g_engineMap.erase(oldestKey);
+        g_engineList.pop_back();
+    }
+}
+
+// Compute the key identifying the CPU engine built from the ops. An empty key means that
+// the engine must not be shared (e.g. each processor owns its dynamic properties).
+std::string ComputeEngineKey(const OpRcPtrVec & rawOps,
+                             BitDepth in, BitDepth out,
+                             OptimizationFlags oFlags, FinalizationFlags fFlags)
+{
+    std::ostringstream oss;
+    oss << BitDepthToString(in) << " " << BitDepthToString(out)
+        << " " << oFlags << " " << fFlags;
+
+    for(const auto & op : rawOps)
+    {
+        const std::string id = op->getCacheID();
+        if(op->isDynamic() || id.empty())
+        {
+            return "";
+        }
+        oss << " " << id;
+    }
+
+    return oss.str();
+}
+
+}
+
+void ClearCPUProcessorCache()
+{
+    AutoMutex lock(g_engineCacheLock);
+
+    size_t memorySize = 0;
+    for(const auto & entry : g_engineList)
+    {
+        memorySize += GetEngineCacheEntrySize(entry.first);
+    }
+    GetCacheCounters(CACHE_CPU_ENGINE).removeEntries(g_engineList.size(), memorySize);
+
+    g_engineMap.clear();
+    g_engineList.clear();
+}
+
+// The engine is never modified once built so the calls in progress can keep using it
+// while another thread replaces the engine of the processor.
+struct CPUProcessor::Impl::Engine
+{
+    ConstOpCPURcPtr    m_inBitDepthOp; // Converts from in to F32. It could be done by
+                                       // the first op.
+    ConstOpCPURcPtrVec m_cpuOps;       // It could be empty if the OpVec only contains a
+                                       // 1D LUT op (e.g. the 1D LUT CPUOp instance would
+                                       // be in the m_inBitDepthOp).
+    ConstOpCPURcPtr    m_outBitDepthOp;// Converts from F32 to out. It could be done by
+                                       // the last op.
+
+    // Values of the dynamic properties baked in the ops (i.e. OPTIMIZATION_DYNAMIC_REBAKE).
+    std::vector<double> m_bakedValues;
+
+    // The scanline helper holds the buffers of an apply() call, so the concurrent calls
+    // use a temporary one.
+    mutable std::unique_ptr<ScanlineHelper> m_scanlineBuilder;
+    mutable std::atomic<bool>               m_scanlineBuilderInUse{false};
+};
+
 DynamicPropertyRcPtr CPUProcessor::Impl::getDynamicProperty(DynamicPropertyType type) const
 {
-    if(m_inBitDepthOp->hasDynamicProperty(type))
+    // When baked, the CPU ops do not hold the dynamic properties anymore.
+    for(const auto & prop : m_dynamicProperties)
+    {
+        if(prop->getType()==type)
+        {
+            return prop;
+        }
+    }
+
+    const ConstEngineRcPtr engine = std::atomic_load(&m_engine);
+
+    if(engine->m_inBitDepthOp->hasDynamicProperty(type))
     {
-        return m_inBitDepthOp->getDynamicProperty(type);
+        return engine->m_inBitDepthOp->getDynamicProperty(type);
     }
 
-    for(const auto & op : m_cpuOps)
+    for(const auto & op : engine->m_cpuOps)
     {
         if(op->hasDynamicProperty(type))
         {
@@ -279,40 +476,35 @@ DynamicPropertyRcPtr CPUProcessor::Impl::getDynamicProperty(DynamicPropertyType
         }
     }
 
-    if(m_outBitDepthOp->hasDynamicProperty(type))
+    if(engine->m_outBitDepthOp->hasDynamicProperty(type))
     {
-        return m_outBitDepthOp->getDynamicProperty(type);
+        return engine->m_outBitDepthOp->getDynamicProperty(type);
     }
 
     throw Exception("Cannot find dynamic property; not used by CPU processor.");
 }
 
-void CPUProcessor::Impl::finalize(const OpRcPtrVec & rawOps,
-                                  BitDepth in, BitDepth out,
-                                  OptimizationFlags oFlags, FinalizationFlags fFlags)
+CPUProcessor::Impl::EngineRcPtr
+    CPUProcessor::Impl::createEngine(OpRcPtrVec & ops, OptimizationTraceImpl * trace) const
 {
-    AutoMutex lock(m_mutex);
-
-    OpRcPtrVec ops = rawOps.clone();
-
     if(!ops.empty())
     {
         // Adjust the op list to the input and output bit-depths
         // to enable the separable optimization.
 
-        ops.front()->setInputBitDepth(in);
-        ops.back()->setOutputBitDepth(out);
+        ops.front()->setInputBitDepth(m_inBitDepth);
+        ops.back()->setOutputBitDepth(m_outBitDepth);
 
         // Optimize the ops.
 
-        OptimizeOpVec(ops, oFlags);
+        OptimizeOpVec(ops, m_oFlags, trace);
     }
 
     if(ops.empty())
     {
         // Support an empty list.
 
-        const double scale = GetBitDepthMaxValue(out) / GetBitDepthMaxValue(in);
+        const double scale = GetBitDepthMaxValue(m_outBitDepth) / GetBitDepthMaxValue(m_inBitDepth);
 
         if(scale==1.0f)
         {
@@ -330,11 +522,175 @@ void CPUProcessor::Impl::finalize(const OpRcPtrVec & rawOps,
 
     // Finalize the ops.
 
-    FinalizeOpVec(ops, fFlags);
+    FinalizeOpVec(ops, m_fFlags);
     UnifyDynamicProperties(ops);
 
+    // Get the CPU Ops while taking care of the input and output bit-depths.
+
+    auto engine = std::make_shared<Engine>();
+    CreateCPUEngine(ops, m_inBitDepth, m_outBitDepth,
+                    engine->m_inBitDepthOp, engine->m_cpuOps, engine->m_outBitDepthOp);
+
+    // Get the right ScanlineHelper.
+    engine->m_scanlineBuilder.reset(CreateScanlineHelper(m_inBitDepth, engine->m_inBitDepthOp,
+                                                         m_outBitDepth, engine->m_outBitDepthOp));
+
+    return engine;
+}
+
+namespace
+{
+
+bool HasBakedValues(const std::vector<DynamicPropertyImplRcPtr> & properties,
+                    const std::vector<double> & values)
+{
+    for(size_t idx=0; idx<properties.size(); ++idx)
+    {
+        if(idx>=values.size() || properties[idx]->getDoubleValue()!=values[idx])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Values of the properties as frozen in the ops (i.e. FreezeDynamicProperties()), which
+// could differ from the current ones if they were changed in the meantime.
+std::vector<double> GetFrozenValues(const OpRcPtrVec & ops,
+                                    const std::vector<DynamicPropertyImplRcPtr> & properties)
+{
+    std::vector<double> values;
+    for(const auto & prop : properties)
+    {
+        for(const auto & op : ops)
+        {
+            if(op->hasDynamicProperty(prop->getType()))
+            {
+                values.push_back(op->getDynamicProperty(prop->getType())->getDoubleValue());
+                break;
+            }
+        }
+    }
+    return values;
+}
+
+}
+
+CPUProcessor::Impl::ConstEngineRcPtr CPUProcessor::Impl::getEngine() const
+{
+    // Note: The common case is an unchanged value so avoid the lock.
+
+    ConstEngineRcPtr engine = std::atomic_load(&m_engine);
+    if(HasBakedValues(m_dynamicProperties, engine->m_bakedValues))
+    {
+        return engine;
+    }
+
+    AutoMutex lock(m_mutex);
+
+    // Another thread could have already rebaked the engine.
+    engine = std::atomic_load(&m_engine);
+
+    if(!HasBakedValues(m_dynamicProperties, engine->m_bakedValues))
+    {
+        OpRcPtrVec ops = m_dynamicOps.clone();
+        FreezeDynamicProperties(ops);
+        std::vector<double> values = GetFrozenValues(ops, m_dynamicProperties);
+
+        EngineRcPtr rebaked = createEngine(ops);
+        rebaked->m_bakedValues.swap(values);
+
+        engine = rebaked;
+        std::atomic_store(&m_engine, engine);
+    }
+
+    return engine;
+}
+
+void CPUProcessor::Impl::finalize(const OpRcPtrVec & rawOps,
+                                  BitDepth in, BitDepth out,
+                                  OptimizationFlags oFlags, FinalizationFlags fFlags,
+                                  OptimizationTraceImpl * trace)
+{
+    AutoMutex lock(m_mutex);
+
     m_inBitDepth  = in;
     m_outBitDepth = out;
+    m_oFlags      = oFlags;
+    m_fFlags      = fFlags;
+
+    m_dynamicOps.clear();
+    m_dynamicProperties.clear();
+
+    // Reuse the CPU engine of an identical processor if any. Note that a traced
+    // optimization always runs.
+
+    const std::string engineKey
+        = trace ? std::string() : ComputeEngineKey(rawOps, in, out, oFlags, fFlags);
+
+    if(!engineKey.empty())
+    {
+        ConstCPUEngineRcPtr engine = GetCachedEngine(engineKey);
+        if(engine)
+        {
+            EngineRcPtr processorEngine = std::make_shared<Engine>();
+            processorEngine->m_inBitDepthOp  = engine->m_inBitDepthOp;
+            processorEngine->m_cpuOps        = engine->m_cpuOps;
+            processorEngine->m_outBitDepthOp = engine->m_outBitDepthOp;
+            processorEngine->m_scanlineBuilder.reset(
+                CreateScanlineHelper(m_inBitDepth, processorEngine->m_inBitDepthOp,
+                                     m_outBitDepth, processorEngine->m_outBitDepthOp));
+
+            m_hasChannelCrosstalk = engine->m_hasChannelCrosstalk;
+            m_cacheID             = engine->m_cacheID;
+
+            std::atomic_store(&m_engine, ConstEngineRcPtr(processorEngine));
+            return;
+        }
+    }
+
+    const std::chrono::steady_clock::time_point missStart = std::chrono::steady_clock::now();
+
+    OpRcPtrVec ops = rawOps.clone();
+
+    if((oFlags & OPTIMIZATION_DYNAMIC_REBAKE) == OPTIMIZATION_DYNAMIC_REBAKE)
+    {
+        // Keep an unoptimized copy of the ops sharing the dynamic properties, 
+        // and optimize a copy where the dynamic properties are frozen at their 
+        // current values. The processor then exposes the shared properties.
+
+        UnifyDynamicProperties(ops);
+
+        static const DynamicPropertyType types[] = { DYNAMIC_PROPERTY_EXPOSURE,
+                                                     DYNAMIC_PROPERTY_CONTRAST,
+                                                     DYNAMIC_PROPERTY_GAMMA };
+        for(const auto type : types)
+        {
+            for(const auto & op : ops)
+            {
+                if(op->hasDynamicProperty(type))
+                {
+                    DynamicPropertyImplRcPtr prop
+                        = OCIO_DYNAMIC_POINTER_CAST<DynamicPropertyImpl>(op->getDynamicProperty(type));
+                    m_dynamicProperties.push_back(prop);
+                    break;
+                }
+            }
+        }
+
+        if(!m_dynamicProperties.empty())
+        {
+            m_dynamicOps = ops;
+            ops = m_dynamicOps.clone();
+            FreezeDynamicProperties(ops);
+        }
+    }
+
+    std::vector<double> bakedValues = GetFrozenValues(ops, m_dynamicProperties);
+
+    EngineRcPtr engine = createEngine(ops, trace);
+    engine->m_bakedValues.swap(bakedValues);
+    std::atomic_store(&m_engine, ConstEngineRcPtr(engine));
 
     // Does the color processing introduce crosstalk between the pixel channels?
 
@@ -348,17 +704,6 @@ void CPUProcessor::Impl::finalize(const OpRcPtrVec & rawOps,
         }
     }
 
-    // Get the CPU Ops while taking care of the input and output bit-depths.
-
-    m_cpuOps.clear();
-    m_inBitDepthOp = nullptr;
-    m_outBitDepthOp = nullptr;
-    CreateCPUEngine(ops, in, out, m_inBitDepthOp, m_cpuOps, m_outBitDepthOp);
-
-    // Get the right ScanlineHelper.
-    m_scanlineBuilder.reset(CreateScanlineHelper(m_inBitDepth, m_inBitDepthOp,
-                                                 m_outBitDepth, m_outBitDepthOp));
-
     // Compute the cache id.
 
     std::stringstream ss;
@@ -373,51 +718,79 @@ void CPUProcessor::Impl::finalize(const OpRcPtrVec & rawOps,
     }
 
     m_cacheID = ss.str();
+
+    if(!engineKey.empty())
+    {
+        auto cachedEngine = std::make_shared<CPUEngine>();
+        cachedEngine->m_inBitDepthOp        = engine->m_inBitDepthOp;
+        cachedEngine->m_cpuOps              = engine->m_cpuOps;
+        cachedEngine->m_outBitDepthOp       = engine->m_outBitDepthOp;
+        cachedEngine->m_hasChannelCrosstalk = m_hasChannelCrosstalk;
+        cachedEngine->m_cacheID             = m_cacheID;
+
+        AddCachedEngine(engineKey, cachedEngine);
+
+        GetCacheCounters(CACHE_CPU_ENGINE).addMissTime(std::chrono::steady_clock::now() - missStart);
+    }
 }
 
 void CPUProcessor::Impl::apply(ImageDesc & imgDesc) const
 {
-    m_scanlineBuilder->init(imgDesc);
+    const ConstEngineRcPtr engine = getEngine();
+
+    ScopedScanlineHelper scanlineBuilder(engine->m_scanlineBuilderInUse,
+                                         engine->m_scanlineBuilder.get(),
+                                         m_inBitDepth, engine->m_inBitDepthOp,
+                                         m_outBitDepth, engine->m_outBitDepthOp);
+
+    scanlineBuilder->init(imgDesc);
 
     float * rgbaBuffer = nullptr;
     long numPixels = 0;
 
     while(true)
     {
-        m_scanlineBuilder->prepRGBAScanline(&rgbaBuffer, numPixels);
+        scanlineBuilder->prepRGBAScanline(&rgbaBuffer, numPixels);
         if(numPixels == 0) break;
         if(!rgbaBuffer)
             throw Exception("Cannot apply transform; null image.");
 
-        for(const auto & op : m_cpuOps)
+        for(const auto & op : engine->m_cpuOps)
         {
             op->apply(rgbaBuffer, rgbaBuffer, numPixels);
         }
         
-        m_scanlineBuilder->finishRGBAScanline();
+        scanlineBuilder->finishRGBAScanline();
     }
 }
 
 void CPUProcessor::Impl::apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc) const
 {
-    m_scanlineBuilder->init(srcImgDesc, dstImgDesc);
+    const ConstEngineRcPtr engine = getEngine();
+
+    ScopedScanlineHelper scanlineBuilder(engine->m_scanlineBuilderInUse,
+                                         engine->m_scanlineBuilder.get(),
+                                         m_inBitDepth, engine->m_inBitDepthOp,
+                                         m_outBitDepth, engine->m_outBitDepthOp);
+
+    scanlineBuilder->init(srcImgDesc, dstImgDesc);
 
     float * rgbaBuffer = nullptr;
     long numPixels = 0;
 
     while(true)
     {
-        m_scanlineBuilder->prepRGBAScanline(&rgbaBuffer, numPixels);
+        scanlineBuilder->prepRGBAScanline(&rgbaBuffer, numPixels);
         if(numPixels == 0) break;
         if(!rgbaBuffer)
             throw Exception("Cannot apply transform; null image.");
 
-        for(const auto & op : m_cpuOps)
+        for(const auto & op : engine->m_cpuOps)
         {
             op->apply(rgbaBuffer, rgbaBuffer, numPixels);
         }
         
-        m_scanlineBuilder->finishRGBAScanline();
+        scanlineBuilder->finishRGBAScanline();
     }
 }
 
@@ -481,15 +854,17 @@ void CPUProcessor::Impl::applyRGBA(void * pixel) const
         throw Exception("Cannot apply transform; bit-depths are different.");
     }
 
+    const ConstEngineRcPtr engine = getEngine();
+
     float v[4];
-    m_inBitDepthOp->apply(pixel, v, 1);
+    engine->m_inBitDepthOp->apply(pixel, v, 1);
 
-    for(const auto & op : m_cpuOps)
+    for(const auto & op : engine->m_cpuOps)
     {
         op->apply(v, v, 1);
     }
 
-    m_outBitDepthOp->apply(v, pixel, 1);
+    engine->m_outBitDepthOp->apply(v, pixel, 1);
 }
     
 
@@ -571,6 +946,8 @@ OCIO_NAMESPACE_EXIT
 
 namespace OCIO = OCIO_NAMESPACE;
 
+#include <thread>
+
 #include "ops/Lut1D/Lut1DOp.h"
 #include "ops/Lut1D/Lut1DOpData.h"
 #include "UnitTest.h"
@@ -2375,5 +2752,293 @@ OCIO_ADD_TEST(CPUProcessor, one_pixel)
     }
 }
 
+OCIO_ADD_TEST(CPUProcessor, dynamic_rebake)
+{
+    // Validate that baking the dynamic properties produces the same results as the
+    // dynamic processing, including after a change of the dynamic property value.
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::ExposureContrastTransformRcPtr ec = OCIO::ExposureContrastTransform::Create();
+    ec->setStyle(OCIO::EXPOSURE_CONTRAST_LINEAR);
+    ec->setExposure(0.5);
+    ec->setPivot(0.18);
+    ec->makeExposureDynamic();
+
+    OCIO::ExponentTransformRcPtr exp = OCIO::ExponentTransform::Create();
+    const double gamma[4] = { 2.2, 2.2, 2.2, 1.0 };
+    exp->setValue(gamma);
+    exp->setDirection(OCIO::TRANSFORM_DIR_INVERSE);
+
+    OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+    group->push_back(exp);
+    group->push_back(ec);
+    group->push_back(exp->createEditableCopy());
+    group->getTransform(2)->setDirection(OCIO::TRANSFORM_DIR_FORWARD);
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(group));
+
+    OCIO::ConstCPUProcessorRcPtr cpuDynamic;
+    OCIO_CHECK_NO_THROW(cpuDynamic
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32,
+                                              OCIO::OPTIMIZATION_DEFAULT,
+                                              OCIO::FINALIZATION_DEFAULT));
+
+    const OCIO::OptimizationFlags rebakeFlags
+        = OCIO::OptimizationFlags(OCIO::OPTIMIZATION_DEFAULT | OCIO::OPTIMIZATION_DYNAMIC_REBAKE);
+
+    OCIO::ConstCPUProcessorRcPtr cpuRebake;
+    OCIO_CHECK_NO_THROW(cpuRebake
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32,
+                                              rebakeFlags, OCIO::FINALIZATION_DEFAULT));
+
+    OCIO_CHECK_NE(std::string(cpuDynamic->getCacheID()), std::string(cpuRebake->getCacheID()));
+
+    OCIO::DynamicPropertyRcPtr dpDynamic;
+    OCIO_CHECK_NO_THROW(dpDynamic = cpuDynamic->getDynamicProperty(OCIO::DYNAMIC_PROPERTY_EXPOSURE));
+    OCIO::DynamicPropertyRcPtr dpRebake;
+    OCIO_CHECK_NO_THROW(dpRebake = cpuRebake->getDynamicProperty(OCIO::DYNAMIC_PROPERTY_EXPOSURE));
+    OCIO_CHECK_EQUAL(dpRebake->getDoubleValue(), 0.5);
+
+    OCIO_CHECK_THROW_WHAT(cpuRebake->getDynamicProperty(OCIO::DYNAMIC_PROPERTY_GAMMA),
+                          OCIO::Exception, "not used by CPU processor");
+
+    const float inPixel[4] = { 0.02f, 0.3f, 0.65f, 1.0f };
+
+    float previous[4] = { 0.f, 0.f, 0.f, 0.f };
+    for (const double value : { 0.5, -1.25, 2. })
+    {
+        dpDynamic->setValue(value);
+        dpRebake->setValue(value);
+
+        float pixelDynamic[4] = { inPixel[0], inPixel[1], inPixel[2], inPixel[3] };
+        float pixelRebake[4]  = { inPixel[0], inPixel[1], inPixel[2], inPixel[3] };
+
+        OCIO_CHECK_NO_THROW(cpuDynamic->applyRGBA(pixelDynamic));
+        OCIO_CHECK_NO_THROW(cpuRebake->applyRGBA(pixelRebake));
+
+        for (unsigned idx = 0; idx < 4; ++idx)
+        {
+            OCIO_CHECK_CLOSE(pixelDynamic[idx], pixelRebake[idx], 1e-6f);
+        }
+
+        // The exposure change is taken into account.
+        OCIO_CHECK_NE(pixelRebake[1], previous[1]);
+        previous[1] = pixelRebake[1];
+    }
+}
+
+
+OCIO_ADD_TEST(CPUProcessor, engine_cache)
+{
+    // Validate that identical CPU processors share their CPU engine.
+
+    OCIO::ClearAllCaches();
+    OCIO_CHECK_EQUAL(OCIO::g_engineList.size(), 0);
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::LogTransformRcPtr log = OCIO::LogTransform::Create();
+    log->setBase(2.0);
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(log));
+
+    OCIO::ConstCPUProcessorRcPtr cpu1;
+    OCIO_CHECK_NO_THROW(cpu1 = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT8,
+                                                                   OCIO::BIT_DEPTH_UINT8,
+                                                                   OCIO::OPTIMIZATION_DEFAULT,
+                                                                   OCIO::FINALIZATION_DEFAULT));
+    OCIO_REQUIRE_EQUAL(OCIO::g_engineList.size(), 1);
+    const OCIO::ConstOpCPURcPtrVec cachedOps = OCIO::g_engineList.front().second->m_cpuOps;
+
+    // A processor built from a different transform instance but with identical ops.
+    OCIO::ConstProcessorRcPtr processor2;
+    OCIO_CHECK_NO_THROW(processor2 = config->getProcessor(log->createEditableCopy()));
+
+    OCIO::ConstCPUProcessorRcPtr cpu2;
+    OCIO_CHECK_NO_THROW(cpu2 = processor2->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT8,
+                                                                    OCIO::BIT_DEPTH_UINT8,
+                                                                    OCIO::OPTIMIZATION_DEFAULT,
+                                                                    OCIO::FINALIZATION_DEFAULT));
+    OCIO_REQUIRE_EQUAL(OCIO::g_engineList.size(), 1);
+    OCIO_CHECK_ASSERT(OCIO::g_engineList.front().second->m_cpuOps == cachedOps);
+    OCIO_CHECK_EQUAL(std::string(cpu1->getCacheID()), std::string(cpu2->getCacheID()));
+
+    uint8_t pixel1[4] = { 10, 100, 200, 255 };
+    uint8_t pixel2[4] = { 10, 100, 200, 255 };
+    OCIO_CHECK_NO_THROW(cpu1->applyRGBA(pixel1));
+    OCIO_CHECK_NO_THROW(cpu2->applyRGBA(pixel2));
+    for(unsigned idx=0; idx<4; ++idx)
+    {
+        OCIO_CHECK_EQUAL(pixel1[idx], pixel2[idx]);
+    }
+
+    // Different bit-depths create another engine.
+    OCIO_CHECK_NO_THROW(processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT16,
+                                                            OCIO::BIT_DEPTH_UINT16,
+                                                            OCIO::OPTIMIZATION_DEFAULT,
+                                                            OCIO::FINALIZATION_DEFAULT));
+    OCIO_CHECK_EQUAL(OCIO::g_engineList.size(), 2);
+
+    // An engine with dynamic properties is never shared.
+    OCIO::ExposureContrastTransformRcPtr ec = OCIO::ExposureContrastTransform::Create();
+    ec->makeExposureDynamic();
+
+    OCIO::ConstProcessorRcPtr processorDyn;
+    OCIO_CHECK_NO_THROW(processorDyn = config->getProcessor(ec));
+    OCIO_CHECK_NO_THROW(processorDyn->getDefaultCPUProcessor());
+    OCIO_CHECK_EQUAL(OCIO::g_engineList.size(), 2);
+
+    OCIO_CHECK_NO_THROW(OCIO::ClearAllCaches());
+    OCIO_CHECK_EQUAL(OCIO::g_engineList.size(), 0);
+    OCIO_CHECK_EQUAL(OCIO::g_engineMap.size(), 0);
+
+    // The processors still work.
+    uint8_t pixel3[4] = { 10, 100, 200, 255 };
+    OCIO_CHECK_NO_THROW(cpu2->applyRGBA(pixel3));
+    OCIO_CHECK_EQUAL(pixel1[1], pixel3[1]);
+}
+
+OCIO_ADD_TEST(CPUProcessor, concurrent_apply)
+{
+    // Validate that a CPU processor can process several images at once, the scanline
+    // helper (i.e. the bit-depth conversion buffers) not being shared.
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::LogTransformRcPtr log = OCIO::LogTransform::Create();
+    log->setBase(2.0);
+
+    OCIO::ConstCPUProcessorRcPtr cpu;
+    OCIO_CHECK_NO_THROW(cpu = config->getProcessor(log)->getOptimizedCPUProcessor(
+                                  OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_UINT16,
+                                  OCIO::OPTIMIZATION_DEFAULT, OCIO::FINALIZATION_DEFAULT));
+
+    const long width = 1024;
+    const long height = 32;
+    std::vector<uint16_t> source(width * height * 4);
+    for(size_t idx=0; idx<source.size(); ++idx)
+    {
+        source[idx] = uint16_t((idx * 7919) % 65536);
+    }
+
+    std::vector<uint16_t> expected(source);
+    OCIO::PackedImageDesc expectedImg(&expected[0], width, height, 4, sizeof(uint16_t),
+                                      OCIO::AutoStride, OCIO::AutoStride);
+    OCIO_CHECK_NO_THROW(cpu->apply(expectedImg));
+
+    const unsigned numThreads = 8;
+    std::vector<std::vector<uint16_t>> images(numThreads, source);
+    std::vector<std::thread> threads;
+    for(unsigned t=0; t<numThreads; ++t)
+    {
+        threads.push_back(std::thread([&cpu, &images, t, width, height]()
+        {
+            OCIO::PackedImageDesc img(&images[t][0], width, height, 4, sizeof(uint16_t),
+                                      OCIO::AutoStride, OCIO::AutoStride);
+            cpu->apply(img);
+        }));
+    }
+    for(auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    for(unsigned t=0; t<numThreads; ++t)
+    {
+        OCIO_CHECK_ASSERT(images[t] == expected);
+    }
+}
+
+
+OCIO_ADD_TEST(CPUProcessor, concurrent_rebake)
+{
+    // Validate that the dynamic property of a rebaked processor can change while several
+    // threads apply it, each image being processed by the engine baked when it started.
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::ExposureContrastTransformRcPtr ec = OCIO::ExposureContrastTransform::Create();
+    ec->setStyle(OCIO::EXPOSURE_CONTRAST_LINEAR);
+    ec->setExposure(0.5);
+    ec->setPivot(0.18);
+    ec->makeExposureDynamic();
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(ec));
+
+    const OCIO::OptimizationFlags rebakeFlags
+        = OCIO::OptimizationFlags(OCIO::OPTIMIZATION_DEFAULT | OCIO::OPTIMIZATION_DYNAMIC_REBAKE);
+
+    OCIO::ConstCPUProcessorRcPtr cpu;
+    OCIO_CHECK_NO_THROW(cpu = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT16,
+                                                                  OCIO::BIT_DEPTH_UINT16,
+                                                                  rebakeFlags,
+                                                                  OCIO::FINALIZATION_DEFAULT));
+    OCIO::DynamicPropertyRcPtr exposure;
+    OCIO_CHECK_NO_THROW(exposure = cpu->getDynamicProperty(OCIO::DYNAMIC_PROPERTY_EXPOSURE));
+
+    const long width = 256;
+    const long height = 16;
+    std::vector<uint16_t> source(width * height * 4);
+    for(size_t idx=0; idx<source.size(); ++idx)
+    {
+        source[idx] = uint16_t((idx * 7919) % 65536);
+    }
+
+    const double values[2] = { 0.5, -1.0 };
+    std::vector<uint16_t> expected[2];
+    for(unsigned v=0; v<2; ++v)
+    {
+        exposure->setValue(values[v]);
+        expected[v] = source;
+        OCIO::PackedImageDesc img(&expected[v][0], width, height, 4, sizeof(uint16_t),
+                                  OCIO::AutoStride, OCIO::AutoStride);
+        OCIO_CHECK_NO_THROW(cpu->apply(img));
+    }
+    OCIO_REQUIRE_ASSERT(expected[0] != expected[1]);
+
+    const unsigned numThreads = 4;
+    const unsigned numImages = 20;
+    std::vector<std::vector<uint16_t>> images(numThreads * numImages, source);
+    std::vector<std::thread> threads;
+    for(unsigned t=0; t<numThreads; ++t)
+    {
+        threads.push_back(std::thread([&cpu, &images, t, width, height]()
+        {
+            for(unsigned i=0; i<numImages; ++i)
+            {
+                OCIO::PackedImageDesc img(&images[t * numImages + i][0], width, height, 4,
+                                          sizeof(uint16_t), OCIO::AutoStride, OCIO::AutoStride);
+                cpu->apply(img);
+            }
+        }));
+    }
+    for(unsigned i=0; i<200; ++i)
+    {
+        exposure->setValue(values[i % 2]);
+        std::this_thread::yield();
+    }
+    for(auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    for(const auto & image : images)
+    {
+        OCIO_CHECK_ASSERT(image == expected[0] || image == expected[1]);
+    }
+
+    // The last value is taken into account.
+    exposure->setValue(values[0]);
+    std::vector<uint16_t> image(source);
+    OCIO::PackedImageDesc img(&image[0], width, height, 4, sizeof(uint16_t),
+                              OCIO::AutoStride, OCIO::AutoStride);
+    OCIO_CHECK_NO_THROW(cpu->apply(img));
+    OCIO_CHECK_ASSERT(image == expected[0]);
+}
+
 
 #endif // OCIO_UNIT_TEST
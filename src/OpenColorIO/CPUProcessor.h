@@ -6,6 +6,8 @@
 #define INCLUDED_OCIO_CPUPROCESSOR_H
 
 
+#include <memory>
+
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "Op.h"
@@ -16,6 +18,9 @@ OCIO_NAMESPACE_ENTER
 
 class ScanlineHelper;
 
+// Clear the process-wide cache of CPU engines shared by the CPU processors.
+void ClearCPUProcessorCache();
+
 class CPUProcessor::Impl
 {
 public:
@@ -45,21 +50,39 @@ public:
         
     void finalize(const OpRcPtrVec & rawOps,
                   BitDepth in, BitDepth out,
-                  OptimizationFlags oFlags, FinalizationFlags fFlags);
+                  OptimizationFlags oFlags, FinalizationFlags fFlags,
+                  OptimizationTraceImpl * trace = nullptr);
 
 private:
-    ConstOpCPURcPtr    m_inBitDepthOp; // Converts from in to F32. It could be done by the first op.
-    ConstOpCPURcPtrVec m_cpuOps;       // It could be empty if the OpVec only contains a 1D LUT op
-                                       // (e.g. the 1D LUT CPUOp instance would be in the m_inBitDepthOp).
-    ConstOpCPURcPtr    m_outBitDepthOp;// Converts from F32 to out. It could be done by the last op.
+    // The CPU ops and the scanline helper used by the apply() calls (refer to
+    // CPUProcessor.cpp). A rebake replaces the whole engine.
+    struct Engine;
+    typedef OCIO_SHARED_PTR<Engine> EngineRcPtr;
+    typedef OCIO_SHARED_PTR<const Engine> ConstEngineRcPtr;
+
+    // Optimize & finalize the ops, and create the CPU engine from them.
+    EngineRcPtr createEngine(OpRcPtrVec & ops, OptimizationTraceImpl * trace = nullptr) const;
+
+    // Return the CPU engine to use by a call. With OPTIMIZATION_DYNAMIC_REBAKE, the engine
+    // is rebuilt first when a dynamic property value differs from the one baked in its ops.
+    // The calls in progress keep the engine they started with.
+    ConstEngineRcPtr getEngine() const;
 
     BitDepth           m_inBitDepth = BIT_DEPTH_F32;
     BitDepth           m_outBitDepth = BIT_DEPTH_F32;
+    OptimizationFlags  m_oFlags = OPTIMIZATION_DEFAULT;
+    FinalizationFlags  m_fFlags = FINALIZATION_DEFAULT;
     bool               m_hasChannelCrosstalk = true;
     std::string        m_cacheID;
-    Mutex              m_mutex;
+    mutable Mutex      m_mutex;
+
+    // Only accessed with std::atomic_load() & std::atomic_store(), and only replaced while
+    // holding m_mutex.
+    mutable ConstEngineRcPtr m_engine;
 
-    std::unique_ptr<ScanlineHelper> m_scanlineBuilder;
+    // Only used when the dynamic properties are baked (i.e. OPTIMIZATION_DYNAMIC_REBAKE).
+    OpRcPtrVec                            m_dynamicOps;  // Unoptimized ops sharing the properties.
+    std::vector<DynamicPropertyImplRcPtr> m_dynamicProperties;
 };
 
 
@@ -0,0 +1,242 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "CacheStatistics.h"
+
+OCIO_NAMESPACE_ENTER
+{
+    namespace
+    {
+        const int NUM_CACHE_TYPES = CACHE_BAKED_SAMPLES + 1;
+
+        CacheCounters g_cacheCounters[NUM_CACHE_TYPES];
+    }
+
+    void CacheCounters::addEntries(size_t numEntries, size_t memorySize)
+    {
+        m_numEntries += numEntries;
+        m_memoryUsage += memorySize;
+    }
+
+    void CacheCounters::removeEntries(size_t numEntries, size_t memorySize)
+    {
+        m_numEntries -= numEntries;
+        m_memoryUsage -= memorySize;
+    }
+
+    void CacheCounters::addMissTime(std::chrono::steady_clock::duration duration)
+    {
+        m_missTime += std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    }
+
+    double CacheCounters::getMissTime() const
+    {
+        return double(m_missTime) * 1e-9;
+    }
+
+    void CacheCounters::reset()
+    {
+        m_numHits = 0;
+        m_numMisses = 0;
+        m_numEvictions = 0;
+        m_missTime = 0;
+    }
+
+    CacheCounters & GetCacheCounters(CacheType type)
+    {
+        if(type<0 || type>=NUM_CACHE_TYPES)
+        {
+            throw Exception("Unknown cache type");
+        }
+        return g_cacheCounters[type];
+    }
+
+    CacheMissTimer::CacheMissTimer(CacheType type)
+        :   m_counters(GetCacheCounters(type))
+        ,   m_start(std::chrono::steady_clock::now())
+    {
+    }
+
+    CacheMissTimer::~CacheMissTimer()
+    {
+        m_counters.addMissTime(std::chrono::steady_clock::now() - m_start);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+
+    StringCache::StringCache(CacheType type)
+        :   m_type(type)
+        ,   m_memorySize(0)
+    {
+    }
+
+    StringCache::StringCache(const StringCache & rhs)
+        :   m_type(rhs.m_type)
+        ,   m_map(rhs.m_map)
+        ,   m_memorySize(rhs.m_memorySize)
+    {
+        GetCacheCounters(m_type).addEntries(m_map.size(), m_memorySize);
+    }
+
+    StringCache & StringCache::operator=(const StringCache & rhs)
+    {
+        if(this!=&rhs)
+        {
+            clear();
+            m_map = rhs.m_map;
+            m_memorySize = rhs.m_memorySize;
+            GetCacheCounters(m_type).addEntries(m_map.size(), m_memorySize);
+        }
+        return *this;
+    }
+
+    StringCache::~StringCache()
+    {
+        clear();
+    }
+
+    const std::string * StringCache::find(const std::string & key) const
+    {
+        StringMap::const_iterator iter = m_map.find(key);
+        if(iter==m_map.end())
+        {
+            GetCacheCounters(m_type).addMiss();
+            return nullptr;
+        }
+
+        GetCacheCounters(m_type).addHit();
+        return &iter->second;
+    }
+
+    const std::string & StringCache::insert(const std::string & key, const std::string & value)
+    {
+        auto result = m_map.insert(std::make_pair(key, value));
+        if(result.second)
+        {
+            const size_t entrySize = GetEntrySize(key, value);
+            m_memorySize += entrySize;
+            GetCacheCounters(m_type).addEntries(1, entrySize);
+        }
+        return result.first->second;
+    }
+
+    void StringCache::clear()
+    {
+        GetCacheCounters(m_type).removeEntries(m_map.size(), m_memorySize);
+        m_map.clear();
+        m_memorySize = 0;
+    }
+
+    size_t StringCache::GetEntrySize(const std::string & key, const std::string & value)
+    {
+        return sizeof(StringMap::value_type) + key.size() + value.size();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+
+    size_t GetCacheNumEntries(CacheType type)
+    {
+        return GetCacheCounters(type).getNumEntries();
+    }
+
+    size_t GetCacheMemoryUsage(CacheType type)
+    {
+        return GetCacheCounters(type).getMemoryUsage();
+    }
+
+    unsigned long GetCacheNumHits(CacheType type)
+    {
+        return GetCacheCounters(type).getNumHits();
+    }
+
+    unsigned long GetCacheNumMisses(CacheType type)
+    {
+        return GetCacheCounters(type).getNumMisses();
+    }
+
+    unsigned long GetCacheNumEvictions(CacheType type)
+    {
+        return GetCacheCounters(type).getNumEvictions();
+    }
+
+    double GetCacheMissTime(CacheType type)
+    {
+        return GetCacheCounters(type).getMissTime();
+    }
+
+    void ResetCacheStatistics()
+    {
+        for(int i=0; i<NUM_CACHE_TYPES; ++i)
+        {
+            g_cacheCounters[i].reset();
+        }
+    }
+}
+OCIO_NAMESPACE_EXIT
+
+
+#ifdef OCIO_UNIT_TEST
+
+namespace OCIO = OCIO_NAMESPACE;
+#include <sstream>
+#include "UnitTest.h"
+
+OCIO_ADD_TEST(CacheStatistics, string_cache)
+{
+    const OCIO::CacheType type = OCIO::CACHE_CONTEXT_RESULTS;
+    const size_t entries = OCIO::GetCacheNumEntries(type);
+    const size_t usage = OCIO::GetCacheMemoryUsage(type);
+    const unsigned long hits = OCIO::GetCacheNumHits(type);
+    const unsigned long misses = OCIO::GetCacheNumMisses(type);
+
+    {
+        OCIO::StringCache cache(type);
+        OCIO_CHECK_ASSERT(!cache.find("key"));
+        OCIO_CHECK_EQUAL(cache.insert("key", "value"), "value");
+        OCIO_CHECK_EQUAL(cache.insert("key", "other"), "value");
+        OCIO_REQUIRE_ASSERT(cache.find("key"));
+        OCIO_CHECK_EQUAL(*cache.find("key"), "value");
+
+        OCIO_CHECK_EQUAL(OCIO::GetCacheNumEntries(type), entries + 1);
+        OCIO_CHECK_ASSERT(OCIO::GetCacheMemoryUsage(type) > usage);
+        OCIO_CHECK_EQUAL(OCIO::GetCacheNumHits(type), hits + 2);
+        OCIO_CHECK_EQUAL(OCIO::GetCacheNumMisses(type), misses + 1);
+
+        // The copies are accounted too.
+        OCIO::StringCache copy(cache);
+        OCIO_CHECK_EQUAL(OCIO::GetCacheNumEntries(type), entries + 2);
+
+        copy.clear();
+        OCIO_CHECK_EQUAL(OCIO::GetCacheNumEntries(type), entries + 1);
+    }
+
+    OCIO_CHECK_EQUAL(OCIO::GetCacheNumEntries(type), entries);
+    OCIO_CHECK_EQUAL(OCIO::GetCacheMemoryUsage(type), usage);
+}
+
+OCIO_ADD_TEST(CacheStatistics, reset)
+{
+    {
+        OCIO::CacheMissTimer timer(OCIO::CACHE_CONFIG_CACHE_ID);
+        OCIO::GetCacheCounters(OCIO::CACHE_CONFIG_CACHE_ID).addMiss();
+        OCIO::GetCacheCounters(OCIO::CACHE_CONFIG_CACHE_ID).addEvictions(2);
+    }
+
+    OCIO_CHECK_ASSERT(OCIO::GetCacheNumMisses(OCIO::CACHE_CONFIG_CACHE_ID) > 0);
+    OCIO_CHECK_ASSERT(OCIO::GetCacheNumEvictions(OCIO::CACHE_CONFIG_CACHE_ID) >= 2);
+    OCIO_CHECK_ASSERT(OCIO::GetCacheMissTime(OCIO::CACHE_CONFIG_CACHE_ID) > 0.0);
+
+    OCIO::ResetCacheStatistics();
+
+    OCIO_CHECK_EQUAL(OCIO::GetCacheNumHits(OCIO::CACHE_CONFIG_CACHE_ID), 0);
+    OCIO_CHECK_EQUAL(OCIO::GetCacheNumMisses(OCIO::CACHE_CONFIG_CACHE_ID), 0);
+    OCIO_CHECK_EQUAL(OCIO::GetCacheNumEvictions(OCIO::CACHE_CONFIG_CACHE_ID), 0);
+    OCIO_CHECK_EQUAL(OCIO::GetCacheMissTime(OCIO::CACHE_CONFIG_CACHE_ID), 0.0);
+
+    OCIO_CHECK_THROW_WHAT(OCIO::GetCacheNumEntries(static_cast<OCIO::CacheType>(-1)),
+                          OCIO::Exception, "Unknown cache type");
+}
+
+#endif // OCIO_UNIT_TEST
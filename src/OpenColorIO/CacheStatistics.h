@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_CACHESTATISTICS_H
+#define INCLUDED_OCIO_CACHESTATISTICS_H
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "PrivateTypes.h"
+
+OCIO_NAMESPACE_ENTER
+{
+    // Statistics shared by all the instances of a type of cache (refer to CacheType). The
+    // caches keep their entries and memory usage up to date, and count their lookups.
+    class CacheCounters
+    {
+    public:
+        // Constant initialization, so the global counters are usable by any static object.
+        constexpr CacheCounters()
+            :   m_numEntries(0)
+            ,   m_memoryUsage(0)
+            ,   m_numHits(0)
+            ,   m_numMisses(0)
+            ,   m_numEvictions(0)
+            ,   m_missTime(0)
+        {
+        }
+
+        void addEntries(size_t numEntries, size_t memorySize);
+        void removeEntries(size_t numEntries, size_t memorySize);
+
+        void addHit() { ++m_numHits; }
+        void addMiss() { ++m_numMisses; }
+        void addEvictions(size_t numEvictions) { m_numEvictions += numEvictions; }
+        void addMissTime(std::chrono::steady_clock::duration duration);
+
+        size_t getNumEntries() const { return m_numEntries; }
+        size_t getMemoryUsage() const { return m_memoryUsage; }
+        unsigned long getNumHits() const { return m_numHits; }
+        unsigned long getNumMisses() const { return m_numMisses; }
+        unsigned long getNumEvictions() const { return m_numEvictions; }
+        double getMissTime() const;
+
+        // Reset the lookup counters, the entries are still accounted.
+        void reset();
+
+    private:
+        std::atomic<size_t> m_numEntries;
+        std::atomic<size_t> m_memoryUsage;
+        std::atomic<unsigned long> m_numHits;
+        std::atomic<unsigned long> m_numMisses;
+        std::atomic<unsigned long> m_numEvictions;
+        std::atomic<long long> m_missTime; // In nanoseconds.
+    };
+
+    CacheCounters & GetCacheCounters(CacheType type);
+
+    // Add the time spent in its scope to the time spent on the misses of the cache.
+    class CacheMissTimer
+    {
+    public:
+        explicit CacheMissTimer(CacheType type);
+        CacheMissTimer() = delete;
+        CacheMissTimer(const CacheMissTimer &) = delete;
+        CacheMissTimer & operator=(const CacheMissTimer &) = delete;
+        ~CacheMissTimer();
+
+    private:
+        CacheCounters & m_counters;
+        const std::chrono::steady_clock::time_point m_start;
+    };
+
+    // Map of strings whose entries are accounted in the statistics of its cache type. The
+    // caller is responsible for the thread safety.
+    class StringCache
+    {
+    public:
+        explicit StringCache(CacheType type);
+        StringCache(const StringCache & rhs);
+        StringCache & operator=(const StringCache & rhs);
+        ~StringCache();
+
+        // Return the value of the key, or null if not cached. The lookup counts as a hit
+        // or a miss.
+        const std::string * find(const std::string & key) const;
+
+        // Add the value if the key is not cached yet, and return the cached value.
+        const std::string & insert(const std::string & key, const std::string & value);
+
+        void clear();
+
+        size_t size() const { return m_map.size(); }
+
+    private:
+        static size_t GetEntrySize(const std::string & key, const std::string & value);
+
+        CacheType m_type;
+        StringMap m_map;
+        size_t m_memorySize;
+    };
+}
+OCIO_NAMESPACE_EXIT
+
+#endif
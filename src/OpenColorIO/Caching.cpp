@@ -3,6 +3,9 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "Baker.h"
+#include "CPUProcessor.h"
+#include "Processor.h"
 #include "transforms/CDLTransform.h"
 #include "PathUtils.h"
 #include "transforms/FileTransform.h"
@@ -17,6 +20,9 @@ OCIO_NAMESPACE_ENTER
         ClearPathCaches();
         ClearFileTransformCaches();
         ClearCDLTransformFileCache();
+        ClearCPUProcessorCache();
+        ClearConfigProcessorCaches();
+        ClearBakerCaches();
     }
 }
 OCIO_NAMESPACE_EXIT
@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <cctype>
 #include <sstream>
 
 #include <OpenColorIO/OpenColorIO.h>
@@ -11,6 +12,25 @@
 
 OCIO_NAMESPACE_ENTER
 {
+
+namespace
+{
+
+// Same as comparing the lower case strings, without any allocation as the search is
+// done for each color space added to a config.
+bool NamesEqualCaseIgnore(const char * a, const char * b)
+{
+    for(; *a && *b; ++a, ++b)
+    {
+        if(::tolower((unsigned char)*a)!=::tolower((unsigned char)*b))
+        {
+            return false;
+        }
+    }
+    return *a==*b;
+}
+
+}
     
 class ColorSpaceSet::Impl
 {
@@ -84,10 +104,9 @@ public:
     {
         if(csName && *csName)
         {
-            const std::string str = pystring::lower(csName);
             for(auto & cs: m_colorSpaces)
             {
-                if(pystring::lower(cs->getName())==str)
+                if(NamesEqualCaseIgnore(cs->getName(), csName))
                 {
                     return cs;
                 }
@@ -100,10 +119,9 @@ public:
     {
         if(csName && *csName)
         {
-            const std::string str = pystring::lower(csName);
             for(size_t idx = 0; idx<m_colorSpaces.size(); ++idx)
             {
-                if(pystring::lower(m_colorSpaces[idx]->getName())==str)
+                if(NamesEqualCaseIgnore(m_colorSpaces[idx]->getName(), csName))
                 {
                     return static_cast<int>(idx);
                 }
@@ -115,15 +133,15 @@ public:
 
     void add(const ConstColorSpaceRcPtr & cs)
     {
-        const std::string csName = pystring::lower(cs->getName());
-        if(csName.empty())
+        const char * csName = cs->getName();
+        if(!*csName)
         {
             throw Exception("Cannot add a color space with an empty name.");
         }
 
         for(auto & entry: m_colorSpaces)
         {
-            if(pystring::lower(entry->getName())==csName)
+            if(NamesEqualCaseIgnore(entry->getName(), csName))
             {
                 // The color space replaces the existing one.
                 entry = cs->createEditableCopy();
@@ -2,8 +2,11 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 
+#include <atomic>
 #include <cstdlib>
 #include <cstring>
+#include <list>
+#include <map>
 #include <set>
 #include <sstream>
 #include <fstream>
@@ -12,6 +15,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "CacheStatistics.h"
 #include "HashUtils.h"
 #include "Logging.h"
 #include "LookParse.h"
@@ -24,8 +28,11 @@
 #include "PrivateTypes.h"
 #include "Processor.h"
 #include "pystring/pystring.h"
+#include "OCIOBinary.h"
 #include "OCIOYaml.h"
 #include "Platform.h"
+#include "fileformats/BinaryCache.h"
+#include "transforms/FileTransform.h"
 
 OCIO_NAMESPACE_ENTER
 {
@@ -35,6 +42,12 @@ OCIO_NAMESPACE_ENTER
         const char * OCIO_ACTIVE_DISPLAYS_ENVVAR = "OCIO_ACTIVE_DISPLAYS";
         const char * OCIO_ACTIVE_VIEWS_ENVVAR = "OCIO_ACTIVE_VIEWS";
         
+        // Increment the version when the layout of the binary config changes.
+        const char * BINARY_CONFIG_MAGIC = "OCIOBinaryConfig";
+        const int BINARY_CONFIG_VERSION = 1;
+        // Detects a binary config written by a platform with another endianness.
+        const int BINARY_CONFIG_ENDIANNESS = 0x01020304;
+        
         enum Sanity
         {
             SANITY_UNKNOWN = 0,
@@ -146,6 +159,177 @@ OCIO_NAMESPACE_ENTER
         }
     }
     
+    void GetElementFileReferences(std::set<std::string> & files,
+                                  const ConstLookRcPtr & look)
+    {
+        GetFileReferences(files, look->getTransform());
+        GetFileReferences(files, look->getInverseTransform());
+    }
+    
+    void GetElementFileReferences(std::set<std::string> & files,
+                                  const ConstColorSpaceRcPtr & cs)
+    {
+        GetFileReferences(files, cs->getTransform(COLORSPACE_DIR_TO_REFERENCE));
+        GetFileReferences(files, cs->getTransform(COLORSPACE_DIR_FROM_REFERENCE));
+    }
+
+    // Collect the files a processor may need: the files of the transform and of the
+    // color spaces and looks it refers to (i.e. color space, display and look transforms).
+    // Some of them may not be needed (e.g. both directions of a color space are collected)
+    // as the list is only used to read the files ahead.
+    class ProcessorFileReferences
+    {
+    public:
+        explicit ProcessorFileReferences(const Config & config)
+            :   m_config(config)
+        {
+        }
+
+        void addTransform(const ConstTransformRcPtr & transform)
+        {
+            if(!transform) return;
+
+            if(ConstGroupTransformRcPtr groupTransform = \
+                DynamicPtrCast<const GroupTransform>(transform))
+            {
+                for(int i=0; i<groupTransform->size(); ++i)
+                {
+                    addTransform(groupTransform->getTransform(i));
+                }
+            }
+            else if(ConstFileTransformRcPtr fileTransform = \
+                DynamicPtrCast<const FileTransform>(transform))
+            {
+                m_files.insert(fileTransform->getSrc());
+            }
+            else if(ConstColorSpaceTransformRcPtr csTransform = \
+                DynamicPtrCast<const ColorSpaceTransform>(transform))
+            {
+                addColorSpace(csTransform->getSrc());
+                addColorSpace(csTransform->getDst());
+            }
+            else if(ConstLookTransformRcPtr lookTransform = \
+                DynamicPtrCast<const LookTransform>(transform))
+            {
+                addColorSpace(lookTransform->getSrc());
+                addColorSpace(lookTransform->getDst());
+                addLooks(lookTransform->getLooks());
+            }
+            else if(ConstDisplayTransformRcPtr displayTransform = \
+                DynamicPtrCast<const DisplayTransform>(transform))
+            {
+                const char * display = displayTransform->getDisplay();
+                const char * view = displayTransform->getView();
+
+                addColorSpace(displayTransform->getInputColorSpaceName());
+                addColorSpace(m_config.getDisplayColorSpaceName(display, view));
+                addLooks(displayTransform->getLooksOverrideEnabled()
+                         ? displayTransform->getLooksOverride()
+                         : m_config.getDisplayLooks(display, view));
+
+                if(displayTransform->getLinearCC())
+                {
+                    addColorSpace(ROLE_SCENE_LINEAR);
+                    addTransform(displayTransform->getLinearCC());
+                }
+                if(displayTransform->getColorTimingCC())
+                {
+                    addColorSpace(ROLE_COLOR_TIMING);
+                    addTransform(displayTransform->getColorTimingCC());
+                }
+                addTransform(displayTransform->getChannelView());
+                addTransform(displayTransform->getDisplayCC());
+            }
+        }
+
+        void addColorSpace(const ConstColorSpaceRcPtr & cs)
+        {
+            if(cs && m_colorSpaces.insert(cs->getName()).second)
+            {
+                addTransform(cs->getTransform(COLORSPACE_DIR_TO_REFERENCE));
+                addTransform(cs->getTransform(COLORSPACE_DIR_FROM_REFERENCE));
+            }
+        }
+
+        void addColorSpace(const char * name)
+        {
+            if(name && *name)
+            {
+                addColorSpace(m_config.getColorSpace(name));
+            }
+        }
+
+        void addLooks(const char * looks)
+        {
+            if(!looks || !*looks) return;
+
+            LookParseResult result;
+            for(const auto & tokens : result.parse(looks))
+            {
+                for(const auto & token : tokens)
+                {
+                    ConstLookRcPtr look = m_config.getLook(token.name.c_str());
+                    if(look && m_looks.insert(look->getName()).second)
+                    {
+                        addColorSpace(look->getProcessSpace());
+                        addTransform(look->getTransform());
+                        addTransform(look->getInverseTransform());
+                    }
+                }
+            }
+        }
+
+        const StringSet & getFiles() const { return m_files; }
+
+    private:
+        const Config & m_config;
+        StringSet m_files;
+        StringSet m_colorSpaces;
+        StringSet m_looks;
+    };
+
+    // The hash and the file references of a look or a color space of the config.
+    struct ElementCacheID
+    {
+        std::string hash;
+        std::set<std::string> files;
+    };
+    
+    // Append the hashes of the elements to the stream and collect their file
+    // references. Only the elements not in the map are serialized, and the
+    // elements which are not in the config anymore are removed from the map.
+    template<typename ElementRcPtr>
+    void UpdateElementCacheIDs(std::map<ElementRcPtr, ElementCacheID> & cacheIDs,
+                               const std::vector<ElementRcPtr> & elements,
+                               const OCIOYaml & io,
+                               std::ostream & hashes,
+                               std::set<std::string> & files)
+    {
+        std::map<ElementRcPtr, ElementCacheID> updatedCacheIDs;
+        for(const auto & element : elements)
+        {
+            ElementCacheID & cacheID = updatedCacheIDs[element];
+            
+            auto iter = cacheIDs.find(element);
+            if(iter != cacheIDs.end())
+            {
+                cacheID = std::move(iter->second);
+            }
+            else
+            {
+                std::ostringstream os;
+                io.write(os, element);
+                const std::string fullstr = os.str();
+                cacheID.hash = CacheIDHash(fullstr.c_str(), (int)fullstr.size());
+                GetElementFileReferences(cacheID.files, element);
+            }
+            
+            hashes << cacheID.hash << " ";
+            files.insert(cacheID.files.begin(), cacheID.files.end());
+        }
+        cacheIDs.swap(updatedCacheIDs);
+    }
+    
     void GetColorSpaceReferences(std::set<std::string> & colorSpaceNames,
                                  const ConstTransformRcPtr & transform,
                                  const ConstContextRcPtr & context)
@@ -174,8 +358,8 @@ OCIO_NAMESPACE_ENTER
         else if(ConstLookTransformRcPtr lookTransform = \
             DynamicPtrCast<const LookTransform>(transform))
         {
-            colorSpaceNames.insert(context->resolveStringVar(colorSpaceTransform->getSrc()));
-            colorSpaceNames.insert(context->resolveStringVar(colorSpaceTransform->getDst()));
+            colorSpaceNames.insert(context->resolveStringVar(lookTransform->getSrc()));
+            colorSpaceNames.insert(context->resolveStringVar(lookTransform->getDst()));
         }
     }
     
@@ -190,6 +374,176 @@ OCIO_NAMESPACE_ENTER
         
     } // namespace
     
+    namespace
+    {
+        // Processors returned by Config::getProcessor() are cached by each config. The cache
+        // is bounded and discards the least recently used processor.
+        const size_t MAX_PROCESSOR_CACHE_SIZE = 128;
+
+        // The file version is the file version clock read before building the processor
+        // (refer to IsFileNewerThan()).
+        struct ProcessorCacheEntry
+        {
+            std::string key;
+            ConstProcessorRcPtr processor;
+            unsigned long long fileVersion;
+        };
+
+        // The most recently used processor is at the front.
+        typedef std::list<ProcessorCacheEntry> ProcessorCacheList;
+        typedef std::map<std::string, ProcessorCacheList::iterator> ProcessorCacheMap;
+
+        // The state of the processor cache when looking for a processor, to only cache the
+        // processor built from the same config and file states.
+        struct ProcessorCacheGeneration
+        {
+            unsigned config = 0;
+            unsigned long long files = 0;
+        };
+
+        // The processors are shared with the callers, only the bookkeeping is accounted.
+        size_t GetProcessorCacheEntrySize(const std::string & key)
+        {
+            return sizeof(ProcessorCacheList::value_type) + sizeof(ProcessorCacheMap::value_type)
+                + 2 * key.size();
+        }
+
+        // Incremented by ClearAllCaches() to invalidate the processor caches of all the configs
+        // (e.g. the processors hold LUTs which may have been modified on disk).
+        std::atomic<unsigned> g_processorCachesGeneration(0);
+
+        // A file modified since the file version also invalidates the processors of the other
+        // configs referencing it, but not the processors using other files.
+        bool HasStaleFiles(const ConstProcessorRcPtr & processor, unsigned long long fileVersion)
+        {
+            ConstProcessorMetadataRcPtr metadata = processor->getProcessorMetadata();
+            for(int i=0; i<metadata->getNumFiles(); ++i)
+            {
+                const char * file = metadata->getFile(i);
+                if(IsCachedFileStale(file) || IsFileNewerThan(file, fileVersion)) return true;
+            }
+            return false;
+        }
+
+        void WriteMetadataKey(std::ostream & os, const FormatMetadata & metadata)
+        {
+            os << "[" << metadata.getName() << "=" << metadata.getValue();
+            for(int i=0; i<metadata.getNumAttributes(); ++i)
+            {
+                os << " " << metadata.getAttributeName(i) << "=" << metadata.getAttributeValue(i);
+            }
+            for(int i=0; i<metadata.getNumChildrenElements(); ++i)
+            {
+                WriteMetadataKey(os, metadata.getChildElement(i));
+            }
+            os << "]";
+        }
+
+        template<typename T>
+        bool WriteStreamKey(std::ostream & os, const ConstTransformRcPtr & transform)
+        {
+            OCIO_SHARED_PTR<const T> typed = DynamicPtrCast<const T>(transform);
+            if(!typed) return false;
+            os << *typed;
+            return true;
+        }
+
+        template<typename T>
+        bool WriteStreamKeyWithMetadata(std::ostream & os, const ConstTransformRcPtr & transform)
+        {
+            OCIO_SHARED_PTR<const T> typed = DynamicPtrCast<const T>(transform);
+            if(!typed) return false;
+            os << *typed;
+            WriteMetadataKey(os, typed->getFormatMetadata());
+            return true;
+        }
+
+        // Write a description of the transform identifying the processor built from it.
+        // Returns false if the transform could not be described precisely enough i.e.
+        // the LUT transforms (their stream operators only summarize the values) and the
+        // dynamic transforms (their processors must not be shared).
+        bool WriteTransformKey(std::ostream & os, const ConstTransformRcPtr & transform)
+        {
+            if(!transform)
+            {
+                os << "<null>";
+                return true;
+            }
+
+            if(ConstGroupTransformRcPtr group = DynamicPtrCast<const GroupTransform>(transform))
+            {
+                os << "<GroupTransform " << TransformDirectionToString(group->getDirection());
+                WriteMetadataKey(os, group->getFormatMetadata());
+                for(int i=0; i<group->size(); ++i)
+                {
+                    if(!WriteTransformKey(os, group->getTransform(i))) return false;
+                }
+                os << ">";
+                return true;
+            }
+
+            if(ConstDisplayTransformRcPtr display = DynamicPtrCast<const DisplayTransform>(transform))
+            {
+                os << "<DisplayTransform " << TransformDirectionToString(display->getDirection());
+                os << " " << display->getInputColorSpaceName();
+                os << " " << display->getDisplay() << " " << display->getView();
+                if(display->getLooksOverrideEnabled())
+                {
+                    os << " looks=" << display->getLooksOverride();
+                }
+                if(!WriteTransformKey(os, display->getLinearCC())
+                   || !WriteTransformKey(os, display->getColorTimingCC())
+                   || !WriteTransformKey(os, display->getChannelView())
+                   || !WriteTransformKey(os, display->getDisplayCC()))
+                {
+                    return false;
+                }
+                os << ">";
+                return true;
+            }
+
+            if(ConstExposureContrastTransformRcPtr ec
+                = DynamicPtrCast<const ExposureContrastTransform>(transform))
+            {
+                if(ec->isExposureDynamic() || ec->isContrastDynamic() || ec->isGammaDynamic())
+                {
+                    return false;
+                }
+                os << *ec;
+                WriteMetadataKey(os, ec->getFormatMetadata());
+                return true;
+            }
+
+            // The stream operator of the ExponentTransform only writes the float values.
+            if(ConstExponentTransformRcPtr exponent
+                = DynamicPtrCast<const ExponentTransform>(transform))
+            {
+                double value[4];
+                exponent->getValue(value);
+                os << "<ExponentTransform " << TransformDirectionToString(exponent->getDirection());
+                for(int i=0; i<4; ++i)
+                {
+                    os << " " << value[i];
+                }
+                os << ">";
+                WriteMetadataKey(os, exponent->getFormatMetadata());
+                return true;
+            }
+
+            return WriteStreamKey<AllocationTransform>(os, transform)
+                || WriteStreamKeyWithMetadata<CDLTransform>(os, transform)
+                || WriteStreamKey<ColorSpaceTransform>(os, transform)
+                || WriteStreamKeyWithMetadata<ExponentWithLinearTransform>(os, transform)
+                || WriteStreamKey<FileTransform>(os, transform)
+                || WriteStreamKeyWithMetadata<FixedFunctionTransform>(os, transform)
+                || WriteStreamKeyWithMetadata<LogAffineTransform>(os, transform)
+                || WriteStreamKeyWithMetadata<LogTransform>(os, transform)
+                || WriteStreamKey<LookTransform>(os, transform)
+                || WriteStreamKeyWithMetadata<MatrixTransform>(os, transform)
+                || WriteStreamKeyWithMetadata<RangeTransform>(os, transform);
+        }
+    }
+
     static const unsigned FirstSupportedMajorVersion_ = 1;
     static const unsigned LastSupportedMajorVersion_  = 2;
 
@@ -224,18 +578,46 @@ OCIO_NAMESPACE_ENTER
         mutable std::string sanitytext_;
         
         mutable Mutex cacheidMutex_;
-        mutable StringMap cacheids_;
+        mutable StringCache cacheids_;
         mutable std::string cacheidnocontext_;
+        mutable StringVec fileReferences_;
+        
+        // The looks and color spaces of the config are private copies which are never
+        // edited in place, so each of them is only hashed once and an edit of the config
+        // only hashes the new elements (refer to computeCacheIDWithoutContext()).
+        mutable Mutex elementCacheIDsMutex_;
+        mutable std::map<ConstLookRcPtr, ElementCacheID> lookCacheIDs_;
+        mutable std::map<ConstColorSpaceRcPtr, ElementCacheID> colorSpaceCacheIDs_;
+        
+        mutable Mutex processorCacheMutex_;
+        mutable ProcessorCacheList processorCacheList_;
+        mutable ProcessorCacheMap processorCacheMap_;
+        mutable unsigned processorCacheGeneration_;
+        mutable unsigned processorCacheGlobalGeneration_;
+        bool processorCacheEnabled_;
+        mutable unsigned long processorCacheHits_;
+        mutable unsigned long processorCacheMisses_;
         
         OCIOYaml io_;
         
+        // The config file the config was created from and its fast hash at that time,
+        // recorded by the binary form. Any edit of the config resets them.
+        std::string sourceFile_;
+        std::string sourceFileHash_;
+        
         Impl() : 
             majorVersion_(FirstSupportedMajorVersion_),
             minorVersion_(0),
             context_(Context::Create()),
             colorspaces_(ColorSpaceSet::Create()),
             strictParsing_(true),
-            sanity_(SANITY_UNKNOWN)
+            sanity_(SANITY_UNKNOWN),
+            cacheids_(CACHE_CONFIG_CACHE_ID),
+            processorCacheGeneration_(0),
+            processorCacheGlobalGeneration_(g_processorCachesGeneration),
+            processorCacheEnabled_(true),
+            processorCacheHits_(0),
+            processorCacheMisses_(0)
         {
             std::string activeDisplays;
             Platform::Getenv(OCIO_ACTIVE_DISPLAYS_ENVVAR, activeDisplays);
@@ -259,7 +641,7 @@ OCIO_NAMESPACE_ENTER
         
         ~Impl()
         {
-        
+            removeCachedProcessors();
         }
         
         Impl& operator= (const Impl & rhs)
@@ -304,6 +686,20 @@ OCIO_NAMESPACE_ENTER
                 
                 cacheids_ = rhs.cacheids_;
                 cacheidnocontext_ = rhs.cacheidnocontext_;
+                fileReferences_ = rhs.fileReferences_;
+
+                sourceFile_ = rhs.sourceFile_;
+                sourceFileHash_ = rhs.sourceFileHash_;
+
+                // The looks are copied, only the hashes of the color spaces are valid.
+                {
+                    AutoMutex lock(rhs.elementCacheIDsMutex_);
+                    colorSpaceCacheIDs_ = rhs.colorSpaceCacheIDs_;
+                }
+
+                // The processors are not shared with the copy.
+                clearProcessorCache();
+                processorCacheEnabled_ = rhs.processorCacheEnabled_;
             }
             return *this;
         }
@@ -312,10 +708,48 @@ OCIO_NAMESPACE_ENTER
         // to reset internal cache states.  You also should do this in a
         // thread safe manner by acquiring the cacheidMutex_;
         void resetCacheIDs();
+
+        // Compute the part of the cacheID which does not depend on the context, and the
+        // file references of the config.
+        void computeCacheIDWithoutContext(const Config * config,
+                                          std::string & cacheid,
+                                          StringVec & files) const;
+
+        // The key identifying the processor in the processor cache, the key is empty if
+        // the processor must not be cached.
+        std::string getProcessorCacheKey(const ConstContextRcPtr & context,
+                                         const std::string & description) const;
+
+        // Return a null processor if not found. The generation must be given to
+        // addCachedProcessor() so a processor built from an obsolete config state is not
+        // cached.
+        ConstProcessorRcPtr getCachedProcessor(const std::string & key,
+                                               ProcessorCacheGeneration & generation) const;
+        void addCachedProcessor(const std::string & key,
+                                const ProcessorCacheGeneration & generation,
+                                const ConstProcessorRcPtr & processor) const;
+        void clearProcessorCache();
+        // Remove all the cached processors, the caller must hold processorCacheMutex_.
+        void removeCachedProcessors() const;
+        // Remove all the cached processors if ClearConfigProcessorCaches() was called since
+        // the last check, the caller must hold processorCacheMutex_.
+        void syncProcessorCacheGeneration() const;
         
         // Get all internal transforms (to generate cacheIDs, validation, etc).
         // This currently crawls colorspaces + looks
         void getAllIntenalTransforms(ConstTransformVec & transformVec) const;
+
+        // Write the content and the precomputed state of the config in its binary form
+        // (refer to Config::serializeBinary()).
+        void writeBinary(BinaryCacheWriter & writer, const Config * config) const;
+        // Create the config from its binary form, throw if the binary is not valid.
+        static ConfigRcPtr ReadBinary(const char * data, size_t size);
+
+        // The binary form of the config file in the persistent cache (refer to
+        // SetFileCacheDirectory()), return null if there is no valid one.
+        static ConstConfigRcPtr LoadFromBinaryCache(const std::string & filepath,
+                                                    const std::string & fileHash);
+        static void SaveToBinaryCache(const ConstConfigRcPtr & config);
     };
     
     
@@ -360,8 +794,22 @@ OCIO_NAMESPACE_ENTER
             throw Exception (os.str().c_str());
         }
         
+        const std::string filepath = AbsPath(filename);
+        const std::string fileHash = ComputeFastFileHash(filepath);
+        
+        ConstConfigRcPtr cachedConfig = Impl::LoadFromBinaryCache(filepath, fileHash);
+        if(cachedConfig)
+        {
+            return cachedConfig;
+        }
+        
         ConfigRcPtr config = Config::Create();
         config->getImpl()->io_.open(istream, config, filename);
+        config->getImpl()->sourceFile_ = filepath;
+        config->getImpl()->sourceFileHash_ = fileHash;
+        
+        Impl::SaveToBinaryCache(config);
+        
         return config;
     }
     
@@ -372,6 +820,15 @@ OCIO_NAMESPACE_ENTER
         return config;
     }
     
+    ConstConfigRcPtr Config::CreateFromBinary(std::istream & istream)
+    {
+        std::ostringstream buffer;
+        buffer << istream.rdbuf();
+        const std::string data = buffer.str();
+        
+        return Impl::ReadBinary(data.data(), data.size());
+    }
+    
     ///////////////////////////////////////////////////////////////////////////
     
     
@@ -1369,6 +1826,9 @@ OCIO_NAMESPACE_ENTER
             if(pystring::lower(getImpl()->looksList_[i]->getName()) == namelower)
             {
                 getImpl()->looksList_[i] = look->createEditableCopy();
+                
+                AutoMutex lock(getImpl()->cacheidMutex_);
+                getImpl()->resetCacheIDs();
                 return;
             }
         }
@@ -1412,9 +1872,32 @@ OCIO_NAMESPACE_ENTER
             throw Exception("Config::GetProcessor failed. Destination colorspace is null.");
         }
         
+        // Only the color spaces of the config are identified by their names.
+        std::string key;
+        if(getColorSpace(src->getName()) == src && getColorSpace(dst->getName()) == dst)
+        {
+            std::ostringstream os;
+            os << "<ColorSpaces src=" << src->getName() << ", dst=" << dst->getName() << ">";
+            key = getImpl()->getProcessorCacheKey(context, os.str());
+        }
+
+        ProcessorCacheGeneration generation;
+        ConstProcessorRcPtr cached = getImpl()->getCachedProcessor(key, generation);
+        if(cached)
+        {
+            return cached;
+        }
+
+        ProcessorFileReferences fileReferences(*this);
+        fileReferences.addColorSpace(src);
+        fileReferences.addColorSpace(dst);
+        PrefetchFiles(context, fileReferences.getFiles());
+
         ProcessorRcPtr processor = Processor::Create();
         processor->getImpl()->setColorSpaceConversion(*this, context, src, dst);
         processor->getImpl()->computeMetadata();
+
+        getImpl()->addCachedProcessor(key, generation, processor);
         return processor;
     }
     
@@ -1438,134 +1921,679 @@ OCIO_NAMESPACE_ENTER
             throw Exception(os.str().c_str());
         }
         
-        ConstColorSpaceRcPtr dst = getColorSpace(dstName);
-        if(!dst)
+        ConstColorSpaceRcPtr dst = getColorSpace(dstName);
+        if(!dst)
+        {
+            std::ostringstream os;
+            os << "Could not find colorspace '" << dstName << "'.";
+            throw Exception(os.str().c_str());
+        }
+        
+        return getProcessor(context, src, dst);
+    }
+    
+    
+    ConstProcessorRcPtr Config::getProcessor(const ConstTransformRcPtr& transform) const
+    {
+        return getProcessor(transform, TRANSFORM_DIR_FORWARD);
+    }
+    
+    
+    ConstProcessorRcPtr Config::getProcessor(const ConstTransformRcPtr& transform,
+                                             TransformDirection direction) const
+    {
+        ConstContextRcPtr context = getCurrentContext();
+        return getProcessor(context, transform, direction);
+    }
+    
+    ConstProcessorRcPtr Config::getProcessor(const ConstContextRcPtr & context,
+                                             const ConstTransformRcPtr& transform,
+                                             TransformDirection direction) const
+    {
+        std::string key;
+        std::ostringstream os;
+        os.precision(17);
+        os << TransformDirectionToString(direction) << " ";
+        if(transform && WriteTransformKey(os, transform))
+        {
+            key = getImpl()->getProcessorCacheKey(context, os.str());
+        }
+
+        ProcessorCacheGeneration generation;
+        ConstProcessorRcPtr cached = getImpl()->getCachedProcessor(key, generation);
+        if(cached)
+        {
+            return cached;
+        }
+
+        ProcessorFileReferences fileReferences(*this);
+        fileReferences.addTransform(transform);
+        PrefetchFiles(context, fileReferences.getFiles());
+
+        ProcessorRcPtr processor = Processor::Create();
+        processor->getImpl()->setTransform(*this, context, transform, direction);
+        processor->getImpl()->computeMetadata();
+
+        getImpl()->addCachedProcessor(key, generation, processor);
+        return processor;
+    }
+
+    void Config::setProcessorCacheEnabled(bool enabled)
+    {
+        AutoMutex lock(getImpl()->processorCacheMutex_);
+        getImpl()->processorCacheEnabled_ = enabled;
+        if(!enabled)
+        {
+            getImpl()->removeCachedProcessors();
+        }
+    }
+
+    bool Config::isProcessorCacheEnabled() const
+    {
+        AutoMutex lock(getImpl()->processorCacheMutex_);
+        return getImpl()->processorCacheEnabled_;
+    }
+
+    double Config::getProcessorCacheHitRate() const
+    {
+        AutoMutex lock(getImpl()->processorCacheMutex_);
+        const unsigned long total
+            = getImpl()->processorCacheHits_ + getImpl()->processorCacheMisses_;
+        return total==0 ? 0.0 : double(getImpl()->processorCacheHits_) / double(total);
+    }
+    
+    std::ostream& operator<< (std::ostream& os, const Config& config)
+    {
+        config.serialize(os);
+        return os;
+    }
+    
+    ///////////////////////////////////////////////////////////////////////////
+    //  CacheID
+    
+    const char * Config::getCacheID() const
+    {
+        return getCacheID(getCurrentContext());
+    }
+    
+    const char * Config::getCacheID(const ConstContextRcPtr & context) const
+    {
+        // A null context will use the empty cacheid
+        std::string contextcacheid = "";
+        if(context) contextcacheid = context->getCacheID();
+        
+        std::string cacheidnocontext;
+        StringVec files;
+        {
+            AutoMutex lock(getImpl()->cacheidMutex_);
+            
+            const std::string * cacheid = getImpl()->cacheids_.find(contextcacheid);
+            if(cacheid)
+            {
+                return cacheid->c_str();
+            }
+            
+            cacheidnocontext = getImpl()->cacheidnocontext_;
+            files = getImpl()->fileReferences_;
+        }
+        
+        CacheMissTimer missTimer(CACHE_CONFIG_CACHE_ID);
+        
+        // The cacheid is computed without holding the lock so the lookups from
+        // the other threads are not blocked by the serialization and the file
+        // accesses.
+        
+        // Include the hash of the yaml config serialization
+        if(cacheidnocontext.empty())
+        {
+            getImpl()->computeCacheIDWithoutContext(this, cacheidnocontext, files);
+        }
+        
+        // Also include all file references, using the context (if specified).
+        // The file hashes are cached (refer to GetFastFileHash()).
+        std::string fileReferencesFashHash = "";
+        if(context)
+        {
+            std::ostringstream filehash;
+            
+            for(const auto & file : files)
+            {
+                if(file.empty()) continue;
+                filehash << file << "=";
+                
+                try
+                {
+                    std::string resolvedLocation = context->resolveFileLocation(file.c_str());
+                    filehash << GetFastFileHash(resolvedLocation) << " ";
+                }
+                catch(...)
+                {
+                    filehash << "? ";
+                    continue;
+                }
+            }
+            
+            std::string fullstr = filehash.str();
+            fileReferencesFashHash = CacheIDHash(fullstr.c_str(), (int)fullstr.size());
+        }
+        
+        AutoMutex lock(getImpl()->cacheidMutex_);
+        
+        // Another thread may have computed it meanwhile.
+        if(getImpl()->cacheidnocontext_.empty())
+        {
+            getImpl()->cacheidnocontext_ = cacheidnocontext;
+            getImpl()->fileReferences_ = files;
+        }
+        
+        return getImpl()->cacheids_.insert(
+            contextcacheid,
+            getImpl()->cacheidnocontext_ + ":" + fileReferencesFashHash).c_str();
+    }
+    
+    void Config::Impl::computeCacheIDWithoutContext(const Config * config,
+                                                    std::string & cacheid,
+                                                    StringVec & files) const
+    {
+        AutoMutex lock(elementCacheIDsMutex_);
+        
+        std::ostringstream hashes;
+        std::set<std::string> allFiles;
+        
+        try
+        {
+            io_.writeWithoutElements(hashes, config);
+            
+            const std::vector<ConstLookRcPtr> looks(looksList_.begin(), looksList_.end());
+            UpdateElementCacheIDs(lookCacheIDs_, looks, io_, hashes, allFiles);
+            
+            std::vector<ConstColorSpaceRcPtr> colorspaces;
+            colorspaces.reserve(colorspaces_->getNumColorSpaces());
+            for(int i=0; i<colorspaces_->getNumColorSpaces(); ++i)
+            {
+                colorspaces.push_back(colorspaces_->getColorSpaceByIndex(i));
+            }
+            UpdateElementCacheIDs(colorSpaceCacheIDs_, colorspaces, io_, hashes, allFiles);
+        }
+        catch(const std::exception & e)
+        {
+            std::ostringstream error;
+            error << "Error building YAML: " << e.what();
+            throw Exception(error.str().c_str());
+        }
+        
+        const std::string fullstr = hashes.str();
+        cacheid = CacheIDHash(fullstr.c_str(), (int)fullstr.size());
+        
+        files.assign(allFiles.begin(), allFiles.end());
+    }
+    
+    
+    ///////////////////////////////////////////////////////////////////////////
+    //  Serialization
+    
+    void Config::serialize(std::ostream& os) const
+    {
+        try
+        {
+            getImpl()->io_.write(os, this);
+        }
+        catch( const std::exception & e)
+        {
+            std::ostringstream error;
+            error << "Error building YAML: " << e.what();
+            throw Exception(error.str().c_str());
+        }
+    }
+    
+    void Config::serializeBinary(std::ostream & os) const
+    {
+        // Validate the config beforehand so the result is stored too.
+        try
+        {
+            sanityCheck();
+        }
+        catch(const Exception &)
+        {
+        }
+        
+        BinaryCacheWriter payload;
+        getImpl()->writeBinary(payload, this);
+        
+        BinaryCacheWriter writer;
+        writer.writeString(BINARY_CONFIG_MAGIC);
+        writer.writeInt(BINARY_CONFIG_VERSION);
+        writer.writeInt(BINARY_CONFIG_ENDIANNESS);
+        // The precomputed cacheID depends on the library.
+        writer.writeString(OCIO_VERSION);
+        writer.writeString(payload.getBuffer());
+        writer.writeInt((int)ComputeBinaryCacheChecksum(payload.getBuffer().data(),
+                                                        payload.getBuffer().size()));
+        
+        os.write(writer.getBuffer().data(), (std::streamsize)writer.getBuffer().size());
+        if(!os.good())
+        {
+            throw Exception("Could not write the binary config.");
+        }
+    }
+    
+    namespace
+    {
+        void WriteStrings(BinaryCacheWriter & writer, const StringVec & values)
+        {
+            writer.writeInt((int)values.size());
+            for(const auto & value : values)
+            {
+                writer.writeString(value);
+            }
+        }
+        
+        void ReadStrings(BinaryCacheReader & reader, StringVec & values)
+        {
+            const int size = reader.readInt();
+            if(size < 0)
+            {
+                throw Exception("Corrupted binary config.");
+            }
+            values.resize((size_t)size);
+            for(auto & value : values)
+            {
+                value = reader.readString();
+            }
+        }
+        
+        void WriteElementCacheID(BinaryCacheWriter & writer, const ElementCacheID & cacheID)
+        {
+            writer.writeString(cacheID.hash);
+            WriteStrings(writer, StringVec(cacheID.files.begin(), cacheID.files.end()));
+        }
+        
+        void ReadElementCacheID(BinaryCacheReader & reader, ElementCacheID & cacheID)
+        {
+            cacheID.hash = reader.readString();
+            StringVec files;
+            ReadStrings(reader, files);
+            cacheID.files.insert(files.begin(), files.end());
+        }
+    }
+    
+    void Config::Impl::writeBinary(BinaryCacheWriter & writer, const Config * config) const
+    {
+        writer.writeString(sourceFile_);
+        writer.writeString(sourceFileHash_);
+        
+        writer.writeInt((int)majorVersion_);
+        writer.writeInt((int)minorVersion_);
+        writer.writeString(description_);
+        
+        writer.writeInt((int)env_.size());
+        for(const auto & var : env_)
+        {
+            writer.writeString(var.first);
+            writer.writeString(var.second);
+        }
+        writer.writeInt(context_->getEnvironmentMode());
+        
+        // The search path of a v1 config is a single string, which may have empty paths.
+        writer.writeString(context_->getSearchPath());
+        StringVec searchPaths;
+        for(int i=0; i<context_->getNumSearchPaths(); ++i)
+        {
+            searchPaths.push_back(context_->getSearchPath(i));
+        }
+        WriteStrings(writer, searchPaths);
+        writer.writeString(context_->getWorkingDir());
+        
+        writer.writeBool(strictParsing_);
+        writer.writeFloats(defaultLumaCoefs_);
+        
+        writer.writeInt((int)roles_.size());
+        for(const auto & role : roles_)
+        {
+            writer.writeString(role.first);
+            writer.writeString(role.second);
+        }
+        
+        writer.writeInt((int)displays_.size());
+        for(const auto & display : displays_)
+        {
+            writer.writeString(display.first);
+            writer.writeInt((int)display.second.size());
+            for(const auto & view : display.second)
+            {
+                writer.writeString(view.name);
+                writer.writeString(view.colorspace);
+                writer.writeString(view.looks);
+            }
+        }
+        WriteStrings(writer, activeDisplays_);
+        WriteStrings(writer, activeViews_);
+        
+        writer.writeInt((int)looksList_.size());
+        for(const auto & look : looksList_)
+        {
+            WriteLook(writer, look);
+        }
+        
+        writer.writeInt(colorspaces_->getNumColorSpaces());
+        for(int i=0; i<colorspaces_->getNumColorSpaces(); ++i)
+        {
+            WriteColorSpace(writer, colorspaces_->getColorSpaceByIndex(i));
+        }
+        
+        // The validation only holds for the context it was done with.
+        {
+            AutoMutex lock(cacheidMutex_);
+            writer.writeString(context_->getCacheID());
+            writer.writeInt(sanity_);
+            writer.writeString(sanitytext_);
+        }
+        
+        // The cacheID without the context, and the hashes of the elements so an edit of the
+        // config only hashes the new elements.
+        std::string cacheid;
+        StringVec files;
+        {
+            AutoMutex lock(cacheidMutex_);
+            cacheid = cacheidnocontext_;
+            files = fileReferences_;
+        }
+        
+        if(cacheid.empty())
+        {
+            try
+            {
+                computeCacheIDWithoutContext(config, cacheid, files);
+            }
+            catch(const Exception &)
+            {
+                // The config cannot be serialized in YAML (e.g. a role without color space).
+                cacheid.clear();
+            }
+        }
+        
+        AutoMutex lock(elementCacheIDsMutex_);
+        
+        bool hasCacheID = !cacheid.empty();
+        for(const auto & look : looksList_)
+        {
+            hasCacheID = hasCacheID && lookCacheIDs_.count(look)!=0;
+        }
+        for(int i=0; i<colorspaces_->getNumColorSpaces(); ++i)
+        {
+            hasCacheID = hasCacheID
+                && colorSpaceCacheIDs_.count(colorspaces_->getColorSpaceByIndex(i))!=0;
+        }
+        
+        writer.writeBool(hasCacheID);
+        if(hasCacheID)
+        {
+            writer.writeString(cacheid);
+            WriteStrings(writer, files);
+            for(const auto & look : looksList_)
+            {
+                WriteElementCacheID(writer, lookCacheIDs_.at(look));
+            }
+            for(int i=0; i<colorspaces_->getNumColorSpaces(); ++i)
+            {
+                WriteElementCacheID(writer,
+                    colorSpaceCacheIDs_.at(colorspaces_->getColorSpaceByIndex(i)));
+            }
+        }
+    }
+    
+    ConfigRcPtr Config::Impl::ReadBinary(const char * data, size_t size)
+    {
+        BinaryCacheReader header(data, size);
+        
+        if(header.readString()!=BINARY_CONFIG_MAGIC
+           || header.readInt()!=BINARY_CONFIG_VERSION
+           || header.readInt()!=BINARY_CONFIG_ENDIANNESS
+           || header.readString()!=OCIO_VERSION)
+        {
+            throw Exception("The binary config is not supported by this version of the library.");
+        }
+        
+        const char * payload = nullptr;
+        size_t payloadSize = 0;
+        header.readBlock(payload, payloadSize);
+        if((unsigned)header.readInt()!=ComputeBinaryCacheChecksum(payload, payloadSize)
+           || !header.atEnd())
+        {
+            throw Exception("Corrupted binary config.");
+        }
+        
+        BinaryCacheReader reader(payload, payloadSize);
+        
+        const std::string sourceFile = reader.readString();
+        const std::string sourceFileHash = reader.readString();
+        if(!sourceFile.empty() && ComputeFastFileHash(sourceFile)!=sourceFileHash)
+        {
+            std::ostringstream os;
+            os << "The binary config is out of date, the config file '" << sourceFile;
+            os << "' was modified since.";
+            throw Exception(os.str().c_str());
+        }
+        
+        ConfigRcPtr config = Config::Create();
+        
+        config->setMajorVersion((unsigned)reader.readInt());
+        config->setMinorVersion((unsigned)reader.readInt());
+        config->setDescription(reader.readString().c_str());
+        
+        const int numVars = reader.readInt();
+        for(int i=0; i<numVars; ++i)
+        {
+            const std::string name = reader.readString();
+            config->addEnvironmentVar(name.c_str(), reader.readString().c_str());
+        }
+        const EnvironmentMode mode = (EnvironmentMode)reader.readInt();
+        
+        const std::string searchPath = reader.readString();
+        StringVec searchPaths;
+        ReadStrings(reader, searchPaths);
+        StringVec splitSearchPath;
+        pystring::split(searchPath, splitSearchPath, ":");
+        if(splitSearchPath==searchPaths)
+        {
+            config->setSearchPath(searchPath.c_str());
+        }
+        else
+        {
+            for(const auto & path : searchPaths)
+            {
+                config->addSearchPath(path.c_str());
+            }
+        }
+        const std::string workingDir = reader.readString();
+        
+        config->setStrictParsingEnabled(reader.readBool());
+        std::vector<float> luma;
+        reader.readFloats(luma);
+        if(luma.size()!=3)
+        {
+            throw Exception("Corrupted binary config.");
+        }
+        config->setDefaultLumaCoefs(&luma[0]);
+        
+        const int numRoles = reader.readInt();
+        for(int i=0; i<numRoles; ++i)
+        {
+            const std::string role = reader.readString();
+            config->setRole(role.c_str(), reader.readString().c_str());
+        }
+        
+        const int numDisplays = reader.readInt();
+        for(int i=0; i<numDisplays; ++i)
+        {
+            const std::string display = reader.readString();
+            const int numViews = reader.readInt();
+            for(int v=0; v<numViews; ++v)
+            {
+                const std::string view = reader.readString();
+                const std::string colorspace = reader.readString();
+                const std::string looks = reader.readString();
+                config->addDisplay(display.c_str(), view.c_str(),
+                                   colorspace.c_str(), looks.c_str());
+            }
+        }
+        StringVec active;
+        ReadStrings(reader, active);
+        config->setActiveDisplays(JoinStringEnvStyle(active).c_str());
+        ReadStrings(reader, active);
+        config->setActiveViews(JoinStringEnvStyle(active).c_str());
+        
+        const int numLooks = reader.readInt();
+        for(int i=0; i<numLooks; ++i)
+        {
+            config->addLook(ReadLook(reader));
+        }
+        
+        const int numColorSpaces = reader.readInt();
+        for(int i=0; i<numColorSpaces; ++i)
+        {
+            config->addColorSpace(ReadColorSpace(reader));
+        }
+        
+        // As done by the YAML parsing.
+        config->setWorkingDir(workingDir.c_str());
+        config->setEnvironmentMode(mode);
+        config->loadEnvironment();
+        
+        Impl * impl = config->getImpl();
+        
+        if(numLooks!=(int)impl->looksList_.size()
+           || numColorSpaces!=impl->colorspaces_->getNumColorSpaces())
+        {
+            throw Exception("Corrupted binary config.");
+        }
+        
+        // Restore the precomputed state.
+        
+        const std::string contextCacheID = reader.readString();
+        const int sanity = reader.readInt();
+        const std::string sanityText = reader.readString();
+        if(contextCacheID==config->getCurrentContext()->getCacheID())
+        {
+            AutoMutex lock(impl->cacheidMutex_);
+            impl->sanity_ = (Sanity)sanity;
+            impl->sanitytext_ = sanityText;
+        }
+        
+        if(reader.readBool())
+        {
+            std::string cacheid = reader.readString();
+            StringVec files;
+            ReadStrings(reader, files);
+            
+            {
+                AutoMutex lock(impl->elementCacheIDsMutex_);
+                for(const auto & look : impl->looksList_)
+                {
+                    ReadElementCacheID(reader, impl->lookCacheIDs_[look]);
+                }
+                for(int i=0; i<numColorSpaces; ++i)
+                {
+                    ReadElementCacheID(reader,
+                        impl->colorSpaceCacheIDs_[impl->colorspaces_->getColorSpaceByIndex(i)]);
+                }
+            }
+            
+            AutoMutex lock(impl->cacheidMutex_);
+            impl->cacheidnocontext_ = cacheid;
+            impl->fileReferences_ = files;
+        }
+        
+        if(!reader.atEnd())
         {
-            std::ostringstream os;
-            os << "Could not find colorspace '" << dstName << "'.";
-            throw Exception(os.str().c_str());
+            throw Exception("Corrupted binary config.");
         }
         
-        return getProcessor(context, src, dst);
-    }
-    
-    
-    ConstProcessorRcPtr Config::getProcessor(const ConstTransformRcPtr& transform) const
-    {
-        return getProcessor(transform, TRANSFORM_DIR_FORWARD);
-    }
-    
-    
-    ConstProcessorRcPtr Config::getProcessor(const ConstTransformRcPtr& transform,
-                                             TransformDirection direction) const
-    {
-        ConstContextRcPtr context = getCurrentContext();
-        return getProcessor(context, transform, direction);
-    }
-    
-    ConstProcessorRcPtr Config::getProcessor(const ConstContextRcPtr & context,
-                                             const ConstTransformRcPtr& transform,
-                                             TransformDirection direction) const
-    {
-        ProcessorRcPtr processor = Processor::Create();
-        processor->getImpl()->setTransform(*this, context, transform, direction);
-        processor->getImpl()->computeMetadata();
-        return processor;
-    }
-    
-    std::ostream& operator<< (std::ostream& os, const Config& config)
-    {
-        config.serialize(os);
-        return os;
-    }
-    
-    ///////////////////////////////////////////////////////////////////////////
-    //  CacheID
-    
-    const char * Config::getCacheID() const
-    {
-        return getCacheID(getCurrentContext());
+        impl->sourceFile_ = sourceFile;
+        impl->sourceFileHash_ = sourceFileHash;
+        
+        return config;
     }
     
-    const char * Config::getCacheID(const ConstContextRcPtr & context) const
+    ConstConfigRcPtr Config::Impl::LoadFromBinaryCache(const std::string & filepath,
+                                                       const std::string & fileHash)
     {
-        AutoMutex lock(getImpl()->cacheidMutex_);
-        
-        // A null context will use the empty cacheid
-        std::string contextcacheid = "";
-        if(context) contextcacheid = context->getCacheID();
-        
-        StringMap::const_iterator cacheiditer = getImpl()->cacheids_.find(contextcacheid);
-        if(cacheiditer != getImpl()->cacheids_.end())
+        const std::string directory = GetBinaryCacheDirectory();
+        if(directory.empty() || fileHash.empty())
         {
-            return cacheiditer->second.c_str();
+            return ConstConfigRcPtr();
         }
         
-        // Include the hash of the yaml config serialization
-        if(getImpl()->cacheidnocontext_.empty())
-        {
-            std::stringstream cacheid;
-            serialize(cacheid);
-            std::string fullstr = cacheid.str();
-            getImpl()->cacheidnocontext_ = CacheIDHash(fullstr.c_str(), (int)fullstr.size());
-        }
+        const std::string filename = GetBinaryCacheFilename(directory, filepath, fileHash);
         
-        // Also include all file references, using the context (if specified)
-        std::string fileReferencesFashHash = "";
-        if(context)
+        try
         {
-            std::ostringstream filehash;
+            // Most of the time, there is no entry.
+            std::ifstream probe(filename.c_str());
+            if(!probe.good())
+            {
+                return ConstConfigRcPtr();
+            }
+            probe.close();
             
-            ConstTransformVec allTransforms;
-            getImpl()->getAllIntenalTransforms(allTransforms);
+            Platform::MappedFile file(filename);
+            ConfigRcPtr config = ReadBinary(file.data(), file.size());
             
-            std::set<std::string> files;
-            for(unsigned int i=0; i<allTransforms.size(); ++i)
+            // Protect against hash collisions.
+            if(config->getImpl()->sourceFile_!=filepath
+               || config->getImpl()->sourceFileHash_!=fileHash)
             {
-                GetFileReferences(files, allTransforms[i]);
+                throw Exception("Mismatching binary cache.");
             }
             
-            for(std::set<std::string>::iterator iter = files.begin();
-                iter != files.end(); ++iter)
+            if(IsDebugLoggingEnabled())
             {
-                if(iter->empty()) continue;
-                filehash << *iter << "=";
-                
-                try
-                {
-                    std::string resolvedLocation = context->resolveFileLocation(iter->c_str());
-                    filehash << GetFastFileHash(resolvedLocation) << " ";
-                }
-                catch(...)
-                {
-                    filehash << "? ";
-                    continue;
-                }
+                std::ostringstream os;
+                os << "Loaded the config " << filepath << " from the binary cache " << filename;
+                LogDebug(os.str());
             }
             
-            std::string fullstr = filehash.str();
-            fileReferencesFashHash = CacheIDHash(fullstr.c_str(), (int)fullstr.size());
+            return config;
+        }
+        catch(std::exception & e)
+        {
+            // Fall back to parsing the config, which then replaces the faulty entry.
+            std::ostringstream os;
+            os << "Ignoring the binary cache " << filename << " of " << filepath << ": ";
+            os << e.what();
+            LogDebug(os.str());
         }
         
-        getImpl()->cacheids_[contextcacheid] = getImpl()->cacheidnocontext_ + ":" + fileReferencesFashHash;
-        return getImpl()->cacheids_[contextcacheid].c_str();
+        return ConstConfigRcPtr();
     }
     
-    
-    ///////////////////////////////////////////////////////////////////////////
-    //  Serialization
-    
-    void Config::serialize(std::ostream& os) const
+    void Config::Impl::SaveToBinaryCache(const ConstConfigRcPtr & config)
     {
+        const std::string directory = GetBinaryCacheDirectory();
+        const std::string & filepath = config->getImpl()->sourceFile_;
+        const std::string & fileHash = config->getImpl()->sourceFileHash_;
+        if(directory.empty() || fileHash.empty())
+        {
+            return;
+        }
+        
+        const std::string filename = GetBinaryCacheFilename(directory, filepath, fileHash);
+        
         try
         {
-            getImpl()->io_.write(os, this);
+            std::ostringstream os;
+            config->serializeBinary(os);
+            if(!WriteBinaryCacheFile(filename, os.str()))
+            {
+                throw Exception("The file could not be written.");
+            }
         }
-        catch( const std::exception & e)
+        catch(std::exception & e)
         {
-            std::ostringstream error;
-            error << "Error building YAML: " << e.what();
-            throw Exception(error.str().c_str());
+            std::ostringstream os;
+            os << "Could not write the binary cache " << filename << " of " << filepath << ": ";
+            os << e.what();
+            LogDebug(os.str());
         }
     }
     
@@ -1573,8 +2601,161 @@ OCIO_NAMESPACE_ENTER
     {
         cacheids_.clear();
         cacheidnocontext_ = "";
+        fileReferences_.clear();
         sanity_ = SANITY_UNKNOWN;
         sanitytext_ = "";
+
+        sourceFile_.clear();
+        sourceFileHash_.clear();
+
+        clearProcessorCache();
+    }
+
+    std::string Config::Impl::getProcessorCacheKey(const ConstContextRcPtr & context,
+                                                   const std::string & description) const
+    {
+        std::string key = context ? context->getCacheID() : "";
+        key += ":";
+        key += CacheIDHash(description.c_str(), (int)description.size());
+        return key;
+    }
+
+    ConstProcessorRcPtr Config::Impl::getCachedProcessor(const std::string & key,
+                                                         ProcessorCacheGeneration & generation) const
+    {
+        ConstProcessorRcPtr processor;
+        unsigned long long fileVersion = 0;
+        {
+            AutoMutex lock(processorCacheMutex_);
+
+            syncProcessorCacheGeneration();
+            generation.config = processorCacheGeneration_;
+            generation.files = GetFileVersionClock();
+
+            if(!processorCacheEnabled_ || key.empty())
+            {
+                GetCacheCounters(CACHE_PROCESSOR).addMiss();
+                return ConstProcessorRcPtr();
+            }
+
+            ProcessorCacheMap::iterator entry = processorCacheMap_.find(key);
+            if(entry==processorCacheMap_.end())
+            {
+                ++processorCacheMisses_;
+                GetCacheCounters(CACHE_PROCESSOR).addMiss();
+                return ConstProcessorRcPtr();
+            }
+            processor = entry->second->processor;
+            fileVersion = entry->second->fileVersion;
+        }
+
+        // Checking the files may access the disk so the lock is not held.
+        const bool stale = HasStaleFiles(processor, fileVersion);
+
+        AutoMutex lock(processorCacheMutex_);
+
+        ProcessorCacheMap::iterator entry = processorCacheMap_.find(key);
+        if(stale)
+        {
+            if(entry!=processorCacheMap_.end() && entry->second->processor==processor)
+            {
+                GetCacheCounters(CACHE_PROCESSOR).removeEntries(1, GetProcessorCacheEntrySize(key));
+                processorCacheList_.erase(entry->second);
+                processorCacheMap_.erase(entry);
+            }
+
+            // The new processor is built from the new versions of the files.
+            generation.files = GetFileVersionClock();
+
+            ++processorCacheMisses_;
+            GetCacheCounters(CACHE_PROCESSOR).addMiss();
+            return ConstProcessorRcPtr();
+        }
+
+        ++processorCacheHits_;
+        GetCacheCounters(CACHE_PROCESSOR).addHit();
+        if(entry!=processorCacheMap_.end())
+        {
+            processorCacheList_.splice(processorCacheList_.begin(), processorCacheList_, entry->second);
+        }
+        return processor;
+    }
+
+    void Config::Impl::addCachedProcessor(const std::string & key,
+                                          const ProcessorCacheGeneration & generation,
+                                          const ConstProcessorRcPtr & processor) const
+    {
+        // Each processor owns its dynamic properties. Whether a processor with deferred
+        // files is dynamic is unknown until they are loaded, so it is not cached either.
+        if(key.empty() || processor->getImpl()->hasLazyFiles()
+           || processor->getImpl()->isDynamic())
+        {
+            return;
+        }
+
+        // A file modified while building the processor may have been read before the
+        // modification was detected.
+        ConstProcessorMetadataRcPtr metadata = processor->getProcessorMetadata();
+        for(int i=0; i<metadata->getNumFiles(); ++i)
+        {
+            if(IsFileNewerThan(metadata->getFile(i), generation.files)) return;
+        }
+
+        AutoMutex lock(processorCacheMutex_);
+
+        if(!processorCacheEnabled_ || generation.config!=processorCacheGeneration_
+           || processorCacheMap_.find(key)!=processorCacheMap_.end())
+        {
+            return;
+        }
+
+        processorCacheList_.push_front(ProcessorCacheEntry{ key, processor, generation.files });
+        processorCacheMap_[key] = processorCacheList_.begin();
+        GetCacheCounters(CACHE_PROCESSOR).addEntries(1, GetProcessorCacheEntrySize(key));
+
+        if(processorCacheList_.size()>MAX_PROCESSOR_CACHE_SIZE)
+        {
+            const std::string & oldestKey = processorCacheList_.back().key;
+            GetCacheCounters(CACHE_PROCESSOR).removeEntries(1, GetProcessorCacheEntrySize(oldestKey));
+            GetCacheCounters(CACHE_PROCESSOR).addEvictions(1);
+            processorCacheMap_.erase(oldestKey);
+            processorCacheList_.pop_back();
+        }
+    }
+
+    void Config::Impl::clearProcessorCache()
+    {
+        AutoMutex lock(processorCacheMutex_);
+        removeCachedProcessors();
+        ++processorCacheGeneration_;
+    }
+
+    void Config::Impl::syncProcessorCacheGeneration() const
+    {
+        if(processorCacheGlobalGeneration_!=g_processorCachesGeneration)
+        {
+            removeCachedProcessors();
+            processorCacheGlobalGeneration_ = g_processorCachesGeneration;
+            ++processorCacheGeneration_;
+        }
+    }
+
+    void Config::Impl::removeCachedProcessors() const
+    {
+        size_t memorySize = 0;
+        for(const auto & entry : processorCacheList_)
+        {
+            memorySize += GetProcessorCacheEntrySize(entry.key);
+        }
+        GetCacheCounters(CACHE_PROCESSOR).removeEntries(processorCacheList_.size(), memorySize);
+
+        processorCacheList_.clear();
+        processorCacheMap_.clear();
+    }
+
+    void ClearConfigProcessorCaches()
+    {
+        ++g_processorCachesGeneration;
     }
     
     void Config::Impl::getAllIntenalTransforms(ConstTransformVec & transformVec) const
@@ -4065,5 +5246,426 @@ OCIO_ADD_TEST(Config, matrix_serialization)
     OCIO_CHECK_EQUAL(ss.str(), str);
 }
 
+OCIO_ADD_TEST(Config, processor_cache)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create()->createEditableCopy();
+
+    OCIO::ColorSpaceRcPtr cs = OCIO::ColorSpace::Create();
+    cs->setName("raw");
+    config->addColorSpace(cs);
+
+    cs = OCIO::ColorSpace::Create();
+    cs->setName("lin");
+    OCIO::MatrixTransformRcPtr mat = OCIO::MatrixTransform::Create();
+    const double offset[4] = { 0.1, 0.2, 0.3, 0.0 };
+    mat->setOffset(offset);
+    cs->setTransform(mat, OCIO::COLORSPACE_DIR_TO_REFERENCE);
+    config->addColorSpace(cs);
+
+    OCIO_CHECK_ASSERT(config->isProcessorCacheEnabled());
+    OCIO_CHECK_EQUAL(config->getProcessorCacheHitRate(), 0.0);
+
+    // Identical requests share the processor.
+
+    OCIO::ConstProcessorRcPtr proc1 = config->getProcessor("lin", "raw");
+    OCIO::ConstProcessorRcPtr proc2 = config->getProcessor("lin", "raw");
+    OCIO_CHECK_EQUAL(proc1.get(), proc2.get());
+    OCIO_CHECK_EQUAL(config->getProcessorCacheHitRate(), 0.5);
+
+    proc2 = config->getProcessor("raw", "lin");
+    OCIO_CHECK_NE(proc1.get(), proc2.get());
+
+    // The context is part of the key.
+
+    OCIO::ContextRcPtr context = config->getCurrentContext()->createEditableCopy();
+    context->setStringVar("SHOT", "0010");
+    proc2 = config->getProcessor(context, "lin", "raw");
+    OCIO_CHECK_NE(proc1.get(), proc2.get());
+    OCIO_CHECK_EQUAL(config->getProcessor(context, "lin", "raw").get(), proc2.get());
+
+    // Any config change empties the cache.
+
+    config->setDescription("Modified");
+    proc2 = config->getProcessor("lin", "raw");
+    OCIO_CHECK_NE(proc1.get(), proc2.get());
+
+    OCIO::ClearAllCaches();
+    proc1 = config->getProcessor("lin", "raw");
+    OCIO_CHECK_NE(proc1.get(), proc2.get());
+
+    // Transforms are identified by their values.
+
+    OCIO::MatrixTransformRcPtr mat2 = OCIO::MatrixTransform::Create();
+    mat2->setOffset(offset);
+    proc1 = config->getProcessor(mat);
+    OCIO_CHECK_EQUAL(config->getProcessor(mat2).get(), proc1.get());
+    OCIO_CHECK_NE(config->getProcessor(mat2, OCIO::TRANSFORM_DIR_INVERSE).get(), proc1.get());
+
+    const double offset2[4] = { 0.1, 0.2, 0.30000001, 0.0 };
+    mat2->setOffset(offset2);
+    OCIO_CHECK_NE(config->getProcessor(mat2).get(), proc1.get());
+
+    OCIO::GroupTransformRcPtr group1 = OCIO::GroupTransform::Create();
+    group1->push_back(mat);
+    OCIO::GroupTransformRcPtr group2 = OCIO::GroupTransform::Create();
+    group2->push_back(mat);
+    proc1 = config->getProcessor(group1);
+    OCIO_CHECK_EQUAL(config->getProcessor(group2).get(), proc1.get());
+    group2->push_back(mat);
+    OCIO_CHECK_NE(config->getProcessor(group2).get(), proc1.get());
+
+    // Exponents are compared at the double precision, even if they round to the same float.
+
+    OCIO::ExponentTransformRcPtr exp1 = OCIO::ExponentTransform::Create();
+    const double value1[4] = { 2.2, 2.2, 2.2, 1.0 };
+    exp1->setValue(value1);
+    OCIO::ExponentTransformRcPtr exp2 = OCIO::ExponentTransform::Create();
+    const double value2[4] = { 2.2, 2.2, 2.2000000000001, 1.0 };
+    exp2->setValue(value2);
+    OCIO_CHECK_EQUAL((float)value1[2], (float)value2[2]);
+
+    proc1 = config->getProcessor(exp1);
+    OCIO_CHECK_NE(config->getProcessor(exp2).get(), proc1.get());
+    exp2->setValue(value1);
+    OCIO_CHECK_EQUAL(config->getProcessor(exp2).get(), proc1.get());
+
+    // Processors with dynamic properties are not shared.
+
+    OCIO::ExposureContrastTransformRcPtr ec = OCIO::ExposureContrastTransform::Create();
+    ec->setExposure(0.5);
+    ec->makeExposureDynamic();
+    proc1 = config->getProcessor(ec);
+    OCIO_CHECK_NE(config->getProcessor(ec).get(), proc1.get());
+
+    // Disabling the cache.
+
+    config->setProcessorCacheEnabled(false);
+    OCIO_CHECK_ASSERT(!config->isProcessorCacheEnabled());
+    proc1 = config->getProcessor("lin", "raw");
+    OCIO_CHECK_NE(config->getProcessor("lin", "raw").get(), proc1.get());
+}
+
+OCIO_ADD_TEST(Config, cache_id)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create()->createEditableCopy();
+
+    OCIO::ColorSpaceRcPtr raw = OCIO::ColorSpace::Create();
+    raw->setName("raw");
+    config->addColorSpace(raw);
+
+    OCIO::ColorSpaceRcPtr lin = OCIO::ColorSpace::Create();
+    lin->setName("lin");
+    OCIO::MatrixTransformRcPtr mat = OCIO::MatrixTransform::Create();
+    const double offset[4] = { 0.1, 0.2, 0.3, 0.0 };
+    mat->setOffset(offset);
+    lin->setTransform(mat, OCIO::COLORSPACE_DIR_TO_REFERENCE);
+    config->addColorSpace(lin);
+
+    const OCIO::ConstContextRcPtr noContext;
+    const std::string cacheID = config->getCacheID(noContext);
+    OCIO_CHECK_EQUAL(std::string(config->getCacheID(noContext)), cacheID);
+
+    // A config with the same content has the same cacheID.
+
+    OCIO::ConfigRcPtr other = OCIO::Config::Create()->createEditableCopy();
+    other->addColorSpace(raw);
+    other->addColorSpace(lin);
+    OCIO_CHECK_EQUAL(std::string(other->getCacheID(noContext)), cacheID);
+
+    // Each edited element changes the cacheID.
+
+    OCIO::LookRcPtr look = OCIO::Look::Create();
+    look->setName("look");
+    look->setProcessSpace("lin");
+    look->setTransform(mat);
+    config->addLook(look);
+    const std::string lookCacheID = config->getCacheID(noContext);
+    OCIO_CHECK_NE(lookCacheID, cacheID);
+
+    look->setProcessSpace("raw");
+    config->addLook(look);
+    OCIO_CHECK_NE(std::string(config->getCacheID(noContext)), lookCacheID);
+
+    config->clearLooks();
+    OCIO_CHECK_EQUAL(std::string(config->getCacheID(noContext)), cacheID);
+
+    OCIO::MatrixTransformRcPtr mat2 = OCIO::MatrixTransform::Create();
+    const double offset2[4] = { 0.1, 0.2, 0.4, 0.0 };
+    mat2->setOffset(offset2);
+    lin->setTransform(mat2, OCIO::COLORSPACE_DIR_TO_REFERENCE);
+    config->addColorSpace(lin);
+    OCIO_CHECK_NE(std::string(config->getCacheID(noContext)), cacheID);
+
+    lin->setTransform(mat, OCIO::COLORSPACE_DIR_TO_REFERENCE);
+    config->addColorSpace(lin);
+    OCIO_CHECK_EQUAL(std::string(config->getCacheID(noContext)), cacheID);
+
+    config->setDescription("Modified");
+    OCIO_CHECK_NE(std::string(config->getCacheID(noContext)), cacheID);
+
+    // The file references are part of the cacheID with a context.
+
+    OCIO::FileTransformRcPtr file = OCIO::FileTransform::Create();
+    file->setSrc("missing.spi1d");
+    lin->setTransform(file, OCIO::COLORSPACE_DIR_FROM_REFERENCE);
+    other->addColorSpace(lin);
+
+    OCIO::ContextRcPtr context = OCIO::Context::Create();
+    OCIO_CHECK_NE(std::string(other->getCacheID(context)),
+                  std::string(other->getCacheID(noContext)));
+}
+
+namespace
+{
+
+const std::string BINARY_PROFILE =
+    "ocio_profile_version: 2\n"
+    "\n"
+    "environment:\n"
+    "  SHOT: 001a\n"
+    "search_path:\n"
+    "  - luts\n"
+    "  - shots/$SHOT\n"
+    "strictparsing: false\n"
+    "luma: [0.2126, 0.7152, 0.0722]\n"
+    "description: A binary config\n"
+    "\n"
+    "roles:\n"
+    "  default: raw\n"
+    "  scene_linear: lin\n"
+    "\n"
+    "displays:\n"
+    "  sRGB:\n"
+    "    - !<View> {name: Raw, colorspace: raw}\n"
+    "    - !<View> {name: Film, colorspace: log, looks: +grade}\n"
+    "  P3:\n"
+    "    - !<View> {name: Raw, colorspace: raw}\n"
+    "\n"
+    "active_displays: [sRGB, P3]\n"
+    "active_views: [Film]\n"
+    "\n"
+    "looks:\n"
+    "  - !<Look>\n"
+    "    name: grade\n"
+    "    process_space: log\n"
+    "    transform: !<CDLTransform> {slope: [1.1, 1, 0.9], offset: [0.01, 0, 0],"
+               " power: [1, 1.2, 1], sat: 0.9}\n"
+    "    inverse_transform: !<ExponentTransform> {value: [2.2, 2.2, 2.2, 1]}\n"
+    "\n"
+    "colorspaces:\n"
+    "  - !<ColorSpace>\n"
+    "    name: raw\n"
+    "    family: \"\"\n"
+    "    equalitygroup: \"\"\n"
+    "    bitdepth: unknown\n"
+    "    isdata: true\n"
+    "    allocation: uniform\n"
+    "\n"
+    "  - !<ColorSpace>\n"
+    "    name: lin\n"
+    "    family: scene\n"
+    "    equalitygroup: \"\"\n"
+    "    bitdepth: 32f\n"
+    "    description: |\n"
+    "      Scene linear\n"
+    "    isdata: false\n"
+    "    categories: [working-space, rendering]\n"
+    "    allocation: lg2\n"
+    "    allocationvars: [-8, 5, 0.00390625]\n"
+    "    to_reference: !<GroupTransform>\n"
+    "      children:\n"
+    "        - !<MatrixTransform> {matrix: [2, 0, 0, 0, 0, 2, 0, 0, 0, 0, 2, 0, 0, 0, 0, 1],"
+                   " offset: [0.1, 0.2, 0.3, 0]}\n"
+    "        - !<RangeTransform> {minInValue: -0.0109, maxInValue: 1.0505, minOutValue: 0,"
+                   " maxOutValue: 1, style: noClamp}\n"
+    "        - !<ExposureContrastTransform> {style: video, exposure: {value: 1.5,"
+                   " dynamic: true}, contrast: 0.5, gamma: 1.1, pivot: 0.18}\n"
+    "        - !<FixedFunctionTransform> {style: ACES_RedMod03, direction: inverse}\n"
+    "        - !<AllocationTransform> {allocation: lg2, vars: [-10, 6]}\n"
+    "\n"
+    "  - !<ColorSpace>\n"
+    "    name: log\n"
+    "    family: \"\"\n"
+    "    equalitygroup: \"\"\n"
+    "    bitdepth: 10ui\n"
+    "    isdata: false\n"
+    "    allocation: uniform\n"
+    "    from_reference: !<GroupTransform>\n"
+    "      children:\n"
+    "        - !<LogAffineTransform> {base: 10, logSideSlope: [1.3, 1.4, 1.5],"
+                   " logSideOffset: [0, 0, 0.1]}\n"
+    "        - !<ExponentWithLinearTransform> {gamma: [2.4, 2.4, 2.4, 1],"
+                   " offset: [0.055, 0.055, 0.055, 0], direction: inverse}\n"
+    "        - !<LogTransform> {base: 2}\n"
+    "        - !<FileTransform> {src: $SHOT.spi1d, interpolation: linear}\n"
+    "    to_reference: !<GroupTransform>\n"
+    "      children:\n"
+    "        - !<ColorSpaceTransform> {src: lin, dst: raw}\n"
+    "        - !<LookTransform> {src: lin, dst: log, looks: grade}\n";
+
+std::string SerializeToString(const OCIO::ConstConfigRcPtr & config)
+{
+    std::ostringstream os;
+    config->serialize(os);
+    return os.str();
+}
+
+std::string SerializeBinaryToString(const OCIO::ConstConfigRcPtr & config)
+{
+    std::ostringstream os;
+    config->serializeBinary(os);
+    return os.str();
+}
+
+OCIO::ConstConfigRcPtr CreateFromBinaryString(const std::string & binary)
+{
+    std::istringstream is(binary);
+    return OCIO::Config::CreateFromBinary(is);
+}
+
+void WriteConfigFile(const std::string & filename, const std::string & content)
+{
+    std::ofstream stream(filename.c_str(), std::ios_base::out | std::ios_base::binary);
+    stream << content;
+}
+
+}
+
+OCIO_ADD_TEST(Config, binary_serialization)
+{
+    std::istringstream is(BINARY_PROFILE);
+    OCIO::ConstConfigRcPtr config;
+    OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
+    OCIO_CHECK_NO_THROW(config->sanityCheck());
+
+    std::string binary;
+    OCIO_CHECK_NO_THROW(binary = SerializeBinaryToString(config));
+
+    OCIO::ConstConfigRcPtr binaryConfig;
+    OCIO_CHECK_NO_THROW(binaryConfig = CreateFromBinaryString(binary));
+    OCIO_REQUIRE_ASSERT(binaryConfig);
+
+    OCIO_CHECK_EQUAL(SerializeToString(binaryConfig), SerializeToString(config));
+    OCIO_CHECK_EQUAL(std::string(binaryConfig->getCacheID()), std::string(config->getCacheID()));
+    const OCIO::ConstContextRcPtr noContext;
+    OCIO_CHECK_EQUAL(std::string(binaryConfig->getCacheID(noContext)),
+                     std::string(config->getCacheID(noContext)));
+    OCIO_CHECK_NO_THROW(binaryConfig->sanityCheck());
+    OCIO_CHECK_EQUAL(std::string(binaryConfig->getCurrentContext()->getSearchPath()),
+                     std::string(config->getCurrentContext()->getSearchPath()));
+    OCIO_CHECK_EQUAL(std::string(binaryConfig->getCurrentContext()->resolveStringVar("$SHOT")),
+                     std::string("001a"));
+
+    // The same content is serialized the same way.
+    OCIO_CHECK_EQUAL(SerializeBinaryToString(binaryConfig), binary);
+
+    // An edit of the restored config updates its cacheID.
+    OCIO::ConfigRcPtr editedConfig = binaryConfig->createEditableCopy();
+    editedConfig->setDescription("Edited");
+    OCIO_CHECK_NE(std::string(editedConfig->getCacheID(noContext)),
+                  std::string(config->getCacheID(noContext)));
+
+    // The result of the validation is restored.
+    OCIO::ConfigRcPtr invalidConfig = config->createEditableCopy();
+    invalidConfig->setRole("reference", "missing");
+    OCIO_CHECK_THROW_WHAT(invalidConfig->sanityCheck(), OCIO::Exception,
+                          "refers to a colorspace, 'missing', which is not defined");
+    OCIO_CHECK_NO_THROW(binaryConfig = CreateFromBinaryString(
+                            SerializeBinaryToString(invalidConfig)));
+    OCIO_CHECK_THROW_WHAT(binaryConfig->sanityCheck(), OCIO::Exception,
+                          "refers to a colorspace, 'missing', which is not defined");
+
+    // Corrupted binary configs.
+    OCIO_CHECK_THROW_WHAT(CreateFromBinaryString(""), OCIO::Exception, "Corrupted binary cache");
+    OCIO_CHECK_THROW_WHAT(CreateFromBinaryString(BINARY_PROFILE), OCIO::Exception,
+                          "Corrupted binary cache");
+    OCIO_CHECK_THROW_WHAT(CreateFromBinaryString(binary.substr(0, binary.size() / 2)),
+                          OCIO::Exception, "Corrupted binary cache");
+
+    std::string modified = binary;
+    modified[modified.size() / 2] = (char)(modified[modified.size() / 2] ^ 0x5a);
+    OCIO_CHECK_THROW_WHAT(CreateFromBinaryString(modified), OCIO::Exception,
+                          "Corrupted binary config");
+}
+
+OCIO_ADD_TEST(Config, binary_serialization_source_file)
+{
+    std::string filename;
+    OCIO::Platform::CreateTempFilename(filename, ".ocio");
+    WriteConfigFile(filename, BINARY_PROFILE);
+
+    const std::string previousDirectory = OCIO::GetFileCacheDirectory();
+    OCIO::SetFileCacheDirectory("");
+
+    OCIO::ConstConfigRcPtr config;
+    OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromFile(filename.c_str()));
+    const std::string binary = SerializeBinaryToString(config);
+    const std::string edited = SerializeBinaryToString(config->createEditableCopy());
+    OCIO::ConfigRcPtr editedConfig = config->createEditableCopy();
+    editedConfig->setDescription("Edited");
+    const std::string unrelated = SerializeBinaryToString(editedConfig);
+
+    OCIO_CHECK_NO_THROW(CreateFromBinaryString(binary));
+    OCIO_CHECK_NO_THROW(CreateFromBinaryString(edited));
+
+    // The binary config of a modified config file is out of date.
+    WriteConfigFile(filename, BINARY_PROFILE + "\n");
+    OCIO_CHECK_THROW_WHAT(CreateFromBinaryString(binary), OCIO::Exception,
+                          "The binary config is out of date");
+
+    // An edited config does not depend on the config file anymore.
+    OCIO_CHECK_NO_THROW(CreateFromBinaryString(unrelated));
+
+    OCIO::SetFileCacheDirectory(previousDirectory.c_str());
+    std::remove(filename.c_str());
+}
+
+OCIO_ADD_TEST(Config, binary_cache)
+{
+    std::string filename;
+    OCIO::Platform::CreateTempFilename(filename, ".ocio");
+    WriteConfigFile(filename, BINARY_PROFILE);
+
+    const std::string directory = pystring::os::path::dirname(filename);
+    const std::string filepath = OCIO::AbsPath(filename);
+    const std::string entry
+        = OCIO::GetBinaryCacheFilename(directory, filepath, OCIO::ComputeFastFileHash(filepath));
+    std::remove(entry.c_str());
+
+    const std::string previousDirectory = OCIO::GetFileCacheDirectory();
+    OCIO::SetFileCacheDirectory(directory.c_str());
+
+    // The first load populates the persistent cache.
+    OCIO::ConstConfigRcPtr config;
+    OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromFile(filename.c_str()));
+    OCIO_CHECK_ASSERT(std::ifstream(entry.c_str()).good());
+    const std::string expected = SerializeToString(config);
+    const std::string cacheID = config->getCacheID();
+
+    OCIO::ConstConfigRcPtr cachedConfig;
+    OCIO_CHECK_NO_THROW(cachedConfig = OCIO::Config::CreateFromFile(filename.c_str()));
+    OCIO_CHECK_EQUAL(SerializeToString(cachedConfig), expected);
+    OCIO_CHECK_EQUAL(std::string(cachedConfig->getCacheID()), cacheID);
+
+    // A corrupted entry is ignored, and replaced.
+    WriteConfigFile(entry, "corrupted");
+    OCIO_CHECK_NO_THROW(cachedConfig = OCIO::Config::CreateFromFile(filename.c_str()));
+    OCIO_CHECK_EQUAL(SerializeToString(cachedConfig), expected);
+    OCIO_CHECK_NO_THROW(CreateFromBinaryString(
+                            std::string(OCIO::Platform::MappedFile(entry).data(),
+                                        OCIO::Platform::MappedFile(entry).size())));
+
+    // A modified config file is parsed again.
+    WriteConfigFile(filename, pystring::replace(BINARY_PROFILE, "A binary config", "Modified"));
+    OCIO_CHECK_NO_THROW(cachedConfig = OCIO::Config::CreateFromFile(filename.c_str()));
+    OCIO_CHECK_EQUAL(std::string(cachedConfig->getDescription()), std::string("Modified"));
+
+    OCIO::SetFileCacheDirectory(previousDirectory.c_str());
+    std::remove(entry.c_str());
+    std::remove(OCIO::GetBinaryCacheFilename(directory, filepath,
+                                             OCIO::ComputeFastFileHash(filepath)).c_str());
+    std::remove(filename.c_str());
+}
+
 #endif // OCIO_UNIT_TEST
 
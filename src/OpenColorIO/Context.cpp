@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <chrono>
 #include <cstring>
 #include <iostream>
 #include <map>
@@ -9,6 +10,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "CacheStatistics.h"
 #include "HashUtils.h"
 #include "Mutex.h"
 #include "PathUtils.h"
@@ -39,11 +41,23 @@ namespace
         EnvMap envMap_;
         
         mutable std::string cacheID_;
-        mutable StringMap resultsCache_;
+        mutable StringCache resultsCache_;
         mutable Mutex resultsCacheMutex_;
+
+        // The file references which could not be located are not searched again until
+        // their negative result expires (refer to SetMissingFileCacheTTL()).
+        struct MissingFile
+        {
+            std::string error;
+            bool missingFileException;
+            std::chrono::steady_clock::time_point checkTime;
+            unsigned pathCachesGeneration;
+        };
+        mutable std::map<std::string, MissingFile> missingFiles_;
         
         Impl() :
-            envmode_(ENV_ENVIRONMENT_LOAD_PREDEFINED)
+            envmode_(ENV_ENVIRONMENT_LOAD_PREDEFINED),
+            resultsCache_(CACHE_CONTEXT_RESULTS)
         {
         }
         
@@ -65,10 +79,54 @@ namespace
                 envMap_ = rhs.envMap_;
                 
                 resultsCache_ = rhs.resultsCache_;
+                missingFiles_ = rhs.missingFiles_;
                 cacheID_ = rhs.cacheID_;
             }
             return *this;
         }
+
+        void clearResults()
+        {
+            resultsCache_.clear();
+            missingFiles_.clear();
+        }
+
+        // Throw the error of the file reference if it is known to be missing.
+        void checkMissingFile(const std::string & filename) const
+        {
+            auto missing = missingFiles_.find(filename);
+            if(missing==missingFiles_.end())
+            {
+                return;
+            }
+
+            if(missing->second.pathCachesGeneration!=GetPathCachesGeneration()
+               || IsMissingFileResultExpired(missing->second.checkTime))
+            {
+                missingFiles_.erase(missing);
+                return;
+            }
+
+            if(missing->second.missingFileException)
+            {
+                throw ExceptionMissingFile(missing->second.error.c_str());
+            }
+            throw Exception(missing->second.error.c_str());
+        }
+
+        void addMissingFile(const std::string & filename,
+                            const std::string & error,
+                            bool missingFileException) const
+        {
+            if(GetMissingFileCacheTTL()!=0.0)
+            {
+                MissingFile & missing = missingFiles_[filename];
+                missing.error = error;
+                missing.missingFileException = missingFileException;
+                missing.checkTime = std::chrono::steady_clock::now();
+                missing.pathCachesGeneration = GetPathCachesGeneration();
+            }
+        }
     };
     
     
@@ -145,7 +203,7 @@ namespace
         pystring::split(path, getImpl()->searchPaths_, ":");
         
         getImpl()->searchPath_ = path;
-        getImpl()->resultsCache_.clear();
+        getImpl()->clearResults();
         getImpl()->cacheID_ = "";
     }
     
@@ -171,7 +229,7 @@ namespace
 
         getImpl()->searchPath_ = "";
         getImpl()->searchPaths_.clear();
-        getImpl()->resultsCache_.clear();
+        getImpl()->clearResults();
         getImpl()->cacheID_ = "";
     }
 
@@ -182,7 +240,7 @@ namespace
         if (strlen(path) != 0)
         {
             getImpl()->searchPaths_.emplace_back(path);
-            getImpl()->resultsCache_.clear();
+            getImpl()->clearResults();
             getImpl()->cacheID_ = "";
 
             if (getImpl()->searchPath_.size() != 0)
@@ -198,7 +256,7 @@ namespace
         AutoMutex lock(getImpl()->resultsCacheMutex_);
         
         getImpl()->workingDir_ = dirname;
-        getImpl()->resultsCache_.clear();
+        getImpl()->clearResults();
         getImpl()->cacheID_ = "";
     }
     
@@ -213,7 +271,7 @@ namespace
         
         getImpl()->envmode_ = mode;
         
-        getImpl()->resultsCache_.clear();
+        getImpl()->clearResults();
         getImpl()->cacheID_ = "";
     }
     
@@ -228,7 +286,7 @@ namespace
         LoadEnvironment(getImpl()->envMap_, update);
         
         AutoMutex lock(getImpl()->resultsCacheMutex_);
-        getImpl()->resultsCache_.clear();
+        getImpl()->clearResults();
         getImpl()->cacheID_ = "";
     }
     
@@ -253,7 +311,7 @@ namespace
             }
         }
         
-        getImpl()->resultsCache_.clear();
+        getImpl()->clearResults();
         getImpl()->cacheID_ = "";
     }
     
@@ -300,16 +358,17 @@ namespace
             return "";
         }
         
-        StringMap::const_iterator iter = getImpl()->resultsCache_.find(val);
-        if(iter != getImpl()->resultsCache_.end())
+        const std::string * cached = getImpl()->resultsCache_.find(val);
+        if(cached)
         {
-            return iter->second.c_str();
+            return cached->c_str();
         }
         
+        CacheMissTimer missTimer(CACHE_CONTEXT_RESULTS);
+        
         std::string resolvedval = EnvExpand(val, getImpl()->envMap_);
         
-        getImpl()->resultsCache_[val] = resolvedval;
-        return getImpl()->resultsCache_[val].c_str();
+        return getImpl()->resultsCache_.insert(val, resolvedval).c_str();
     }
     
     
@@ -323,12 +382,16 @@ namespace
             return "";
         }
         
-        StringMap::const_iterator iter = getImpl()->resultsCache_.find(filename);
-        if(iter != getImpl()->resultsCache_.end())
+        const std::string * cached = getImpl()->resultsCache_.find(filename);
+        if(cached)
         {
-            return iter->second.c_str();
+            return cached->c_str();
         }
         
+        getImpl()->checkMissingFile(filename);
+        
+        CacheMissTimer missTimer(CACHE_CONTEXT_RESULTS);
+        
         // Attempt to load an absolute file reference
         {
         std::string expandedfullpath = EnvExpand(filename, getImpl()->envMap_);
@@ -336,12 +399,13 @@ namespace
         {
             if(FileExists(expandedfullpath))
             {
-                getImpl()->resultsCache_[filename] = pystring::os::path::normpath(expandedfullpath);
-                return getImpl()->resultsCache_[filename].c_str();
+                return getImpl()->resultsCache_.insert(
+                    filename, pystring::os::path::normpath(expandedfullpath)).c_str();
             }
             std::ostringstream errortext;
             errortext << "The specified absolute file reference ";
             errortext << "'" << expandedfullpath << "' could not be located. ";
+            getImpl()->addMissingFile(filename, errortext.str(), false);
             throw Exception(errortext.str().c_str());
         }
         }
@@ -368,13 +432,14 @@ namespace
             std::string expandedfullpath = EnvExpand(fullpath, getImpl()->envMap_);
             if(FileExists(expandedfullpath))
             {
-                getImpl()->resultsCache_[filename] = pystring::os::path::normpath(expandedfullpath);
-                return getImpl()->resultsCache_[filename].c_str();
+                return getImpl()->resultsCache_.insert(
+                    filename, pystring::os::path::normpath(expandedfullpath)).c_str();
             }
             if(i!=0) errortext << " : ";
             errortext << expandedfullpath;
         }
         
+        getImpl()->addMissingFile(filename, errortext.str(), true);
         throw ExceptionMissingFile(errortext.str().c_str());
     }
 
@@ -110,7 +110,8 @@ DynamicPropertyRcPtr GPUProcessor::Impl::getDynamicProperty(DynamicPropertyType
 
 void GPUProcessor::Impl::finalize(const OpRcPtrVec & rawOps,
                                   OptimizationFlags oFlags,
-                                  FinalizationFlags fFlags)
+                                  FinalizationFlags fFlags,
+                                  OptimizationTraceImpl * trace)
 {
     AutoMutex lock(m_mutex);
 
@@ -125,7 +126,7 @@ void GPUProcessor::Impl::finalize(const OpRcPtrVec & rawOps,
         op->setOutputBitDepth(BIT_DEPTH_F32);
     }
 
-    OptimizeOpVec(m_ops, oFlags);
+    OptimizeOpVec(m_ops, oFlags, trace);
     FinalizeOpVec(m_ops, fFlags);
     UnifyDynamicProperties(m_ops);
 
@@ -35,7 +35,8 @@ public:
     // Builder functions, Not exposed
         
     void finalize(const OpRcPtrVec & rawOps,
-                  OptimizationFlags oFlags, FinalizationFlags fFlags);
+                  OptimizationFlags oFlags, FinalizationFlags fFlags,
+                  OptimizationTraceImpl * trace = nullptr);
 
 private:
     OpRcPtrVec    m_ops;
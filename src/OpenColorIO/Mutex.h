@@ -6,7 +6,9 @@
 #define INCLUDED_OCIO_MUTEX_H
 
 
+#include <functional>
 #include <mutex> 
+#include <string>
 #include <assert.h>
 
 
@@ -57,6 +59,21 @@ OCIO_NAMESPACE_ENTER
 
     typedef AutoLock<std::mutex> AutoMutex;
 
+    /** Split a global cache in independent shards (each one with its own mutex) to
+        reduce the lock contention when many threads access the cache at once. */
+    template <class T, size_t N = 16>
+    class CacheShards
+    {
+    public:
+        T & get(const std::string & key) { return m_shards[std::hash<std::string>()(key) % N]; }
+
+        T & operator[](size_t index) { return m_shards[index]; }
+        size_t size() const { return N; }
+
+    private:
+        T m_shards[N];
+    };
+
 }
 OCIO_NAMESPACE_EXIT
 
@@ -0,0 +1,484 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <vector>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "OCIOBinary.h"
+
+
+OCIO_NAMESPACE_ENTER
+{
+    namespace
+    {
+        // The values are stored in the binary form, only append new types.
+        enum BinaryTransformType
+        {
+            BINARY_TRANSFORM_NONE = 0,
+            BINARY_TRANSFORM_ALLOCATION,
+            BINARY_TRANSFORM_CDL,
+            BINARY_TRANSFORM_COLORSPACE,
+            BINARY_TRANSFORM_EXPONENT,
+            BINARY_TRANSFORM_EXPONENT_WITH_LINEAR,
+            BINARY_TRANSFORM_EXPOSURE_CONTRAST,
+            BINARY_TRANSFORM_FILE,
+            BINARY_TRANSFORM_FIXED_FUNCTION,
+            BINARY_TRANSFORM_GROUP,
+            BINARY_TRANSFORM_LOG_AFFINE,
+            BINARY_TRANSFORM_LOG,
+            BINARY_TRANSFORM_LOOK,
+            BINARY_TRANSFORM_MATRIX,
+            BINARY_TRANSFORM_RANGE
+        };
+
+        inline std::string ToString(const char * str)
+        {
+            return str ? str : "";
+        }
+
+        int ReadCount(BinaryCacheReader & reader)
+        {
+            const int count = reader.readInt();
+            if(count < 0)
+            {
+                throw Exception("Corrupted binary cache.");
+            }
+            return count;
+        }
+
+        void WriteDoubles(BinaryCacheWriter & writer, const double * values, int size)
+        {
+            for(int i=0; i<size; ++i)
+            {
+                writer.writeDouble(values[i]);
+            }
+        }
+
+        void ReadDoubles(BinaryCacheReader & reader, double * values, int size)
+        {
+            for(int i=0; i<size; ++i)
+            {
+                values[i] = reader.readDouble();
+            }
+        }
+
+        void WriteDynamicProperty(BinaryCacheWriter & writer, bool dynamic, double value)
+        {
+            writer.writeBool(dynamic);
+            writer.writeDouble(value);
+        }
+
+        void WriteTransformContent(BinaryCacheWriter & writer,
+                                   const ConstTransformRcPtr & transform)
+        {
+            if(ConstAllocationTransformRcPtr t
+                = DynamicPtrCast<const AllocationTransform>(transform))
+            {
+                writer.writeInt(BINARY_TRANSFORM_ALLOCATION);
+                writer.writeInt(t->getAllocation());
+                std::vector<float> vars(t->getNumVars());
+                if(!vars.empty()) t->getVars(&vars[0]);
+                writer.writeFloats(vars);
+            }
+            else if(ConstCDLTransformRcPtr t = DynamicPtrCast<const CDLTransform>(transform))
+            {
+                writer.writeInt(BINARY_TRANSFORM_CDL);
+                double rgb[3];
+                t->getSlope(rgb);
+                WriteDoubles(writer, rgb, 3);
+                t->getOffset(rgb);
+                WriteDoubles(writer, rgb, 3);
+                t->getPower(rgb);
+                WriteDoubles(writer, rgb, 3);
+                writer.writeDouble(t->getSat());
+            }
+            else if(ConstColorSpaceTransformRcPtr t
+                = DynamicPtrCast<const ColorSpaceTransform>(transform))
+            {
+                writer.writeInt(BINARY_TRANSFORM_COLORSPACE);
+                writer.writeString(ToString(t->getSrc()));
+                writer.writeString(ToString(t->getDst()));
+            }
+            else if(ConstExponentTransformRcPtr t
+                = DynamicPtrCast<const ExponentTransform>(transform))
+            {
+                writer.writeInt(BINARY_TRANSFORM_EXPONENT);
+                double value[4];
+                t->getValue(value);
+                WriteDoubles(writer, value, 4);
+            }
+            else if(ConstExponentWithLinearTransformRcPtr t
+                = DynamicPtrCast<const ExponentWithLinearTransform>(transform))
+            {
+                writer.writeInt(BINARY_TRANSFORM_EXPONENT_WITH_LINEAR);
+                double values[4];
+                t->getGamma(values);
+                WriteDoubles(writer, values, 4);
+                t->getOffset(values);
+                WriteDoubles(writer, values, 4);
+            }
+            else if(ConstExposureContrastTransformRcPtr t
+                = DynamicPtrCast<const ExposureContrastTransform>(transform))
+            {
+                writer.writeInt(BINARY_TRANSFORM_EXPOSURE_CONTRAST);
+                writer.writeInt(t->getStyle());
+                WriteDynamicProperty(writer, t->isExposureDynamic(), t->getExposure());
+                WriteDynamicProperty(writer, t->isContrastDynamic(), t->getContrast());
+                WriteDynamicProperty(writer, t->isGammaDynamic(), t->getGamma());
+                writer.writeDouble(t->getPivot());
+            }
+            else if(ConstFileTransformRcPtr t = DynamicPtrCast<const FileTransform>(transform))
+            {
+                writer.writeInt(BINARY_TRANSFORM_FILE);
+                writer.writeString(ToString(t->getSrc()));
+                writer.writeString(ToString(t->getCCCId()));
+                writer.writeInt(t->getInterpolation());
+            }
+            else if(ConstFixedFunctionTransformRcPtr t
+                = DynamicPtrCast<const FixedFunctionTransform>(transform))
+            {
+                writer.writeInt(BINARY_TRANSFORM_FIXED_FUNCTION);
+                writer.writeInt(t->getStyle());
+                std::vector<double> params(t->getNumParams(), 0.);
+                if(!params.empty()) t->getParams(&params[0]);
+                writer.writeInt((int)params.size());
+                WriteDoubles(writer, params.data(), (int)params.size());
+            }
+            else if(ConstGroupTransformRcPtr t = DynamicPtrCast<const GroupTransform>(transform))
+            {
+                writer.writeInt(BINARY_TRANSFORM_GROUP);
+                writer.writeInt(t->size());
+                for(int i=0; i<t->size(); ++i)
+                {
+                    WriteTransform(writer, t->getTransform(i));
+                }
+            }
+            else if(ConstLogAffineTransformRcPtr t
+                = DynamicPtrCast<const LogAffineTransform>(transform))
+            {
+                writer.writeInt(BINARY_TRANSFORM_LOG_AFFINE);
+                writer.writeDouble(t->getBase());
+                double values[3];
+                t->getLogSideSlopeValue(values);
+                WriteDoubles(writer, values, 3);
+                t->getLogSideOffsetValue(values);
+                WriteDoubles(writer, values, 3);
+                t->getLinSideSlopeValue(values);
+                WriteDoubles(writer, values, 3);
+                t->getLinSideOffsetValue(values);
+                WriteDoubles(writer, values, 3);
+            }
+            else if(ConstLogTransformRcPtr t = DynamicPtrCast<const LogTransform>(transform))
+            {
+                writer.writeInt(BINARY_TRANSFORM_LOG);
+                writer.writeDouble(t->getBase());
+            }
+            else if(ConstLookTransformRcPtr t = DynamicPtrCast<const LookTransform>(transform))
+            {
+                writer.writeInt(BINARY_TRANSFORM_LOOK);
+                writer.writeString(ToString(t->getSrc()));
+                writer.writeString(ToString(t->getDst()));
+                writer.writeString(ToString(t->getLooks()));
+            }
+            else if(ConstMatrixTransformRcPtr t
+                = DynamicPtrCast<const MatrixTransform>(transform))
+            {
+                writer.writeInt(BINARY_TRANSFORM_MATRIX);
+                double matrix[16];
+                t->getMatrix(matrix);
+                WriteDoubles(writer, matrix, 16);
+                double offset[4];
+                t->getOffset(offset);
+                WriteDoubles(writer, offset, 4);
+            }
+            else if(ConstRangeTransformRcPtr t = DynamicPtrCast<const RangeTransform>(transform))
+            {
+                writer.writeInt(BINARY_TRANSFORM_RANGE);
+                writer.writeInt(t->getStyle());
+                writer.writeBool(t->hasMinInValue());
+                writer.writeDouble(t->hasMinInValue() ? t->getMinInValue() : 0.);
+                writer.writeBool(t->hasMaxInValue());
+                writer.writeDouble(t->hasMaxInValue() ? t->getMaxInValue() : 0.);
+                writer.writeBool(t->hasMinOutValue());
+                writer.writeDouble(t->hasMinOutValue() ? t->getMinOutValue() : 0.);
+                writer.writeBool(t->hasMaxOutValue());
+                writer.writeDouble(t->hasMaxOutValue() ? t->getMaxOutValue() : 0.);
+            }
+            else
+            {
+                throw Exception("Unsupported Transform() type for serialization.");
+            }
+        }
+
+        TransformRcPtr ReadTransformContent(BinaryCacheReader & reader, int type)
+        {
+            switch(type)
+            {
+                case BINARY_TRANSFORM_ALLOCATION:
+                {
+                    AllocationTransformRcPtr t = AllocationTransform::Create();
+                    t->setAllocation((Allocation)reader.readInt());
+                    std::vector<float> vars;
+                    reader.readFloats(vars);
+                    if(!vars.empty())
+                    {
+                        t->setVars(static_cast<int>(vars.size()), &vars[0]);
+                    }
+                    return t;
+                }
+                case BINARY_TRANSFORM_CDL:
+                {
+                    CDLTransformRcPtr t = CDLTransform::Create();
+                    double rgb[3];
+                    ReadDoubles(reader, rgb, 3);
+                    t->setSlope(rgb);
+                    ReadDoubles(reader, rgb, 3);
+                    t->setOffset(rgb);
+                    ReadDoubles(reader, rgb, 3);
+                    t->setPower(rgb);
+                    t->setSat(reader.readDouble());
+                    return t;
+                }
+                case BINARY_TRANSFORM_COLORSPACE:
+                {
+                    ColorSpaceTransformRcPtr t = ColorSpaceTransform::Create();
+                    t->setSrc(reader.readString().c_str());
+                    t->setDst(reader.readString().c_str());
+                    return t;
+                }
+                case BINARY_TRANSFORM_EXPONENT:
+                {
+                    ExponentTransformRcPtr t = ExponentTransform::Create();
+                    double value[4];
+                    ReadDoubles(reader, value, 4);
+                    t->setValue(value);
+                    return t;
+                }
+                case BINARY_TRANSFORM_EXPONENT_WITH_LINEAR:
+                {
+                    ExponentWithLinearTransformRcPtr t = ExponentWithLinearTransform::Create();
+                    double values[4];
+                    ReadDoubles(reader, values, 4);
+                    t->setGamma(values);
+                    ReadDoubles(reader, values, 4);
+                    t->setOffset(values);
+                    return t;
+                }
+                case BINARY_TRANSFORM_EXPOSURE_CONTRAST:
+                {
+                    ExposureContrastTransformRcPtr t = ExposureContrastTransform::Create();
+                    t->setStyle((ExposureContrastStyle)reader.readInt());
+                    if(reader.readBool()) t->makeExposureDynamic();
+                    t->setExposure(reader.readDouble());
+                    if(reader.readBool()) t->makeContrastDynamic();
+                    t->setContrast(reader.readDouble());
+                    if(reader.readBool()) t->makeGammaDynamic();
+                    t->setGamma(reader.readDouble());
+                    t->setPivot(reader.readDouble());
+                    return t;
+                }
+                case BINARY_TRANSFORM_FILE:
+                {
+                    FileTransformRcPtr t = FileTransform::Create();
+                    t->setSrc(reader.readString().c_str());
+                    t->setCCCId(reader.readString().c_str());
+                    t->setInterpolation((Interpolation)reader.readInt());
+                    return t;
+                }
+                case BINARY_TRANSFORM_FIXED_FUNCTION:
+                {
+                    FixedFunctionTransformRcPtr t = FixedFunctionTransform::Create();
+                    t->setStyle((FixedFunctionStyle)reader.readInt());
+                    std::vector<double> params(ReadCount(reader));
+                    ReadDoubles(reader, params.data(), (int)params.size());
+                    t->setParams(params.data(), params.size());
+                    return t;
+                }
+                case BINARY_TRANSFORM_GROUP:
+                {
+                    GroupTransformRcPtr t = GroupTransform::Create();
+                    const int size = ReadCount(reader);
+                    for(int i=0; i<size; ++i)
+                    {
+                        TransformRcPtr child = ReadTransform(reader);
+                        if(!child)
+                        {
+                            throw Exception("Corrupted binary cache.");
+                        }
+                        t->push_back(child);
+                    }
+                    return t;
+                }
+                case BINARY_TRANSFORM_LOG_AFFINE:
+                {
+                    LogAffineTransformRcPtr t = LogAffineTransform::Create();
+                    t->setBase(reader.readDouble());
+                    double values[3];
+                    ReadDoubles(reader, values, 3);
+                    t->setLogSideSlopeValue(values);
+                    ReadDoubles(reader, values, 3);
+                    t->setLogSideOffsetValue(values);
+                    ReadDoubles(reader, values, 3);
+                    t->setLinSideSlopeValue(values);
+                    ReadDoubles(reader, values, 3);
+                    t->setLinSideOffsetValue(values);
+                    return t;
+                }
+                case BINARY_TRANSFORM_LOG:
+                {
+                    LogTransformRcPtr t = LogTransform::Create();
+                    t->setBase(reader.readDouble());
+                    return t;
+                }
+                case BINARY_TRANSFORM_LOOK:
+                {
+                    LookTransformRcPtr t = LookTransform::Create();
+                    t->setSrc(reader.readString().c_str());
+                    t->setDst(reader.readString().c_str());
+                    t->setLooks(reader.readString().c_str());
+                    return t;
+                }
+                case BINARY_TRANSFORM_MATRIX:
+                {
+                    MatrixTransformRcPtr t = MatrixTransform::Create();
+                    double matrix[16];
+                    ReadDoubles(reader, matrix, 16);
+                    t->setMatrix(matrix);
+                    double offset[4];
+                    ReadDoubles(reader, offset, 4);
+                    t->setOffset(offset);
+                    return t;
+                }
+                case BINARY_TRANSFORM_RANGE:
+                {
+                    RangeTransformRcPtr t = RangeTransform::Create();
+                    t->setStyle((RangeStyle)reader.readInt());
+                    bool hasValue = reader.readBool();
+                    double value = reader.readDouble();
+                    if(hasValue) t->setMinInValue(value); else t->unsetMinInValue();
+                    hasValue = reader.readBool();
+                    value = reader.readDouble();
+                    if(hasValue) t->setMaxInValue(value); else t->unsetMaxInValue();
+                    hasValue = reader.readBool();
+                    value = reader.readDouble();
+                    if(hasValue) t->setMinOutValue(value); else t->unsetMinOutValue();
+                    hasValue = reader.readBool();
+                    value = reader.readDouble();
+                    if(hasValue) t->setMaxOutValue(value); else t->unsetMaxOutValue();
+                    return t;
+                }
+                default:
+                    throw Exception("Corrupted binary cache.");
+            }
+        }
+    }
+
+    void WriteTransform(BinaryCacheWriter & writer, const ConstTransformRcPtr & transform)
+    {
+        if(!transform)
+        {
+            writer.writeInt(BINARY_TRANSFORM_NONE);
+            return;
+        }
+
+        WriteTransformContent(writer, transform);
+        writer.writeInt(transform->getDirection());
+    }
+
+    TransformRcPtr ReadTransform(BinaryCacheReader & reader)
+    {
+        const int type = reader.readInt();
+        if(type==BINARY_TRANSFORM_NONE)
+        {
+            return TransformRcPtr();
+        }
+
+        TransformRcPtr transform = ReadTransformContent(reader, type);
+        transform->setDirection((TransformDirection)reader.readInt());
+        return transform;
+    }
+
+    void WriteColorSpace(BinaryCacheWriter & writer, const ConstColorSpaceRcPtr & cs)
+    {
+        writer.writeString(ToString(cs->getName()));
+        writer.writeString(ToString(cs->getFamily()));
+        writer.writeString(ToString(cs->getEqualityGroup()));
+        writer.writeString(ToString(cs->getDescription()));
+        writer.writeInt(cs->getBitDepth());
+        writer.writeBool(cs->isData());
+
+        writer.writeInt(cs->getNumCategories());
+        for(int i=0; i<cs->getNumCategories(); ++i)
+        {
+            writer.writeString(ToString(cs->getCategory(i)));
+        }
+
+        writer.writeInt(cs->getAllocation());
+        std::vector<float> vars(cs->getAllocationNumVars());
+        if(!vars.empty()) cs->getAllocationVars(&vars[0]);
+        writer.writeFloats(vars);
+
+        WriteTransform(writer, cs->getTransform(COLORSPACE_DIR_TO_REFERENCE));
+        WriteTransform(writer, cs->getTransform(COLORSPACE_DIR_FROM_REFERENCE));
+    }
+
+    ColorSpaceRcPtr ReadColorSpace(BinaryCacheReader & reader)
+    {
+        ColorSpaceRcPtr cs = ColorSpace::Create();
+
+        cs->setName(reader.readString().c_str());
+        cs->setFamily(reader.readString().c_str());
+        cs->setEqualityGroup(reader.readString().c_str());
+        cs->setDescription(reader.readString().c_str());
+        cs->setBitDepth((BitDepth)reader.readInt());
+        cs->setIsData(reader.readBool());
+
+        const int numCategories = ReadCount(reader);
+        for(int i=0; i<numCategories; ++i)
+        {
+            cs->addCategory(reader.readString().c_str());
+        }
+
+        cs->setAllocation((Allocation)reader.readInt());
+        std::vector<float> vars;
+        reader.readFloats(vars);
+        if(!vars.empty())
+        {
+            cs->setAllocationVars(static_cast<int>(vars.size()), &vars[0]);
+        }
+
+        ConstTransformRcPtr toRef = ReadTransform(reader);
+        if(toRef) cs->setTransform(toRef, COLORSPACE_DIR_TO_REFERENCE);
+        ConstTransformRcPtr fromRef = ReadTransform(reader);
+        if(fromRef) cs->setTransform(fromRef, COLORSPACE_DIR_FROM_REFERENCE);
+
+        return cs;
+    }
+
+    void WriteLook(BinaryCacheWriter & writer, const ConstLookRcPtr & look)
+    {
+        writer.writeString(ToString(look->getName()));
+        writer.writeString(ToString(look->getProcessSpace()));
+        writer.writeString(ToString(look->getDescription()));
+        WriteTransform(writer, look->getTransform());
+        WriteTransform(writer, look->getInverseTransform());
+    }
+
+    LookRcPtr ReadLook(BinaryCacheReader & reader)
+    {
+        LookRcPtr look = Look::Create();
+
+        look->setName(reader.readString().c_str());
+        look->setProcessSpace(reader.readString().c_str());
+        look->setDescription(reader.readString().c_str());
+
+        ConstTransformRcPtr transform = ReadTransform(reader);
+        if(transform) look->setTransform(transform);
+        ConstTransformRcPtr inverse = ReadTransform(reader);
+        if(inverse) look->setInverseTransform(inverse);
+
+        return look;
+    }
+}
+OCIO_NAMESPACE_EXIT
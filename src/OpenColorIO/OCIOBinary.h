@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_BINARY_H
+#define INCLUDED_OCIO_BINARY_H
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "fileformats/BinaryCache.h"
+
+OCIO_NAMESPACE_ENTER
+{
+    // Binary form of the elements of a config, used by the binary config snapshots (refer
+    // to Config::serializeBinary()). The elements hold the same content as their YAML form
+    // (refer to OCIOYaml), and the same transforms are supported.
+
+    // The transform may be null.
+    void WriteTransform(BinaryCacheWriter & writer, const ConstTransformRcPtr & transform);
+    TransformRcPtr ReadTransform(BinaryCacheReader & reader);
+
+    void WriteColorSpace(BinaryCacheWriter & writer, const ConstColorSpaceRcPtr & cs);
+    ColorSpaceRcPtr ReadColorSpace(BinaryCacheReader & reader);
+
+    void WriteLook(BinaryCacheWriter & writer, const ConstLookRcPtr & look);
+    LookRcPtr ReadLook(BinaryCacheReader & reader);
+}
+OCIO_NAMESPACE_EXIT
+
+#endif
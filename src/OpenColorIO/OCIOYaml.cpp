@@ -2410,7 +2410,7 @@ OCIO_NAMESPACE_ENTER
             
         }
         
-        inline void save(YAML::Emitter& out, const Config* c)
+        inline void save(YAML::Emitter& out, const Config* c, bool withElements)
         {
             std::stringstream ss;
             const unsigned configMajorVersion = c->getMajorVersion();
@@ -2555,6 +2555,12 @@ OCIO_NAMESPACE_ENTER
             out << YAML::Newline;
 #endif
             
+            if(!withElements)
+            {
+                out << YAML::EndMap;
+                return;
+            }
+
             // Looks
             if(c->getNumLooks() > 0)
             {
@@ -2616,7 +2622,28 @@ OCIO_NAMESPACE_ENTER
     void OCIOYaml::write(std::ostream& ostream, const Config* c) const
     {
         YAML::Emitter out;
-        save(out, c);
+        save(out, c, true);
+        ostream << out.c_str();
+    }
+    
+    void OCIOYaml::writeWithoutElements(std::ostream& ostream, const Config* c) const
+    {
+        YAML::Emitter out;
+        save(out, c, false);
+        ostream << out.c_str();
+    }
+    
+    void OCIOYaml::write(std::ostream& ostream, const ConstLookRcPtr & look) const
+    {
+        YAML::Emitter out;
+        save(out, look);
+        ostream << out.c_str();
+    }
+    
+    void OCIOYaml::write(std::ostream& ostream, const ConstColorSpaceRcPtr & cs) const
+    {
+        YAML::Emitter out;
+        save(out, cs);
         ostream << out.c_str();
     }
     
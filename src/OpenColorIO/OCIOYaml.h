@@ -14,6 +14,12 @@ OCIO_NAMESPACE_ENTER
     public:
         void open(std::istream& istream, ConfigRcPtr& c, const char* filename = NULL) const;
         void write(std::ostream& ostream, const Config* c) const;
+
+        // Write the config without its looks and color spaces, and write each of them
+        // separately, so the elements of the config could be hashed independently.
+        void writeWithoutElements(std::ostream& ostream, const Config* c) const;
+        void write(std::ostream& ostream, const ConstLookRcPtr & look) const;
+        void write(std::ostream& ostream, const ConstColorSpaceRcPtr & cs) const;
     };
     
 }
@@ -358,6 +358,34 @@ OCIO_NAMESPACE_ENTER
         }
     }
 
+    void InternOpArrays(const ConstOpDataVec & opDataVec)
+    {
+        for (const auto & opData : opDataVec)
+        {
+            // Not shared yet, refer to the precondition.
+            OpDataRcPtr data = std::const_pointer_cast<OpData>(opData);
+
+            if (data->getType() == OpData::Lut1DType)
+            {
+                OCIO_DYNAMIC_POINTER_CAST<Lut1DOpData>(data)->getArray().intern();
+            }
+            else if (data->getType() == OpData::Lut3DType)
+            {
+                OCIO_DYNAMIC_POINTER_CAST<Lut3DOpData>(data)->getArray().intern();
+            }
+        }
+    }
+
+    void InternOpArrays(OpRcPtrVec & ops)
+    {
+        ConstOpDataVec opDataVec;
+        for (ConstOpRcPtr op : ops)
+        {
+            opDataVec.push_back(op->data());
+        }
+        InternOpArrays(opDataVec);
+    }
+
     namespace
     {
 
@@ -399,6 +427,26 @@ OCIO_NAMESPACE_ENTER
         }
     }
 
+    void FreezeDynamicProperties(OpRcPtrVec & ops)
+    {
+        static const DynamicPropertyType types[] = { DYNAMIC_PROPERTY_EXPOSURE,
+                                                     DYNAMIC_PROPERTY_CONTRAST,
+                                                     DYNAMIC_PROPERTY_GAMMA };
+
+        for (auto op : ops)
+        {
+            for (const auto type : types)
+            {
+                if (op->hasDynamicProperty(type))
+                {
+                    const double value = op->getDynamicProperty(type)->getDoubleValue();
+                    op->replaceDynamicProperty(
+                        type, std::make_shared<DynamicPropertyImpl>(type, value, false));
+                }
+            }
+        }
+    }
+
     void CreateOpVecFromOpData(OpRcPtrVec & ops,
                                const ConstOpDataRcPtr & opData,
                                TransformDirection dir)
@@ -1082,4 +1130,38 @@ OCIO_ADD_TEST(OpData, equality)
     OCIO_CHECK_ASSERT( !(*op2==*mat1) );
 }
 
+OCIO_ADD_TEST(InternOpArrays, lut3d)
+{
+    OCIO::Lut3DOpDataRcPtr lut1 = std::make_shared<OCIO::Lut3DOpData>(5);
+    OCIO::Lut3DOpDataRcPtr lut2 = std::make_shared<OCIO::Lut3DOpData>(5);
+    OCIO::Lut3DOpDataRcPtr lut3 = std::make_shared<OCIO::Lut3DOpData>(5);
+    lut3->getArray()[1] = 0.5f;
+
+    OCIO::OpRcPtrVec ops1, ops2;
+    OCIO_CHECK_NO_THROW(OCIO::CreateLut3DOp(ops1, lut1, OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_CHECK_NO_THROW(OCIO::CreateLut3DOp(ops2, lut2, OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_CHECK_NO_THROW(OCIO::CreateLut3DOp(ops2, lut3, OCIO::TRANSFORM_DIR_FORWARD));
+
+    OCIO::InternOpArrays(ops1);
+    OCIO::InternOpArrays(ops2);
+
+    // Identical LUTs share their values.
+    OCIO_CHECK_EQUAL(lut1->getArray().getSharedValues().get(),
+                     lut2->getArray().getSharedValues().get());
+    OCIO_CHECK_NE(lut1->getArray().getSharedValues().get(),
+                  lut3->getArray().getSharedValues().get());
+
+    // Copies also share them, until modified.
+    OCIO::OpRcPtrVec ops3 = ops1.clone();
+    OCIO::ConstOpRcPtr op = ops3[0];
+    auto lut4 = OCIO_DYNAMIC_POINTER_CAST<const OCIO::Lut3DOpData>(op->data());
+    OCIO_CHECK_EQUAL(lut4->getArray().getSharedValues().get(),
+                     lut1->getArray().getSharedValues().get());
+
+    lut2->getArray()[1] = 0.5f;
+    OCIO_CHECK_NE(lut1->getArray().getSharedValues().get(),
+                  lut2->getArray().getSharedValues().get());
+    OCIO_CHECK_NE(lut4->getArray()[1], 0.5f);
+}
+
 #endif
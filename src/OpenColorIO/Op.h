@@ -196,9 +196,23 @@ OCIO_NAMESPACE_ENTER
     // Sets all ops to F32 and finalize them.
     void FinalizeOpVec(OpRcPtrVec & opVec, FinalizationFlags fFlags);
 
-    void OptimizeOpVec(OpRcPtrVec & result, OptimizationFlags oFlags);
+    // Shares the LUT arrays with the identical arrays already loaded (refer to
+    // ArrayT::intern()). The op data must not be accessed by other threads yet.
+    void InternOpArrays(OpRcPtrVec & ops);
+    void InternOpArrays(const ConstOpDataVec & opDataVec);
+
+    class OptimizationTraceImpl;
+
+    // Optimizes the op list. When a trace is provided, each optimization pass is
+    // recorded in it.
+    void OptimizeOpVec(OpRcPtrVec & result, OptimizationFlags oFlags,
+                       OptimizationTraceImpl * trace = nullptr);
 
     void UnifyDynamicProperties(OpRcPtrVec & ops);
+
+    // Replaces the dynamic properties by non-dynamic copies holding the current
+    // values so the optimizer processes the ops like any other static op.
+    void FreezeDynamicProperties(OpRcPtrVec & ops);
    
     void CreateOpVecFromOpData(OpRcPtrVec & ops,
                                const ConstOpDataRcPtr & opData,
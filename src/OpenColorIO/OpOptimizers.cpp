@@ -9,6 +9,7 @@
 
 #include "Logging.h"
 #include "Op.h"
+#include "OptimizationTrace.h"
 #include "ops/Lut1D/Lut1DOp.h"
 #include "ops/Lut1D/Lut1DOpData.h"
 
@@ -105,7 +106,14 @@ OCIO_NAMESPACE_ENTER
             return count;
         }
 
-        int CombineOps(OpRcPtrVec & opVec)
+        // The composition of 1D LUTs resamples them so it is only done when requested.
+        bool IsCombineAllowed(ConstOpRcPtr & first, OptimizationFlags oFlags)
+        {
+            return first->data()->getType()!=OpData::Lut1DType
+                || (oFlags & OPTIMIZATION_COMP_LUT1D)==OPTIMIZATION_COMP_LUT1D;
+        }
+
+        int CombineOps(OpRcPtrVec & opVec, OptimizationFlags oFlags = OPTIMIZATION_ALL)
         {
             int count = 0;
             int firstindex = 0; // this must be a signed int
@@ -117,7 +125,7 @@ OCIO_NAMESPACE_ENTER
                 ConstOpRcPtr first = opVec[firstindex];
                 ConstOpRcPtr second = opVec[firstindex+1];
 
-                if(first->canCombineWith(second))
+                if(IsCombineAllowed(first, oFlags) && first->canCombineWith(second))
                 {
                     tmpops.clear();
                     first->combineWith(tmpops, second);
@@ -176,7 +184,9 @@ OCIO_NAMESPACE_ENTER
         //       the parameters.
         for(const auto & op : ops)
         {
-            // TODO: Dynamic bypassed ops can be 'optimizied' like any other ops.
+            // A dynamic op ends the prefix as its values can change after the optimization.
+            // Note: Frozen dynamic ops (refer to FreezeDynamicProperties()) are not dynamic
+            // anymore so they are optimized like any other ops.
 
             // In OCIO, the hasChannelCrosstalk method returns false for separable ops.
             if(op->hasChannelCrosstalk() || op->isDynamic())
@@ -251,10 +261,13 @@ OCIO_NAMESPACE_ENTER
 
     // Use functional composition to replace a string of separable ops at the head of
     // the op list with a single 1D LUT that is built to do a look-up for the input bit-depth.
+    //
+    // Only the static ops ahead of the first dynamic op are replaced, the following ops
+    // are still optimized by the other passes as dynamic ops are never combined with
+    // their neighbours. The CPUProcessor freezes the dynamic ops when requested
+    // (i.e. OPTIMIZATION_DYNAMIC_REBAKE) so the whole op list could then be replaced.
     void OptimizeSeparablePrefix(OpRcPtrVec & ops, OptimizationFlags /*oFlags*/)
     {
-        // TODO: Take care of the dynamic properties.
-
         if(ops.empty())
         {
             return;
@@ -298,7 +311,27 @@ OCIO_NAMESPACE_ENTER
         ops.insert(ops.begin(), lutOps.begin(), lutOps.end());
     }
 
-    void OptimizeOpVec(OpRcPtrVec & ops, OptimizationFlags oFlags)
+    namespace
+    {
+        // Run an optimization pass and record it in the trace if any.
+        template<typename Pass>
+        void RunPass(OptimizationTraceImpl * trace, const char * name,
+                     OpRcPtrVec & ops, Pass pass)
+        {
+            if(trace)
+            {
+                trace->beginPass(name, ops);
+                pass(ops);
+                trace->endPass(ops);
+            }
+            else
+            {
+                pass(ops);
+            }
+        }
+    }
+
+    void OptimizeOpVec(OpRcPtrVec & ops, OptimizationFlags oFlags, OptimizationTraceImpl * trace)
     {
         if(ops.empty()) return;
 
@@ -323,9 +356,17 @@ OCIO_NAMESPACE_ENTER
 
         while(passes<=MAX_OPTIMIZATION_PASSES)
         {
-            int noops = RemoveNoOps(ops);
-            int inverseops = RemoveInverseOps(ops);
-            int combines = CombineOps(ops);
+            int noops = 0;
+            RunPass(trace, "RemoveNoOps", ops,
+                    [&noops](OpRcPtrVec & o) { noops = RemoveNoOps(o); });
+
+            int inverseops = 0;
+            RunPass(trace, "RemoveInverseOps", ops,
+                    [&inverseops](OpRcPtrVec & o) { inverseops = RemoveInverseOps(o); });
+
+            int combines = 0;
+            RunPass(trace, "CombineOps", ops,
+                    [&combines, oFlags](OpRcPtrVec & o) { combines = CombineOps(o, oFlags); });
 
             if(noops == 0 && inverseops==0 && combines==0)
             {
@@ -357,7 +398,8 @@ OCIO_NAMESPACE_ENTER
             if((oFlags & OPTIMIZATION_COMP_SEPARABLE_PREFIX)
                     == OPTIMIZATION_COMP_SEPARABLE_PREFIX)
             {
-                OptimizeSeparablePrefix(ops, oFlags);
+                RunPass(trace, "OptimizeSeparablePrefix", ops,
+                        [oFlags](OpRcPtrVec & o) { OptimizeSeparablePrefix(o, oFlags); });
             }
         }
 
@@ -771,6 +813,71 @@ OCIO_ADD_TEST(OptimizeSeparablePrefix, op_with_dyn_properties)
     OCIO_CHECK_ASSERT(exp->isDynamic());
 }
 
+OCIO_ADD_TEST(OptimizeSeparablePrefix, op_with_frozen_dyn_properties)
+{
+    // Test that frozen dynamic properties do not prevent the prefix optimization.
+
+    OCIO::OpRcPtrVec originalOps;
+
+    OCIO::MatrixOpDataRcPtr matrix
+        = std::make_shared<OCIO::MatrixOpData>(OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_UINT16);
+    matrix->setArrayValue(0, 0.5);
+
+    OCIO_CHECK_NO_THROW(OCIO::CreateMatrixOp(originalOps, matrix, OCIO::TRANSFORM_DIR_FORWARD));
+
+    OCIO::ExposureContrastOpDataRcPtr exposure =
+        std::make_shared<OCIO::ExposureContrastOpData>();
+
+    exposure->setExposure(0.2);
+    exposure->setPivot(0.5);
+    exposure->getExposureProperty()->makeDynamic();
+
+    OCIO_CHECK_NO_THROW(OCIO::CreateExposureContrastOp(originalOps, exposure, OCIO::TRANSFORM_DIR_FORWARD));
+
+    OCIO::GammaOpData::Params params = { 2.2 };
+    OCIO::GammaOpData::Params paramsA = { 1. };
+    OCIO::GammaOpDataRcPtr gamma
+        = std::make_shared<OCIO::GammaOpData>(OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_UINT16,
+                                              OCIO::FormatMetadataImpl(OCIO::METADATA_ROOT),
+                                              OCIO::GammaOpData::BASIC_FWD,
+                                              params, params, params, paramsA);
+
+    OCIO_CHECK_NO_THROW(OCIO::CreateGammaOp(originalOps, gamma, OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_REQUIRE_EQUAL(originalOps.size(), 3);
+
+    OCIO::OpRcPtrVec optimizedOps = originalOps.clone();
+    OCIO_CHECK_ASSERT(optimizedOps[1]->isDynamic());
+
+    OCIO_CHECK_NO_THROW(OCIO::FreezeDynamicProperties(optimizedOps));
+    OCIO_CHECK_ASSERT(!optimizedOps[1]->isDynamic());
+    OCIO_CHECK_ASSERT(!optimizedOps[1]->hasDynamicProperty(OCIO::DYNAMIC_PROPERTY_EXPOSURE));
+
+    // The frozen op keeps the exposure value.
+    OCIO::ConstOpRcPtr o = optimizedOps[1];
+    OCIO::ConstExposureContrastOpDataRcPtr exp
+        = OCIO::DynamicPtrCast<const OCIO::ExposureContrastOpData>(o->data());
+    OCIO_REQUIRE_ASSERT(exp);
+    OCIO_CHECK_EQUAL(exp->getExposure(), 0.2);
+
+    // The original op is still dynamic.
+    OCIO_CHECK_ASSERT(originalOps[1]->isDynamic());
+
+    // Optimize it.
+
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeSeparablePrefix(optimizedOps, OCIO::OPTIMIZATION_VERY_GOOD));
+
+    // Validate the result.
+
+    OCIO_REQUIRE_EQUAL(optimizedOps.size(), 1U);
+    o = optimizedOps[0];
+    OCIO_CHECK_EQUAL(o->data()->getType(), OCIO::OpData::Lut1DType);
+
+    OCIO_CHECK_NO_THROW(FinalizeOpVec(originalOps, OCIO::FINALIZATION_DEFAULT));
+    OCIO_CHECK_NO_THROW(FinalizeOpVec(optimizedOps, OCIO::FINALIZATION_DEFAULT));
+
+    compareRender(originalOps, optimizedOps, __LINE__);
+}
+
 OCIO_ADD_TEST(OpOptimizers, optimizations_with_bit_depths)
 {
     // Test that optimization of a transform preserves
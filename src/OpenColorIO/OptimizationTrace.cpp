@@ -0,0 +1,319 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <sstream>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "OptimizationTrace.h"
+#include "ops/Lut1D/Lut1DOpData.h"
+#include "ops/Lut3D/Lut3DOpData.h"
+
+OCIO_NAMESPACE_ENTER
+{
+
+OptimizationTraceRcPtr OptimizationTrace::Create()
+{
+    return std::make_shared<OptimizationTraceImpl>();
+}
+
+void OptimizationTraceImpl::clear()
+{
+    m_passes.clear();
+}
+
+int OptimizationTraceImpl::getNumPasses() const
+{
+    return static_cast<int>(m_passes.size());
+}
+
+const char * OptimizationTraceImpl::getPassName(int passIndex) const
+{
+    return getPass(passIndex).m_name.c_str();
+}
+
+double OptimizationTraceImpl::getPassDuration(int passIndex) const
+{
+    return getPass(passIndex).m_duration;
+}
+
+int OptimizationTraceImpl::getNumOpsBefore(int passIndex) const
+{
+    return static_cast<int>(getPass(passIndex).m_before.size());
+}
+
+const char * OptimizationTraceImpl::getOpInfoBefore(int passIndex, int opIndex) const
+{
+    return GetOp(getPass(passIndex).m_before, opIndex).m_info.c_str();
+}
+
+const char * OptimizationTraceImpl::getOpCacheIDBefore(int passIndex, int opIndex) const
+{
+    return GetOp(getPass(passIndex).m_before, opIndex).m_cacheID.c_str();
+}
+
+unsigned long OptimizationTraceImpl::getOpLutSizeBefore(int passIndex, int opIndex) const
+{
+    return GetOp(getPass(passIndex).m_before, opIndex).m_lutSize;
+}
+
+int OptimizationTraceImpl::getNumOpsAfter(int passIndex) const
+{
+    return static_cast<int>(getPass(passIndex).m_after.size());
+}
+
+const char * OptimizationTraceImpl::getOpInfoAfter(int passIndex, int opIndex) const
+{
+    return GetOp(getPass(passIndex).m_after, opIndex).m_info.c_str();
+}
+
+const char * OptimizationTraceImpl::getOpCacheIDAfter(int passIndex, int opIndex) const
+{
+    return GetOp(getPass(passIndex).m_after, opIndex).m_cacheID.c_str();
+}
+
+unsigned long OptimizationTraceImpl::getOpLutSizeAfter(int passIndex, int opIndex) const
+{
+    return GetOp(getPass(passIndex).m_after, opIndex).m_lutSize;
+}
+
+void OptimizationTraceImpl::beginPass(const char * name, const OpRcPtrVec & ops)
+{
+    Pass pass;
+    pass.m_name = name;
+    Snapshot(ops, pass.m_before);
+
+    m_passes.push_back(pass);
+
+    // Only measure the pass itself.
+    m_start = std::chrono::steady_clock::now();
+}
+
+void OptimizationTraceImpl::endPass(const OpRcPtrVec & ops)
+{
+    const std::chrono::duration<double, std::milli> duration
+        = std::chrono::steady_clock::now() - m_start;
+
+    if(m_passes.empty())
+    {
+        throw Exception("Internal error: No optimization pass to end.");
+    }
+
+    Pass & pass = m_passes.back();
+    pass.m_duration = duration.count();
+    Snapshot(ops, pass.m_after);
+}
+
+void OptimizationTraceImpl::Snapshot(const OpRcPtrVec & ops, OpSnapshots & snapshots)
+{
+    snapshots.clear();
+    snapshots.reserve(ops.size());
+
+    for(const auto & op : ops)
+    {
+        OpSnapshot snapshot;
+        snapshot.m_info    = op->getInfo();
+        snapshot.m_cacheID = op->getCacheID();
+
+        if(snapshot.m_cacheID.empty())
+        {
+            // Ops created by the optimization (e.g. combined ops) are not yet finalized.
+            OpRcPtr finalizedOp = op->clone();
+            finalizedOp->finalize(FINALIZATION_EXACT);
+            snapshot.m_cacheID = finalizedOp->getCacheID();
+        }
+
+        ConstOpRcPtr constOp = op;
+        ConstOpDataRcPtr data = constOp->data();
+        switch(data->getType())
+        {
+            case OpData::Lut1DType:
+            {
+                ConstLut1DOpDataRcPtr lut = OCIO_DYNAMIC_POINTER_CAST<const Lut1DOpData>(data);
+                snapshot.m_lutSize = lut->getArray().getLength();
+                break;
+            }
+            case OpData::Lut3DType:
+            {
+                ConstLut3DOpDataRcPtr lut = OCIO_DYNAMIC_POINTER_CAST<const Lut3DOpData>(data);
+                snapshot.m_lutSize = static_cast<unsigned long>(lut->getGridSize());
+                break;
+            }
+            default:
+                break;
+        }
+
+        snapshots.push_back(snapshot);
+    }
+}
+
+const OptimizationTraceImpl::Pass & OptimizationTraceImpl::getPass(int passIndex) const
+{
+    if(passIndex<0 || passIndex>=static_cast<int>(m_passes.size()))
+    {
+        std::ostringstream os;
+        os << "Invalid optimization pass index " << passIndex << ".";
+        throw Exception(os.str().c_str());
+    }
+
+    return m_passes[passIndex];
+}
+
+const OptimizationTraceImpl::OpSnapshot &
+    OptimizationTraceImpl::GetOp(const OpSnapshots & snapshots, int opIndex)
+{
+    if(opIndex<0 || opIndex>=static_cast<int>(snapshots.size()))
+    {
+        std::ostringstream os;
+        os << "Invalid op index " << opIndex << ".";
+        throw Exception(os.str().c_str());
+    }
+
+    return snapshots[opIndex];
+}
+
+std::ostream & operator<< (std::ostream & os, const OptimizationTrace & trace)
+{
+    for(int pass=0; pass<trace.getNumPasses(); ++pass)
+    {
+        os << "Pass " << pass << ": " << trace.getPassName(pass)
+           << " took " << trace.getPassDuration(pass) << " ms, "
+           << trace.getNumOpsBefore(pass) << " -> " << trace.getNumOpsAfter(pass) << " ops\n";
+
+        for(int op=0; op<trace.getNumOpsAfter(pass); ++op)
+        {
+            os << "    " << trace.getOpInfoAfter(pass, op);
+
+            const unsigned long lutSize = trace.getOpLutSizeAfter(pass, op);
+            if(lutSize!=0)
+            {
+                os << " (size " << lutSize << ")";
+            }
+
+            os << "\n";
+        }
+    }
+
+    return os;
+}
+
+}
+OCIO_NAMESPACE_EXIT
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef OCIO_UNIT_TEST
+
+namespace OCIO = OCIO_NAMESPACE;
+
+#include "ops/Log/LogOps.h"
+#include "ops/Matrix/MatrixOps.h"
+#include "UnitTest.h"
+
+OCIO_ADD_TEST(OptimizationTrace, optimize_op_vec)
+{
+    // A scale followed by its inverse and a log, processing 10i images.
+
+    OCIO::OpRcPtrVec ops;
+
+    const double scale[4] = { 2.0, 2.0, 2.0, 1.0 };
+    OCIO_CHECK_NO_THROW(OCIO::CreateScaleOp(ops, scale, OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_CHECK_NO_THROW(OCIO::CreateScaleOp(ops, scale, OCIO::TRANSFORM_DIR_INVERSE));
+    OCIO_CHECK_NO_THROW(OCIO::CreateLogOp(ops, 2.0, OCIO::TRANSFORM_DIR_FORWARD));
+
+    OCIO_CHECK_NO_THROW(OCIO::FinalizeOpVec(ops, OCIO::FINALIZATION_EXACT));
+
+    ops.front()->setInputBitDepth(OCIO::BIT_DEPTH_UINT10);
+    ops.back()->setOutputBitDepth(OCIO::BIT_DEPTH_UINT10);
+
+    OCIO::OptimizationTraceImpl trace;
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(ops, OCIO::OPTIMIZATION_DEFAULT, &trace));
+    OCIO_REQUIRE_EQUAL(ops.size(), 1);
+
+    OCIO_REQUIRE_ASSERT(trace.getNumPasses() > 3);
+
+    OCIO_CHECK_EQUAL(std::string(trace.getPassName(0)), "RemoveNoOps");
+    OCIO_CHECK_EQUAL(trace.getNumOpsBefore(0), 3);
+    OCIO_CHECK_EQUAL(trace.getNumOpsAfter(0), 3);
+    OCIO_CHECK_ASSERT(trace.getPassDuration(0) >= 0.0);
+    OCIO_CHECK_EQUAL(std::string(trace.getOpInfoBefore(0, 0)), "<MatrixOffsetOp>");
+    OCIO_CHECK_EQUAL(std::string(trace.getOpCacheIDBefore(0, 0)),
+                     std::string(trace.getOpCacheIDAfter(0, 0)));
+    OCIO_CHECK_ASSERT(!std::string(trace.getOpCacheIDBefore(0, 0)).empty());
+    OCIO_CHECK_EQUAL(trace.getOpLutSizeBefore(0, 0), 0);
+
+    OCIO_CHECK_EQUAL(std::string(trace.getPassName(1)), "RemoveInverseOps");
+
+    // The scales are combined.
+    OCIO_CHECK_EQUAL(std::string(trace.getPassName(2)), "CombineOps");
+    OCIO_CHECK_EQUAL(trace.getNumOpsBefore(2), 3);
+    OCIO_REQUIRE_EQUAL(trace.getNumOpsAfter(2), 2);
+    OCIO_CHECK_EQUAL(std::string(trace.getOpInfoAfter(2, 1)), "<LogOp>");
+    // The combined op is not finalized but the trace still provides its cache identifier.
+    OCIO_CHECK_ASSERT(!std::string(trace.getOpCacheIDAfter(2, 0)).empty());
+    OCIO_CHECK_NE(std::string(trace.getOpCacheIDBefore(2, 0)),
+                  std::string(trace.getOpCacheIDAfter(2, 0)));
+
+    // The last pass replaces the remaining ops by a 1D LUT sampled for 10i.
+    const int last = trace.getNumPasses() - 1;
+    OCIO_CHECK_EQUAL(std::string(trace.getPassName(last)), "OptimizeSeparablePrefix");
+    OCIO_CHECK_EQUAL(trace.getNumOpsBefore(last), 2);
+    OCIO_REQUIRE_EQUAL(trace.getNumOpsAfter(last), 1);
+    OCIO_CHECK_EQUAL(std::string(trace.getOpInfoAfter(last, 0)), "<Lut1DOp>");
+    OCIO_CHECK_EQUAL(trace.getOpLutSizeAfter(last, 0), 1024);
+
+    OCIO_CHECK_THROW_WHAT(trace.getPassName(last + 1),
+                          OCIO::Exception, "Invalid optimization pass index");
+    OCIO_CHECK_THROW_WHAT(trace.getOpInfoAfter(last, 1), OCIO::Exception, "Invalid op index");
+
+    std::ostringstream oss;
+    oss << trace;
+    OCIO_CHECK_NE(oss.str().find("OptimizeSeparablePrefix"), std::string::npos);
+    OCIO_CHECK_NE(oss.str().find("<Lut1DOp> (size 1024)"), std::string::npos);
+
+    trace.clear();
+    OCIO_CHECK_EQUAL(trace.getNumPasses(), 0);
+}
+
+OCIO_ADD_TEST(OptimizationTrace, processor)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::LogTransformRcPtr log = OCIO::LogTransform::Create();
+    log->setBase(2.0);
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(log));
+
+    OCIO::OptimizationTraceRcPtr trace = OCIO::OptimizationTrace::Create();
+
+    OCIO_CHECK_NO_THROW(processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT8,
+                                                            OCIO::BIT_DEPTH_UINT8,
+                                                            OCIO::OPTIMIZATION_DEFAULT,
+                                                            OCIO::FINALIZATION_DEFAULT,
+                                                            trace));
+    OCIO_REQUIRE_ASSERT(trace->getNumPasses() > 0);
+    const int last = trace->getNumPasses() - 1;
+    OCIO_CHECK_EQUAL(std::string(trace->getPassName(last)), "OptimizeSeparablePrefix");
+    OCIO_REQUIRE_EQUAL(trace->getNumOpsAfter(last), 1);
+    OCIO_CHECK_EQUAL(trace->getOpLutSizeAfter(last, 0), 256);
+
+    // The GPU processor always processes F32 images so there is no 1D LUT.
+    trace->clear();
+    OCIO_CHECK_NO_THROW(processor->getOptimizedGPUProcessor(OCIO::OPTIMIZATION_DEFAULT,
+                                                            OCIO::FINALIZATION_DEFAULT,
+                                                            trace));
+    OCIO_REQUIRE_ASSERT(trace->getNumPasses() > 0);
+    const int lastGPU = trace->getNumPasses() - 1;
+    OCIO_REQUIRE_EQUAL(trace->getNumOpsAfter(lastGPU), 1);
+    OCIO_CHECK_EQUAL(std::string(trace->getOpInfoAfter(lastGPU, 0)), "<LogOp>");
+    OCIO_CHECK_EQUAL(trace->getOpLutSizeAfter(lastGPU, 0), 0);
+
+    OCIO_CHECK_THROW_WHAT(processor->getOptimizedGPUProcessor(OCIO::OPTIMIZATION_DEFAULT,
+                                                              OCIO::FINALIZATION_DEFAULT,
+                                                              OCIO::OptimizationTraceRcPtr()),
+                          OCIO::Exception, "The optimization trace is null");
+}
+
+#endif // OCIO_UNIT_TEST
@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_OPTIMIZATIONTRACE_H
+#define INCLUDED_OCIO_OPTIMIZATIONTRACE_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "Op.h"
+
+OCIO_NAMESPACE_ENTER
+{
+
+class OptimizationTraceImpl;
+typedef OCIO_SHARED_PTR<OptimizationTraceImpl> OptimizationTraceImplRcPtr;
+
+// Records the optimization passes of an op list.
+//
+// Note: The trace is not thread-safe so it must not be shared between processors
+// created in parallel.
+class OptimizationTraceImpl : public OptimizationTrace
+{
+public:
+    OptimizationTraceImpl() = default;
+    virtual ~OptimizationTraceImpl() = default;
+
+    void clear() override;
+
+    int getNumPasses() const override;
+    const char * getPassName(int passIndex) const override;
+    double getPassDuration(int passIndex) const override;
+
+    int getNumOpsBefore(int passIndex) const override;
+    const char * getOpInfoBefore(int passIndex, int opIndex) const override;
+    const char * getOpCacheIDBefore(int passIndex, int opIndex) const override;
+    unsigned long getOpLutSizeBefore(int passIndex, int opIndex) const override;
+
+    int getNumOpsAfter(int passIndex) const override;
+    const char * getOpInfoAfter(int passIndex, int opIndex) const override;
+    const char * getOpCacheIDAfter(int passIndex, int opIndex) const override;
+    unsigned long getOpLutSizeAfter(int passIndex, int opIndex) const override;
+
+    // Start the recording of a pass i.e. snapshot the op list and start the timer.
+    void beginPass(const char * name, const OpRcPtrVec & ops);
+    // End the recording of the current pass i.e. stop the timer and snapshot the op list.
+    void endPass(const OpRcPtrVec & ops);
+
+private:
+    struct OpSnapshot
+    {
+        std::string m_info;
+        std::string m_cacheID;
+        unsigned long m_lutSize = 0;
+    };
+
+    typedef std::vector<OpSnapshot> OpSnapshots;
+
+    struct Pass
+    {
+        std::string m_name;
+        double m_duration = 0.0; // In milliseconds.
+        OpSnapshots m_before;
+        OpSnapshots m_after;
+    };
+
+    static void Snapshot(const OpRcPtrVec & ops, OpSnapshots & snapshots);
+
+    const Pass & getPass(int passIndex) const;
+    static const OpSnapshot & GetOp(const OpSnapshots & snapshots, int opIndex);
+
+    std::vector<Pass> m_passes;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+}
+OCIO_NAMESPACE_EXIT
+
+#endif
@@ -1,7 +1,12 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <locale>
 #include <set>
 #include <sstream>
 
@@ -346,6 +351,44 @@ OCIO_NAMESPACE_ENTER
         throw Exception(ss.str().c_str());
     }
 
+    const char * CacheTypeToString(CacheType type)
+    {
+        switch(type)
+        {
+            case CACHE_FILE:                return "file";
+            case CACHE_FILE_HASH:           return "filehash";
+            case CACHE_CDL_FILE:            return "cdlfile";
+            case CACHE_CONTEXT_RESULTS:     return "contextresults";
+            case CACHE_CONFIG_CACHE_ID:     return "configcacheid";
+            case CACHE_PROCESSOR:           return "processor";
+            case CACHE_OPTIMIZED_PROCESSOR: return "optimizedprocessor";
+            case CACHE_CPU_ENGINE:          return "cpuengine";
+            case CACHE_BAKED_SAMPLES:       return "bakedsamples";
+        }
+
+        throw Exception("Unknown cache type");
+    }
+
+    CacheType CacheTypeFromString(const char * type)
+    {
+        const std::string str = pystring::lower(type ? type : "");
+
+        if     (str == "file")               return CACHE_FILE;
+        else if(str == "filehash")           return CACHE_FILE_HASH;
+        else if(str == "cdlfile")            return CACHE_CDL_FILE;
+        else if(str == "contextresults")     return CACHE_CONTEXT_RESULTS;
+        else if(str == "configcacheid")      return CACHE_CONFIG_CACHE_ID;
+        else if(str == "processor")          return CACHE_PROCESSOR;
+        else if(str == "optimizedprocessor") return CACHE_OPTIMIZED_PROCESSOR;
+        else if(str == "cpuengine")          return CACHE_CPU_ENGINE;
+        else if(str == "bakedsamples")       return CACHE_BAKED_SAMPLES;
+
+        std::string msg("Unknown cache type: ");
+        msg += (type && *type) ? type : "<null>";
+
+        throw Exception(msg.c_str());
+    }
+
     const char * ROLE_DEFAULT = "default";
     const char * ROLE_REFERENCE = "reference";
     const char * ROLE_DATA = "data";
@@ -385,13 +428,744 @@ OCIO_NAMESPACE_ENTER
         return pretty.str();
     }
     
+    namespace
+    {
+        inline bool IsSpaceChar(char c)
+        {
+            return c==' ' || c=='\t' || c=='\n' || c=='\r' || c=='\v' || c=='\f';
+        }
+        
+        inline bool IsDigitChar(char c)
+        {
+            return c>='0' && c<='9';
+        }
+        
+        inline char ToLowerChar(char c)
+        {
+            return (c>='A' && c<='Z') ? char(c - 'A' + 'a') : c;
+        }
+        
+        // Does [str, end) start with the lower case word, ignoring the case?
+        bool StartsWithWord(const char * str, const char * end, const char * word)
+        {
+            for(; *word; ++word, ++str)
+            {
+                if(str==end || ToLowerChar(*str)!=*word) return false;
+            }
+            return true;
+        }
+        
+        // The powers of 10 which are exactly represented.
+        const float FloatPow10[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f,
+                                     1e9f, 1e10f };
+        const double DoublePow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+                                       1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                       1e18, 1e19, 1e20, 1e21, 1e22 };
+        
+        // Is the double exactly halfway between the float and its next float toward
+        // the double, i.e. would the rounding of the double to float be ambiguous?
+        bool IsHalfway(double d, float f)
+        {
+            const float next = std::nextafter(f, d>f ? std::numeric_limits<float>::infinity()
+                                                     : -std::numeric_limits<float>::infinity());
+            return (double(f) + double(next)) * 0.5 == d;
+        }
+    }
+    
+    namespace
+    {
+        // Decimal number, as scanned by ScanNumber().
+        struct DecimalNumber
+        {
+            bool negative = false;
+            bool nan = false;
+            bool infinity = false;
+            uint64_t mantissa = 0;
+            int exponent = 0;
+            // Some significant digits are not in the mantissa.
+            bool truncated = false;
+        };
+        
+        // Scan the number starting at str. Return the position following the number,
+        // or str if there is none.
+        const char * ScanNumber(const char * str, const char * end, DecimalNumber & number)
+        {
+            const char * ptr = str;
+            
+            if(ptr!=end && (*ptr=='-' || *ptr=='+'))
+            {
+                number.negative = (*ptr=='-');
+                ++ptr;
+            }
+            
+            if(ptr!=end && !IsDigitChar(*ptr) && *ptr!='.')
+            {
+                if(StartsWithWord(ptr, end, "nan"))
+                {
+                    number.nan = true;
+                    return ptr + 3;
+                }
+                if(StartsWithWord(ptr, end, "infinity"))
+                {
+                    number.infinity = true;
+                    return ptr + 8;
+                }
+                if(StartsWithWord(ptr, end, "inf"))
+                {
+                    number.infinity = true;
+                    return ptr + 3;
+                }
+                return str;
+            }
+            
+            // Accumulate up to 19 significant digits. The other digits only matter for
+            // the rounding which is then left to the slow path.
+            static const int MAX_DIGITS = 19;
+            int numDigits = 0;
+            bool hasDigits = false;
+            
+            for(; ptr!=end && IsDigitChar(*ptr); ++ptr)
+            {
+                hasDigits = true;
+                const unsigned digit = unsigned(*ptr - '0');
+                if(numDigits<MAX_DIGITS)
+                {
+                    number.mantissa = number.mantissa * 10 + digit;
+                    if(number.mantissa!=0) ++numDigits;
+                }
+                else
+                {
+                    ++number.exponent;
+                    number.truncated |= (digit!=0);
+                }
+            }
+            
+            if(ptr!=end && *ptr=='.')
+            {
+                ++ptr;
+                for(; ptr!=end && IsDigitChar(*ptr); ++ptr)
+                {
+                    hasDigits = true;
+                    const unsigned digit = unsigned(*ptr - '0');
+                    if(numDigits<MAX_DIGITS)
+                    {
+                        number.mantissa = number.mantissa * 10 + digit;
+                        if(number.mantissa!=0) ++numDigits;
+                        --number.exponent;
+                    }
+                    else
+                    {
+                        number.truncated |= (digit!=0);
+                    }
+                }
+            }
+            
+            if(!hasDigits)
+            {
+                return str;
+            }
+            
+            // The exponent is only part of the number if it has digits.
+            if(ptr!=end && (*ptr=='e' || *ptr=='E'))
+            {
+                const char * expPtr = ptr + 1;
+                bool expNegative = false;
+                if(expPtr!=end && (*expPtr=='-' || *expPtr=='+'))
+                {
+                    expNegative = (*expPtr=='-');
+                    ++expPtr;
+                }
+                
+                if(expPtr!=end && IsDigitChar(*expPtr))
+                {
+                    int exp = 0;
+                    for(; expPtr!=end && IsDigitChar(*expPtr); ++expPtr)
+                    {
+                        if(exp<100000) exp = exp * 10 + (*expPtr - '0');
+                    }
+                    number.exponent += expNegative ? -exp : exp;
+                    ptr = expPtr;
+                }
+            }
+            
+            return ptr;
+        }
+        
+        // When the mantissa and the power of 10 are both exactly represented, a single
+        // multiplication or division gives the correctly rounded result (refer to
+        // "How to Read Floating Point Numbers Accurately", W. D. Clinger).
+        bool FastPathDouble(const DecimalNumber & number, double & value)
+        {
+            if(number.truncated || number.mantissa>(uint64_t(1)<<53)
+               || number.exponent<-22 || number.exponent>22)
+            {
+                return false;
+            }
+            
+            value = double(number.mantissa);
+            value = number.exponent<0 ? value / DoublePow10[-number.exponent]
+                                      : value * DoublePow10[number.exponent];
+            return true;
+        }
+        
+        // The rare other numbers use the "C" locale conversion.
+        template<typename T>
+        bool SlowPath(const char * str, const char * end, T & value)
+        {
+            std::istringstream is(std::string(str, end));
+            is.imbue(std::locale::classic());
+            return bool(is >> value);
+        }
+    }
+    
+    const char * ParseFloat(const char * str, const char * end, float & value)
+    {
+        DecimalNumber number;
+        const char * ptr = ScanNumber(str, end, number);
+        if(ptr==str)
+        {
+            return str;
+        }
+        
+        const float sign = number.negative ? -1.0f : 1.0f;
+        if(number.nan || number.infinity || number.mantissa==0)
+        {
+            value = sign * (number.nan ? std::numeric_limits<float>::quiet_NaN()
+                            : number.infinity ? std::numeric_limits<float>::infinity()
+                            : 0.0f);
+            return ptr;
+        }
+        
+        if(!number.truncated && number.mantissa<=(uint64_t(1)<<24)
+           && number.exponent>=-10 && number.exponent<=10)
+        {
+            float f = float(number.mantissa);
+            f = number.exponent<0 ? f / FloatPow10[-number.exponent]
+                                  : f * FloatPow10[number.exponent];
+            value = sign * f;
+            return ptr;
+        }
+        
+        double d = 0.0;
+        if(FastPathDouble(number, d))
+        {
+            // The double is correctly rounded, and so is its conversion to float
+            // unless the double rounding is ambiguous.
+            const float f = float(d);
+            if(double(f)==d || !IsHalfway(d, f))
+            {
+                value = sign * f;
+                return ptr;
+            }
+        }
+        
+        float f = 0.0f;
+        if(!SlowPath(str, ptr, f))
+        {
+            return str;
+        }
+        value = f;
+        return ptr;
+    }
+    
+    const char * ParseDouble(const char * str, const char * end, double & value)
+    {
+        DecimalNumber number;
+        const char * ptr = ScanNumber(str, end, number);
+        if(ptr==str)
+        {
+            return str;
+        }
+        
+        const double sign = number.negative ? -1.0 : 1.0;
+        if(number.nan || number.infinity || number.mantissa==0)
+        {
+            value = sign * (number.nan ? std::numeric_limits<double>::quiet_NaN()
+                            : number.infinity ? std::numeric_limits<double>::infinity()
+                            : 0.0);
+            return ptr;
+        }
+        
+        double d = 0.0;
+        if(FastPathDouble(number, d))
+        {
+            value = sign * d;
+            return ptr;
+        }
+        
+        if(!SlowPath(str, ptr, d))
+        {
+            return str;
+        }
+        value = d;
+        return ptr;
+    }
+    
+    const char * ParseInt(const char * str, const char * end, int & value)
+    {
+        const char * ptr = str;
+        
+        bool negative = false;
+        if(ptr!=end && (*ptr=='-' || *ptr=='+'))
+        {
+            negative = (*ptr=='-');
+            ++ptr;
+        }
+        
+        if(ptr==end || !IsDigitChar(*ptr))
+        {
+            return str;
+        }
+        
+        static const int64_t MAX_VALUE = int64_t(std::numeric_limits<int>::max()) + 1;
+        int64_t val = 0;
+        for(; ptr!=end && IsDigitChar(*ptr); ++ptr)
+        {
+            val = val * 10 + (*ptr - '0');
+            if(val>MAX_VALUE)
+            {
+                return str;
+            }
+        }
+        
+        if(negative)
+        {
+            val = -val;
+        }
+        else if(val==MAX_VALUE)
+        {
+            return str;
+        }
+        
+        value = int(val);
+        return ptr;
+    }
+
+    namespace
+    {
+        // The rare numbers not handled by the fast paths use the "C" locale of a stream.
+        void FormatSlowPath(std::string & str, double value, int precision, int width, bool fixed)
+        {
+            std::ostringstream os;
+            os.imbue(std::locale::classic());
+            if(fixed)
+            {
+                os.setf(std::ios::fixed, std::ios::floatfield);
+            }
+            os.precision(precision);
+            os.width(width);
+            os << value;
+            str += os.str();
+        }
+
+#ifdef __SIZEOF_INT128__
+        typedef unsigned __int128 uint128_t;
+
+        // The powers of 10 and 5 fitting in 128 bits.
+        struct Powers
+        {
+            uint128_t pow10[39];
+            uint128_t pow5[56];
+
+            Powers()
+            {
+                pow10[0] = 1;
+                for(int i=1; i<39; ++i) pow10[i] = pow10[i-1] * 10;
+                pow5[0] = 1;
+                for(int i=1; i<56; ++i) pow5[i] = pow5[i-1] * 5;
+            }
+        };
+
+        const Powers & GetPowers()
+        {
+            static const Powers powers;
+            return powers;
+        }
+
+        inline int BitLength(uint128_t value)
+        {
+            const uint64_t high = uint64_t(value >> 64);
+            const uint64_t low = uint64_t(value);
+            return high ? 128 - __builtin_clzll(high) : low ? 64 - __builtin_clzll(low) : 0;
+        }
+
+        inline int NumDigits(uint128_t value, const Powers & powers)
+        {
+            // 1233 / 4096 approximates log10(2).
+            const int digits = (BitLength(value) * 1233) >> 12;
+            return digits + (value >= powers.pow10[digits] ? 1 : 0);
+        }
+
+        // Exact decomposition of a positive finite value as n / 10^scale. Return false if
+        // n does not fit in 127 bits, which only happens for the very small or very large
+        // values, and the doubles using most of their mantissa.
+        bool Decompose(double value, const Powers & powers, uint128_t & n, int & scale)
+        {
+            uint64_t bits = 0;
+            memcpy(&bits, &value, sizeof(double));
+
+            const int biasedExponent = int(bits >> 52) & 0x7FF;
+            uint64_t mantissa = bits & ((uint64_t(1) << 52) - 1);
+            int exponent = -1074;
+            if(biasedExponent!=0)
+            {
+                mantissa |= uint64_t(1) << 52;
+                exponent = biasedExponent - 1075;
+            }
+
+            const int zeros = __builtin_ctzll(mantissa);
+            mantissa >>= zeros;
+            exponent += zeros;
+
+            const int mantissaBits = 64 - __builtin_clzll(mantissa);
+            if(exponent>=0)
+            {
+                if(mantissaBits + exponent > 127) return false;
+                n = uint128_t(mantissa) << exponent;
+                scale = 0;
+            }
+            else
+            {
+                // m / 2^k is m * 5^k / 10^k.
+                if(-exponent >= 56) return false;
+                const uint128_t pow5 = powers.pow5[-exponent];
+                if(mantissaBits + BitLength(pow5) > 127) return false;
+                n = uint128_t(mantissa) * pow5;
+                scale = -exponent;
+            }
+            return true;
+        }
+
+        // Divide by 10^shift with the rounding of the C library i.e. to the nearest, and
+        // to even when the value is exactly halfway.
+        inline uint128_t RoundedDivide(uint128_t n, int shift, const Powers & powers)
+        {
+            if((n >> 64) == 0 && shift < 20)
+            {
+                // Much faster than the 128-bit division.
+                const uint64_t n64 = uint64_t(n);
+                const uint64_t divisor = uint64_t(powers.pow10[shift]);
+                uint64_t quotient = n64 / divisor;
+                const uint64_t remainder = n64 - quotient * divisor;
+                const uint64_t half = divisor / 2;
+                if(remainder > half || (remainder == half && (quotient & 1)))
+                {
+                    ++quotient;
+                }
+                return quotient;
+            }
+
+            const uint128_t divisor = powers.pow10[shift];
+            uint128_t quotient = n / divisor;
+            const uint128_t remainder = n - quotient * divisor;
+            const uint128_t half = divisor / 2;
+            if(remainder > half || (remainder == half && (quotient & 1)))
+            {
+                ++quotient;
+            }
+            return quotient;
+        }
+
+        inline void AppendPadded(std::string & str, const char * buffer, int length,
+                                 bool negative, int width)
+        {
+            const int total = length + (negative ? 1 : 0);
+            if(width > total)
+            {
+                str.append(size_t(width - total), ' ');
+            }
+            if(negative)
+            {
+                str += '-';
+            }
+            str.append(buffer, size_t(length));
+        }
+
+        bool FormatGeneralFastPath(std::string & str, double value, int precision, int width)
+        {
+            if(precision > 18) return false;
+            if(precision == 0) precision = 1;
+
+            const bool negative = std::signbit(value);
+            const double absValue = std::fabs(value);
+
+            char buffer[48];
+            int length = 0;
+
+            if(absValue == 0.0)
+            {
+                buffer[length++] = '0';
+                AppendPadded(str, buffer, length, negative, width);
+                return true;
+            }
+
+            const Powers & powers = GetPowers();
+
+            uint128_t n = 0;
+            int scale = 0;
+            if(!Decompose(absValue, powers, n, scale)) return false;
+
+            // The value is 'digits' (having 'precision' digits) times 10^(exponent-precision+1).
+            const int numDigits = NumDigits(n, powers);
+            int exponent = numDigits - 1 - scale;
+            uint64_t digits = 0;
+            if(numDigits > precision)
+            {
+                uint128_t rounded = RoundedDivide(n, numDigits - precision, powers);
+                if(rounded == powers.pow10[precision])
+                {
+                    rounded = powers.pow10[precision - 1];
+                    ++exponent;
+                }
+                digits = uint64_t(rounded);
+            }
+            else
+            {
+                digits = uint64_t(n) * uint64_t(powers.pow10[precision - numDigits]);
+            }
+
+            char chars[20];
+            for(int i=precision-1; i>=0; --i)
+            {
+                chars[i] = char('0' + digits % 10);
+                digits /= 10;
+            }
+
+            // The trailing zeros are removed.
+            int significant = precision;
+            while(significant > 1 && chars[significant - 1] == '0') --significant;
+
+            if(exponent < -4 || exponent >= precision)
+            {
+                buffer[length++] = chars[0];
+                if(significant > 1)
+                {
+                    buffer[length++] = '.';
+                    for(int i=1; i<significant; ++i) buffer[length++] = chars[i];
+                }
+                buffer[length++] = 'e';
+                buffer[length++] = exponent < 0 ? '-' : '+';
+
+                int absExponent = exponent < 0 ? -exponent : exponent;
+                if(absExponent >= 100)
+                {
+                    buffer[length++] = char('0' + absExponent / 100);
+                    absExponent %= 100;
+                }
+                buffer[length++] = char('0' + absExponent / 10);
+                buffer[length++] = char('0' + absExponent % 10);
+            }
+            else if(exponent >= 0)
+            {
+                const int intDigits = exponent + 1;
+                for(int i=0; i<intDigits; ++i) buffer[length++] = chars[i];
+                if(significant > intDigits)
+                {
+                    buffer[length++] = '.';
+                    for(int i=intDigits; i<significant; ++i) buffer[length++] = chars[i];
+                }
+            }
+            else
+            {
+                buffer[length++] = '0';
+                buffer[length++] = '.';
+                for(int i=1; i<-exponent; ++i) buffer[length++] = '0';
+                for(int i=0; i<significant; ++i) buffer[length++] = chars[i];
+            }
+
+            AppendPadded(str, buffer, length, negative, width);
+            return true;
+        }
+
+        bool FormatFixedFastPath(std::string & str, double value, int precision, int width)
+        {
+            if(precision > 18) return false;
+
+            const bool negative = std::signbit(value);
+            const double absValue = std::fabs(value);
+
+            // The value is 'digits' times 10^-precision.
+            uint64_t digits = 0;
+            if(absValue != 0.0)
+            {
+                const Powers & powers = GetPowers();
+
+                uint128_t n = 0;
+                int scale = 0;
+                if(!Decompose(absValue, powers, n, scale)) return false;
+
+                if(scale > precision)
+                {
+                    const int shift = scale - precision;
+                    // Otherwise n (below 2^127) rounds to 0.
+                    if(shift < 39)
+                    {
+                        const uint128_t rounded = RoundedDivide(n, shift, powers);
+                        if(rounded >> 64) return false;
+                        digits = uint64_t(rounded);
+                    }
+                }
+                else
+                {
+                    const int shift = precision - scale;
+                    if(NumDigits(n, powers) + shift > 19) return false;
+                    digits = uint64_t(n) * uint64_t(powers.pow10[shift]);
+                }
+            }
+
+            char chars[24];
+            int numChars = 0;
+            while(digits != 0 || numChars <= precision)
+            {
+                chars[numChars++] = char('0' + digits % 10);
+                digits /= 10;
+            }
+
+            char buffer[48];
+            int length = 0;
+            for(int i=numChars-1; i>=precision; --i) buffer[length++] = chars[i];
+            if(precision > 0)
+            {
+                buffer[length++] = '.';
+                for(int i=precision-1; i>=0; --i) buffer[length++] = chars[i];
+            }
+
+            AppendPadded(str, buffer, length, negative, width);
+            return true;
+        }
+#else
+        bool FormatGeneralFastPath(std::string &, double, int, int)
+        {
+            return false;
+        }
+
+        bool FormatFixedFastPath(std::string &, double, int, int)
+        {
+            return false;
+        }
+#endif
+    }
+
+    void AppendGeneral(std::string & str, double value, int precision, int width)
+    {
+        // Like the streams, a negative precision means the default one.
+        if(precision < 0) precision = 6;
+
+        if(!std::isfinite(value) || !FormatGeneralFastPath(str, value, precision, width))
+        {
+            FormatSlowPath(str, value, precision, width, false);
+        }
+    }
+
+    void AppendFixed(std::string & str, double value, int precision, int width)
+    {
+        if(precision < 0) precision = 6;
+
+        if(!std::isfinite(value) || !FormatFixedFastPath(str, value, precision, width))
+        {
+            FormatSlowPath(str, value, precision, width, true);
+        }
+    }
+
+    NumberWriter::NumberWriter(std::ostream & stream)
+        :   m_stream(stream)
+    {
+        m_buffer.reserve(BUFFER_SIZE + 256);
+    }
+
+    NumberWriter::~NumberWriter()
+    {
+        try
+        {
+            flush();
+        }
+        catch(...)
+        {
+            // The errors are only reported by an explicit flush().
+        }
+    }
+
+    void NumberWriter::flush()
+    {
+        if(!m_buffer.empty())
+        {
+            m_stream.write(m_buffer.data(), std::streamsize(m_buffer.size()));
+            m_buffer.clear();
+        }
+    }
+
+    LineTokenizer::LineTokenizer(const char * str, size_t len)
+        :   m_pos(str)
+        ,   m_end(str + len)
+        ,   m_token(str)
+        ,   m_tokenLength(0)
+    {
+    }
+    
+    LineTokenizer::LineTokenizer(const std::string & line)
+        :   LineTokenizer(line.c_str(), line.size())
+    {
+    }
+    
+    bool LineTokenizer::next()
+    {
+        while(m_pos!=m_end && IsSpaceChar(*m_pos)) ++m_pos;
+        m_token = m_pos;
+        while(m_pos!=m_end && !IsSpaceChar(*m_pos)) ++m_pos;
+        m_tokenLength = size_t(m_pos - m_token);
+        return m_tokenLength!=0;
+    }
+    
+    bool LineTokenizer::isToken(const char * str) const
+    {
+        size_t i = 0;
+        for(; i<m_tokenLength; ++i)
+        {
+            if(str[i]=='\0' || ToLowerChar(m_token[i])!=str[i]) return false;
+        }
+        return str[i]=='\0';
+    }
+    
+    bool LineTokenizer::getFloat(float & value) const
+    {
+        const char * end = m_token + m_tokenLength;
+        float val = 0.0f;
+        if(m_tokenLength==0 || ParseFloat(m_token, end, val)!=end)
+        {
+            return false;
+        }
+        value = val;
+        return true;
+    }
+    
+    bool LineTokenizer::getInt(int & value) const
+    {
+        const char * end = m_token + m_tokenLength;
+        int val = 0;
+        if(m_tokenLength==0 || ParseInt(m_token, end, val)!=end)
+        {
+            return false;
+        }
+        value = val;
+        return true;
+    }
+    
+    bool LineTokenizer::atEnd() const
+    {
+        const char * pos = m_pos;
+        while(pos!=m_end && IsSpaceChar(*pos)) ++pos;
+        return pos==m_end;
+    }
+    
     bool StringToFloat(float * fval, const char * str)
     {
         if(!str) return false;
         
-        std::istringstream inputStringstream(str);
-        float x;
-        if(!(inputStringstream >> x))
+        const char * end = str + strlen(str);
+        while(str!=end && IsSpaceChar(*str)) ++str;
+        
+        float x = 0.0f;
+        if(ParseFloat(str, end, x)==str)
         {
             return false;
         }
@@ -405,9 +1179,14 @@ OCIO_NAMESPACE_ENTER
         if(!str) return false;
         if(!ival) return false;
         
-        std::istringstream i(str);
-        char c=0;
-        if (!(i >> *ival) || (failIfLeftoverChars && i.get(c))) return false;
+        const char * end = str + strlen(str);
+        while(str!=end && IsSpaceChar(*str)) ++str;
+        
+        int x = 0;
+        const char * ptr = ParseInt(str, end, x);
+        if(ptr==str || (failIfLeftoverChars && ptr!=end)) return false;
+        
+        *ival = x;
         return true;
     }
     
@@ -442,13 +1221,10 @@ OCIO_NAMESPACE_ENTER
         
         for(unsigned int i=0; i<lineParts.size(); i++)
         {
-            std::istringstream inputStringstream(lineParts[i]);
-            float x;
-            if(!(inputStringstream >> x))
+            if(!StringToFloat(&floatArray[i], lineParts[i].c_str()))
             {
                 return false;
             }
-            floatArray[i] = x;
         }
         
         return true;
@@ -492,7 +1268,7 @@ OCIO_NAMESPACE_ENTER
             {
                 line.resize(line.size() - 1);
             }
-            if(!pystring::strip(line).empty())
+            if(line.find_first_not_of(" \t\n\r\v\f")!=std::string::npos)
             {
                 return true;
             }
@@ -502,6 +1278,32 @@ OCIO_NAMESPACE_ENTER
         return false;
     }
     
+    bool nextline(const char * & pos, const char * end, const char * & line, size_t & length)
+    {
+        while(pos < end)
+        {
+            line = pos;
+            const char * eol = static_cast<const char *>(memchr(pos, '\n', size_t(end - pos)));
+            pos = eol ? eol + 1 : end;
+            length = size_t((eol ? eol : end) - line);
+            if(length > 0 && line[length - 1] == '\r')
+            {
+                --length;
+            }
+            for(size_t i = 0; i < length; ++i)
+            {
+                if(!IsSpaceChar(line[i]))
+                {
+                    return true;
+                }
+            }
+        }
+        
+        line = end;
+        length = 0;
+        return false;
+    }
+    
     
     bool StrEqualsCaseIgnore(const std::string & a, const std::string & b)
     {
@@ -591,6 +1393,9 @@ OCIO_NAMESPACE_EXIT
 
 namespace OCIO = OCIO_NAMESPACE;
 
+#include <cstdio>
+#include <cstdlib>
+
 #include "UnitTest.h"
 
 OCIO_ADD_TEST(ParseUtils, XMLText)
@@ -749,6 +1554,21 @@ OCIO_ADD_TEST(ParseUtils, ColorSpace)
     OCIO_CHECK_EQUAL(OCIO::COLORSPACE_DIR_UNKNOWN, resCSD);
 }
 
+OCIO_ADD_TEST(ParseUtils, CacheType)
+{
+    for(int i = OCIO::CACHE_FILE; i <= OCIO::CACHE_BAKED_SAMPLES; ++i)
+    {
+        const OCIO::CacheType type = static_cast<OCIO::CacheType>(i);
+        OCIO_CHECK_EQUAL(OCIO::CacheTypeFromString(OCIO::CacheTypeToString(type)), type);
+    }
+
+    OCIO_CHECK_EQUAL(OCIO::CacheTypeFromString("FileHash"), OCIO::CACHE_FILE_HASH);
+    OCIO_CHECK_THROW_WHAT(OCIO::CacheTypeFromString("unknown"), OCIO::Exception,
+                          "Unknown cache type: unknown");
+    OCIO_CHECK_THROW_WHAT(OCIO::CacheTypeFromString(nullptr), OCIO::Exception,
+                          "Unknown cache type: <null>");
+}
+
 OCIO_ADD_TEST(ParseUtils, BitDepth)
 {
     std::string resStr;
@@ -920,6 +1740,314 @@ OCIO_ADD_TEST(ParseUtils, StringToFloat)
     OCIO_CHECK_EQUAL(fval, 1.0f);
 }
 
+namespace
+{
+// Check that the number is parsed exactly like strtof() in the "C" locale.
+void CheckParseFloat(const std::string & str)
+{
+    const char * end = str.c_str() + str.size();
+
+    float value = -1.0f;
+    OCIO_CHECK_ASSERT_MESSAGE(OCIO::ParseFloat(str.c_str(), end, value) == end,
+                              "Could not parse '" << str << "'");
+
+    const float expected = strtof(str.c_str(), nullptr);
+    OCIO_CHECK_ASSERT_MESSAGE(memcmp(&value, &expected, sizeof(float)) == 0,
+                              "Wrong conversion of '" << str << "'");
+}
+}
+
+OCIO_ADD_TEST(ParseUtils, ParseFloat)
+{
+    const char * numbers[] = { "0", "-0", "1", "-1.5", "+2.25", ".5", "5.", "0.1", "1e-3",
+                               "1.5E+2", "0.000001", "65504", "3.4028235e38", "1.17549435e-38",
+                               "1e-45", "0.333333333333333333333333333333",
+                               "123456789012345678901234567890", "16777217", "9007199254740993",
+                               "0.30000001192092896", "1.00000005960464477539062500001",
+                               "1.000000059604644775390625" };
+    for(const char * number : numbers)
+    {
+        CheckParseFloat(number);
+    }
+
+    // Compare the conversion of many random floats written with various precisions.
+    unsigned seed = 1;
+    for(int i=0; i<100000; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        uint32_t bits = seed;
+        float f = 0.0f;
+        memcpy(&f, &bits, sizeof(float));
+        if(!std::isfinite(f)) continue;
+
+        char buffer[64];
+        snprintf(buffer, sizeof(buffer), "%.9g", f);
+        CheckParseFloat(buffer);
+        snprintf(buffer, sizeof(buffer), "%.17g", double(f));
+        CheckParseFloat(buffer);
+        snprintf(buffer, sizeof(buffer), "%.6f", double(seed % 100000) / 65535.0);
+        CheckParseFloat(buffer);
+    }
+
+    float value = 0.0f;
+    const std::string inf("-inf");
+    OCIO_CHECK_ASSERT(OCIO::ParseFloat(inf.c_str(), inf.c_str() + 4, value) == inf.c_str() + 4);
+    OCIO_CHECK_EQUAL(value, -std::numeric_limits<float>::infinity());
+    const std::string nan("NaN");
+    OCIO_CHECK_ASSERT(OCIO::ParseFloat(nan.c_str(), nan.c_str() + 3, value) == nan.c_str() + 3);
+    OCIO_CHECK_ASSERT(std::isnan(value));
+
+    // Partial or invalid numbers.
+    const std::string partial("1.5e+x");
+    OCIO_CHECK_ASSERT(OCIO::ParseFloat(partial.c_str(), partial.c_str() + 6, value)
+                      == partial.c_str() + 3);
+    OCIO_CHECK_EQUAL(value, 1.5f);
+    // The range does not need to be null terminated.
+    OCIO_CHECK_ASSERT(OCIO::ParseFloat(partial.c_str(), partial.c_str() + 2, value)
+                      == partial.c_str() + 2);
+    OCIO_CHECK_EQUAL(value, 1.0f);
+
+    const char * invalids[] = { "", "-", ".", "e5", "x1", "1e39" };
+    for(const char * invalid : invalids)
+    {
+        OCIO_CHECK_ASSERT(OCIO::ParseFloat(invalid, invalid + strlen(invalid), value) == invalid);
+    }
+}
+
+OCIO_ADD_TEST(ParseUtils, ParseDouble)
+{
+    // Compare with strtod() the conversion of many random doubles written with
+    // various precisions.
+    unsigned seed = 1;
+    for(int i=0; i<100000; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        const double d = double(seed) / 4294967296.0 * std::pow(10.0, int(seed % 13) - 6);
+
+        for(const char * format : { "%.17g", "%.9g", "%.6f", "%.3e" })
+        {
+            char buffer[64];
+            snprintf(buffer, sizeof(buffer), format, d);
+            const size_t len = strlen(buffer);
+
+            double value = 0.0;
+            OCIO_REQUIRE_ASSERT(OCIO::ParseDouble(buffer, buffer + len, value) == buffer + len);
+            OCIO_CHECK_EQUAL(value, strtod(buffer, nullptr));
+        }
+    }
+
+    double value = 0.0;
+    const std::string number("-1.25e-3,");
+    OCIO_CHECK_ASSERT(OCIO::ParseDouble(number.c_str(), number.c_str() + number.size(), value)
+                      == number.c_str() + 8);
+    OCIO_CHECK_EQUAL(value, -1.25e-3);
+    const std::string inf("inf");
+    OCIO_CHECK_ASSERT(OCIO::ParseDouble(inf.c_str(), inf.c_str() + 3, value) == inf.c_str() + 3);
+    OCIO_CHECK_EQUAL(value, std::numeric_limits<double>::infinity());
+
+    const char * invalids[] = { "", "-", ".", "e5", "x1", "1e400" };
+    for(const char * invalid : invalids)
+    {
+        OCIO_CHECK_ASSERT(OCIO::ParseDouble(invalid, invalid + strlen(invalid), value) == invalid);
+    }
+}
+
+OCIO_ADD_TEST(ParseUtils, ParseInt)
+{
+    int value = 0;
+    const std::string max("2147483647");
+    OCIO_CHECK_ASSERT(OCIO::ParseInt(max.c_str(), max.c_str() + max.size(), value)
+                      == max.c_str() + max.size());
+    OCIO_CHECK_EQUAL(value, 2147483647);
+    const std::string min("-2147483648");
+    OCIO_CHECK_ASSERT(OCIO::ParseInt(min.c_str(), min.c_str() + min.size(), value)
+                      == min.c_str() + min.size());
+    OCIO_CHECK_EQUAL(value, std::numeric_limits<int>::min());
+
+    const std::string partial("+12x");
+    OCIO_CHECK_ASSERT(OCIO::ParseInt(partial.c_str(), partial.c_str() + 4, value)
+                      == partial.c_str() + 3);
+    OCIO_CHECK_EQUAL(value, 12);
+
+    const char * invalids[] = { "", "-", "x1", "2147483648", "-2147483649", "99999999999999" };
+    for(const char * invalid : invalids)
+    {
+        OCIO_CHECK_ASSERT(OCIO::ParseInt(invalid, invalid + strlen(invalid), value) == invalid);
+    }
+}
+
+namespace
+{
+void CheckFormat(double value, int precision, int width)
+{
+    char expected[512];
+    std::string str;
+
+    snprintf(expected, sizeof(expected), "%*.*g", width, precision, value);
+    OCIO::AppendGeneral(str, value, precision, width);
+    OCIO_REQUIRE_EQUAL(str, std::string(expected));
+
+    str.clear();
+    snprintf(expected, sizeof(expected), "%*.*f", width, precision, value);
+    OCIO::AppendFixed(str, value, precision, width);
+    OCIO_REQUIRE_EQUAL(str, std::string(expected));
+}
+}
+
+OCIO_ADD_TEST(ParseUtils, AppendGeneral)
+{
+    const double numbers[] = { 0.0, -0.0, 1.0, -1.0, 0.5, 0.125, 0.1, 2.5, 3.5, 1e-5, 1e-4,
+                               0.00012345, 123456.0, 1234567.0, 9.9999995, 0.99999999,
+                               65504.0, 1e21, 1e22, 1.5e300, 4.9e-324, 2.2250738585072014e-308,
+                               0.30000001192092896, 1.0000000596046448, 999999.5, 0.0625 };
+    const int precisions[] = { 0, 1, 2, 5, 6, 8, 15, 17, 20 };
+    for(double number : numbers)
+    {
+        for(int precision : precisions)
+        {
+            CheckFormat(number, precision, 0);
+            CheckFormat(-number, precision, 0);
+        }
+        CheckFormat(number, 8, 11);
+        CheckFormat(-number, 15, 19);
+    }
+
+    // Compare many random floats and doubles, and values of a LUT of integer codes.
+    unsigned seed = 1;
+    for(int i=0; i<20000; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        uint32_t bits = seed;
+        float f = 0.0f;
+        memcpy(&f, &bits, sizeof(float));
+        if(std::isfinite(f))
+        {
+            CheckFormat(f, 8, 11);
+            CheckFormat(f, 5, 0);
+            CheckFormat(f, 6, 0);
+        }
+
+        const uint64_t bits64 = (uint64_t(seed) << 32) | (seed * 2654435761u);
+        double d = 0.0;
+        memcpy(&d, &bits64, sizeof(double));
+        if(std::isfinite(d))
+        {
+            CheckFormat(d, 15, 19);
+        }
+
+        const double code = double(seed % 65536) / 65535.0;
+        CheckFormat(code, 6, 0);
+        CheckFormat(float(code), 8, 0);
+    }
+
+    // The non-finite values.
+    std::string str;
+    OCIO::AppendGeneral(str, std::numeric_limits<double>::infinity(), 8, 5);
+    OCIO_CHECK_EQUAL(str, std::string("  inf"));
+    str.clear();
+    OCIO::AppendFixed(str, -std::numeric_limits<double>::infinity(), 6);
+    OCIO_CHECK_EQUAL(str, std::string("-inf"));
+    str.clear();
+    OCIO::AppendGeneral(str, std::numeric_limits<double>::quiet_NaN(), 8);
+    OCIO_CHECK_EQUAL(str, std::string("nan"));
+}
+
+OCIO_ADD_TEST(ParseUtils, NumberWriter)
+{
+    std::ostringstream expected;
+    for(int i=0; i<20000; ++i)
+    {
+        char line[64];
+        snprintf(line, sizeof(line), "%.6f %11.8g\n", double(i) / 3.0, double(i) / 7.0);
+        expected << line;
+    }
+
+    std::ostringstream os;
+    os.precision(3);
+    {
+        OCIO::NumberWriter writer(os);
+        for(int i=0; i<20000; ++i)
+        {
+            writer.writeFixed(double(i) / 3.0, 6);
+            writer.write(' ');
+            writer.writeGeneral(double(i) / 7.0, 8, 11);
+            writer.write("\n");
+        }
+        // The end of the text is still buffered.
+        OCIO_CHECK_ASSERT(os.str().size() > 0);
+        OCIO_CHECK_ASSERT(os.str().size() < expected.str().size());
+    }
+
+    // The stream state is not changed.
+    OCIO_CHECK_EQUAL(os.str(), expected.str());
+    OCIO_CHECK_EQUAL(os.precision(), 3);
+}
+
+OCIO_ADD_TEST(ParseUtils, LineTokenizer)
+{
+    const std::string line("  LUT_3D_SIZE\t33 0.5 1e-2x  ");
+    OCIO::LineTokenizer tokens(line);
+
+    OCIO_REQUIRE_ASSERT(tokens.next());
+    OCIO_CHECK_EQUAL(std::string(tokens.token(), tokens.tokenLength()), "LUT_3D_SIZE");
+    OCIO_CHECK_ASSERT(tokens.isToken("lut_3d_size"));
+    OCIO_CHECK_ASSERT(!tokens.isToken("lut_3d"));
+    OCIO_CHECK_ASSERT(!tokens.isToken("lut_3d_size_"));
+
+    int size = 0;
+    OCIO_CHECK_ASSERT(tokens.nextInt(size));
+    OCIO_CHECK_EQUAL(size, 33);
+
+    float value = 0.0f;
+    OCIO_CHECK_ASSERT(tokens.getFloat(value));
+    OCIO_CHECK_EQUAL(value, 33.0f);
+    OCIO_CHECK_ASSERT(tokens.nextFloat(value));
+    OCIO_CHECK_EQUAL(value, 0.5f);
+    OCIO_CHECK_ASSERT(!tokens.getInt(size));
+    OCIO_CHECK_ASSERT(!tokens.atEnd());
+
+    // The whole token must be a number.
+    OCIO_CHECK_ASSERT(!tokens.nextFloat(value));
+    OCIO_CHECK_EQUAL(value, 0.5f);
+
+    OCIO_CHECK_ASSERT(tokens.atEnd());
+    OCIO_CHECK_ASSERT(!tokens.next());
+    OCIO_CHECK_ASSERT(!tokens.nextFloat(value));
+
+    OCIO::LineTokenizer empty("", 0);
+    OCIO_CHECK_ASSERT(empty.atEnd());
+    OCIO_CHECK_ASSERT(!empty.next());
+}
+
+OCIO_ADD_TEST(ParseUtils, nextline_buffer)
+{
+    const std::string content("first line\r\n \t\n\n  second\nlast");
+    const char * pos = content.data();
+    const char * end = pos + content.size();
+    const char * line = nullptr;
+    size_t length = 0;
+
+    OCIO_REQUIRE_ASSERT(OCIO::nextline(pos, end, line, length));
+    OCIO_CHECK_EQUAL(std::string(line, length), "first line");
+    OCIO_REQUIRE_ASSERT(OCIO::nextline(pos, end, line, length));
+    OCIO_CHECK_EQUAL(std::string(line, length), "  second");
+    OCIO_REQUIRE_ASSERT(OCIO::nextline(pos, end, line, length));
+    OCIO_CHECK_EQUAL(std::string(line, length), "last");
+    OCIO_CHECK_ASSERT(!OCIO::nextline(pos, end, line, length));
+    OCIO_CHECK_EQUAL(length, 0);
+
+    // Same lines as the stream version.
+    std::istringstream istream(content);
+    std::string streamLine;
+    pos = content.data();
+    while(OCIO::nextline(istream, streamLine))
+    {
+        OCIO_REQUIRE_ASSERT(OCIO::nextline(pos, end, line, length));
+        OCIO_CHECK_EQUAL(std::string(line, length), streamLine);
+    }
+    OCIO_CHECK_ASSERT(!OCIO::nextline(pos, end, line, length));
+}
+
 OCIO_ADD_TEST(ParseUtils, FloatDouble)
 {
     std::string resStr;
@@ -34,6 +34,97 @@ OCIO_NAMESPACE_ENTER
     bool StringVecToIntVec(std::vector<int> & intArray,
                            const StringVec & lineParts);
     
+    // Locale independent parsing of the number starting at str, the [str, end) range
+    // does not need to be null terminated and the leading spaces are not skipped.
+    // Return the position following the number, or str if no number could be parsed.
+    // The numbers are correctly rounded, like with strtof() and strtod() in the "C" locale.
+    const char * ParseFloat(const char * str, const char * end, float & value);
+    const char * ParseDouble(const char * str, const char * end, double & value);
+    const char * ParseInt(const char * str, const char * end, int & value);
+
+    // Locale independent formatting of a number appended to str, producing exactly the
+    // characters of printf("%*.*g") and printf("%*.*f") (i.e. of a stream with the given
+    // precision, in its default or fixed notation) in the "C" locale. The common numbers
+    // are formatted from an exact integer decomposition of the value, without any call
+    // to the C library.
+    void AppendGeneral(std::string & str, double value, int precision, int width = 0);
+    void AppendFixed(std::string & str, double value, int precision, int width = 0);
+
+    // Buffered writing of the numbers of a LUT to a stream. The text is only handed to
+    // the stream in large blocks, when the buffer is full and by flush() or the
+    // destructor. The stream state (i.e. precision, notation and width) is not used.
+    class NumberWriter
+    {
+    public:
+        explicit NumberWriter(std::ostream & stream);
+        NumberWriter() = delete;
+        NumberWriter(const NumberWriter &) = delete;
+        NumberWriter & operator=(const NumberWriter &) = delete;
+        ~NumberWriter();
+
+        void write(const char * str) { m_buffer += str; flushIfFull(); }
+        void write(char c) { m_buffer += c; flushIfFull(); }
+
+        void writeGeneral(double value, int precision, int width = 0)
+        {
+            AppendGeneral(m_buffer, value, precision, width);
+            flushIfFull();
+        }
+        void writeFixed(double value, int precision, int width = 0)
+        {
+            AppendFixed(m_buffer, value, precision, width);
+            flushIfFull();
+        }
+
+        void flush();
+
+    private:
+        void flushIfFull()
+        {
+            if(m_buffer.size()>=BUFFER_SIZE) flush();
+        }
+
+        static constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+        std::ostream & m_stream;
+        std::string m_buffer;
+    };
+
+    // Split a line of text on spaces without any allocation. The tokens point into the
+    // line which must outlive the tokenizer.
+    class LineTokenizer
+    {
+    public:
+        LineTokenizer(const char * str, size_t len);
+        explicit LineTokenizer(const std::string & line);
+        LineTokenizer() = delete;
+        
+        // Move to the next token, return false if there is none.
+        bool next();
+        
+        const char * token() const { return m_token; }
+        size_t tokenLength() const { return m_tokenLength; }
+        
+        // Compare the current token ignoring the case, str must be in lower case.
+        bool isToken(const char * str) const;
+        
+        // Convert the current token, fail if the whole token is not a number.
+        bool getFloat(float & value) const;
+        bool getInt(int & value) const;
+        
+        bool nextFloat(float & value) { return next() && getFloat(value); }
+        bool nextInt(int & value) { return next() && getInt(value); }
+        
+        // Return true if there is no token left.
+        bool atEnd() const;
+        
+    private:
+        const char * m_pos;
+        const char * m_end;
+        const char * m_token;
+        size_t m_tokenLength;
+    };
+    
     //////////////////////////////////////////////////////////////////////////
     
     // read the next non empty line, and store it in 'line'
@@ -41,6 +132,10 @@ OCIO_NAMESPACE_ENTER
     
     bool nextline(std::istream &istream, std::string &line);
     
+    // Same as above for the content of a buffer, without any copy. 'pos' is advanced past
+    // the line, which is returned without its line ending.
+    bool nextline(const char * & pos, const char * end, const char * & line, size_t & length);
+    
     bool StrEqualsCaseIgnore(const std::string & a, const std::string & b);
     
     // If a ',' is in the string, split on it
@@ -1,16 +1,21 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <atomic>
+#include <chrono>
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <set>
 #include <sstream>
+#include <vector>
 #include <sys/stat.h>
 #include <errno.h>
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "CacheStatistics.h"
 #include "Mutex.h"
 #include "PathUtils.h"
 #include "Platform.h"
@@ -40,81 +45,258 @@ OCIO_NAMESPACE_ENTER
             struct stat results;
             if (stat(filename.c_str(), &results) == 0)
             {
-                // Treat the mtime + inode as a proxy for the contents
+                // Treat the mtime + inode + size as a proxy for the contents
                 std::ostringstream fasthash;
                 fasthash << results.st_ino << ":";
-                fasthash << results.st_mtime;
+                fasthash << results.st_mtime << ":";
+                fasthash << results.st_size;
                 return fasthash.str();
             }
             
             return "";
         }
         
+        // Duration (in seconds) of the negative results, a negative value means until
+        // ClearAllCaches().
+        std::atomic<double> g_missingFileCacheTTL(0.0);
+        std::atomic<unsigned> g_pathCachesGeneration(0);
+        std::atomic<bool> g_directoryIndexEnabled(false);
+
         // We mutex both the main map and each item individually, so that
         // the potentially slow stat calls dont block other lookups to already
         // existing items. (The stat calls will block other lookups on the
-        // *same* file though).
+        // *same* file though). The map is sharded to limit the contention, and
+        // the lookups of the hash of an existing file do not lock the item.
+        // A missing file is checked again once its negative result expired.
         
         struct FileHashResult
         {
             Mutex mutex;
             std::string hash;
-            bool ready;
+            // The hash of an existing file never changes once computed.
+            std::atomic<bool> ready;
+            bool checked;
+            std::chrono::steady_clock::time_point checkTime;
             
             FileHashResult():
-                ready(false)
+                ready(false),
+                checked(false)
             {}
         };
         
         typedef OCIO_SHARED_PTR<FileHashResult> FileHashResultPtr;
         typedef std::map<std::string, FileHashResultPtr> FileCacheMap;
+
+        struct FileHashShard
+        {
+            Mutex mutex;
+            FileCacheMap cache;
+        };
         
-        FileCacheMap g_fastFileHashCache;
-        Mutex g_fastFileHashCache_mutex;
+        CacheShards<FileHashShard> g_fastFileHashCache;
+
+        size_t GetFileHashEntrySize(const std::string & filename)
+        {
+            return sizeof(FileCacheMap::value_type) + sizeof(FileHashResult) + filename.size();
+        }
+
+        // The index holds the listing of the directories of the looked up files, so the
+        // files missing from a listing are reported without any stat call.
+
+        struct DirectoryListing
+        {
+            Mutex mutex;
+            bool listed = false;
+            bool valid = false;
+            std::chrono::steady_clock::time_point listTime;
+            std::set<std::string> filenames;
+        };
+
+        typedef OCIO_SHARED_PTR<DirectoryListing> DirectoryListingPtr;
+        typedef std::map<std::string, DirectoryListingPtr> DirectoryIndexMap;
+
+        struct DirectoryIndexShard
+        {
+            Mutex mutex;
+            DirectoryIndexMap index;
+        };
+
+        CacheShards<DirectoryIndexShard> g_directoryIndex;
+
+        std::string GetIndexedFilename(const std::string & filename)
+        {
+#if defined(_WIN32) || defined(__APPLE__)
+            // Case insensitive file systems.
+            return pystring::lower(filename);
+#else
+            return filename;
+#endif
+        }
+
+        bool IsMissingFromDirectoryIndex(const std::string & filepath)
+        {
+            std::string dirname, basename;
+            pystring::os::path::split(dirname, basename, filepath);
+            if(dirname.empty() || basename.empty())
+            {
+                return false;
+            }
+
+            DirectoryListingPtr listing;
+            {
+                DirectoryIndexShard & shard = g_directoryIndex.get(dirname);
+                AutoMutex lock(shard.mutex);
+                DirectoryListingPtr & entry = shard.index[dirname];
+                if(!entry)
+                {
+                    entry = std::make_shared<DirectoryListing>();
+                }
+                listing = entry;
+            }
+
+            AutoMutex lock(listing->mutex);
+            if(!listing->listed || IsMissingFileResultExpired(listing->listTime))
+            {
+                std::vector<std::string> filenames;
+                listing->valid = Platform::ListDirectory(dirname, filenames);
+                listing->filenames.clear();
+                for(const auto & name : filenames)
+                {
+                    listing->filenames.insert(GetIndexedFilename(name));
+                }
+                listing->listTime = std::chrono::steady_clock::now();
+                listing->listed = true;
+            }
+
+            // A directory which could not be listed gives no information.
+            return listing->valid
+                && listing->filenames.find(GetIndexedFilename(basename)) == listing->filenames.end();
+        }
     }
     
     std::string GetFastFileHash(const std::string & filename)
     {
         FileHashResultPtr fileHashResultPtr;
         {
-            AutoMutex lock(g_fastFileHashCache_mutex);
-            FileCacheMap::iterator iter = g_fastFileHashCache.find(filename);
-            if(iter != g_fastFileHashCache.end())
+            FileHashShard & shard = g_fastFileHashCache.get(filename);
+            AutoMutex lock(shard.mutex);
+            FileCacheMap::iterator iter = shard.cache.find(filename);
+            if(iter != shard.cache.end())
             {
+                GetCacheCounters(CACHE_FILE_HASH).addHit();
                 fileHashResultPtr = iter->second;
             }
             else
             {
+                GetCacheCounters(CACHE_FILE_HASH).addMiss();
+                GetCacheCounters(CACHE_FILE_HASH).addEntries(1, GetFileHashEntrySize(filename));
                 fileHashResultPtr = FileHashResultPtr(new FileHashResult);
-                g_fastFileHashCache[filename] = fileHashResultPtr;
+                shard.cache[filename] = fileHashResultPtr;
             }
         }
         
-        std::string hash;
+        if(fileHashResultPtr->ready.load(std::memory_order_acquire))
+        {
+            return fileHashResultPtr->hash;
+        }
+
+        AutoMutex lock(fileHashResultPtr->mutex);
+        if(!fileHashResultPtr->ready.load(std::memory_order_relaxed)
+           && (!fileHashResultPtr->checked
+               || IsMissingFileResultExpired(fileHashResultPtr->checkTime)))
         {
-            AutoMutex lock(fileHashResultPtr->mutex);
-            if(!fileHashResultPtr->ready)
+            CacheMissTimer missTimer(CACHE_FILE_HASH);
+            fileHashResultPtr->hash = ComputeHash(filename);
+            fileHashResultPtr->checkTime = std::chrono::steady_clock::now();
+            fileHashResultPtr->checked = true;
+            if(!fileHashResultPtr->hash.empty())
             {
-                fileHashResultPtr->ready = true;
-                fileHashResultPtr->hash = ComputeHash(filename);
+                fileHashResultPtr->ready.store(true, std::memory_order_release);
             }
-            
-            hash = fileHashResultPtr->hash;
         }
         
-        return hash;
+        return fileHashResultPtr->hash;
     }
     
+    std::string ComputeFastFileHash(const std::string & filename)
+    {
+        return ComputeHash(filename);
+    }
+
+    void ClearFastFileHash(const std::string & filename)
+    {
+        FileHashShard & shard = g_fastFileHashCache.get(filename);
+        AutoMutex lock(shard.mutex);
+        if(shard.cache.erase(filename)!=0)
+        {
+            GetCacheCounters(CACHE_FILE_HASH).removeEntries(1, GetFileHashEntrySize(filename));
+        }
+    }
+
     bool FileExists(const std::string & filename)
     {
+        if(g_directoryIndexEnabled && g_missingFileCacheTTL != 0.0
+           && IsMissingFromDirectoryIndex(filename))
+        {
+            return false;
+        }
+
         std::string hash = GetFastFileHash(filename);
         return (!hash.empty());
     }
+
+    bool IsMissingFileResultExpired(const std::chrono::steady_clock::time_point & checkTime)
+    {
+        const double ttl = g_missingFileCacheTTL;
+        return ttl >= 0.0
+            && std::chrono::duration<double>(std::chrono::steady_clock::now() - checkTime).count() >= ttl;
+    }
+
+    unsigned GetPathCachesGeneration()
+    {
+        return g_pathCachesGeneration;
+    }
+
+    void SetMissingFileCacheTTL(double seconds)
+    {
+        g_missingFileCacheTTL = seconds;
+    }
+
+    double GetMissingFileCacheTTL()
+    {
+        return g_missingFileCacheTTL;
+    }
+
+    void SetDirectoryIndexEnabled(bool enabled)
+    {
+        g_directoryIndexEnabled = enabled;
+    }
+
+    bool IsDirectoryIndexEnabled()
+    {
+        return g_directoryIndexEnabled;
+    }
     
     void ClearPathCaches()
     {
-        AutoMutex lock(g_fastFileHashCache_mutex);
-        g_fastFileHashCache.clear();
+        ++g_pathCachesGeneration;
+
+        for(size_t i=0; i<g_directoryIndex.size(); ++i)
+        {
+            AutoMutex lock(g_directoryIndex[i].mutex);
+            g_directoryIndex[i].index.clear();
+        }
+
+        for(size_t i=0; i<g_fastFileHashCache.size(); ++i)
+        {
+            FileHashShard & shard = g_fastFileHashCache[i];
+            AutoMutex lock(shard.mutex);
+            for(const auto & entry : shard.cache)
+            {
+                GetCacheCounters(CACHE_FILE_HASH).removeEntries(1, GetFileHashEntrySize(entry.first));
+            }
+            shard.cache.clear();
+        }
     }
     
     namespace
@@ -228,6 +410,8 @@ OCIO_NAMESPACE_EXIT
 #ifdef OCIO_UNIT_TEST
 
 namespace OCIO = OCIO_NAMESPACE;
+#include <cstdio>
+#include <thread>
 #include "UnitTest.h"
 
 OCIO_ADD_TEST(PathUtils, EnvExpand)
@@ -247,4 +431,96 @@ OCIO_ADD_TEST(PathUtils, EnvExpand)
     OCIO_CHECK_ASSERT( testresult == foo_result );
 }
 
+namespace
+{
+void WriteTestFile(const std::string & filename)
+{
+    std::ofstream ofs(filename.c_str());
+    ofs << "content";
+}
+}
+
+OCIO_ADD_TEST(PathUtils, missing_file_cache)
+{
+    std::string filename;
+    OCIO::Platform::CreateTempFilename(filename, ".txt");
+
+    std::string dirname, basename;
+    pystring::os::path::split(dirname, basename, filename);
+
+    OCIO::ContextRcPtr context = OCIO::Context::Create();
+    context->setSearchPath(dirname.c_str());
+
+    // The missing file is not searched again until the cache is cleared.
+    OCIO::SetMissingFileCacheTTL(-1.0);
+    OCIO_CHECK_THROW(context->resolveFileLocation(basename.c_str()), OCIO::ExceptionMissingFile);
+    OCIO_CHECK_ASSERT(!OCIO::FileExists(filename));
+
+    WriteTestFile(filename);
+    OCIO_CHECK_THROW(context->resolveFileLocation(basename.c_str()), OCIO::ExceptionMissingFile);
+    OCIO_CHECK_ASSERT(!OCIO::FileExists(filename));
+
+    OCIO::ClearAllCaches();
+    OCIO_CHECK_EQUAL(std::string(context->resolveFileLocation(basename.c_str())), filename);
+    OCIO_CHECK_ASSERT(OCIO::FileExists(filename));
+    std::remove(filename.c_str());
+
+    // The missing file is searched each time.
+    OCIO::SetMissingFileCacheTTL(0.0);
+    OCIO::Platform::CreateTempFilename(filename, ".txt");
+    pystring::os::path::split(dirname, basename, filename);
+
+    OCIO_CHECK_THROW(context->resolveFileLocation(basename.c_str()), OCIO::ExceptionMissingFile);
+    WriteTestFile(filename);
+    OCIO_CHECK_EQUAL(std::string(context->resolveFileLocation(basename.c_str())), filename);
+    std::remove(filename.c_str());
+
+    // The missing file is searched again once its negative result expired.
+    OCIO::SetMissingFileCacheTTL(0.05);
+    OCIO::Platform::CreateTempFilename(filename, ".txt");
+    pystring::os::path::split(dirname, basename, filename);
+
+    OCIO_CHECK_THROW(context->resolveFileLocation(basename.c_str()), OCIO::ExceptionMissingFile);
+    OCIO_CHECK_ASSERT(!OCIO::FileExists(filename));
+    WriteTestFile(filename);
+    OCIO_CHECK_THROW(context->resolveFileLocation(basename.c_str()), OCIO::ExceptionMissingFile);
+    OCIO_CHECK_ASSERT(!OCIO::FileExists(filename));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    OCIO_CHECK_EQUAL(std::string(context->resolveFileLocation(basename.c_str())), filename);
+    OCIO_CHECK_ASSERT(OCIO::FileExists(filename));
+    std::remove(filename.c_str());
+
+    // The caching of the missing files is disabled by default.
+    OCIO::SetMissingFileCacheTTL(0.0);
+    OCIO::ClearAllCaches();
+}
+
+OCIO_ADD_TEST(PathUtils, directory_index)
+{
+    std::string filename;
+    OCIO::Platform::CreateTempFilename(filename, ".txt");
+    WriteTestFile(filename);
+
+    OCIO::SetMissingFileCacheTTL(-1.0);
+    OCIO::SetDirectoryIndexEnabled(true);
+    OCIO::ClearAllCaches();
+
+    OCIO_CHECK_ASSERT(OCIO::FileExists(filename));
+    OCIO_CHECK_ASSERT(!OCIO::FileExists(filename + ".missing"));
+
+    // The directory is listed again once the cache is cleared.
+    WriteTestFile(filename + ".missing");
+    OCIO_CHECK_ASSERT(!OCIO::FileExists(filename + ".missing"));
+    OCIO::ClearAllCaches();
+    OCIO_CHECK_ASSERT(OCIO::FileExists(filename + ".missing"));
+
+    std::remove(filename.c_str());
+    std::remove((filename + ".missing").c_str());
+
+    OCIO::SetDirectoryIndexEnabled(false);
+    OCIO::SetMissingFileCacheTTL(0.0);
+    OCIO::ClearAllCaches();
+}
+
 #endif // OCIO_BUILD_TESTS
@@ -7,6 +7,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include <chrono>
 #include <map>
 
 OCIO_NAMESPACE_ENTER
@@ -47,12 +48,26 @@ OCIO_NAMESPACE_ENTER
     // in the EnvMap.
     std::string EnvExpand(const std::string & str, const EnvMap & map);
     
-    // Check if a file exists
+    // Check if a file exists. A missing file is reported without any file system access
+    // until its negative result expires (refer to SetMissingFileCacheTTL()).
     bool FileExists(const std::string & filename);
+
+    // True if the negative result (i.e. missing file) checked at that time expired.
+    bool IsMissingFileResultExpired(const std::chrono::steady_clock::time_point & checkTime);
+
+    // Incremented each time the path caches are cleared, so the results derived from them
+    // (e.g. the file locations resolved by the contexts) are discarded too.
+    unsigned GetPathCachesGeneration();
     
     // Get a fast hash for a file, without reading all the contents.
     // Currently, this checks the mtime and the inode number.
     std::string GetFastFileHash(const std::string & filename);
+
+    // Compute the fast hash of a file, bypassing the cache.
+    std::string ComputeFastFileHash(const std::string & filename);
+
+    // Discard the cached fast hash of a file (i.e. the file was modified).
+    void ClearFastFileHash(const std::string & filename);
     
     void ClearPathCaches();
 }
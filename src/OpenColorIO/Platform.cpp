@@ -10,9 +10,18 @@
 
 #include "Platform.h"
 
+#include <fstream>
+#include <iterator>
+
 #ifndef _WIN32
+#include <cerrno>
 #include <chrono>
 #include <random>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 
@@ -112,6 +121,141 @@ void CreateTempFilename(std::string & filename, const std::string & filenameExt)
     filename += filenameExt;
 }
 
+MappedFile::MappedFile(const std::string & filename)
+{
+#ifndef _WIN32
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if(fd != -1)
+    {
+        struct stat results;
+        if(::fstat(fd, &results) == 0 && results.st_size > 0)
+        {
+            void * mapping = ::mmap(nullptr, (size_t)results.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(mapping != MAP_FAILED)
+            {
+                m_data = static_cast<const char *>(mapping);
+                m_size = (size_t)results.st_size;
+                m_mapped = true;
+            }
+        }
+        ::close(fd);
+
+        if(m_mapped)
+        {
+            return;
+        }
+    }
+#endif
+
+    // Fall back to reading the whole file.
+    std::ifstream stream(filename.c_str(), std::ios_base::in | std::ios_base::binary);
+    if(!stream.good())
+    {
+        std::ostringstream os;
+        os << "Error could not read '" << filename << "'.";
+        throw Exception(os.str().c_str());
+    }
+
+    m_buffer.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+}
+
+MappedFile::~MappedFile()
+{
+#ifndef _WIN32
+    if(m_mapped)
+    {
+        ::munmap(const_cast<char *>(m_data), m_size);
+    }
+#endif
+}
+
+void ReadFile(const std::string & filename, std::vector<char> & content)
+{
+    content.clear();
+
+#ifndef _WIN32
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if(fd != -1)
+    {
+        struct stat results;
+        if(::fstat(fd, &results) == 0)
+        {
+            content.resize((size_t)results.st_size);
+
+            size_t length = 0;
+            while(length < content.size())
+            {
+                const ssize_t numRead = ::read(fd, content.data() + length, content.size() - length);
+                if(numRead < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if(numRead <= 0)
+                {
+                    break;
+                }
+                length += (size_t)numRead;
+            }
+            ::close(fd);
+
+            content.resize(length);
+            return;
+        }
+        ::close(fd);
+    }
+#endif
+
+    // Fall back to the streams.
+    std::ifstream stream(filename.c_str(), std::ios_base::in | std::ios_base::binary);
+    if(!stream.good())
+    {
+        std::ostringstream os;
+        os << "Error could not read '" << filename << "'.";
+        throw Exception(os.str().c_str());
+    }
+
+    content.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+}
+
+bool ListDirectory(const std::string & dirname, std::vector<std::string> & filenames)
+{
+    filenames.clear();
+
+#ifdef _WIN32
+    WIN32_FIND_DATAA data;
+    HANDLE handle = FindFirstFileA((dirname + "\\*").c_str(), &data);
+    if(handle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    do
+    {
+        filenames.push_back(data.cFileName);
+    }
+    while(FindNextFileA(handle, &data));
+
+    FindClose(handle);
+#else
+    DIR * dir = ::opendir(dirname.c_str());
+    if(!dir)
+    {
+        return false;
+    }
+
+    while(const struct dirent * entry = ::readdir(dir))
+    {
+        filenames.push_back(entry->d_name);
+    }
+
+    ::closedir(dir);
+#endif
+
+    return true;
+}
+
 
 }//namespace platform
 
@@ -123,6 +267,8 @@ OCIO_NAMESPACE_EXIT
 #ifdef OCIO_UNIT_TEST
 
 namespace OCIO = OCIO_NAMESPACE;
+#include <algorithm>
+#include "pystring/pystring.h"
 #include "UnitTest.h"
 
 OCIO_ADD_TEST(Platform, getenv)
@@ -231,4 +377,90 @@ OCIO_ADD_TEST(Platform, CreateTempFilename)
     OCIO_CHECK_ASSERT(f1!=f2);
 }
 
+OCIO_ADD_TEST(Platform, MappedFile)
+{
+    std::string filename;
+    OCIO_CHECK_NO_THROW(OCIO::Platform::CreateTempFilename(filename, ""));
+
+    OCIO_CHECK_THROW_WHAT(OCIO::Platform::MappedFile file(filename),
+                          OCIO::Exception,
+                          "could not read");
+
+    const std::string content("Some content\n\0with a null character", 35);
+    {
+        std::ofstream stream(filename, std::ios_base::out | std::ios_base::binary);
+        stream << content;
+    }
+
+    {
+        OCIO::Platform::MappedFile file(filename);
+        OCIO_REQUIRE_EQUAL(file.size(), content.size());
+        OCIO_CHECK_EQUAL(std::string(file.data(), file.size()), content);
+    }
+
+    // Empty file.
+    {
+        std::ofstream stream(filename, std::ios_base::out | std::ios_base::trunc);
+    }
+
+    {
+        OCIO::Platform::MappedFile file(filename);
+        OCIO_CHECK_EQUAL(file.size(), 0);
+    }
+
+    std::remove(filename.c_str());
+}
+
+OCIO_ADD_TEST(Platform, ReadFile)
+{
+    std::string filename;
+    OCIO_CHECK_NO_THROW(OCIO::Platform::CreateTempFilename(filename, ""));
+
+    std::vector<char> content;
+    OCIO_CHECK_THROW_WHAT(OCIO::Platform::ReadFile(filename, content),
+                          OCIO::Exception,
+                          "could not read");
+
+    const std::string expected("Some content\n\0with a null character", 35);
+    {
+        std::ofstream stream(filename, std::ios_base::out | std::ios_base::binary);
+        stream << expected;
+    }
+
+    OCIO_CHECK_NO_THROW(OCIO::Platform::ReadFile(filename, content));
+    OCIO_REQUIRE_EQUAL(content.size(), expected.size());
+    OCIO_CHECK_EQUAL(std::string(content.data(), content.size()), expected);
+
+    // Empty file.
+    {
+        std::ofstream stream(filename, std::ios_base::out | std::ios_base::trunc);
+    }
+
+    OCIO_CHECK_NO_THROW(OCIO::Platform::ReadFile(filename, content));
+    OCIO_CHECK_EQUAL(content.size(), 0);
+
+    std::remove(filename.c_str());
+}
+
+OCIO_ADD_TEST(Platform, ListDirectory)
+{
+    std::string filename;
+    OCIO_CHECK_NO_THROW(OCIO::Platform::CreateTempFilename(filename, ".ctf"));
+    {
+        std::ofstream stream(filename);
+    }
+
+    std::string dirname, basename;
+    pystring::os::path::split(dirname, basename, filename);
+
+    std::vector<std::string> filenames;
+    OCIO_CHECK_ASSERT(OCIO::Platform::ListDirectory(dirname, filenames));
+    OCIO_CHECK_ASSERT(std::find(filenames.begin(), filenames.end(), basename) != filenames.end());
+
+    std::remove(filename.c_str());
+
+    OCIO_CHECK_ASSERT(!OCIO::Platform::ListDirectory(filename, filenames));
+    OCIO_CHECK_ASSERT(filenames.empty());
+}
+
 #endif // OCIO_UNIT_TEST
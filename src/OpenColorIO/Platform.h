@@ -37,6 +37,8 @@
 #endif // defined(_WIN32)
 
 // general includes
+#include <string>
+#include <vector>
 #include <stdio.h>
 #include <math.h>
 #include <assert.h>
@@ -90,6 +92,39 @@ void AlignedFree(void* memBlock);
 // Create a temporary filename where filenameExt could be empty.
 void CreateTempFilename(std::string & filename, const std::string & filenameExt);
 
+// Read-only view of the content of a file. The file is memory-mapped when the platform
+// supports it, otherwise it is read in memory. An exception is thrown if the file could
+// not be read. As modifying a mapped file while it is used could crash the process, only
+// use it for the files replaced atomically (e.g. the binary cache entries).
+class MappedFile
+{
+public:
+    MappedFile() = delete;
+    MappedFile(const MappedFile &) = delete;
+    MappedFile & operator=(const MappedFile &) = delete;
+
+    explicit MappedFile(const std::string & filename);
+    ~MappedFile();
+
+    const char * data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    const char * m_data = nullptr;
+    size_t m_size = 0;
+    bool m_mapped = false;
+    std::vector<char> m_buffer;
+};
+
+// Read the content of a file in memory, with a single read of the size given by the file
+// system when the platform supports it. A file truncated meanwhile only gives a shorter
+// content. An exception is thrown if the file could not be read.
+void ReadFile(const std::string & filename, std::vector<char> & content);
+
+// List the names of the entries of a directory. Returns false if the directory could not be
+// read.
+bool ListDirectory(const std::string & dirname, std::vector<std::string> & filenames);
+
 }
 
 }
@@ -8,10 +8,12 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "CacheStatistics.h"
 #include "CPUProcessor.h"
 #include "GPUProcessor.h"
 #include "HashUtils.h"
 #include "OpBuilders.h"
+#include "OptimizationTrace.h"
 #include "Processor.h"
 #include "TransformBuilder.h"
 #include "transforms/FileTransform.h"
@@ -210,6 +212,13 @@ OCIO_NAMESPACE_ENTER
         return getImpl()->getOptimizedGPUProcessor(oFlags, fFlags);
     }
 
+    ConstGPUProcessorRcPtr Processor::getOptimizedGPUProcessor(OptimizationFlags oFlags, 
+                                                               FinalizationFlags fFlags,
+                                                               const OptimizationTraceRcPtr & trace) const
+    {
+        return getImpl()->getOptimizedGPUProcessor(oFlags, fFlags, trace);
+    }
+
     ConstCPUProcessorRcPtr Processor::getDefaultCPUProcessor() const
     {
         return getImpl()->getDefaultCPUProcessor();
@@ -229,24 +238,109 @@ OCIO_NAMESPACE_ENTER
         return getImpl()->getOptimizedCPUProcessor(inBitDepth, outBitDepth, oFlags, fFlags);
     }
 
+    ConstCPUProcessorRcPtr Processor::getOptimizedCPUProcessor(BitDepth inBitDepth, 
+                                                               BitDepth outBitDepth,
+                                                               OptimizationFlags oFlags,
+                                                               FinalizationFlags fFlags,
+                                                               const OptimizationTraceRcPtr & trace) const
+    {
+        return getImpl()->getOptimizedCPUProcessor(inBitDepth, outBitDepth, oFlags, fFlags, trace);
+    }
+
     
 
+    namespace
+    {
+        bool HasDynamicOp(const OpRcPtrVec & ops)
+        {
+            for(const auto & op : ops)
+            {
+                if(op->isDynamic())
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+    }
+
     Processor::Impl::Impl():
-        m_metadata(ProcessorMetadata::Create())
+        m_metadata(ProcessorMetadata::Create()),
+        m_hasLazyFiles(false)
     {
     }
     
     Processor::Impl::~Impl()
-    { }
+    {
+        GetCacheCounters(CACHE_OPTIMIZED_PROCESSOR).removeEntries(
+            m_cpuProcessors.size() + m_gpuProcessors.size(),
+            m_cpuProcessors.size() * sizeof(CPUProcessorMap::value_type)
+                + m_gpuProcessors.size() * sizeof(GPUProcessorMap::value_type));
+    }
     
+    void Processor::Impl::loadLazyFiles() const
+    {
+        OpRcPtrVec ops = m_ops;
+        LoadLazyFileOps(ops);
+        UnifyDynamicProperties(ops);
+
+        // The loaded files may reference other files.
+        ProcessorMetadataRcPtr metadata = ProcessorMetadata::Create();
+        for(auto & op : ops)
+        {
+            op->dumpMetadata(metadata);
+        }
+
+        m_ops = ops;
+        m_metadata = metadata;
+        m_hasLazyFiles = false;
+    }
+
+    const OpRcPtrVec & Processor::Impl::getOps() const
+    {
+        if(m_hasLazyFiles)
+        {
+            AutoMutex lock(m_opsMutex);
+            if(m_hasLazyFiles)
+            {
+                loadLazyFiles();
+            }
+        }
+        return m_ops;
+    }
+
+    OpRcPtrVec Processor::Impl::getFinalizableOps() const
+    {
+        if(m_hasLazyFiles)
+        {
+            AutoMutex lock(m_opsMutex);
+            if(m_hasLazyFiles)
+            {
+                OpRcPtrVec ops = m_ops;
+                RemoveInverseLazyFileOps(ops);
+                LoadLazyFileOps(ops);
+
+                // Unifying the dynamic properties alters the ops, which are shared with
+                // the processor ops, so all the files are then loaded.
+                if(!HasDynamicOp(ops))
+                {
+                    return ops;
+                }
+
+                loadLazyFiles();
+            }
+        }
+        return m_ops;
+    }
+
     bool Processor::Impl::isNoOp() const
     {
-        return IsOpVecNoOp(m_ops);
+        return IsOpVecNoOp(getOps());
     }
     
     bool Processor::Impl::hasChannelCrosstalk() const
     {
-        for(const auto & op : m_ops)
+        for(const auto & op : getOps())
         {
             if(op->hasChannelCrosstalk()) return true;
         }
@@ -256,23 +350,24 @@ OCIO_NAMESPACE_ENTER
     
     ConstProcessorMetadataRcPtr Processor::Impl::getProcessorMetadata() const
     {
+        getOps();
         return m_metadata;
     }
 
     
     const FormatMetadata & Processor::Impl::getFormatMetadata() const
     {
-        return m_ops.getFormatMetadata();
+        return getOps().getFormatMetadata();
     }
 
     int Processor::Impl::getNumTransforms() const
     {
-        return (int)m_ops.size();
+        return (int)getOps().size();
     }
 
     const FormatMetadata & Processor::Impl::getTransformFormatMetadata(int index) const
     {
-        auto op = OCIO_DYNAMIC_POINTER_CAST<const Op>(m_ops[index]);
+        auto op = OCIO_DYNAMIC_POINTER_CAST<const Op>(getOps()[index]);
         return op->data()->getFormatMetadata();
     }
 
@@ -284,7 +379,7 @@ OCIO_NAMESPACE_ENTER
         group->getFormatMetadata() = getFormatMetadata();
 
         // Build transforms from ops.
-        for (ConstOpRcPtr op : m_ops)
+        for (ConstOpRcPtr op : getOps())
         {
             CreateTransform(group, op);
         }
@@ -307,7 +402,7 @@ OCIO_NAMESPACE_ENTER
         try
         {
             std::string fName{ formatName };
-            fmt->write(m_ops, getFormatMetadata(), fName, os);
+            fmt->write(getOps(), getFormatMetadata(), fName, os);
         }
         catch (std::exception & e)
         {
@@ -320,7 +415,7 @@ OCIO_NAMESPACE_ENTER
 
     bool Processor::Impl::hasDynamicProperty(DynamicPropertyType type) const
     {
-        for (const auto & op : m_ops)
+        for (const auto & op : getOps())
         {
             if (op->hasDynamicProperty(type))
             {
@@ -332,7 +427,7 @@ OCIO_NAMESPACE_ENTER
 
     DynamicPropertyRcPtr Processor::Impl::getDynamicProperty(DynamicPropertyType type) const
     {
-        for(const auto & op : m_ops)
+        for(const auto & op : getOps())
         {
             if(op->hasDynamicProperty(type))
             {
@@ -343,20 +438,27 @@ OCIO_NAMESPACE_ENTER
         throw Exception("Cannot find dynamic property; not used by processor.");
     }
 
+    bool Processor::Impl::isDynamic() const
+    {
+        return HasDynamicOp(getOps());
+    }
+
     const char * Processor::Impl::getCacheID() const
     {
+        const OpRcPtrVec & ops = getOps();
+
         AutoMutex lock(m_resultsCacheMutex);
         
         if(!m_cpuCacheID.empty()) return m_cpuCacheID.c_str();
         
-        if(m_ops.empty())
+        if(ops.empty())
         {
             m_cpuCacheID = "<NOOP>";
         }
         else
         {
             std::ostringstream cacheid;
-            for(const auto & op : m_ops)
+            for(const auto & op : ops)
             {
                 cacheid << op->getCacheID() << " ";
             }
@@ -370,22 +472,82 @@ OCIO_NAMESPACE_ENTER
     
     ///////////////////////////////////////////////////////////////////////////
 
+    namespace
+    {
+        OptimizationTraceImpl * GetTraceImpl(const OptimizationTraceRcPtr & trace)
+        {
+            if(!trace)
+            {
+                throw Exception("The optimization trace is null.");
+            }
+
+            OptimizationTraceImpl * impl = dynamic_cast<OptimizationTraceImpl *>(trace.get());
+            if(!impl)
+            {
+                throw Exception("Unsupported optimization trace implementation.");
+            }
+
+            return impl;
+        }
+    }
+
     ConstGPUProcessorRcPtr Processor::Impl::getDefaultGPUProcessor() const
     {
+        return getOptimizedGPUProcessor(OPTIMIZATION_DEFAULT, FINALIZATION_DEFAULT);
+    }
+
+    ConstGPUProcessorRcPtr Processor::Impl::getOptimizedGPUProcessor(OptimizationFlags oFlags,
+                                                                     FinalizationFlags fFlags) const
+    {
+        const ProcessorKey key(BIT_DEPTH_F32, BIT_DEPTH_F32, oFlags, fFlags);
+
+        // The dynamic processors are never memoized, so the lookup is always safe.
+        {
+            AutoMutex lock(m_resultsCacheMutex);
+            auto it = m_gpuProcessors.find(key);
+            if(it!=m_gpuProcessors.end())
+            {
+                GetCacheCounters(CACHE_OPTIMIZED_PROCESSOR).addHit();
+                return it->second;
+            }
+        }
+
+        GetCacheCounters(CACHE_OPTIMIZED_PROCESSOR).addMiss();
+
+        const OpRcPtrVec ops = getFinalizableOps();
+        const bool memoize = !HasDynamicOp(ops);
+
+        // The finalization is done outside of the lock.
         GPUProcessorRcPtr gpu = GPUProcessorRcPtr(new GPUProcessor(), &GPUProcessor::deleter);
 
-        gpu->getImpl()->finalize(m_ops, 
-                                 OPTIMIZATION_DEFAULT, FINALIZATION_DEFAULT);
+        {
+            CacheMissTimer missTimer(CACHE_OPTIMIZED_PROCESSOR);
+            gpu->getImpl()->finalize(ops, oFlags, fFlags);
+        }
+
+        if(memoize)
+        {
+            AutoMutex lock(m_resultsCacheMutex);
+            // Another thread may have been faster.
+            auto result = m_gpuProcessors.insert(std::make_pair(key, gpu));
+            if(result.second)
+            {
+                GetCacheCounters(CACHE_OPTIMIZED_PROCESSOR).addEntries(
+                    1, sizeof(GPUProcessorMap::value_type));
+            }
+            return result.first->second;
+        }
 
         return gpu;
     }
 
     ConstGPUProcessorRcPtr Processor::Impl::getOptimizedGPUProcessor(OptimizationFlags oFlags,
-                                                                     FinalizationFlags fFlags) const
+                                                                     FinalizationFlags fFlags,
+                                                                     const OptimizationTraceRcPtr & trace) const
     {
         GPUProcessorRcPtr gpu = GPUProcessorRcPtr(new GPUProcessor(), &GPUProcessor::deleter);
 
-        gpu->getImpl()->finalize(m_ops, oFlags, fFlags);
+        gpu->getImpl()->finalize(getFinalizableOps(), oFlags, fFlags, GetTraceImpl(trace));
 
         return gpu;
     }
@@ -394,23 +556,59 @@ OCIO_NAMESPACE_ENTER
 
     ConstCPUProcessorRcPtr Processor::Impl::getDefaultCPUProcessor() const
     {
-        CPUProcessorRcPtr cpu = CPUProcessorRcPtr(new CPUProcessor(), &CPUProcessor::deleter);
-
-        cpu->getImpl()->finalize(m_ops, 
-                                 BIT_DEPTH_F32, BIT_DEPTH_F32, 
-                                 OPTIMIZATION_DEFAULT, FINALIZATION_DEFAULT);
-
-        return cpu;
+        return getOptimizedCPUProcessor(BIT_DEPTH_F32, BIT_DEPTH_F32,
+                                        OPTIMIZATION_DEFAULT, FINALIZATION_DEFAULT);
     }
 
     ConstCPUProcessorRcPtr Processor::Impl::getOptimizedCPUProcessor(OptimizationFlags oFlags,
                                                                      FinalizationFlags fFlags) const
     {
+        return getOptimizedCPUProcessor(BIT_DEPTH_F32, BIT_DEPTH_F32, oFlags, fFlags);
+    }
+
+    ConstCPUProcessorRcPtr Processor::Impl::getOptimizedCPUProcessor(BitDepth inBitDepth, 
+                                                                     BitDepth outBitDepth,
+                                                                     OptimizationFlags oFlags,
+                                                                     FinalizationFlags fFlags) const
+    {
+        const ProcessorKey key(inBitDepth, outBitDepth, oFlags, fFlags);
+
+        // The dynamic processors are never memoized, so the lookup is always safe.
+        {
+            AutoMutex lock(m_resultsCacheMutex);
+            auto it = m_cpuProcessors.find(key);
+            if(it!=m_cpuProcessors.end())
+            {
+                GetCacheCounters(CACHE_OPTIMIZED_PROCESSOR).addHit();
+                return it->second;
+            }
+        }
+
+        GetCacheCounters(CACHE_OPTIMIZED_PROCESSOR).addMiss();
+
+        const OpRcPtrVec ops = getFinalizableOps();
+        const bool memoize = !HasDynamicOp(ops);
+
+        // The finalization is done outside of the lock.
         CPUProcessorRcPtr cpu = CPUProcessorRcPtr(new CPUProcessor(), &CPUProcessor::deleter);
 
-        cpu->getImpl()->finalize(m_ops,
-                                 BIT_DEPTH_F32, BIT_DEPTH_F32,
-                                 oFlags, fFlags);
+        {
+            CacheMissTimer missTimer(CACHE_OPTIMIZED_PROCESSOR);
+            cpu->getImpl()->finalize(ops, inBitDepth, outBitDepth, oFlags, fFlags);
+        }
+
+        if(memoize)
+        {
+            AutoMutex lock(m_resultsCacheMutex);
+            // Another thread may have been faster.
+            auto result = m_cpuProcessors.insert(std::make_pair(key, cpu));
+            if(result.second)
+            {
+                GetCacheCounters(CACHE_OPTIMIZED_PROCESSOR).addEntries(
+                    1, sizeof(CPUProcessorMap::value_type));
+            }
+            return result.first->second;
+        }
 
         return cpu;
     }
@@ -418,11 +616,13 @@ OCIO_NAMESPACE_ENTER
     ConstCPUProcessorRcPtr Processor::Impl::getOptimizedCPUProcessor(BitDepth inBitDepth, 
                                                                      BitDepth outBitDepth,
                                                                      OptimizationFlags oFlags,
-                                                                     FinalizationFlags fFlags) const
+                                                                     FinalizationFlags fFlags,
+                                                                     const OptimizationTraceRcPtr & trace) const
     {
         CPUProcessorRcPtr cpu = CPUProcessorRcPtr(new CPUProcessor(), &CPUProcessor::deleter);
 
-        cpu->getImpl()->finalize(m_ops, inBitDepth, outBitDepth, oFlags, fFlags);
+        cpu->getImpl()->finalize(getFinalizableOps(), inBitDepth, outBitDepth, oFlags, fFlags,
+                                 GetTraceImpl(trace));
 
         return cpu;
     }
@@ -442,7 +642,9 @@ OCIO_NAMESPACE_ENTER
         }
         BuildColorSpaceOps(m_ops, config, context, srcColorSpace, dstColorSpace);
         FinalizeOpVec(m_ops, FINALIZATION_EXACT);
+        InternOpArrays(m_ops);
         UnifyDynamicProperties(m_ops);
+        m_hasLazyFiles = HasLazyFileOps(m_ops);
     }
     
     void Processor::Impl::setTransform(const Config & config,
@@ -457,7 +659,9 @@ OCIO_NAMESPACE_ENTER
         transform->validate();
         BuildOps(m_ops, config, context, transform, direction);
         FinalizeOpVec(m_ops, FINALIZATION_EXACT);
+        InternOpArrays(m_ops);
         UnifyDynamicProperties(m_ops);
+        m_hasLazyFiles = HasLazyFileOps(m_ops);
     }
 
     void Processor::Impl::computeMetadata()
@@ -479,6 +683,8 @@ OCIO_NAMESPACE_EXIT
 #ifdef OCIO_UNIT_TEST
 
 namespace OCIO = OCIO_NAMESPACE;
+#include <thread>
+#include <vector>
 #include "ops/exposurecontrast/ExposureContrastOps.h"
 #include "UnitTest.h"
 
@@ -502,6 +708,140 @@ OCIO_ADD_TEST(Processor, basic)
     OCIO_CHECK_EQUAL(std::string(processorMat->getCacheID()), "$c15dfc9b251ee075f33c4ccb3eb1e4b8");
 }
 
+OCIO_ADD_TEST(Processor, derived_processors)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    auto mat = OCIO::MatrixTransform::Create();
+    double offset[4]{ 0.1, 0.2, 0.3, 0.4 };
+    mat->setOffset(offset);
+
+    OCIO::ConstProcessorRcPtr processor = config->getProcessor(mat);
+
+    // The derived processors are memoized.
+
+    OCIO::ConstCPUProcessorRcPtr cpu = processor->getDefaultCPUProcessor();
+    OCIO_CHECK_EQUAL(processor->getDefaultCPUProcessor().get(), cpu.get());
+    OCIO_CHECK_EQUAL(processor->getOptimizedCPUProcessor(OCIO::OPTIMIZATION_DEFAULT,
+                                                         OCIO::FINALIZATION_DEFAULT).get(),
+                     cpu.get());
+    OCIO_CHECK_NE(processor->getOptimizedCPUProcessor(OCIO::OPTIMIZATION_NONE,
+                                                      OCIO::FINALIZATION_DEFAULT).get(),
+                  cpu.get());
+    OCIO_CHECK_NE(processor->getOptimizedCPUProcessor(OCIO::OPTIMIZATION_DEFAULT,
+                                                      OCIO::FINALIZATION_EXACT).get(),
+                  cpu.get());
+
+    cpu = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT8, OCIO::BIT_DEPTH_UINT16,
+                                              OCIO::OPTIMIZATION_DEFAULT,
+                                              OCIO::FINALIZATION_DEFAULT);
+    OCIO_CHECK_EQUAL(cpu->getInputBitDepth(), OCIO::BIT_DEPTH_UINT8);
+    OCIO_CHECK_EQUAL(cpu->getOutputBitDepth(), OCIO::BIT_DEPTH_UINT16);
+    OCIO_CHECK_EQUAL(processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT8,
+                                                         OCIO::BIT_DEPTH_UINT16,
+                                                         OCIO::OPTIMIZATION_DEFAULT,
+                                                         OCIO::FINALIZATION_DEFAULT).get(),
+                     cpu.get());
+    OCIO_CHECK_NE(processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT8,
+                                                      OCIO::BIT_DEPTH_UINT8,
+                                                      OCIO::OPTIMIZATION_DEFAULT,
+                                                      OCIO::FINALIZATION_DEFAULT).get(),
+                  cpu.get());
+
+    OCIO::ConstGPUProcessorRcPtr gpu = processor->getDefaultGPUProcessor();
+    OCIO_CHECK_EQUAL(processor->getDefaultGPUProcessor().get(), gpu.get());
+    OCIO_CHECK_NE(processor->getOptimizedGPUProcessor(OCIO::OPTIMIZATION_NONE,
+                                                      OCIO::FINALIZATION_DEFAULT).get(),
+                  gpu.get());
+
+    // Each derived processor owns its dynamic properties so they are not memoized.
+
+    auto ec = OCIO::ExposureContrastTransform::Create();
+    ec->makeExposureDynamic();
+    processor = config->getProcessor(ec);
+
+    cpu = processor->getDefaultCPUProcessor();
+    OCIO_CHECK_NE(processor->getDefaultCPUProcessor().get(), cpu.get());
+    gpu = processor->getDefaultGPUProcessor();
+    OCIO_CHECK_NE(processor->getDefaultGPUProcessor().get(), gpu.get());
+}
+
+OCIO_ADD_TEST(Processor, concurrent_derived_processor)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    // i.e. log2(x + 1).
+    auto mat = OCIO::MatrixTransform::Create();
+    double offset[4]{ 1.0, 1.0, 1.0, 0.0 };
+    mat->setOffset(offset);
+    auto log = OCIO::LogTransform::Create();
+    log->setBase(2.0);
+    auto group = OCIO::GroupTransform::Create();
+    group->push_back(mat);
+    group->push_back(log);
+
+    OCIO::ConstProcessorRcPtr processor = config->getProcessor(group);
+
+    // The memoized processor of packed integer images shares its scanline buffers.
+    auto getCPU = [&processor]()
+    {
+        return processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT8,
+                                                   OCIO::BIT_DEPTH_UINT16,
+                                                   OCIO::OPTIMIZATION_DEFAULT,
+                                                   OCIO::FINALIZATION_DEFAULT);
+    };
+
+    const long width = 256;
+    const long height = 64;
+    std::vector<uint8_t> src(width * height * 4);
+    for (size_t idx = 0; idx < src.size(); ++idx)
+    {
+        src[idx] = uint8_t((idx * 7) % 256);
+    }
+
+    std::vector<uint16_t> expected(src.size());
+    {
+        OCIO::PackedImageDesc srcImg(&src[0], width, height, 4, sizeof(uint8_t),
+                                     OCIO::AutoStride, OCIO::AutoStride);
+        OCIO::PackedImageDesc dstImg(&expected[0], width, height, 4, sizeof(uint16_t),
+                                     OCIO::AutoStride, OCIO::AutoStride);
+        getCPU()->apply(srcImg, dstImg);
+    }
+
+    const size_t numThreads = 4;
+    std::vector<int> identical(numThreads, 0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+        threads.emplace_back([&, t]()
+        {
+            OCIO::ConstCPUProcessorRcPtr cpu = getCPU();
+            std::vector<uint16_t> dst(src.size());
+            bool same = true;
+            for (int iter = 0; iter < 20; ++iter)
+            {
+                OCIO::PackedImageDesc srcImg(&src[0], width, height, 4, sizeof(uint8_t),
+                                             OCIO::AutoStride, OCIO::AutoStride);
+                OCIO::PackedImageDesc dstImg(&dst[0], width, height, 4, sizeof(uint16_t),
+                                             OCIO::AutoStride, OCIO::AutoStride);
+                cpu->apply(srcImg, dstImg);
+                same = same && dst == expected;
+            }
+            identical[t] = same ? 1 : 0;
+        });
+    }
+
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+        OCIO_CHECK_ASSERT(identical[t]);
+    }
+}
+
 OCIO_ADD_TEST(Processor, shared_dynamic_properties)
 {
     OCIO::TransformDirection direction = OCIO::TRANSFORM_DIR_FORWARD;
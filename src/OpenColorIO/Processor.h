@@ -5,6 +5,10 @@
 #ifndef INCLUDED_OCIO_PROCESSOR_H
 #define INCLUDED_OCIO_PROCESSOR_H
 
+#include <atomic>
+#include <map>
+#include <tuple>
+
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "Mutex.h"
@@ -16,15 +20,36 @@ OCIO_NAMESPACE_ENTER
     class Processor::Impl
     {
     private:
-        ProcessorMetadataRcPtr m_metadata;
+        mutable ProcessorMetadataRcPtr m_metadata;
 
-        // Vector of ops for the processor.
-        OpRcPtrVec m_ops;
+        // Vector of ops for the processor. When the lazy file loading is enabled, it
+        // holds placeholder ops until the files are loaded (refer to getOps()).
+        mutable OpRcPtrVec m_ops;
+        mutable std::atomic<bool> m_hasLazyFiles;
+        mutable Mutex m_opsMutex;
 
         mutable std::string m_cpuCacheID;
+
+        // The derived processors are memoized per bit-depths and flags (except when they
+        // own dynamic properties as each one has its own instances).
+        typedef std::tuple<BitDepth, BitDepth, OptimizationFlags, FinalizationFlags> ProcessorKey;
+        typedef std::map<ProcessorKey, ConstCPUProcessorRcPtr> CPUProcessorMap;
+        typedef std::map<ProcessorKey, ConstGPUProcessorRcPtr> GPUProcessorMap;
+        mutable CPUProcessorMap m_cpuProcessors;
+        mutable GPUProcessorMap m_gpuProcessors;
         
         mutable Mutex m_resultsCacheMutex;
 
+        // Load the deferred files of m_ops, the caller must hold m_opsMutex.
+        void loadLazyFiles() const;
+
+        // Return the ops, once the deferred files are loaded.
+        const OpRcPtrVec & getOps() const;
+
+        // Return the ops to optimize for a CPU or GPU processor. Unlike getOps(), the
+        // deferred files followed by their inverse are removed without being loaded.
+        OpRcPtrVec getFinalizableOps() const;
+
     public:
         Impl();
         ~Impl();
@@ -42,6 +67,12 @@ OCIO_NAMESPACE_ENTER
         bool hasDynamicProperty(DynamicPropertyType type) const;
         DynamicPropertyRcPtr getDynamicProperty(DynamicPropertyType type) const;
 
+        // True if any op holds an enabled dynamic property.
+        bool isDynamic() const;
+
+        // True if some files are not loaded yet (refer to SetLazyFileLoadingEnabled()).
+        bool hasLazyFiles() const { return m_hasLazyFiles; }
+
         const char * getCacheID() const;
 
         GroupTransformRcPtr createGroupTransform() const;
@@ -57,6 +88,11 @@ OCIO_NAMESPACE_ENTER
         ConstGPUProcessorRcPtr getOptimizedGPUProcessor(OptimizationFlags oFlags, 
                                                         FinalizationFlags fFlags) const;
 
+        // Get an optimized GPU processor instance for F32 images, and trace its optimization.
+        ConstGPUProcessorRcPtr getOptimizedGPUProcessor(OptimizationFlags oFlags, 
+                                                        FinalizationFlags fFlags,
+                                                        const OptimizationTraceRcPtr & trace) const;
+
         // Get an optimized CPU processor instance for F32 images with default optimizations.
         ConstCPUProcessorRcPtr getDefaultCPUProcessor() const;
 
@@ -70,6 +106,14 @@ OCIO_NAMESPACE_ENTER
                                                         OptimizationFlags oFlags,
                                                         FinalizationFlags fFlags) const;
 
+        // Get a optimized CPU processor instance for arbitrary input and output bit-depths,
+        // and trace its optimization.
+        ConstCPUProcessorRcPtr getOptimizedCPUProcessor(BitDepth inBitDepth,
+                                                        BitDepth outBitDepth,
+                                                        OptimizationFlags oFlags,
+                                                        FinalizationFlags fFlags,
+                                                        const OptimizationTraceRcPtr & trace) const;
+
         ////////////////////////////////////////////
         //
         // Builder functions, Not exposed
@@ -86,6 +130,9 @@ OCIO_NAMESPACE_ENTER
 
         void computeMetadata();
     };
+
+    // Invalidate the processor caches of all the configs.
+    void ClearConfigProcessorCaches();
     
 }
 OCIO_NAMESPACE_EXIT
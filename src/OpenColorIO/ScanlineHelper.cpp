@@ -20,9 +20,9 @@ namespace
 
 template<typename InType, typename OutType>
 GenericScanlineHelper<InType, OutType>::GenericScanlineHelper(BitDepth inputBitDepth,
-                                                              ConstOpCPURcPtr & inBitDepthOp,
+                                                              const ConstOpCPURcPtr & inBitDepthOp,
                                                               BitDepth outputBitDepth,
-                                                              ConstOpCPURcPtr & outBitDepthOp)
+                                                              const ConstOpCPURcPtr & outBitDepthOp)
     :   ScanlineHelper()
     ,   m_inputBitDepth(inputBitDepth)
     ,   m_outputBitDepth(outputBitDepth)
@@ -35,8 +35,8 @@ class GenericScanlineHelper : public ScanlineHelper
 {
 public:
     GenericScanlineHelper() = delete;
-    GenericScanlineHelper(BitDepth inputBitDepth, ConstOpCPURcPtr & inBitDepthOp,
-                          BitDepth outputBitDepth, ConstOpCPURcPtr & outBitDepthOp);
+    GenericScanlineHelper(BitDepth inputBitDepth, const ConstOpCPURcPtr & inBitDepthOp,
+                          BitDepth outputBitDepth, const ConstOpCPURcPtr & outBitDepthOp);
 
     void init(const ImageDesc & srcImg, ImageDesc & dstImg) override;
     void init(ImageDesc & img) override;
@@ -0,0 +1,686 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "fileformats/BinaryCache.h"
+#include "HashUtils.h"
+#include "Logging.h"
+#include "Mutex.h"
+#include "Platform.h"
+#include "pystring/pystring.h"
+
+
+OCIO_NAMESPACE_ENTER
+{
+    namespace
+    {
+        const char * OCIO_FILE_CACHE_DIR_ENVVAR = "OCIO_FILE_CACHE_DIR";
+
+        // Increment the version when the layout of a payload changes.
+        const char * BINARY_CACHE_MAGIC = "OCIOBinaryCache";
+        const int BINARY_CACHE_VERSION = 1;
+        // Detects a cache written by a platform with another endianness.
+        const int BINARY_CACHE_ENDIANNESS = 0x01020304;
+
+        const char * BINARY_CACHE_EXTENSION = ".ociocache";
+
+        Mutex g_binaryCacheDirectoryMutex;
+        bool g_binaryCacheDirectoryInitialized = false;
+        std::string g_binaryCacheDirectory;
+    }
+
+    std::string GetBinaryCacheDirectory()
+    {
+        AutoMutex lock(g_binaryCacheDirectoryMutex);
+        if(!g_binaryCacheDirectoryInitialized)
+        {
+            Platform::Getenv(OCIO_FILE_CACHE_DIR_ENVVAR, g_binaryCacheDirectory);
+            g_binaryCacheDirectoryInitialized = true;
+        }
+        return g_binaryCacheDirectory;
+    }
+
+    // Each version of a file has its own cache entry.
+    std::string GetBinaryCacheFilename(const std::string & directory,
+                                       const std::string & filepath,
+                                       const std::string & fileHash)
+    {
+        const std::string key = filepath + "|" + fileHash;
+        // Remove the leading '$'.
+        const std::string hash = CacheIDHash(key.c_str(), (int)key.size()).substr(1);
+        return pystring::os::path::join(directory, hash + BINARY_CACHE_EXTENSION);
+    }
+
+    // FNV-1a is enough to detect a truncated or damaged cache file.
+    unsigned ComputeBinaryCacheChecksum(const char * data, size_t size)
+    {
+        unsigned hash = 2166136261u;
+        for(size_t i=0; i<size; ++i)
+        {
+            hash ^= (unsigned char)data[i];
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    bool WriteBinaryCacheFile(const std::string & filename, const std::string & content)
+    {
+        // Write a temporary file then rename it.
+        std::string tmpFilename;
+        Platform::CreateTempFilename(tmpFilename, "");
+        tmpFilename = filename + "." + pystring::os::path::basename(tmpFilename);
+
+        {
+            std::ofstream stream(tmpFilename.c_str(),
+                                 std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+            stream.write(content.data(), (std::streamsize)content.size());
+            stream.close();
+
+            if(!stream.good())
+            {
+                std::remove(tmpFilename.c_str());
+                return false;
+            }
+        }
+
+        if(std::rename(tmpFilename.c_str(), filename.c_str()) != 0)
+        {
+            // The rename does not replace an existing entry on Windows (e.g. a corrupted
+            // one, or the one of a faster process).
+            std::remove(filename.c_str());
+            if(std::rename(tmpFilename.c_str(), filename.c_str()) != 0)
+            {
+                std::remove(tmpFilename.c_str());
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void BinaryCacheWriter::write(const void * data, size_t size)
+    {
+        m_buffer.append(static_cast<const char *>(data), size);
+    }
+
+    void BinaryCacheWriter::writeBool(bool value)
+    {
+        const char v = value ? 1 : 0;
+        write(&v, 1);
+    }
+
+    void BinaryCacheWriter::writeInt(int value)
+    {
+        write(&value, sizeof(int));
+    }
+
+    void BinaryCacheWriter::writeFloat(float value)
+    {
+        write(&value, sizeof(float));
+    }
+
+    void BinaryCacheWriter::writeDouble(double value)
+    {
+        write(&value, sizeof(double));
+    }
+
+    void BinaryCacheWriter::writeString(const std::string & value)
+    {
+        writeInt((int)value.size());
+        write(value.data(), value.size());
+    }
+
+    void BinaryCacheWriter::writeFloats(const std::vector<float> & values)
+    {
+        writeInt((int)values.size());
+        if(!values.empty())
+        {
+            write(values.data(), values.size() * sizeof(float));
+        }
+    }
+
+    BinaryCacheReader::BinaryCacheReader(const char * data, size_t size)
+        :   m_data(data)
+        ,   m_size(size)
+        ,   m_pos(0)
+    {
+    }
+
+    void BinaryCacheReader::read(void * data, size_t size)
+    {
+        if(size > m_size - m_pos)
+        {
+            throw Exception("Corrupted binary cache.");
+        }
+        memcpy(data, m_data + m_pos, size);
+        m_pos += size;
+    }
+
+    bool BinaryCacheReader::readBool()
+    {
+        char v = 0;
+        read(&v, 1);
+        return v != 0;
+    }
+
+    int BinaryCacheReader::readInt()
+    {
+        int v = 0;
+        read(&v, sizeof(int));
+        return v;
+    }
+
+    float BinaryCacheReader::readFloat()
+    {
+        float v = 0.0f;
+        read(&v, sizeof(float));
+        return v;
+    }
+
+    double BinaryCacheReader::readDouble()
+    {
+        double v = 0.0;
+        read(&v, sizeof(double));
+        return v;
+    }
+
+    std::string BinaryCacheReader::readString()
+    {
+        const char * data = nullptr;
+        size_t size = 0;
+        readBlock(data, size);
+        return std::string(data, size);
+    }
+
+    void BinaryCacheReader::readBlock(const char * & data, size_t & size)
+    {
+        const int blockSize = readInt();
+        if(blockSize < 0 || (size_t)blockSize > m_size - m_pos)
+        {
+            throw Exception("Corrupted binary cache.");
+        }
+        data = m_data + m_pos;
+        size = (size_t)blockSize;
+        m_pos += size;
+    }
+
+    void BinaryCacheReader::readFloats(std::vector<float> & values)
+    {
+        const int size = readInt();
+        if(size < 0 || (size_t)size > (m_size - m_pos) / sizeof(float))
+        {
+            throw Exception("Corrupted binary cache.");
+        }
+        values.resize((size_t)size);
+        if(size > 0)
+        {
+            read(values.data(), values.size() * sizeof(float));
+        }
+    }
+
+    void WriteLut1D(BinaryCacheWriter & writer, const Lut1D & lut)
+    {
+        writer.writeFloat(lut.maxerror);
+        writer.writeInt(lut.errortype);
+        for(int i=0; i<3; ++i)
+        {
+            writer.writeFloat(lut.from_min[i]);
+            writer.writeFloat(lut.from_max[i]);
+            writer.writeFloats(lut.luts[i]);
+        }
+        writer.writeInt(lut.inputBitDepth);
+        writer.writeInt(lut.outputBitDepth);
+    }
+
+    void ReadLut1D(BinaryCacheReader & reader, Lut1D & lut)
+    {
+        lut.maxerror = reader.readFloat();
+        lut.errortype = (Lut1D::ErrorType)reader.readInt();
+        for(int i=0; i<3; ++i)
+        {
+            lut.from_min[i] = reader.readFloat();
+            lut.from_max[i] = reader.readFloat();
+            reader.readFloats(lut.luts[i]);
+        }
+        lut.inputBitDepth = (BitDepth)reader.readInt();
+        lut.outputBitDepth = (BitDepth)reader.readInt();
+    }
+
+    void WriteLut3D(BinaryCacheWriter & writer, const Lut3D & lut)
+    {
+        for(int i=0; i<3; ++i)
+        {
+            writer.writeFloat(lut.from_min[i]);
+            writer.writeFloat(lut.from_max[i]);
+            writer.writeInt(lut.size[i]);
+        }
+        writer.writeFloats(lut.lut);
+    }
+
+    void ReadLut3D(BinaryCacheReader & reader, Lut3D & lut)
+    {
+        for(int i=0; i<3; ++i)
+        {
+            lut.from_min[i] = reader.readFloat();
+            lut.from_max[i] = reader.readFloat();
+            lut.size[i] = reader.readInt();
+        }
+        reader.readFloats(lut.lut);
+
+        if((size_t)lut.size[0] * lut.size[1] * lut.size[2] * 3 != lut.lut.size())
+        {
+            throw Exception("Corrupted binary cache.");
+        }
+    }
+
+    namespace
+    {
+        int ReadCount(BinaryCacheReader & reader)
+        {
+            const int count = reader.readInt();
+            if(count < 0)
+            {
+                throw Exception("Corrupted binary cache.");
+            }
+            return count;
+        }
+
+        void WriteMetadataContent(BinaryCacheWriter & writer, const FormatMetadataImpl & metadata)
+        {
+            const FormatMetadataImpl::Attributes & attributes = metadata.getAttributes();
+            writer.writeInt((int)attributes.size());
+            for(const auto & attribute : attributes)
+            {
+                writer.writeString(attribute.first);
+                writer.writeString(attribute.second);
+            }
+
+            const FormatMetadataImpl::Elements & elements = metadata.getChildrenElements();
+            writer.writeInt((int)elements.size());
+            for(const auto & element : elements)
+            {
+                writer.writeString(element.getName());
+                writer.writeString(element.getValue());
+                WriteMetadataContent(writer, element);
+            }
+        }
+
+        void ReadMetadataContent(BinaryCacheReader & reader, FormatMetadataImpl & metadata)
+        {
+            const int numAttributes = ReadCount(reader);
+            for(int i=0; i<numAttributes; ++i)
+            {
+                const std::string name = reader.readString();
+                const std::string value = reader.readString();
+                metadata.addAttribute(name.c_str(), value.c_str());
+            }
+
+            const int numElements = ReadCount(reader);
+            for(int i=0; i<numElements; ++i)
+            {
+                const std::string name = reader.readString();
+                const std::string value = reader.readString();
+                FormatMetadata & element = metadata.addChildElement(name.c_str(), value.c_str());
+                ReadMetadataContent(reader, dynamic_cast<FormatMetadataImpl &>(element));
+            }
+        }
+    }
+
+    void WriteFormatMetadata(BinaryCacheWriter & writer, const FormatMetadataImpl & metadata)
+    {
+        writer.writeString(metadata.getName());
+        writer.writeString(metadata.getValue());
+        WriteMetadataContent(writer, metadata);
+    }
+
+    void ReadFormatMetadata(BinaryCacheReader & reader, FormatMetadataImpl & metadata)
+    {
+        metadata.clear();
+        metadata.setName(reader.readString());
+        metadata.setValue(reader.readString());
+        ReadMetadataContent(reader, metadata);
+    }
+
+    bool LoadFileFromBinaryCache(FileFormat * & format,
+                                 CachedFileRcPtr & cachedFile,
+                                 const std::string & filepath,
+                                 const std::string & fileHash)
+    {
+        const std::string directory = GetBinaryCacheDirectory();
+        if(directory.empty() || fileHash.empty())
+        {
+            return false;
+        }
+
+        const std::string filename = GetBinaryCacheFilename(directory, filepath, fileHash);
+
+        try
+        {
+            // Most of the time, there is no entry.
+            std::ifstream probe(filename.c_str());
+            if(!probe.good())
+            {
+                return false;
+            }
+            probe.close();
+
+            Platform::MappedFile file(filename);
+            BinaryCacheReader header(file.data(), file.size());
+
+            if(header.readString()!=BINARY_CACHE_MAGIC
+               || header.readInt()!=BINARY_CACHE_VERSION
+               || header.readInt()!=BINARY_CACHE_ENDIANNESS)
+            {
+                throw Exception("Unsupported binary cache.");
+            }
+
+            FileFormat * cachedFormat
+                = FormatRegistry::GetInstance().getFileFormatByName(header.readString());
+
+            // Protect against hash collisions.
+            if(!cachedFormat || header.readString()!=filepath || header.readString()!=fileHash)
+            {
+                throw Exception("Mismatching binary cache.");
+            }
+
+            // The payload is read straight from the mapped file.
+            const char * payload = nullptr;
+            size_t payloadSize = 0;
+            header.readBlock(payload, payloadSize);
+            if((unsigned)header.readInt()!=ComputeBinaryCacheChecksum(payload, payloadSize)
+               || !header.atEnd())
+            {
+                throw Exception("Corrupted binary cache.");
+            }
+
+            BinaryCacheReader reader(payload, payloadSize);
+            CachedFileRcPtr loadedFile = cachedFormat->readBinaryCache(reader);
+            if(!loadedFile || !reader.atEnd())
+            {
+                throw Exception("Corrupted binary cache.");
+            }
+
+            format = cachedFormat;
+            cachedFile = loadedFile;
+
+            if(IsDebugLoggingEnabled())
+            {
+                std::ostringstream os;
+                os << "    Loaded " << filepath << " from the binary cache " << filename;
+                LogDebug(os.str());
+            }
+
+            return true;
+        }
+        catch(std::exception & e)
+        {
+            // Fall back to reading the file, which then replaces the faulty entry.
+            std::ostringstream os;
+            os << "Ignoring the binary cache " << filename << " of " << filepath << ": ";
+            os << e.what();
+            LogDebug(os.str());
+        }
+
+        return false;
+    }
+
+    void SaveFileToBinaryCache(const FileFormat * format,
+                               const CachedFileRcPtr & cachedFile,
+                               const std::string & filepath,
+                               const std::string & fileHash)
+    {
+        const std::string directory = GetBinaryCacheDirectory();
+        if(directory.empty() || fileHash.empty() || !format || !cachedFile)
+        {
+            return;
+        }
+
+        BinaryCacheWriter payload;
+        if(!format->writeBinaryCache(cachedFile, payload))
+        {
+            return;
+        }
+
+        BinaryCacheWriter writer;
+        writer.writeString(BINARY_CACHE_MAGIC);
+        writer.writeInt(BINARY_CACHE_VERSION);
+        writer.writeInt(BINARY_CACHE_ENDIANNESS);
+        writer.writeString(format->getName());
+        writer.writeString(filepath);
+        writer.writeString(fileHash);
+        writer.writeString(payload.getBuffer());
+        writer.writeInt((int)ComputeBinaryCacheChecksum(payload.getBuffer().data(),
+                                                        payload.getBuffer().size()));
+
+        const std::string filename = GetBinaryCacheFilename(directory, filepath, fileHash);
+
+        if(!WriteBinaryCacheFile(filename, writer.getBuffer()))
+        {
+            std::ostringstream os;
+            os << "Could not write the binary cache " << filename << " of " << filepath;
+            LogDebug(os.str());
+        }
+    }
+
+    void SetFileCacheDirectory(const char * dirname)
+    {
+        AutoMutex lock(g_binaryCacheDirectoryMutex);
+        g_binaryCacheDirectory = dirname ? dirname : "";
+        g_binaryCacheDirectoryInitialized = true;
+    }
+
+    const char * GetFileCacheDirectory()
+    {
+        GetBinaryCacheDirectory();
+
+        AutoMutex lock(g_binaryCacheDirectoryMutex);
+        return g_binaryCacheDirectory.c_str();
+    }
+}
+OCIO_NAMESPACE_EXIT
+
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef OCIO_UNIT_TEST
+
+namespace OCIO = OCIO_NAMESPACE;
+#include "PathUtils.h"
+#include "UnitTest.h"
+#include "UnitTestUtils.h"
+
+OCIO_ADD_TEST(BinaryCache, reader_writer)
+{
+    OCIO::BinaryCacheWriter writer;
+    writer.writeBool(true);
+    writer.writeInt(-12);
+    writer.writeFloat(0.5f);
+    writer.writeDouble(0.1);
+    writer.writeString("abc");
+    writer.writeFloats({ 1.0f, 2.0f, 3.0f });
+
+    const std::string & buffer = writer.getBuffer();
+
+    OCIO::BinaryCacheReader reader(buffer.data(), buffer.size());
+    OCIO_CHECK_EQUAL(reader.readBool(), true);
+    OCIO_CHECK_EQUAL(reader.readInt(), -12);
+    OCIO_CHECK_EQUAL(reader.readFloat(), 0.5f);
+    OCIO_CHECK_EQUAL(reader.readDouble(), 0.1);
+    OCIO_CHECK_EQUAL(reader.readString(), "abc");
+    std::vector<float> values;
+    reader.readFloats(values);
+    OCIO_REQUIRE_EQUAL(values.size(), 3);
+    OCIO_CHECK_EQUAL(values[2], 3.0f);
+    OCIO_CHECK_ASSERT(reader.atEnd());
+
+    OCIO_CHECK_THROW_WHAT(reader.readInt(), OCIO::Exception, "Corrupted binary cache");
+
+    // Truncated buffer.
+    OCIO::BinaryCacheReader truncated(buffer.data(), buffer.size() - 4);
+    truncated.readBool();
+    truncated.readInt();
+    truncated.readFloat();
+    truncated.readDouble();
+    truncated.readString();
+    OCIO_CHECK_THROW_WHAT(truncated.readFloats(values), OCIO::Exception, "Corrupted binary cache");
+}
+
+OCIO_ADD_TEST(BinaryCache, load_and_save)
+{
+    const std::string lutName("lustre_33x33x33.3dl");
+    const std::string filepath = std::string(OCIO::getTestFilesDir()) + "/" + lutName;
+    const std::string fileHash = OCIO::ComputeFastFileHash(filepath);
+    OCIO_REQUIRE_ASSERT(!fileHash.empty());
+
+    std::string tmpFilename;
+    OCIO::Platform::CreateTempFilename(tmpFilename, "");
+    const std::string directory = pystring::os::path::dirname(tmpFilename);
+    const std::string entry = OCIO::GetBinaryCacheFilename(directory, filepath, fileHash);
+    std::remove(entry.c_str());
+
+    const std::string previousDirectory = OCIO::GetFileCacheDirectory();
+
+    OCIO::FileFormat * format = nullptr;
+    OCIO::CachedFileRcPtr cachedFile;
+
+    // Disabled.
+    OCIO::SetFileCacheDirectory("");
+    OCIO_CHECK_ASSERT(!OCIO::LoadFileFromBinaryCache(format, cachedFile, filepath, fileHash));
+
+    OCIO::SetFileCacheDirectory(directory.c_str());
+    OCIO_CHECK_EQUAL(std::string(OCIO::GetFileCacheDirectory()), directory);
+    OCIO_CHECK_ASSERT(!OCIO::LoadFileFromBinaryCache(format, cachedFile, filepath, fileHash));
+
+    // Reading the file populates the persistent cache.
+    OCIO::ClearAllCaches();
+    OCIO::ConstProcessorRcPtr proc;
+    OCIO_CHECK_NO_THROW(proc = OCIO::GetFileTransformProcessor(lutName));
+    OCIO_CHECK_ASSERT(OCIO::LoadFileFromBinaryCache(format, cachedFile, filepath, fileHash));
+    OCIO_CHECK_ASSERT(format);
+    OCIO_CHECK_ASSERT(cachedFile);
+
+    // The LUT read from the persistent cache is identical.
+    OCIO::ClearAllCaches();
+    OCIO::ConstProcessorRcPtr cachedProc;
+    OCIO_CHECK_NO_THROW(cachedProc = OCIO::GetFileTransformProcessor(lutName));
+    OCIO_CHECK_EQUAL(std::string(cachedProc->getCacheID()), std::string(proc->getCacheID()));
+
+    // Another version of the file.
+    OCIO_CHECK_ASSERT(!OCIO::LoadFileFromBinaryCache(format, cachedFile, filepath, fileHash + "1"));
+
+    // A corrupted entry is ignored, and replaced.
+    {
+        std::string content;
+        {
+            OCIO::Platform::MappedFile file(entry);
+            content.assign(file.data(), file.size() / 2);
+        }
+        std::ofstream stream(entry.c_str(), std::ios_base::out | std::ios_base::binary);
+        stream << content;
+    }
+    OCIO_CHECK_ASSERT(!OCIO::LoadFileFromBinaryCache(format, cachedFile, filepath, fileHash));
+
+    OCIO::ClearAllCaches();
+    OCIO_CHECK_NO_THROW(cachedProc = OCIO::GetFileTransformProcessor(lutName));
+    OCIO_CHECK_EQUAL(std::string(cachedProc->getCacheID()), std::string(proc->getCacheID()));
+    OCIO_CHECK_ASSERT(OCIO::LoadFileFromBinaryCache(format, cachedFile, filepath, fileHash));
+
+    OCIO::SetFileCacheDirectory(previousDirectory.c_str());
+    OCIO::ClearAllCaches();
+    std::remove(entry.c_str());
+}
+
+OCIO_ADD_TEST(BinaryCache, write_file)
+{
+    std::string filename;
+    OCIO::Platform::CreateTempFilename(filename, ".ociocache");
+
+    OCIO_CHECK_ASSERT(OCIO::WriteBinaryCacheFile(filename, "first"));
+
+    // An existing entry is replaced.
+    OCIO_CHECK_ASSERT(OCIO::WriteBinaryCacheFile(filename, "second"));
+    {
+        std::ifstream stream(filename.c_str(), std::ios_base::in | std::ios_base::binary);
+        const std::string content((std::istreambuf_iterator<char>(stream)),
+                                  std::istreambuf_iterator<char>());
+        OCIO_CHECK_EQUAL(content, "second");
+    }
+
+    const std::string missingDirectory
+        = pystring::os::path::join(filename + ".missing", "entry.ociocache");
+    OCIO_CHECK_ASSERT(!OCIO::WriteBinaryCacheFile(missingDirectory, "first"));
+
+    std::remove(filename.c_str());
+}
+
+OCIO_ADD_TEST(BinaryCache, ctf_load_and_save)
+{
+    std::string tmpFilename;
+    OCIO::Platform::CreateTempFilename(tmpFilename, "");
+    const std::string directory = pystring::os::path::dirname(tmpFilename);
+
+    const std::string previousDirectory = OCIO::GetFileCacheDirectory();
+    OCIO::SetFileCacheDirectory(directory.c_str());
+
+    // A LUT1D with an integer input, a LUT3D and a half domain inverse LUT1D.
+    const std::vector<std::string> lutNames{ "lut1d_comp.clf",
+                                             "lut3d_17x17x17_10i_12i.clf",
+                                             "lut1d_inverse_halfdom_slog_fclut.ctf" };
+    for (const auto & lutName : lutNames)
+    {
+        const std::string filepath = std::string(OCIO::getTestFilesDir()) + "/" + lutName;
+        const std::string fileHash = OCIO::ComputeFastFileHash(filepath);
+        OCIO_REQUIRE_ASSERT(!fileHash.empty());
+        const std::string entry = OCIO::GetBinaryCacheFilename(directory, filepath, fileHash);
+        std::remove(entry.c_str());
+
+        OCIO::ClearAllCaches();
+        OCIO::ConstProcessorRcPtr proc;
+        OCIO_CHECK_NO_THROW(proc = OCIO::GetFileTransformProcessor(lutName));
+
+        OCIO::FileFormat * format = nullptr;
+        OCIO::CachedFileRcPtr cachedFile;
+        OCIO_CHECK_ASSERT(OCIO::LoadFileFromBinaryCache(format, cachedFile, filepath, fileHash));
+
+        // The LUTs read from the persistent cache are identical.
+        OCIO::ClearAllCaches();
+        OCIO::ConstProcessorRcPtr cachedProc;
+        OCIO_CHECK_NO_THROW(cachedProc = OCIO::GetFileTransformProcessor(lutName));
+        OCIO_CHECK_EQUAL(std::string(cachedProc->getCacheID()), std::string(proc->getCacheID()));
+
+        float pixel[3] = { 0.1f, 0.5f, 0.9f };
+        float cachedPixel[3] = { 0.1f, 0.5f, 0.9f };
+        proc->getDefaultCPUProcessor()->applyRGB(pixel);
+        cachedProc->getDefaultCPUProcessor()->applyRGB(cachedPixel);
+        OCIO_CHECK_EQUAL(pixel[0], cachedPixel[0]);
+        OCIO_CHECK_EQUAL(pixel[1], cachedPixel[1]);
+        OCIO_CHECK_EQUAL(pixel[2], cachedPixel[2]);
+
+        std::remove(entry.c_str());
+    }
+
+    // The files holding other ops are not stored.
+    {
+        const std::string lutName("cdl_clamp_fwd.clf");
+        const std::string filepath = std::string(OCIO::getTestFilesDir()) + "/" + lutName;
+        const std::string fileHash = OCIO::ComputeFastFileHash(filepath);
+
+        OCIO::ClearAllCaches();
+        OCIO_CHECK_NO_THROW(OCIO::GetFileTransformProcessor(lutName));
+
+        OCIO::FileFormat * format = nullptr;
+        OCIO::CachedFileRcPtr cachedFile;
+        OCIO_CHECK_ASSERT(!OCIO::LoadFileFromBinaryCache(format, cachedFile, filepath, fileHash));
+    }
+
+    OCIO::SetFileCacheDirectory(previousDirectory.c_str());
+    OCIO::ClearAllCaches();
+}
+
+#endif // OCIO_UNIT_TEST
@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_BINARYCACHE_H
+#define INCLUDED_OCIO_BINARYCACHE_H
+
+#include <string>
+#include <vector>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "fileformats/FormatMetadata.h"
+#include "ops/Lut1D/Lut1DOp.h"
+#include "ops/Lut3D/Lut3DOp.h"
+#include "transforms/FileTransform.h"
+
+OCIO_NAMESPACE_ENTER
+{
+    // The persistent file cache stores the payload of the parsed LUT files in a compact
+    // binary form, so other processes map it instead of parsing the file again (refer to
+    // SetFileCacheDirectory()). Only the formats implementing FileFormat::writeBinaryCache()
+    // and FileFormat::readBinaryCache() are stored.
+
+    class BinaryCacheWriter
+    {
+    public:
+        void writeBool(bool value);
+        void writeInt(int value);
+        void writeFloat(float value);
+        void writeDouble(double value);
+        void writeString(const std::string & value);
+        void writeFloats(const std::vector<float> & values);
+
+        const std::string & getBuffer() const { return m_buffer; }
+
+    private:
+        void write(const void * data, size_t size);
+
+        std::string m_buffer;
+    };
+
+    // Throws an exception when reading past the end of the buffer (i.e. corrupted cache).
+    class BinaryCacheReader
+    {
+    public:
+        BinaryCacheReader(const char * data, size_t size);
+
+        bool readBool();
+        int readInt();
+        float readFloat();
+        double readDouble();
+        std::string readString();
+        void readFloats(std::vector<float> & values);
+        // Access a block written by writeString() without copying it.
+        void readBlock(const char * & data, size_t & size);
+
+        bool atEnd() const { return m_pos == m_size; }
+
+    private:
+        void read(void * data, size_t size);
+
+        const char * m_data;
+        size_t m_size;
+        size_t m_pos;
+    };
+
+    // The directory of the persistent cache, empty if disabled.
+    std::string GetBinaryCacheDirectory();
+
+    // The entry of a version of a file (identified by its fast hash) in the directory.
+    std::string GetBinaryCacheFilename(const std::string & directory,
+                                       const std::string & filepath,
+                                       const std::string & fileHash);
+
+    // Detects a truncated or damaged entry.
+    unsigned ComputeBinaryCacheChecksum(const char * data, size_t size);
+
+    // Write the entry so concurrent processes never read a partially written one. Returns
+    // false if the entry could not be written.
+    bool WriteBinaryCacheFile(const std::string & filename, const std::string & content);
+
+    // Helpers for the legacy LUT structures used by most of the file formats.
+    void WriteLut1D(BinaryCacheWriter & writer, const Lut1D & lut);
+    void ReadLut1D(BinaryCacheReader & reader, Lut1D & lut);
+    void WriteLut3D(BinaryCacheWriter & writer, const Lut3D & lut);
+    void ReadLut3D(BinaryCacheReader & reader, Lut3D & lut);
+
+    // Helpers for the metadata of the transforms and ops.
+    void WriteFormatMetadata(BinaryCacheWriter & writer, const FormatMetadataImpl & metadata);
+    void ReadFormatMetadata(BinaryCacheReader & reader, FormatMetadataImpl & metadata);
+
+    // Load the file from the persistent cache. Returns false if the cache is disabled or if
+    // there is no valid entry for this version of the file (identified by its fast hash).
+    bool LoadFileFromBinaryCache(FileFormat * & format,
+                                 CachedFileRcPtr & cachedFile,
+                                 const std::string & filepath,
+                                 const std::string & fileHash);
+
+    // Store the file in the persistent cache if enabled and supported by the format.
+    void SaveFileToBinaryCache(const FileFormat * format,
+                               const CachedFileRcPtr & cachedFile,
+                               const std::string & filepath,
+                               const std::string & fileHash);
+}
+OCIO_NAMESPACE_EXIT
+
+#endif
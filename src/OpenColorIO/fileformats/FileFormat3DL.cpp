@@ -8,6 +8,8 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "Baker.h"
+#include "fileformats/BinaryCache.h"
 #include "MathUtils.h"
 #include "ops/Lut1D/Lut1DOp.h"
 #include "ops/Lut3D/Lut3DOp.h"
@@ -94,6 +96,11 @@ OCIO_NAMESPACE_ENTER
             };
             ~LocalCachedFile() {};
             
+            size_t getMemorySize() const override
+            {
+                return sizeof(LocalCachedFile) + lut1D->getMemorySize() + lut3D->getMemorySize();
+            }
+            
             bool has1D;
             bool has3D;
             // TODO: Switch to the OpData classes.
@@ -127,6 +134,11 @@ OCIO_NAMESPACE_ENTER
                               CachedFileRcPtr untypedCachedFile,
                               const FileTransform& fileTransform,
                               TransformDirection dir) const override;
+
+            bool writeBinaryCache(const CachedFileRcPtr & untypedCachedFile,
+                                  BinaryCacheWriter & writer) const override;
+
+            CachedFileRcPtr readBinaryCache(BinaryCacheReader & reader) const override;
         };
         
         
@@ -487,11 +499,6 @@ OCIO_NAMESPACE_ENTER
             int shaperSize = baker.getShaperSize();
             if(shaperSize==-1) shaperSize = cubeSize;
             
-            std::vector<float> cubeData;
-            cubeData.resize(cubeSize*cubeSize*cubeSize*3);
-            GenerateIdentityLut3D(&cubeData[0], cubeSize, 3, LUT3DORDER_FAST_BLUE);
-            PackedImageDesc cubeImg(&cubeData[0], cubeSize*cubeSize*cubeSize, 1, 3);
-            
             // Apply our conversion from the input space to the output space.
             ConstProcessorRcPtr inputToTarget;
             std::string looks = baker.getLooks();
@@ -509,8 +516,9 @@ OCIO_NAMESPACE_ENTER
               inputToTarget = config->getProcessor(baker.getInputSpace(),
                   baker.getTargetSpace());
             }
-            ConstCPUProcessorRcPtr cpu = inputToTarget->getDefaultCPUProcessor();
-            cpu->apply(cubeImg);
+            ConstBakedSamplesRcPtr samples
+                = BakeLut3DSamples({ inputToTarget }, cubeSize, LUT3DORDER_FAST_BLUE);
+            const std::vector<float> & cubeData = *samples;
             
             // Write out the file.
             // For for maximum compatibility with other apps, we will
@@ -529,13 +537,14 @@ OCIO_NAMESPACE_ENTER
             float shaperScale = static_cast<float>(
                 GetMaxValueFromIntegerBitDepth(SHAPER_BIT_DEPTH));
             
+            NumberWriter writer(ostream);
             for(unsigned int i=0; i<shaperData.size(); ++i)
             {
-                if(i != 0) ostream << " ";
+                if(i != 0) writer.write(' ');
                 int val = GetClampedIntFromNormFloat(shaperData[i], shaperScale);
-                ostream << val;
+                writer.writeFixed(val, 0);
             }
-            ostream << "\n";
+            writer.write('\n');
             
             // Write out the 3D Cube
             float cubeScale = static_cast<float>(
@@ -549,9 +558,15 @@ OCIO_NAMESPACE_ENTER
                 int r = GetClampedIntFromNormFloat(cubeData[3*i+0], cubeScale);
                 int g = GetClampedIntFromNormFloat(cubeData[3*i+1], cubeScale);
                 int b = GetClampedIntFromNormFloat(cubeData[3*i+2], cubeScale);
-                ostream << r << " " << g << " " << b << "\n";
+                writer.writeFixed(r, 0);
+                writer.write(' ');
+                writer.writeFixed(g, 0);
+                writer.write(' ');
+                writer.writeFixed(b, 0);
+                writer.write('\n');
             }
-            ostream << "\n";
+            writer.write('\n');
+            writer.flush();
             
             if(formatName == "lustre")
             {
@@ -620,6 +635,30 @@ OCIO_NAMESPACE_ENTER
                 }
             }
         }
+
+        bool LocalFileFormat::writeBinaryCache(const CachedFileRcPtr & untypedCachedFile,
+                                               BinaryCacheWriter & writer) const
+        {
+            LocalCachedFileRcPtr cachedFile = DynamicPtrCast<LocalCachedFile>(untypedCachedFile);
+            if(!cachedFile) return false;
+
+            writer.writeBool(cachedFile->has1D);
+            writer.writeBool(cachedFile->has3D);
+            WriteLut1D(writer, *cachedFile->lut1D);
+            WriteLut3D(writer, *cachedFile->lut3D);
+            return true;
+        }
+
+        CachedFileRcPtr LocalFileFormat::readBinaryCache(BinaryCacheReader & reader) const
+        {
+            LocalCachedFileRcPtr cachedFile = LocalCachedFileRcPtr(new LocalCachedFile());
+
+            cachedFile->has1D = reader.readBool();
+            cachedFile->has3D = reader.readBool();
+            ReadLut1D(reader, *cachedFile->lut1D);
+            ReadLut3D(reader, *cachedFile->lut3D);
+            return cachedFile;
+        }
     }
     
     FileFormat * CreateFileFormat3DL()
@@ -41,6 +41,11 @@ OCIO_NAMESPACE_ENTER
             CachedFileRcPtr read(
                 std::istream & istream,
                 const std::string & fileName) const override;
+
+            int probe(const char * data, size_t size) const override
+            {
+                return ProbeXMLElement(data, size, "ColorCorrection");
+            }
             
             void buildFileOps(OpRcPtrVec & ops,
                               const Config& config,
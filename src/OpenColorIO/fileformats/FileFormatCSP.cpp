@@ -13,6 +13,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "Baker.h"
 #include "MathUtils.h"
 #include "ops/Lut1D/Lut1DOp.h"
 #include "ops/Lut3D/Lut3DOp.h"
@@ -299,6 +300,11 @@ OCIO_NAMESPACE_ENTER
             };
             ~CachedFileCSP() {};
             
+            size_t getMemorySize() const override
+            {
+                return sizeof(CachedFileCSP) + prelut->getMemorySize() + lut1D->getMemorySize() + lut3D->getMemorySize();
+            }
+            
             bool hasprelut;
             std::string csptype;
             std::string metadata;
@@ -315,6 +321,23 @@ OCIO_NAMESPACE_ENTER
             return pystring::startswith(pystring::upper(pystring::strip(str)), prefix);
         }
         
+        // Read all the floats of the line. Return false if a value is not a float,
+        // the values still hold one entry per word of the line.
+        bool ReadFloats(std::vector<float> & values, const std::string & line)
+        {
+            values.clear();
+            
+            bool valid = true;
+            LineTokenizer tokens(line);
+            while(tokens.next())
+            {
+                float value = 0.0f;
+                valid = tokens.getFloat(value) && valid;
+                values.push_back(value);
+            }
+            return valid;
+        }
+        
         class LocalFileFormat : public FileFormat
         {
         public:
@@ -326,6 +349,12 @@ OCIO_NAMESPACE_ENTER
             CachedFileRcPtr read(
                 std::istream & istream,
                 const std::string & fileName) const override;
+
+            int probe(const char * data, size_t size) const override
+            {
+                return ProbeStartsWith(data, size, "CSPLUTV100") ? FORMAT_PROBE_LIKELY
+                                                                : FORMAT_PROBE_NO;
+            }
             
             void bake(const Baker & baker,
                       const std::string & formatName,
@@ -438,26 +467,23 @@ OCIO_NAMESPACE_ENTER
                 
                 if(cpoints>=2)
                 {
-                    StringVec inputparts, outputparts;
-                    
                     nextline (istream, line);
-                    pystring::split(pystring::strip(line), inputparts);
+                    const bool validInput = ReadFloats(prelut_in[c], line);
                     
                     nextline (istream, line);
-                    pystring::split(pystring::strip(line), outputparts);
+                    const bool validOutput = ReadFloats(prelut_out[c], line);
                     
-                    if(static_cast<int>(inputparts.size()) != cpoints ||
-                       static_cast<int>(outputparts.size()) != cpoints)
+                    if(static_cast<int>(prelut_in[c].size()) != cpoints ||
+                       static_cast<int>(prelut_out[c].size()) != cpoints)
                     {
                         std::ostringstream os;
                         os << "Prelut does not specify the expected number of data points. ";
                         os << "Expected: " << cpoints << ".";
-                        os << "Found: " << inputparts.size() << ", " << outputparts.size() << ".";
+                        os << "Found: " << prelut_in[c].size() << ", " << prelut_out[c].size() << ".";
                         throw Exception(os.str().c_str());
                     }
                     
-                    if(!StringVecToFloatVec(prelut_in[c], inputparts) ||
-                       !StringVecToFloatVec(prelut_out[c], outputparts))
+                    if(!validInput || !validOutput)
                     {
                         std::ostringstream os;
                         os << "Prelut data is malformed, cannot to float array.";
@@ -508,8 +534,10 @@ OCIO_NAMESPACE_ENTER
                     // scan for the three floats
                     float lp[3];
                     nextline (istream, line);
-                    if (sscanf (line.c_str(), "%f %f %f",
-                        &lp[0], &lp[1], &lp[2]) != 3) {
+                    LineTokenizer tokens(line);
+                    if (!tokens.nextFloat(lp[0]) ||
+                        !tokens.nextFloat(lp[1]) ||
+                        !tokens.nextFloat(lp[2])) {
                         throw Exception ("malformed 1D csp LUT");
                     }
 
@@ -542,10 +570,10 @@ OCIO_NAMESPACE_ENTER
                     // load the cube
                     nextline (istream, line);
                     
-                    if(sscanf (line.c_str(), "%f %f %f",
-                       &lut3d_ptr->lut[3*i+0],
-                       &lut3d_ptr->lut[3*i+1],
-                       &lut3d_ptr->lut[3*i+2]) != 3 )
+                    LineTokenizer tokens(line);
+                    if(!tokens.nextFloat(lut3d_ptr->lut[3*i+0]) ||
+                       !tokens.nextFloat(lut3d_ptr->lut[3*i+1]) ||
+                       !tokens.nextFloat(lut3d_ptr->lut[3*i+2]))
                     {
                         std::ostringstream os;
                         os << "Malformed 3D csp LUT, couldn't read cube row (";
@@ -637,14 +665,11 @@ OCIO_NAMESPACE_ENTER
             int cubeSize = baker.getCubeSize();
             if(cubeSize==-1) cubeSize = DEFAULT_CUBE_SIZE;
             cubeSize = std::max(2, cubeSize); // smallest cube is 2x2x2
-            std::vector<float> cubeData;
-            cubeData.resize(cubeSize*cubeSize*cubeSize*3);
-            GenerateIdentityLut3D(&cubeData[0], cubeSize, 3, LUT3DORDER_FAST_RED);
-            PackedImageDesc cubeImg(&cubeData[0], cubeSize*cubeSize*cubeSize, 1, 3);
+            ConstBakedSamplesRcPtr cubeSamples;
 
             std::string looks = baker.getLooks();
             
-            std::vector<float> shaperInData;
+            ConstBakedSamplesRcPtr shaperInSamples;
             std::vector<float> shaperOutData;
             
             // Use an explicitly shaper space
@@ -664,14 +689,11 @@ OCIO_NAMESPACE_ENTER
                 }
                 
                 shaperOutData.resize(shaperSize*3);
-                shaperInData.resize(shaperSize*3);
                 GenerateIdentityLut1D(&shaperOutData[0], shaperSize, 3);
-                GenerateIdentityLut1D(&shaperInData[0], shaperSize, 3);
                 
-                ConstCPUProcessorRcPtr shaperToInput 
-                    = config->getProcessor(baker.getShaperSpace(), 
-                                           baker.getInputSpace())->getDefaultCPUProcessor();
-                if(shaperToInput->hasChannelCrosstalk())
+                ConstProcessorRcPtr shaperToInput 
+                    = config->getProcessor(baker.getShaperSpace(), baker.getInputSpace());
+                if(shaperToInput->getDefaultCPUProcessor()->hasChannelCrosstalk())
                 {
                     // TODO: Automatically turn shaper into non-crosstalked version?
                     std::ostringstream os;
@@ -680,27 +702,23 @@ OCIO_NAMESPACE_ENTER
                     os << "Please select an alternate shaper space or omit this option.";
                     throw Exception(os.str().c_str());
                 }
-                PackedImageDesc shaperInImg(&shaperInData[0], shaperSize, 1, 3);
-                shaperToInput->apply(shaperInImg);
+                shaperInSamples = BakeLut1DSamples({ shaperToInput }, shaperSize);
 
-                ConstCPUProcessorRcPtr shaperToTarget;
+                ConstProcessorRcPtr shaperToTarget;
                 if (!looks.empty())
                 {
                     LookTransformRcPtr transform = LookTransform::Create();
                     transform->setLooks(looks.c_str());
                     transform->setSrc(baker.getShaperSpace());
                     transform->setDst(baker.getTargetSpace());
-                    shaperToTarget
-                        = config->getProcessor(transform, 
-                                               TRANSFORM_DIR_FORWARD)->getDefaultCPUProcessor();
+                    shaperToTarget = config->getProcessor(transform, TRANSFORM_DIR_FORWARD);
                 }
                 else
                 {
                     shaperToTarget
-                        = config->getProcessor(baker.getShaperSpace(), 
-                                               baker.getTargetSpace())->getDefaultCPUProcessor();
+                        = config->getProcessor(baker.getShaperSpace(), baker.getTargetSpace());
                 }
-                shaperToTarget->apply(cubeImg);
+                cubeSamples = BakeLut3DSamples({ shaperToTarget }, cubeSize, LUT3DORDER_FAST_RED);
             }
             else
             {
@@ -744,16 +762,12 @@ OCIO_NAMESPACE_ENTER
                     shaperSize = 2;
                 }
                 shaperOutData.resize(shaperSize*3);
-                shaperInData.resize(shaperSize*3);
                 GenerateIdentityLut1D(&shaperOutData[0], shaperSize, 3);
-                GenerateIdentityLut1D(&shaperInData[0], shaperSize, 3);
                 
                 // Apply the forward to the allocation to the output shaper y axis, and the cube
-                ConstCPUProcessorRcPtr shaperToInput
-                    = config->getProcessor(allocationTransform, TRANSFORM_DIR_INVERSE)->getDefaultCPUProcessor();
-                PackedImageDesc shaperInImg(&shaperInData[0], shaperSize, 1, 3);
-                shaperToInput->apply(shaperInImg);
-                shaperToInput->apply(cubeImg);
+                ConstProcessorRcPtr shaperToInput
+                    = config->getProcessor(allocationTransform, TRANSFORM_DIR_INVERSE);
+                shaperInSamples = BakeLut1DSamples({ shaperToInput }, shaperSize);
                 
                 // Apply the 3D LUT to the remainder (from the input to the output)
                 ConstProcessorRcPtr inputToTarget;
@@ -770,9 +784,12 @@ OCIO_NAMESPACE_ENTER
                 {
                     inputToTarget = config->getProcessor(baker.getInputSpace(), baker.getTargetSpace());
                 }
-                ConstCPUProcessorRcPtr cpu = inputToTarget->getDefaultCPUProcessor();
-                cpu->apply(cubeImg);
+                cubeSamples = BakeLut3DSamples({ shaperToInput, inputToTarget },
+                                               cubeSize, LUT3DORDER_FAST_RED);
             }
+
+            const std::vector<float> & shaperInData = *shaperInSamples;
+            const std::vector<float> & cubeData = *cubeSamples;
             
             // Write out the file
             ostream << "CSPLUTV100\n";
@@ -824,10 +841,17 @@ OCIO_NAMESPACE_ENTER
                 throw Exception("Internal cube size exception.");
             }
             ostream << cubeSize << " " << cubeSize << " " << cubeSize << "\n";
+            NumberWriter writer(ostream);
             for(int i=0; i<cubeSize*cubeSize*cubeSize; ++i)
             {
-                ostream << cubeData[3*i+0] << " " << cubeData[3*i+1] << " " << cubeData[3*i+2] << "\n";
+                writer.writeFixed(cubeData[3*i+0], 6);
+                writer.write(' ');
+                writer.writeFixed(cubeData[3*i+1], 6);
+                writer.write(' ');
+                writer.writeFixed(cubeData[3*i+2], 6);
+                writer.write('\n');
             }
+            writer.flush();
             ostream << "\n";
         }
         
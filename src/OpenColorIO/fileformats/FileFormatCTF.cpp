@@ -1,14 +1,18 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <algorithm>
 #include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <fstream>
+#include <iterator>
 #include <sstream>
 
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "expat.h"
+#include "fileformats/BinaryCache.h"
 #include "fileformats/ctf/CTFTransform.h"
 #include "fileformats/ctf/CTFReaderHelper.h"
 #include "fileformats/ctf/CTFReaderUtils.h"
@@ -16,6 +20,8 @@
 #include "fileformats/xmlutils/XMLReaderUtils.h"
 #include "fileformats/xmlutils/XMLWriterUtils.h"
 #include "OpBuilders.h"
+#include "ops/Lut1D/Lut1DOpData.h"
+#include "ops/Lut3D/Lut3DOpData.h"
 #include "ops/NoOp/NoOps.h"
 #include "Platform.h"
 #include "pystring/pystring.h"
@@ -98,6 +104,31 @@ public:
     {
     };
     ~LocalCachedFile() {};
+
+    size_t getMemorySize() const override
+    {
+        size_t size = sizeof(LocalCachedFile);
+        if (m_transform)
+        {
+            // The LUT arrays dominate.
+            for (const auto & op : m_transform->getOps())
+            {
+                if (auto lut1D = DynamicPtrCast<const Lut1DOpData>(op))
+                {
+                    size += lut1D->getArray().getValues().size() * sizeof(float);
+                }
+                else if (auto lut3D = DynamicPtrCast<const Lut3DOpData>(op))
+                {
+                    size += lut3D->getArray().getValues().size() * sizeof(float);
+                }
+                else
+                {
+                    size += sizeof(OpData);
+                }
+            }
+        }
+        return size;
+    }
             
     CTFReaderTransformPtr m_transform;
     std::string m_filePath;
@@ -116,6 +147,15 @@ public:
             
     CachedFileRcPtr read(std::istream & istream,
                          const std::string & fileName) const override;
+
+    CachedFileRcPtr readBuffer(const char * data,
+                               size_t size,
+                               const std::string & fileName) const override;
+
+    int probe(const char * data, size_t size) const override
+    {
+        return ProbeXMLElement(data, size, "ProcessList");
+    }
             
     void buildFileOps(OpRcPtrVec & ops,
                       const Config & config,
@@ -128,6 +168,11 @@ public:
                const FormatMetadataImpl & metadata,
                const std::string & formatName,
                std::ostream & /*ostream*/) const override;
+
+    bool writeBinaryCache(const CachedFileRcPtr & untypedCachedFile,
+                          BinaryCacheWriter & writer) const override;
+
+    CachedFileRcPtr readBinaryCache(BinaryCacheReader & reader) const override;
 };
         
 void LocalFileFormat::getFormatInfo(FormatInfoVec & formatInfoVec) const
@@ -145,6 +190,13 @@ void LocalFileFormat::getFormatInfo(FormatInfoVec & formatInfoVec) const
     info2.capabilities = FORMAT_CAPABILITY_READ |
                          FORMAT_CAPABILITY_WRITE;
     formatInfoVec.push_back(info2);
+
+    // Opt-in CTF variant whose LUT arrays are base64 encoded (refer to ArrayEncoding).
+    FormatInfo info3;
+    info3.name = FILEFORMAT_CTF_BINARY;
+    info3.extension = "ctf";
+    info3.capabilities = FORMAT_CAPABILITY_WRITE;
+    formatInfoVec.push_back(info3);
 }
 
 class XMLParserHelper
@@ -171,23 +223,37 @@ public:
         XML_ParserFree(m_parser);
     }
 
-    void Parse(std::istream & istream)
+    void Parse(const char * data, size_t size)
     {
-        std::string line;
-        m_lineNumber = 0;
-        while (istream.good())
+        // Expat is fed large blocks rather than lines to avoid the overhead of its
+        // calls. The blocks end on a line boundary, so the character data of the
+        // elements is still split at the lines (i.e. never in the middle of a number).
+        static const size_t BLOCK_SIZE = 1024 * 1024;
+
+        const char * end = data + size;
+        do
         {
-            std::getline(istream, line);
-            // Add back the newline character. Parsing will copy the line in a
-            // buffer up to the length of the line without the null termination.
-            // Our code will be called back to parse the buffer into a number.
-            // Code uses strtod. The buffer has to be delimited so that strtod
-            // does not access it after its length.
-            line.push_back('\n');
-            ++m_lineNumber;
-
-            Parse(line, !istream.good());
+            const char * blockEnd = end;
+            if (size_t(end - data) > BLOCK_SIZE)
+            {
+                const char * lastLine = data + BLOCK_SIZE;
+                while (lastLine != data && *(lastLine - 1) != '\n') --lastLine;
+
+                if (lastLine != data)
+                {
+                    blockEnd = lastLine;
+                }
+                else
+                {
+                    const void * eol = memchr(data + BLOCK_SIZE, '\n', end - data - BLOCK_SIZE);
+                    blockEnd = eol ? static_cast<const char *>(eol) + 1 : end;
+                }
+            }
+
+            Parse(data, blockEnd - data, blockEnd == end);
+            data = blockEnd;
         }
+        while (data != end);
 
         if (!m_elms.empty())
         {
@@ -213,13 +279,13 @@ public:
         }
     }
 
-    void Parse(const std::string & buffer, bool lastLine)
+    void Parse(const char * buffer, size_t size, bool lastBlock)
     {
-        const int done = lastLine?1:0;
+        const int done = lastBlock?1:0;
 
         if (XML_STATUS_ERROR == XML_Parse(m_parser,
-                                          buffer.c_str(),
-                                          (int)buffer.size(), done))
+                                          buffer,
+                                          (int)size, done))
         {
             XML_Error eXpatErrorCode = XML_GetErrorCode(m_parser);
             if (eXpatErrorCode == XML_ERROR_TAG_MISMATCH)
@@ -303,7 +369,7 @@ private:
         os << "Error parsing CTF/CLF file (";
         os << m_fileName.c_str() << "). ";
         os << "Error is: " << error.c_str();
-        os << ". At line (" << m_lineNumber << ")";
+        os << ". At line (" << getXmLineNumber() << ")";
         throw Exception(os.str().c_str());
     }
 
@@ -411,7 +477,7 @@ private:
                     std::make_shared<CTFReaderMetadataElt>(
                         name,
                         pMD,
-                        pImpl->m_lineNumber,
+                        pImpl->getXmLineNumber(),
                         pImpl->m_fileName));
 
                 pImpl->m_elms.back()->start(atts);
@@ -598,7 +664,8 @@ private:
                             std::make_shared<CTFReaderArrayElt>(
                                 name, pContainer,
                                 pImpl->getXmLineNumber(),
-                                pImpl->getXmlFilename()));
+                                pImpl->getXmlFilename(),
+                                pImpl->IsCLF()));
                     }
                 }
                 else if (SupportedElement(name, pElt, TAG_DESCRIPTION,
@@ -975,7 +1042,7 @@ private:
 
     unsigned int getXmLineNumber() const
     {
-        return m_lineNumber;
+        return (unsigned int)XML_GetCurrentLineNumber(m_parser);
     }
 
     const std::string & getXmlFilename() const
@@ -989,7 +1056,6 @@ private:
     }
 
     XML_Parser m_parser;
-    unsigned int m_lineNumber;
     std::string m_fileName;
     bool m_isCLF;
     XmlReaderElementStack m_elms; // Parsing stack
@@ -997,31 +1063,11 @@ private:
 
 };
 
-bool isLoadableCTF(std::istream & istream)
+bool isLoadableCTF(const char * data, size_t size)
 {
-    std::streampos curPos = istream.tellg();
-
-    const unsigned limit(5 * 1024); // 5 kilobytes.
-    const char *pattern = "<ProcessList";
-    bool foundPattern = false;
-    unsigned sizeProcessed(0);
-    char line[limit + 1];
-
-    // Error: file is not found, or cannot read.
-    if (istream.good())
-    {
-        // Find ProcessList tag at beginning of file.
-        while (istream.good() && !foundPattern && (sizeProcessed < limit))
-        {
-            istream.getline(line, limit);
-            if (strstr(line, pattern)) foundPattern = true;
-            sizeProcessed += (unsigned)strlen(line);
-        }
-    }
-
-    // Restore pos in stream.
-    istream.seekg(curPos);
-    return foundPattern;
+    // Find ProcessList tag at beginning of file.
+    const size_t limit(5 * 1024); // 5 kilobytes.
+    return ProbeContains(data, std::min(size, limit), "<ProcessList");
 }
 
 // Try and load the format.
@@ -1030,7 +1076,18 @@ CachedFileRcPtr LocalFileFormat::read(
     std::istream & istream,
     const std::string & filePath) const
 {
-    if (!isLoadableCTF(istream))
+    // Parse the whole content from memory.
+    const std::string content((std::istreambuf_iterator<char>(istream)),
+                              std::istreambuf_iterator<char>());
+    return readBuffer(content.data(), content.size(), filePath);
+}
+
+CachedFileRcPtr LocalFileFormat::readBuffer(
+    const char * data,
+    size_t size,
+    const std::string & filePath) const
+{
+    if (!isLoadableCTF(data, size))
     {
         std::ostringstream oss;
         oss << "Parsing error: '" << filePath << "' is not a CTF/CLF file.";
@@ -1038,18 +1095,209 @@ CachedFileRcPtr LocalFileFormat::read(
     }
 
     XMLParserHelper parser(filePath);
-    parser.Parse(istream);
+    parser.Parse(data, size);
 
     LocalCachedFileRcPtr cachedFile =
         LocalCachedFileRcPtr(new LocalCachedFile());
 
     // Keep transform.
     cachedFile->m_transform = parser.getTransform();
+    // Identical LUTs from different files share their values.
+    InternOpArrays(cachedFile->m_transform->getOps());
     cachedFile->m_filePath = filePath;
 
     return cachedFile;
 }
 
+namespace
+{
+void WriteVersion(BinaryCacheWriter & writer, const CTFVersion & version)
+{
+    std::ostringstream oss;
+    oss << version;
+    writer.writeString(oss.str());
+}
+
+CTFVersion ReadVersion(BinaryCacheReader & reader)
+{
+    CTFVersion version;
+    CTFVersion::ReadVersion(reader.readString(), version);
+    return version;
+}
+
+void WriteOpArray(BinaryCacheWriter & writer, const Array & array)
+{
+    writer.writeInt((int)array.getLength());
+    writer.writeInt((int)array.getNumColorComponents());
+    writer.writeFloats(array.getValues());
+}
+
+void ReadOpArray(BinaryCacheReader & reader, Array & array)
+{
+    const int length = reader.readInt();
+    const int numColorComponents = reader.readInt();
+    if (length < 0 || numColorComponents < 0)
+    {
+        throw Exception("Corrupted binary cache.");
+    }
+
+    array.resize((unsigned long)length, (unsigned long)numColorComponents);
+    reader.readFloats(array.getValues());
+    array.validate();
+}
+
+void WriteOpData(BinaryCacheWriter & writer, const OpData & op)
+{
+    writer.writeInt(op.getType());
+    WriteFormatMetadata(writer, op.getFormatMetadata());
+    writer.writeInt(op.getInputBitDepth());
+    writer.writeInt(op.getOutputBitDepth());
+}
+}
+
+// The LUTs dominate the parsing of the large files, so only the files holding nothing
+// but LUT1D and LUT3D ops are stored in the persistent file cache.
+bool LocalFileFormat::writeBinaryCache(const CachedFileRcPtr & untypedCachedFile,
+                                       BinaryCacheWriter & writer) const
+{
+    LocalCachedFileRcPtr cachedFile = DynamicPtrCast<LocalCachedFile>(untypedCachedFile);
+    if (!cachedFile || !cachedFile->m_transform)
+    {
+        return false;
+    }
+
+    const CTFReaderTransform & transform = *cachedFile->m_transform;
+    for (const auto & op : transform.getOps())
+    {
+        if (op->getType() != OpData::Lut1DType && op->getType() != OpData::Lut3DType)
+        {
+            return false;
+        }
+    }
+
+    writer.writeString(cachedFile->m_filePath);
+
+    writer.writeString(transform.getID());
+    writer.writeString(transform.getName());
+    writer.writeString(transform.getInverseOfId());
+    writer.writeString(transform.getInputDescriptor());
+    writer.writeString(transform.getOutputDescriptor());
+    WriteFormatMetadata(writer, transform.getInfoMetadata());
+    writer.writeInt((int)transform.getDescriptions().size());
+    for (const auto & desc : transform.getDescriptions())
+    {
+        writer.writeString(desc);
+    }
+    WriteVersion(writer, transform.getCTFVersion());
+    WriteVersion(writer, transform.getCLFVersion());
+
+    writer.writeInt((int)transform.getOps().size());
+    for (const auto & op : transform.getOps())
+    {
+        WriteOpData(writer, *op);
+
+        if (auto lut1D = DynamicPtrCast<const Lut1DOpData>(op))
+        {
+            writer.writeInt(lut1D->getFileOutputBitDepth());
+            writer.writeInt(lut1D->getDirection());
+            writer.writeInt(lut1D->getInterpolation());
+            writer.writeInt(lut1D->getInversionQuality());
+            writer.writeInt(lut1D->getHalfFlags());
+            writer.writeInt(lut1D->getHueAdjust());
+            WriteOpArray(writer, lut1D->getArray());
+        }
+        else
+        {
+            auto lut3D = DynamicPtrCast<const Lut3DOpData>(op);
+            writer.writeInt(lut3D->getFileOutputBitDepth());
+            writer.writeInt(lut3D->getDirection());
+            writer.writeInt(lut3D->getInterpolation());
+            writer.writeInt(lut3D->getInversionQuality());
+            WriteOpArray(writer, lut3D->getArray());
+        }
+    }
+
+    return true;
+}
+
+CachedFileRcPtr LocalFileFormat::readBinaryCache(BinaryCacheReader & reader) const
+{
+    LocalCachedFileRcPtr cachedFile = LocalCachedFileRcPtr(new LocalCachedFile());
+    cachedFile->m_filePath = reader.readString();
+
+    cachedFile->m_transform = std::make_shared<CTFReaderTransform>();
+    CTFReaderTransform & transform = *cachedFile->m_transform;
+
+    transform.setID(reader.readString().c_str());
+    transform.setName(reader.readString().c_str());
+    transform.setInverseOfId(reader.readString().c_str());
+    transform.setInputDescriptor(reader.readString());
+    transform.setOutputDescriptor(reader.readString());
+    ReadFormatMetadata(reader, transform.getInfoMetadata());
+    const int numDescriptions = reader.readInt();
+    for (int i = 0; i < numDescriptions; ++i)
+    {
+        transform.getDescriptions().push_back(reader.readString());
+    }
+    transform.setCTFVersion(ReadVersion(reader));
+    transform.setCLFVersion(ReadVersion(reader));
+
+    const int numOps = reader.readInt();
+    for (int i = 0; i < numOps; ++i)
+    {
+        const int type = reader.readInt();
+        FormatMetadataImpl metadata(METADATA_ROOT);
+        ReadFormatMetadata(reader, metadata);
+        const BitDepth inBitDepth = (BitDepth)reader.readInt();
+        const BitDepth outBitDepth = (BitDepth)reader.readInt();
+        const BitDepth fileOutBitDepth = (BitDepth)reader.readInt();
+        const TransformDirection dir = (TransformDirection)reader.readInt();
+        const Interpolation interpolation = (Interpolation)reader.readInt();
+        const LutInversionQuality invQuality = (LutInversionQuality)reader.readInt();
+
+        // The bit-depths are set before the array, as they would otherwise scale it.
+        if (type == OpData::Lut1DType)
+        {
+            auto lut = std::make_shared<Lut1DOpData>(2, dir);
+            lut->getFormatMetadata() = metadata;
+            lut->setInputBitDepth(inBitDepth);
+            lut->setOutputBitDepth(outBitDepth);
+            lut->setFileOutputBitDepth(fileOutBitDepth);
+            lut->setInterpolation(interpolation);
+            lut->setInversionQuality(invQuality);
+            const int halfFlags = reader.readInt();
+            lut->setInputHalfDomain((halfFlags & Lut1DOpData::LUT_INPUT_HALF_CODE) != 0);
+            lut->setOutputRawHalfs((halfFlags & Lut1DOpData::LUT_OUTPUT_HALF_CODE) != 0);
+            lut->setHueAdjust((LUT1DHueAdjust)reader.readInt());
+            ReadOpArray(reader, lut->getArray());
+            lut->validate();
+            transform.getOps().push_back(lut);
+        }
+        else if (type == OpData::Lut3DType)
+        {
+            auto lut = std::make_shared<Lut3DOpData>(2, dir);
+            lut->getFormatMetadata() = metadata;
+            lut->setInputBitDepth(inBitDepth);
+            lut->setOutputBitDepth(outBitDepth);
+            lut->setFileOutputBitDepth(fileOutBitDepth);
+            lut->setInterpolation(interpolation);
+            lut->setInversionQuality(invQuality);
+            ReadOpArray(reader, lut->getArray());
+            lut->validate();
+            transform.getOps().push_back(lut);
+        }
+        else
+        {
+            throw Exception("Corrupted binary cache.");
+        }
+    }
+
+    // Identical LUTs from different files share their values.
+    InternOpArrays(transform.getOps());
+
+    return cachedFile;
+}
+
 // Helper called by LocalFileFormat::buildFileOps
 void BuildOp(OpRcPtrVec & ops,
              const Config& config,
@@ -1181,10 +1429,15 @@ void LocalFileFormat::write(const OpRcPtrVec & ops,
                             std::ostream & ostream) const
 {
     bool isCLF = false;
+    bool binaryArrays = false;
     if (Platform::Strcasecmp(formatName.c_str(), FILEFORMAT_CLF) == 0)
     {
         isCLF = true;
     }
+    else if (Platform::Strcasecmp(formatName.c_str(), FILEFORMAT_CTF_BINARY) == 0)
+    {
+        binaryArrays = true;
+    }
     else if (Platform::Strcasecmp(formatName.c_str(), FILEFORMAT_CTF) != 0)
     {
         // Neither a clf nor a ctf.
@@ -1199,7 +1452,7 @@ void LocalFileFormat::write(const OpRcPtrVec & ops,
     ostream << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << std::endl;
     XmlFormatter fmt(ostream);
 
-    TransformWriter writer(fmt, transform, isCLF);
+    TransformWriter writer(fmt, transform, isCLF, binaryArrays);
     writer.write();
 }
 
@@ -4245,6 +4498,128 @@ OCIO_ADD_TEST(FileFormatCTF, attribute_float_parse_leading_spaces)
     OCIO_CHECK_EQUAL(ec->getExposure(), -1.5);
 }
 
+OCIO_ADD_TEST(FileFormatCTF, large_array_blocks)
+{
+    // The content is parsed by blocks of 1MB ending on a line boundary: the values
+    // must not be split, whatever the layout of the lines.
+    const unsigned length = 65536;
+    for (const char * separator : { "\n", " " })
+    {
+        std::ostringstream strebuf;
+        strebuf << "<?xml version='1.0' encoding='UTF-8'?>\n";
+        strebuf << "<ProcessList id='large' compCLFversion='2.0'>\n";
+        strebuf << "<LUT1D inBitDepth='32f' outBitDepth='32f'>\n";
+        strebuf << "<Array dim='" << length << " 3'>\n";
+        for (unsigned i = 0; i < length; ++i)
+        {
+            const float value = float(i) / float(length - 1);
+            strebuf << value << " " << -value << " " << value * 0.5f << separator;
+        }
+        strebuf << "\n</Array>\n</LUT1D>\n</ProcessList>\n";
+        const std::string content = strebuf.str();
+        OCIO_REQUIRE_ASSERT(content.size() > 1024 * 1024);
+
+        OCIO::LocalFileFormat tester;
+        OCIO::CachedFileRcPtr file;
+        OCIO_CHECK_NO_THROW(file = tester.readBuffer(content.data(), content.size(), "large.clf"));
+        OCIO::LocalCachedFileRcPtr cachedFile = OCIO_DYNAMIC_POINTER_CAST<OCIO::LocalCachedFile>(file);
+        OCIO_REQUIRE_ASSERT(cachedFile);
+
+        const auto & fileOps = cachedFile->m_transform->getOps();
+        OCIO_REQUIRE_EQUAL(fileOps.size(), 1);
+        auto lut = std::dynamic_pointer_cast<const OCIO::Lut1DOpData>(fileOps[0]);
+        OCIO_REQUIRE_ASSERT(lut);
+
+        const auto & values = lut->getArray().getValues();
+        OCIO_REQUIRE_EQUAL(values.size(), 3 * length);
+        for (unsigned i = 0; i < length; ++i)
+        {
+            std::ostringstream oss;
+            oss << float(i) / float(length - 1);
+            const float value = std::stof(oss.str());
+            OCIO_REQUIRE_EQUAL(values[3 * i], value);
+            OCIO_REQUIRE_EQUAL(values[3 * i + 1], -value);
+        }
+    }
+}
+
+OCIO_ADD_TEST(FileFormatCTF, array_encoding)
+{
+    // 0.5f, -2.0f, 1.0f as little-endian floats: 0000003F 000000C0 0000803F.
+    const std::string prefix{ "<?xml version='1.0' encoding='UTF-8'?>\n"
+                              "<ProcessList id='binary' version='1.3'>\n"
+                              "<LUT1D inBitDepth='32f' outBitDepth='32f'>\n" };
+    const std::string suffix{ "\n</Array>\n</LUT1D>\n</ProcessList>\n" };
+
+    OCIO::LocalFileFormat tester;
+    {
+        const std::string content = prefix
+            + "<Array dim='2 3' encoding='base64Float32'>\nAAAAPwAAAMAAAIA/\n"
+              "AAAAPwAAAMAA\r\n AIA/" + suffix;
+        OCIO::CachedFileRcPtr file;
+        OCIO_CHECK_NO_THROW(file = tester.readBuffer(content.data(), content.size(), "binary.ctf"));
+        auto cachedFile = OCIO_DYNAMIC_POINTER_CAST<OCIO::LocalCachedFile>(file);
+        OCIO_REQUIRE_ASSERT(cachedFile);
+        auto lut = std::dynamic_pointer_cast<const OCIO::Lut1DOpData>(
+            cachedFile->m_transform->getOps()[0]);
+        OCIO_REQUIRE_ASSERT(lut);
+        const auto & values = lut->getArray().getValues();
+        OCIO_REQUIRE_EQUAL(values.size(), 6);
+        OCIO_CHECK_EQUAL(values[0], 0.5f);
+        OCIO_CHECK_EQUAL(values[1], -2.0f);
+        OCIO_CHECK_EQUAL(values[5], 1.0f);
+    }
+    {
+        // 0.5, -2.0, 1.0 as little-endian halfs: 0038 00C0 003C.
+        const std::string content = prefix
+            + "<Array dim='1 3' encoding='base64Float16'>ADgAwAA8" + suffix;
+        OCIO::CachedFileRcPtr file;
+        OCIO_CHECK_NO_THROW(file = tester.readBuffer(content.data(), content.size(), "binary.ctf"));
+        auto cachedFile = OCIO_DYNAMIC_POINTER_CAST<OCIO::LocalCachedFile>(file);
+        OCIO_REQUIRE_ASSERT(cachedFile);
+        auto lut = std::dynamic_pointer_cast<const OCIO::Lut1DOpData>(
+            cachedFile->m_transform->getOps()[0]);
+        OCIO_REQUIRE_ASSERT(lut);
+        const auto & values = lut->getArray().getValues();
+        OCIO_REQUIRE_EQUAL(values.size(), 3);
+        OCIO_CHECK_EQUAL(values[0], 0.5f);
+        OCIO_CHECK_EQUAL(values[1], -2.0f);
+        OCIO_CHECK_EQUAL(values[2], 1.0f);
+    }
+
+    const std::string unknown = prefix + "<Array dim='1 3' encoding='base32'>AAAA" + suffix;
+    OCIO_CHECK_THROW_WHAT(tester.readBuffer(unknown.data(), unknown.size(), "binary.ctf"),
+                          OCIO::Exception, "Array encoding not recognized: 'base32'");
+
+    const std::string invalid
+        = prefix + "<Array dim='1 3' encoding='base64Float32'>AAAAPw*AAMAAAIA/" + suffix;
+    OCIO_CHECK_THROW_WHAT(tester.readBuffer(invalid.data(), invalid.size(), "binary.ctf"),
+                          OCIO::Exception, "Invalid base64 character '*'");
+
+    const std::string truncated
+        = prefix + "<Array dim='1 3' encoding='base64Float32'>AAAAPwAAAMAAAIA" + suffix;
+    OCIO_CHECK_THROW_WHAT(tester.readBuffer(truncated.data(), truncated.size(), "binary.ctf"),
+                          OCIO::Exception, "Truncated base64 array values");
+
+    const std::string tooMany
+        = prefix + "<Array dim='1 3' encoding='base64Float32'>AAAAPwAAAMAAAIA/AAAAPw==" + suffix;
+    OCIO_CHECK_THROW_WHAT(tester.readBuffer(tooMany.data(), tooMany.size(), "binary.ctf"),
+                          OCIO::Exception, "found too many values");
+
+    // The CLF arrays are only text.
+    const std::string clfPrefix{ "<?xml version='1.0' encoding='UTF-8'?>\n"
+                                 "<ProcessList id='binary' compCLFversion='2.0'>\n"
+                                 "<LUT1D inBitDepth='32f' outBitDepth='32f'>\n" };
+    const std::string clf
+        = clfPrefix + "<Array dim='1 3' encoding='base64Float32'>AAAAPwAAAMAAAIA/" + suffix;
+    OCIO_CHECK_THROW_WHAT(tester.readBuffer(clf.data(), clf.size(), "binary.clf"),
+                          OCIO::Exception,
+                          "encoding 'base64Float32' is not allowed in a CLF file");
+
+    const std::string clfText = clfPrefix + "<Array dim='1 3' encoding='text'>0.5 -2 1" + suffix;
+    OCIO_CHECK_NO_THROW(tester.readBuffer(clfText.data(), clfText.size(), "binary.clf"));
+}
+
 OCIO_ADD_TEST(FixedFunction, load_ff_aces_redmod)
 {
     OCIO::LocalCachedFileRcPtr cachedFile;
@@ -6545,6 +6920,112 @@ OCIO_ADD_TEST(CTFTransform, lut3d_array_ctf)
     OCIO_CHECK_EQUAL(expected, outputTransform.str());
 }
 
+OCIO_ADD_TEST(CTFTransform, lut3d_binary_ctf)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    config->setMajorVersion(2);
+
+    OCIO::LUT3DTransformRcPtr lut = OCIO::LUT3DTransform::Create();
+    const unsigned long gs = 5;
+    lut->setGridSize(gs);
+    for (unsigned long r = 0; r < gs; ++r)
+    {
+        for (unsigned long g = 0; g < gs; ++g)
+        {
+            for (unsigned long b = 0; b < gs; ++b)
+            {
+                lut->setValue(r, g, b, float(r) / 3.0f, -float(g) / 7.0f, float(b) * 1e-7f);
+            }
+        }
+    }
+
+    OCIO::ConstProcessorRcPtr processor = config->getProcessor(lut);
+
+    // CLF output always stays as text.
+    std::ostringstream outputCLF;
+    OCIO_CHECK_NO_THROW(processor->write(OCIO::FILEFORMAT_CLF, outputCLF));
+    OCIO_CHECK_EQUAL(outputCLF.str().find("encoding=\"base64"), std::string::npos);
+
+    std::ostringstream outputTransform;
+    OCIO_CHECK_NO_THROW(processor->write(OCIO::FILEFORMAT_CTF_BINARY, outputTransform));
+    const std::string result = outputTransform.str();
+    OCIO_CHECK_NE(result.find("<Array dim=\"5 5 5 3\" encoding=\"base64Float32\">"),
+                  std::string::npos);
+
+    // The float values are exactly read back.
+    OCIO::LocalFileFormat tester;
+    OCIO::CachedFileRcPtr file;
+    OCIO_CHECK_NO_THROW(file = tester.readBuffer(result.data(), result.size(), "binary.ctf"));
+    auto cachedFile = OCIO_DYNAMIC_POINTER_CAST<OCIO::LocalCachedFile>(file);
+    OCIO_REQUIRE_ASSERT(cachedFile);
+    const auto & fileOps = cachedFile->m_transform->getOps();
+    OCIO_REQUIRE_EQUAL(fileOps.size(), 1);
+    auto lutData = std::dynamic_pointer_cast<const OCIO::Lut3DOpData>(fileOps[0]);
+    OCIO_REQUIRE_ASSERT(lutData);
+    OCIO_REQUIRE_EQUAL(lutData->getArray().getLength(), gs);
+
+    const auto & values = lutData->getArray().getValues();
+    for (unsigned long r = 0; r < gs; ++r)
+    {
+        for (unsigned long g = 0; g < gs; ++g)
+        {
+            for (unsigned long b = 0; b < gs; ++b)
+            {
+                float rgb[3];
+                lut->getValue(r, g, b, rgb[0], rgb[1], rgb[2]);
+                const unsigned long idx = ((r * gs + g) * gs + b) * 3;
+                OCIO_REQUIRE_EQUAL(values[idx], rgb[0]);
+                OCIO_REQUIRE_EQUAL(values[idx + 1], rgb[1]);
+                OCIO_REQUIRE_EQUAL(values[idx + 2], rgb[2]);
+            }
+        }
+    }
+}
+
+OCIO_ADD_TEST(CTFTransform, lut1d_binary_ctf)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    config->setMajorVersion(2);
+
+    OCIO::LUT1DTransformRcPtr lut = OCIO::LUT1DTransform::Create();
+    lut->setLength(4);
+    lut->setValue(1, 0.25f, 0.5f, -0.125f);
+    lut->setValue(2, 0.75f, 1.5f, 65504.0f);
+
+    for (const bool rawHalfs : { false, true })
+    {
+        lut->setFileOutputBitDepth(OCIO::BIT_DEPTH_F16);
+        lut->setOutputRawHalfs(rawHalfs);
+
+        OCIO::ConstProcessorRcPtr processor = config->getProcessor(lut);
+        std::ostringstream outputTransform;
+        OCIO_CHECK_NO_THROW(processor->write(OCIO::FILEFORMAT_CTF_BINARY, outputTransform));
+        const std::string result = outputTransform.str();
+
+        // The raw halfs are encoded as floats to preserve their bits.
+        OCIO_CHECK_NE(result.find(rawHalfs ? "encoding=\"base64Float32\""
+                                           : "encoding=\"base64Float16\""),
+                      std::string::npos);
+
+        OCIO::LocalFileFormat tester;
+        OCIO::CachedFileRcPtr file;
+        OCIO_CHECK_NO_THROW(file = tester.readBuffer(result.data(), result.size(), "binary.ctf"));
+        auto cachedFile = OCIO_DYNAMIC_POINTER_CAST<OCIO::LocalCachedFile>(file);
+        OCIO_REQUIRE_ASSERT(cachedFile);
+        auto lutData = std::dynamic_pointer_cast<const OCIO::Lut1DOpData>(
+            cachedFile->m_transform->getOps()[0]);
+        OCIO_REQUIRE_ASSERT(lutData);
+        OCIO_CHECK_EQUAL(lutData->isOutputRawHalfs(), rawHalfs);
+
+        const auto & values = lutData->getArray().getValues();
+        OCIO_REQUIRE_EQUAL(values.size(), 12);
+        OCIO_CHECK_EQUAL(values[3], 0.25f);
+        OCIO_CHECK_EQUAL(values[4], 0.5f);
+        OCIO_CHECK_EQUAL(values[5], -0.125f);
+        OCIO_CHECK_EQUAL(values[8], 65504.0f);
+    }
+}
+
 OCIO_ADD_TEST(CTFTransform, lut3d_inverse_clf)
 {
     OCIO::ConfigRcPtr config = OCIO::Config::Create();
@@ -14,6 +14,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdio>
+#include <cstring>
 #include <sstream>
 
 
@@ -318,9 +319,11 @@ OCIO_NAMESPACE_ENTER
                 ReplaceTabsAndStripSpaces(InString);
                 StripEndNewLine(InString);
 
-                if (isdigit(*InString))
+                int value = 0;
+                if (isdigit(*InString)
+                    && ParseInt(InString, InString + strlen(InString), value) != InString)
                 {
-                    ptable[Count++] = (unsigned short)atoi(InString);
+                    ptable[Count++] = (unsigned short)value;
                     if (Count >= length)
                         break;
                 }
@@ -645,6 +648,12 @@ OCIO_NAMESPACE_ENTER
             };
             ~LocalCachedFile() {};
             
+            size_t getMemorySize() const override
+            {
+                const Array & array = lut1D->getArray();
+                return sizeof(LocalCachedFile) + array.getValues().size() * sizeof(float);
+            }
+
             Lut1DOpDataRcPtr lut1D;
         };
         
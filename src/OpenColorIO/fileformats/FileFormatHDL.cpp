@@ -29,6 +29,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "Baker.h"
 #include "MathUtils.h"
 #include "ops/Lut1D/Lut1DOp.h"
 #include "ops/Lut3D/Lut3DOp.h"
@@ -139,77 +140,81 @@ OCIO_NAMESPACE_ENTER
         {
             // State variables
             bool inlut = false;
+            bool expectBrace = false;
+            std::string lutword;
             std::string lutname;
+            std::vector<float> * values = nullptr;
 
-            std::string word;
-
-            while(istream >> word)
+            std::string line;
+            while(nextline(istream, line))
             {
-                if(!inlut)
+                // The words are not copied, and the values are parsed in place.
+                LineTokenizer tokens(line);
+                while(tokens.next())
                 {
-                    if(word == "{")
-                    {
-                        // Lone "{" is for a 3D
-                        inlut = true;
-                        lutname = "3d";
-                    }
-                    else
+                    if(expectBrace)
                     {
-                        // Named LUT, e.g "Pre {"
-                        inlut = true;
-                        lutname = pystring::lower(word);
-
                         // Ensure next word is "{"
-                        std::string nextword;
-                        istream >> nextword;
-                        if(nextword != "{")
+                        if(!tokens.isToken("{"))
                         {
                             std::ostringstream os;
                             os << "Malformed LUT - Unknown word '";
-                            os << word << "' after LUT name '";
-                            os << nextword << "'";
+                            os << lutword << "' after LUT name '";
+                            os << std::string(tokens.token(), tokens.tokenLength()) << "'";
                             throw Exception(os.str().c_str());
                         }
+                        expectBrace = false;
                     }
-                }
-                else if(word == "}")
-                {
-                    // end of LUT
-                    inlut = false;
-                    lutname = "";
-                }
-                else if(inlut)
-                {
-                    // StringToFloat was far slower, for 787456 values:
-                    // - StringToFloat took 3879 (avg nanoseconds per value)
-                    // - stdtod took 169 nanoseconds
-                    char* endptr = 0;
-                    float v = static_cast<float>(strtod(word.c_str(), &endptr));
-
-                    if(!*endptr)
+                    else if(!inlut)
                     {
-                        // Since each word should contain a single
-                        // float value, the pointer should be null
-                        lutValues[lutname].push_back(v);
+                        if(tokens.isToken("{"))
+                        {
+                            // Lone "{" is for a 3D
+                            inlut = true;
+                            lutname = "3d";
+                        }
+                        else
+                        {
+                            // Named LUT, e.g "Pre {"
+                            inlut = true;
+                            expectBrace = true;
+                            lutword.assign(tokens.token(), tokens.tokenLength());
+                            lutname = pystring::lower(lutword);
+                        }
+                        values = &lutValues[lutname];
+                    }
+                    else if(tokens.isToken("}"))
+                    {
+                        // end of LUT
+                        inlut = false;
+                        lutname = "";
+                        values = nullptr;
                     }
                     else
                     {
-                        // stdtod endptr still contained stuff,
-                        // meaning an invalid float value
-                        std::ostringstream os;
-                        os << "Invalid float value in " << lutname;
-                        os << " LUT, '" << word << "'";
-                        throw Exception(os.str().c_str());
+                        float v = 0.0f;
+                        if(tokens.getFloat(v))
+                        {
+                            values->push_back(v);
+                        }
+                        else
+                        {
+                            // The word is not a single float value.
+                            std::ostringstream os;
+                            os << "Invalid float value in " << lutname;
+                            os << " LUT, '" << std::string(tokens.token(), tokens.tokenLength()) << "'";
+                            throw Exception(os.str().c_str());
+                        }
                     }
                 }
-                else
-                {
-                    std::ostringstream os;
-                    os << "Unexpected word, possibly a value outside";
-                    os <<" a LUT {} block. Word was '" << word << "'";
-                    throw Exception(os.str().c_str());
+            }
 
-                }
+            if(expectBrace)
+            {
+                std::ostringstream os;
+                os << "Malformed LUT - Unknown word '";
+                os << lutword << "' after LUT name ''";
+                throw Exception(os.str().c_str());
             }
         }
 
@@ -231,6 +236,11 @@ OCIO_NAMESPACE_ENTER
                 lut3D = Lut3D::Create();
             };
             ~CachedFileHDL() {};
+            
+            size_t getMemorySize() const override
+            {
+                return sizeof(CachedFileHDL) + lut1D->getMemorySize() + lut3D->getMemorySize();
+            }
             std::string hdlversion;
             std::string hdlformat;
             std::string hdltype;
@@ -675,7 +685,7 @@ OCIO_NAMESPACE_ENTER
             }
             
             // Make prelut
-            std::vector<float> prelutData;
+            ConstBakedSamplesRcPtr prelutSamples;
             
             float fromInStart = 0; // for "From:" part of header
             float fromInEnd = 1;
@@ -724,35 +734,16 @@ OCIO_NAMESPACE_ENTER
 
                 // Generate the identity prelut values, then apply the transform.
                 // Prelut is linearly sampled from fromInStart to fromInEnd
-                prelutData.resize(shaperSize*3);
-                
-                for (int i = 0; i < shaperSize; ++i)
-                {
-                    const float x = (float)(double(i) / double(shaperSize - 1));
-                    float cur_value = lerpf(fromInStart, fromInEnd, x);
-
-                    prelutData[3*i+0] = cur_value;
-                    prelutData[3*i+1] = cur_value;
-                    prelutData[3*i+2] = cur_value;
-                }
-                
-                PackedImageDesc prelutImg(&prelutData[0], shaperSize, 1, 3);
-
-                ConstCPUProcessorRcPtr cpu = inputToShaperProc->getDefaultCPUProcessor();
-                cpu->apply(prelutImg);
+                prelutSamples = BakeLut1DSamples({ inputToShaperProc }, shaperSize,
+                                                 fromInStart, fromInEnd);
             }
             
             // TODO: Do same "auto prelut" input-space allocation as FileFormatCSP?
             
             // Make 3D LUT
-            std::vector<float> cubeData;
+            ConstBakedSamplesRcPtr cubeSamples;
             if(required_lut == HDL_3D || required_lut == HDL_3D1D)
             {
-                cubeData.resize(cubeSize*cubeSize*cubeSize*3);
-                
-                GenerateIdentityLut3D(&cubeData[0], cubeSize, 3, LUT3DORDER_FAST_RED);
-                PackedImageDesc cubeImg(&cubeData[0], cubeSize*cubeSize*cubeSize, 1, 3);
-                
                 ConstProcessorRcPtr cubeProc;
                 if(required_lut == HDL_3D1D)
                 {
@@ -778,21 +769,15 @@ OCIO_NAMESPACE_ENTER
                     cubeProc = inputToTargetProc;
                 }
 
-                ConstCPUProcessorRcPtr cpu = cubeProc->getDefaultCPUProcessor();
-                cpu->apply(cubeImg);
+                cubeSamples = BakeLut3DSamples({ cubeProc }, cubeSize, LUT3DORDER_FAST_RED);
             }
             
             
             // Make 1D LUT
-            std::vector<float> onedData;
+            ConstBakedSamplesRcPtr onedSamples;
             if(required_lut == HDL_1D)
             {
-                onedData.resize(onedSize * 3);
-                
-                GenerateIdentityLut1D(&onedData[0], onedSize, 3);
-                PackedImageDesc onedImg(&onedData[0], onedSize, 1, 3);
-                ConstCPUProcessorRcPtr cpu = inputToTargetProc->getDefaultCPUProcessor();
-                cpu->apply(onedImg);
+                onedSamples = BakeLut1DSamples({ inputToTargetProc }, onedSize);
             }
             
             
@@ -827,6 +812,7 @@ OCIO_NAMESPACE_ENTER
             if(required_lut == HDL_3D1D)
             {
                 ostream << "Pre {\n";
+                const std::vector<float> & prelutData = *prelutSamples;
                 for(int i=0; i < shaperSize; ++i)
                 {
                     // Grab green channel from RGB prelut
@@ -850,15 +836,22 @@ OCIO_NAMESPACE_ENTER
             // Write the cube data after the "{"
             if(required_lut == HDL_3D || required_lut == HDL_3D1D)
             {
+                const std::vector<float> & cubeData = *cubeSamples;
+                NumberWriter writer(ostream);
                 for(int i=0; i < cubeSize*cubeSize*cubeSize; ++i)
                 {
                     // TODO: Original baker code clamped values to
                     // 1.0, was this necessary/desirable?
 
-                    ostream << "\t" << cubeData[3*i+0];
-                    ostream << " "  << cubeData[3*i+1];
-                    ostream << " "  << cubeData[3*i+2] << "\n";
+                    writer.write('\t');
+                    writer.writeFixed(cubeData[3*i+0], 6);
+                    writer.write(' ');
+                    writer.writeFixed(cubeData[3*i+1], 6);
+                    writer.write(' ');
+                    writer.writeFixed(cubeData[3*i+2], 6);
+                    writer.write('\n');
                 }
+                writer.flush();
                 
                 // Write closing "}"
                 ostream << " }\n";
@@ -867,6 +860,7 @@ OCIO_NAMESPACE_ENTER
             // Write out channels for 1D LUT
             if(required_lut == HDL_1D)
             {
+                const std::vector<float> & onedData = *onedSamples;
                 ostream << "R {\n";
                 for(int i=0; i < onedSize; ++i)
                     ostream << "\t" << onedData[i*3+0] << "\n";
@@ -8,6 +8,7 @@
 #include "ops/Lut1D/Lut1DOp.h"
 #include "ops/Matrix/MatrixOps.h"
 #include "ops/Gamma/GammaOps.h"
+#include <cstring>
 #include <sstream>
 
 #include "iccProfileReader.h"
@@ -32,6 +33,11 @@ OCIO_NAMESPACE_ENTER
         LocalCachedFile() {};
         ~LocalCachedFile() {};
 
+        size_t getMemorySize() const override
+        {
+            return sizeof(LocalCachedFile) + (lut ? lut->getMemorySize() : 0);
+        }
+
         // Matrix part
         double mMatrix44[16];
 
@@ -67,6 +73,13 @@ OCIO_NAMESPACE_ENTER
             return true;
         }
 
+        // The header always has the 'acsp' signature.
+        int probe(const char * data, size_t size) const override
+        {
+            return size >= 40 && memcmp(data + 36, "acsp", 4) == 0 ? FORMAT_PROBE_LIKELY
+                                                                   : FORMAT_PROBE_NO;
+        }
+
     private:
         static void ThrowErrorMessage(const std::string & error,
             const std::string & fileName);
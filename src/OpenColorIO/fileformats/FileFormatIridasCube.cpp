@@ -8,6 +8,8 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "Baker.h"
+#include "fileformats/BinaryCache.h"
 #include "ops/Lut1D/Lut1DOp.h"
 #include "ops/Lut3D/Lut3DOp.h"
 #include "ParseUtils.h"
@@ -76,6 +78,11 @@ OCIO_NAMESPACE_ENTER
                 lut3D = Lut3D::Create();
             };
             ~LocalCachedFile() {};
+            
+            size_t getMemorySize() const override
+            {
+                return sizeof(LocalCachedFile) + lut1D->getMemorySize() + lut3D->getMemorySize();
+            }
 
             bool has1D;
             bool has3D;
@@ -99,6 +106,22 @@ OCIO_NAMESPACE_ENTER
             CachedFileRcPtr read(
                 std::istream & istream,
                 const std::string & fileName) const override;
+
+            int probe(const char * data, size_t size) const override
+            {
+                if(!ProbeIsText(data, size))
+                {
+                    return FORMAT_PROBE_NO;
+                }
+                return ProbeContains(data, size, "LUT_3D_SIZE")
+                       || ProbeContains(data, size, "LUT_1D_SIZE") ? FORMAT_PROBE_LIKELY
+                                                                   : FORMAT_PROBE_MAYBE;
+            }
+
+            CachedFileRcPtr readBuffer(
+                const char * data,
+                size_t size,
+                const std::string & fileName) const override;
             
             void bake(const Baker & baker,
                       const std::string & formatName,
@@ -110,6 +133,11 @@ OCIO_NAMESPACE_ENTER
                               CachedFileRcPtr untypedCachedFile,
                               const FileTransform& fileTransform,
                               TransformDirection dir) const override;
+
+            bool writeBinaryCache(const CachedFileRcPtr & untypedCachedFile,
+                                  BinaryCacheWriter & writer) const override;
+
+            CachedFileRcPtr readBinaryCache(BinaryCacheReader & reader) const override;
         private:
             static void ThrowErrorMessage(const std::string & error,
                 const std::string & fileName,
@@ -156,6 +184,18 @@ OCIO_NAMESPACE_ENTER
                 throw Exception ("File stream empty when trying to read Iridas .cube LUT");
             }
 
+            // Parse the whole content from memory.
+            const std::string content((std::istreambuf_iterator<char>(istream)),
+                                      std::istreambuf_iterator<char>());
+            return readBuffer(content.data(), content.size(), fileName);
+        }
+
+        CachedFileRcPtr
+        LocalFileFormat::readBuffer(
+            const char * data,
+            size_t size,
+            const std::string & fileName) const
+        {
             // Parse the file
             std::vector<float> raw;
 
@@ -169,60 +209,59 @@ OCIO_NAMESPACE_ENTER
             float domain_max[] = { 1.0f, 1.0f, 1.0f };
 
             {
-                std::string line;
-                StringVec parts;
-                std::vector<float> tmpfloats;
+                const char * pos = data;
+                const char * end = data + size;
+                const char * line = nullptr;
+                size_t lineLength = 0;
                 int lineNumber = 0;
 
-                while(nextline(istream, line))
+                while(nextline(pos, end, line, lineLength))
                 {
                     ++lineNumber;
                     // All lines starting with '#' are comments
-                    if(pystring::startswith(line,"#")) continue;
+                    if(line[0] == '#') continue;
 
-                    // Strip, lowercase, and split the line
-                    pystring::split(pystring::lower(pystring::strip(line)), parts);
-                    if(parts.empty()) continue;
+                    // Split the line without any allocation
+                    LineTokenizer tokens(line, lineLength);
+                    if(!tokens.next()) continue;
 
-                    if(pystring::lower(parts[0]) == "title")
+                    if(tokens.isToken("title"))
                     {
                         // Optional, and currently unhandled
                     }
-                    else if(pystring::lower(parts[0]) == "lut_1d_size")
+                    else if(tokens.isToken("lut_1d_size"))
                     {
-                        if(parts.size() != 2
-                            || !StringToInt( &size1d, parts[1].c_str()))
+                        if(!tokens.nextInt(size1d) || !tokens.atEnd())
                         {
                             ThrowErrorMessage(
                                 "Malformed LUT_1D_SIZE tag.",
                                 fileName,
                                 lineNumber,
-                                line);
+                                std::string(line, lineLength));
                         }
 
                         raw.reserve(3*size1d);
                         in1d = true;
                     }
-                    else if(pystring::lower(parts[0]) == "lut_2d_size")
+                    else if(tokens.isToken("lut_2d_size"))
                     {
                         ThrowErrorMessage(
                             "Unsupported tag: 'LUT_2D_SIZE'.",
                             fileName,
                             lineNumber,
-                            line);
+                            std::string(line, lineLength));
                     }
-                    else if(pystring::lower(parts[0]) == "lut_3d_size")
+                    else if(tokens.isToken("lut_3d_size"))
                     {
                         int size = 0;
 
-                        if(parts.size() != 2
-                            || !StringToInt( &size, parts[1].c_str()))
+                        if(!tokens.nextInt(size) || !tokens.atEnd())
                         {
                             ThrowErrorMessage(
                                 "Malformed LUT_3D_SIZE tag.",
                                 fileName,
                                 lineNumber,
-                                line);
+                                std::string(line, lineLength));
                         }
                         size3d[0] = size;
                         size3d[1] = size;
@@ -231,51 +270,51 @@ OCIO_NAMESPACE_ENTER
                         raw.reserve(3*size3d[0]*size3d[1]*size3d[2]);
                         in3d = true;
                     }
-                    else if(pystring::lower(parts[0]) == "domain_min")
+                    else if(tokens.isToken("domain_min"))
                     {
-                        if(parts.size() != 4 ||
-                            !StringToFloat( &domain_min[0], parts[1].c_str()) ||
-                            !StringToFloat( &domain_min[1], parts[2].c_str()) ||
-                            !StringToFloat( &domain_min[2], parts[3].c_str()))
+                        if(!tokens.nextFloat(domain_min[0]) ||
+                            !tokens.nextFloat(domain_min[1]) ||
+                            !tokens.nextFloat(domain_min[2]) ||
+                            !tokens.atEnd())
                         {
                             ThrowErrorMessage(
                                 "Malformed DOMAIN_MIN tag.",
                                 fileName,
                                 lineNumber,
-                                line);
+                                std::string(line, lineLength));
                         }
                     }
-                    else if(pystring::lower(parts[0]) == "domain_max")
+                    else if(tokens.isToken("domain_max"))
                     {
-                        if(parts.size() != 4 ||
-                            !StringToFloat( &domain_max[0], parts[1].c_str()) ||
-                            !StringToFloat( &domain_max[1], parts[2].c_str()) ||
-                            !StringToFloat( &domain_max[2], parts[3].c_str()))
+                        if(!tokens.nextFloat(domain_max[0]) ||
+                            !tokens.nextFloat(domain_max[1]) ||
+                            !tokens.nextFloat(domain_max[2]) ||
+                            !tokens.atEnd())
                         {
                             ThrowErrorMessage(
                                 "Malformed DOMAIN_MAX tag.",
                                 fileName,
                                 lineNumber,
-                                line);
+                                std::string(line, lineLength));
                         }
                     }
                     else
                     {
                         // It must be a float triple!
-
-                        if(!StringVecToFloatVec(tmpfloats, parts) || tmpfloats.size() != 3)
+                        float rgb[3];
+                        if(!tokens.getFloat(rgb[0]) ||
+                            !tokens.nextFloat(rgb[1]) ||
+                            !tokens.nextFloat(rgb[2]) ||
+                            !tokens.atEnd())
                         {
                             ThrowErrorMessage(
                                 "Malformed color triples specified.",
                                 fileName,
                                 lineNumber,
-                                line);
+                                std::string(line, lineLength));
                         }
 
-                        for(int i=0; i<3; ++i)
-                        {
-                            raw.push_back(tmpfloats[i]);
-                        }
+                        raw.insert(raw.end(), rgb, rgb + 3);
                     }
                 }
             }
@@ -384,11 +423,6 @@ OCIO_NAMESPACE_ENTER
             if(cubeSize==-1) cubeSize = DEFAULT_CUBE_SIZE;
             cubeSize = std::max(2, cubeSize); // smallest cube is 2x2x2
 
-            std::vector<float> cubeData;
-            cubeData.resize(cubeSize*cubeSize*cubeSize*3);
-            GenerateIdentityLut3D(&cubeData[0], cubeSize, 3, LUT3DORDER_FAST_RED);
-            PackedImageDesc cubeImg(&cubeData[0], cubeSize*cubeSize*cubeSize, 1, 3);
-
             // Apply our conversion from the input space to the output space.
             ConstProcessorRcPtr inputToTarget;
             std::string looks = baker.getLooks();
@@ -404,8 +438,9 @@ OCIO_NAMESPACE_ENTER
             {
                 inputToTarget = config->getProcessor(baker.getInputSpace(), baker.getTargetSpace());
             }
-            ConstCPUProcessorRcPtr cpu = inputToTarget->getDefaultCPUProcessor();
-            cpu->apply(cubeImg);
+            ConstBakedSamplesRcPtr samples
+                = BakeLut3DSamples({ inputToTarget }, cubeSize, LUT3DORDER_FAST_RED);
+            const std::vector<float> & cubeData = *samples;
 
             if(baker.getMetadata() != NULL)
             {
@@ -430,12 +465,17 @@ OCIO_NAMESPACE_ENTER
             // Set to a fixed 6 decimal precision
             ostream.setf(std::ios::fixed, std::ios::floatfield);
             ostream.precision(6);
+            NumberWriter writer(ostream);
             for(int i=0; i<cubeSize*cubeSize*cubeSize; ++i)
             {
-                ostream << cubeData[3*i+0] << " "
-                        << cubeData[3*i+1] << " "
-                        << cubeData[3*i+2] << "\n";
+                writer.writeFixed(cubeData[3*i+0], 6);
+                writer.write(' ');
+                writer.writeFixed(cubeData[3*i+1], 6);
+                writer.write(' ');
+                writer.writeFixed(cubeData[3*i+2], 6);
+                writer.write('\n');
             }
+            writer.flush();
         }
 
         void
@@ -498,6 +538,30 @@ OCIO_NAMESPACE_ENTER
                 }
             }
         }
+
+        bool LocalFileFormat::writeBinaryCache(const CachedFileRcPtr & untypedCachedFile,
+                                               BinaryCacheWriter & writer) const
+        {
+            LocalCachedFileRcPtr cachedFile = DynamicPtrCast<LocalCachedFile>(untypedCachedFile);
+            if(!cachedFile) return false;
+
+            writer.writeBool(cachedFile->has1D);
+            writer.writeBool(cachedFile->has3D);
+            WriteLut1D(writer, *cachedFile->lut1D);
+            WriteLut3D(writer, *cachedFile->lut3D);
+            return true;
+        }
+
+        CachedFileRcPtr LocalFileFormat::readBinaryCache(BinaryCacheReader & reader) const
+        {
+            LocalCachedFileRcPtr cachedFile = LocalCachedFileRcPtr(new LocalCachedFile());
+
+            cachedFile->has1D = reader.readBool();
+            cachedFile->has3D = reader.readBool();
+            ReadLut1D(reader, *cachedFile->lut1D);
+            ReadLut3D(reader, *cachedFile->lut3D);
+            return cachedFile;
+        }
     }
 
     FileFormat * CreateFileFormatIridasCube()
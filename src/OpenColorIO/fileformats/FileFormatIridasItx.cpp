@@ -8,6 +8,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "Baker.h"
 #include "ops/Lut1D/Lut1DOp.h"
 #include "ops/Lut3D/Lut3DOp.h"
 #include "ParseUtils.h"
@@ -53,6 +54,11 @@ OCIO_NAMESPACE_ENTER
             };
             ~LocalCachedFile() {};
             
+            size_t getMemorySize() const override
+            {
+                return sizeof(LocalCachedFile) + lut3D->getMemorySize();
+            }
+            
             // TODO: Switch to the OpData class.
             Lut3DRcPtr lut3D;
         };
@@ -72,6 +78,16 @@ OCIO_NAMESPACE_ENTER
             CachedFileRcPtr read(
                 std::istream & istream,
                 const std::string & fileName) const override;
+
+            int probe(const char * data, size_t size) const override
+            {
+                if(!ProbeIsText(data, size))
+                {
+                    return FORMAT_PROBE_NO;
+                }
+                return ProbeContains(data, size, "LUT_3D_SIZE") ? FORMAT_PROBE_LIKELY
+                                                                : FORMAT_PROBE_MAYBE;
+            }
             
             void bake(const Baker & baker,
                       const std::string & formatName,
@@ -248,11 +264,6 @@ OCIO_NAMESPACE_ENTER
             if(cubeSize==-1) cubeSize = DEFAULT_CUBE_SIZE;
             cubeSize = std::max(2, cubeSize); // smallest cube is 2x2x2
             
-            std::vector<float> cubeData;
-            cubeData.resize(cubeSize*cubeSize*cubeSize*3);
-            GenerateIdentityLut3D(&cubeData[0], cubeSize, 3, LUT3DORDER_FAST_RED);
-            PackedImageDesc cubeImg(&cubeData[0], cubeSize*cubeSize*cubeSize, 1, 3);
-            
             // Apply our conversion from the input space to the output space.
             ConstProcessorRcPtr inputToTarget;
             std::string looks = baker.getLooks();
@@ -270,8 +281,9 @@ OCIO_NAMESPACE_ENTER
                 inputToTarget = config->getProcessor(baker.getInputSpace(),
                     baker.getTargetSpace());
             }
-            ConstCPUProcessorRcPtr cpu = inputToTarget->getDefaultCPUProcessor();
-            cpu->apply(cubeImg);
+            ConstBakedSamplesRcPtr samples
+                = BakeLut3DSamples({ inputToTarget }, cubeSize, LUT3DORDER_FAST_RED);
+            const std::vector<float> & cubeData = *samples;
             
             // Write out the file.
             // For for maximum compatibility with other apps, we will
@@ -286,13 +298,17 @@ OCIO_NAMESPACE_ENTER
             // Set to a fixed 6 decimal precision
             ostream.setf(std::ios::fixed, std::ios::floatfield);
             ostream.precision(6);
+            NumberWriter writer(ostream);
             for(int i=0; i<cubeSize*cubeSize*cubeSize; ++i)
             {
-                float r = cubeData[3*i+0];
-                float g = cubeData[3*i+1];
-                float b = cubeData[3*i+2];
-                ostream << r << " " << g << " " << b << "\n";
+                writer.writeFixed(cubeData[3*i+0], 6);
+                writer.write(' ');
+                writer.writeFixed(cubeData[3*i+1], 6);
+                writer.write(' ');
+                writer.writeFixed(cubeData[3*i+2], 6);
+                writer.write('\n');
             }
+            writer.flush();
             ostream << "\n";
         }
         
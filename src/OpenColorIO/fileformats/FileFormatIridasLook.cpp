@@ -481,6 +481,11 @@ OCIO_NAMESPACE_ENTER
                 lut3D = Lut3D::Create();
             };
             ~LocalCachedFile() {};
+            
+            size_t getMemorySize() const override
+            {
+                return sizeof(LocalCachedFile) + lut3D->getMemorySize();
+            }
 
             // TODO: Switch to the OpData class.
             Lut3DRcPtr lut3D;
@@ -500,6 +505,11 @@ OCIO_NAMESPACE_ENTER
                 std::istream & istream,
                 const std::string & fileName) const override;
 
+            int probe(const char * data, size_t size) const override
+            {
+                return ProbeXMLElement(data, size, "look");
+            }
+
             void buildFileOps(OpRcPtrVec & ops,
                               const Config& config,
                               const ConstContextRcPtr & context,
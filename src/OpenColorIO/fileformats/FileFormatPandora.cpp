@@ -26,6 +26,11 @@ OCIO_NAMESPACE_ENTER
             };
             ~LocalCachedFile() {};
             
+            size_t getMemorySize() const override
+            {
+                return sizeof(LocalCachedFile) + lut3D->getMemorySize();
+            }
+            
             // TODO: Switch to the OpData class.
             Lut3DRcPtr lut3D;
         };
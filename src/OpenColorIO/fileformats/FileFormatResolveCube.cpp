@@ -8,6 +8,8 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "Baker.h"
+#include "fileformats/BinaryCache.h"
 #include "ops/Lut1D/Lut1DOp.h"
 #include "ops/Lut3D/Lut3DOp.h"
 #include "ParseUtils.h"
@@ -184,6 +186,11 @@ OCIO_NAMESPACE_ENTER
             };
             ~LocalCachedFile() {};
             
+            size_t getMemorySize() const override
+            {
+                return sizeof(LocalCachedFile) + lut1D->getMemorySize() + lut3D->getMemorySize();
+            }
+            
             bool has1D;
             bool has3D;
             // TODO: Switch to the OpData classes.
@@ -206,6 +213,22 @@ OCIO_NAMESPACE_ENTER
             CachedFileRcPtr read(
                 std::istream & istream,
                 const std::string & fileName) const override;
+
+            int probe(const char * data, size_t size) const override
+            {
+                if(!ProbeIsText(data, size))
+                {
+                    return FORMAT_PROBE_NO;
+                }
+                return ProbeContains(data, size, "LUT_3D_SIZE")
+                       || ProbeContains(data, size, "LUT_1D_SIZE") ? FORMAT_PROBE_LIKELY
+                                                                   : FORMAT_PROBE_MAYBE;
+            }
+
+            CachedFileRcPtr readBuffer(
+                const char * data,
+                size_t size,
+                const std::string & fileName) const override;
             
             void bake(const Baker & baker,
                       const std::string & formatName,
@@ -217,6 +240,11 @@ OCIO_NAMESPACE_ENTER
                               CachedFileRcPtr untypedCachedFile,
                               const FileTransform& fileTransform,
                               TransformDirection dir) const override;
+
+            bool writeBinaryCache(const CachedFileRcPtr & untypedCachedFile,
+                                  BinaryCacheWriter & writer) const override;
+
+            CachedFileRcPtr readBinaryCache(BinaryCacheReader & reader) const override;
         private:
             static void ThrowErrorMessage(const std::string & error,
                 const std::string & fileName,
@@ -262,7 +290,18 @@ OCIO_NAMESPACE_ENTER
             {
                 throw Exception ("File stream empty when trying to read Resolve .cube lut");
             }
-            
+
+            // Parse the whole content from memory.
+            const std::string content((std::istreambuf_iterator<char>(istream)),
+                                      std::istreambuf_iterator<char>());
+            return readBuffer(content.data(), content.size(), fileName);
+        }
+
+        CachedFileRcPtr LocalFileFormat::readBuffer(
+            const char * data,
+            size_t size,
+            const std::string & fileName) const
+        {
             // Parse the file
             std::vector<float> raw1d;
             std::vector<float> raw3d;
@@ -280,19 +319,20 @@ OCIO_NAMESPACE_ENTER
             float range3d_max = 1.0f;
             
             {
-                std::string line;
-                StringVec parts;
-                std::vector<float> tmpfloats;
+                const char * pos = data;
+                const char * end = data + size;
+                const char * line = nullptr;
+                size_t lineLength = 0;
                 int lineNumber = 0;
                 bool headerComplete = false;
                 int tripletNumber = 0;
                 
-                while(nextline(istream, line))
+                while(nextline(pos, end, line, lineLength))
                 {
                     ++lineNumber;
                     
                     // All lines starting with '#' are comments
-                    if(pystring::startswith(line,"#"))
+                    if(line[0] == '#')
                     {
                         if(headerComplete)
                         {
@@ -300,7 +340,7 @@ OCIO_NAMESPACE_ENTER
                                 "Comments not allowed after header.",
                                 fileName,
                                 lineNumber,
-                                line);
+                                std::string(line, lineLength));
                         }
                         else
                         {
@@ -308,80 +348,78 @@ OCIO_NAMESPACE_ENTER
                         }
                     }
                     
-                    // Strip, lowercase, and split the line
-                    pystring::split(pystring::lower(pystring::strip(line)), parts);
-                    if(parts.empty()) continue;
+                    // Split the line without any allocation
+                    LineTokenizer tokens(line, lineLength);
+                    if(!tokens.next()) continue;
                     
-                    if(pystring::lower(parts[0]) == "title")
+                    if(tokens.isToken("title"))
                     {
                         ThrowErrorMessage(
                             "Unsupported tag: 'TITLE'.",
                             fileName,
                             lineNumber,
-                            line);
+                            std::string(line, lineLength));
                     }
-                    else if(pystring::lower(parts[0]) == "lut_1d_size")
+                    else if(tokens.isToken("lut_1d_size"))
                     {
-                        if(parts.size() != 2
-                            || !StringToInt( &size1d, parts[1].c_str()))
+                        if(!tokens.nextInt(size1d) || !tokens.atEnd())
                         {
                             ThrowErrorMessage(
                                 "Malformed LUT_1D_SIZE tag.",
                                 fileName,
                                 lineNumber,
-                                line);
+                                std::string(line, lineLength));
                         }
                         
                         raw1d.reserve(3*size1d);
                         has1d = true;
                     }
-                    else if(pystring::lower(parts[0]) == "lut_2d_size")
+                    else if(tokens.isToken("lut_2d_size"))
                     {
                         ThrowErrorMessage(
                             "Unsupported tag: 'LUT_2D_SIZE'.",
                             fileName,
                             lineNumber,
-                            line);
+                            std::string(line, lineLength));
                     }
-                    else if(pystring::lower(parts[0]) == "lut_3d_size")
+                    else if(tokens.isToken("lut_3d_size"))
                     {
-                        if(parts.size() != 2
-                            || !StringToInt( &size3d, parts[1].c_str()))
+                        if(!tokens.nextInt(size3d) || !tokens.atEnd())
                         {
                             ThrowErrorMessage(
                                 "Malformed LUT_3D_SIZE tag.",
                                 fileName,
                                 lineNumber,
-                                line);
+                                std::string(line, lineLength));
                         }
                         
                         raw3d.reserve(3*size3d*size3d*size3d);
                         has3d = true;
                     }
-                    else if(pystring::lower(parts[0]) == "lut_1d_input_range")
+                    else if(tokens.isToken("lut_1d_input_range"))
                     {
-                        if(parts.size() != 3 || 
-                            !StringToFloat( &range1d_min, parts[1].c_str()) ||
-                            !StringToFloat( &range1d_max, parts[2].c_str()))
+                        if(!tokens.nextFloat(range1d_min) ||
+                            !tokens.nextFloat(range1d_max) ||
+                            !tokens.atEnd())
                         {
                             ThrowErrorMessage(
                                 "Malformed LUT_1D_INPUT_RANGE tag.",
                                 fileName,
                                 lineNumber,
-                                line);
+                                std::string(line, lineLength));
                         }
                     }
-                    else if(pystring::lower(parts[0]) == "lut_3d_input_range")
+                    else if(tokens.isToken("lut_3d_input_range"))
                     {
-                        if(parts.size() != 3 || 
-                            !StringToFloat( &range3d_min, parts[1].c_str()) ||
-                            !StringToFloat( &range3d_max, parts[2].c_str()))
+                        if(!tokens.nextFloat(range3d_min) ||
+                            !tokens.nextFloat(range3d_max) ||
+                            !tokens.atEnd())
                         {
                             ThrowErrorMessage(
                                 "Malformed LUT_3D_INPUT_RANGE tag.",
                                 fileName,
                                 lineNumber,
-                                line);
+                                std::string(line, lineLength));
                         }
                     }
                     else
@@ -389,24 +427,28 @@ OCIO_NAMESPACE_ENTER
                         headerComplete = true;
                         
                         // It must be a float triple!
-                        if(!StringVecToFloatVec(tmpfloats, parts) || tmpfloats.size() != 3)
+                        float rgb[3];
+                        if(!tokens.getFloat(rgb[0]) ||
+                            !tokens.nextFloat(rgb[1]) ||
+                            !tokens.nextFloat(rgb[2]) ||
+                            !tokens.atEnd())
                         {
                             ThrowErrorMessage(
                                 "Malformed color triples specified.",
                                 fileName,
                                 lineNumber,
-                                line);
+                                std::string(line, lineLength));
                         }
                         
                         for(int i=0; i<3; ++i)
                         {
                             if(has1d && tripletNumber < size1d)
                             {
-                                raw1d.push_back(tmpfloats[i]);
+                                raw1d.push_back(rgb[i]);
                             }
                             else
                             {
-                                raw3d.push_back(tmpfloats[i]);
+                                raw3d.push_back(rgb[i]);
                             }
                         }
                         
@@ -612,7 +654,7 @@ OCIO_NAMESPACE_ENTER
             // Generate Shaper
             //
             
-            std::vector<float> shaperData;
+            ConstBakedSamplesRcPtr shaperSamples;
             
             float fromInStart = 0;
             float fromInEnd = 1;
@@ -661,34 +703,17 @@ OCIO_NAMESPACE_ENTER
 
                 // Generate the identity shaper values, then apply the transform.
                 // Shaper is linearly sampled from fromInStart to fromInEnd
-                shaperData.resize(shaperSize*3);
-                
-                for (int i = 0; i < shaperSize; ++i)
-                {
-                    const float x = (float)(double(i) / double(shaperSize - 1));
-                    float cur_value = lerpf(fromInStart, fromInEnd, x);
-
-                    shaperData[3*i+0] = cur_value;
-                    shaperData[3*i+1] = cur_value;
-                    shaperData[3*i+2] = cur_value;
-                }
-                
-                PackedImageDesc shaperImg(&shaperData[0], shaperSize, 1, 3);
-                ConstCPUProcessorRcPtr cpu = inputToShaperProc->getDefaultCPUProcessor();
-                cpu->apply(shaperImg);
+                shaperSamples = BakeLut1DSamples({ inputToShaperProc }, shaperSize,
+                                                 fromInStart, fromInEnd);
             }
             
             //
             // Generate 3DLUT
             //
             
-            std::vector<float> cubeData;
+            ConstBakedSamplesRcPtr cubeSamples;
             if(required_lut == CUBE_3D || required_lut == CUBE_1D_3D)
             {
-                cubeData.resize(cubeSize*cubeSize*cubeSize*3);
-                GenerateIdentityLut3D(&cubeData[0], cubeSize, 3, LUT3DORDER_FAST_RED);
-                PackedImageDesc cubeImg(&cubeData[0], cubeSize*cubeSize*cubeSize, 1, 3);
-                
                 ConstProcessorRcPtr cubeProc;
                 if(required_lut == CUBE_1D_3D)
                 {
@@ -714,23 +739,17 @@ OCIO_NAMESPACE_ENTER
                     cubeProc = inputToTargetProc;
                 }
 
-                ConstCPUProcessorRcPtr cpu = cubeProc->getDefaultCPUProcessor();
-                cpu->apply(cubeImg);
+                cubeSamples = BakeLut3DSamples({ cubeProc }, cubeSize, LUT3DORDER_FAST_RED);
             }
             
             //
             // Generate 1DLUT
             //
             
-            std::vector<float> onedData;
+            ConstBakedSamplesRcPtr onedSamples;
             if(required_lut == CUBE_1D)
             {
-                onedData.resize(onedSize * 3);
-                GenerateIdentityLut1D(&onedData[0], onedSize, 3);
-                PackedImageDesc onedImg(&onedData[0], onedSize, 1, 3);
-                
-                ConstCPUProcessorRcPtr cpu = inputToTargetProc->getDefaultCPUProcessor();
-                cpu->apply(onedImg);
+                onedSamples = BakeLut1DSamples({ inputToTargetProc }, onedSize);
             }
             
             //
@@ -778,36 +797,52 @@ OCIO_NAMESPACE_ENTER
                 //ostream << "LUT_3D_INPUT_RANGE 0.0 1.0\n";
             }
             
+            NumberWriter writer(ostream);
+            
             // Write 1D data
             if(required_lut == CUBE_1D)
             {
+                const std::vector<float> & onedData = *onedSamples;
                 for(int i=0; i<onedSize; ++i)
                 {
-                    ostream << onedData[3*i+0] << " "
-                            << onedData[3*i+1] << " "
-                            << onedData[3*i+2] << "\n";
+                    writer.writeFixed(onedData[3*i+0], 6);
+                    writer.write(' ');
+                    writer.writeFixed(onedData[3*i+1], 6);
+                    writer.write(' ');
+                    writer.writeFixed(onedData[3*i+2], 6);
+                    writer.write('\n');
                 }
             }
             else if(required_lut == CUBE_1D_3D)
             {
+                const std::vector<float> & shaperData = *shaperSamples;
                 for(int i=0; i<shaperSize; ++i)
                 {
-                    ostream << shaperData[3*i+0] << " "
-                            << shaperData[3*i+1] << " "
-                            << shaperData[3*i+2] << "\n";
+                    writer.writeFixed(shaperData[3*i+0], 6);
+                    writer.write(' ');
+                    writer.writeFixed(shaperData[3*i+1], 6);
+                    writer.write(' ');
+                    writer.writeFixed(shaperData[3*i+2], 6);
+                    writer.write('\n');
                 }
             }
             
             // Write 3D data
             if(required_lut == CUBE_3D || required_lut == CUBE_1D_3D)
             {
+                const std::vector<float> & cubeData = *cubeSamples;
                 for(int i=0; i<cubeSize*cubeSize*cubeSize; ++i)
                 {
-                    ostream << cubeData[3*i+0] << " "
-                            << cubeData[3*i+1] << " "
-                            << cubeData[3*i+2] << "\n";
+                    writer.writeFixed(cubeData[3*i+0], 6);
+                    writer.write(' ');
+                    writer.writeFixed(cubeData[3*i+1], 6);
+                    writer.write(' ');
+                    writer.writeFixed(cubeData[3*i+2], 6);
+                    writer.write('\n');
                 }
             }
+            
+            writer.flush();
         }
         
         void
@@ -870,6 +905,30 @@ OCIO_NAMESPACE_ENTER
                 }
             }
         }
+
+        bool LocalFileFormat::writeBinaryCache(const CachedFileRcPtr & untypedCachedFile,
+                                               BinaryCacheWriter & writer) const
+        {
+            LocalCachedFileRcPtr cachedFile = DynamicPtrCast<LocalCachedFile>(untypedCachedFile);
+            if(!cachedFile) return false;
+
+            writer.writeBool(cachedFile->has1D);
+            writer.writeBool(cachedFile->has3D);
+            WriteLut1D(writer, *cachedFile->lut1D);
+            WriteLut3D(writer, *cachedFile->lut3D);
+            return true;
+        }
+
+        CachedFileRcPtr LocalFileFormat::readBinaryCache(BinaryCacheReader & reader) const
+        {
+            LocalCachedFileRcPtr cachedFile = LocalCachedFileRcPtr(new LocalCachedFile());
+
+            cachedFile->has1D = reader.readBool();
+            cachedFile->has3D = reader.readBool();
+            ReadLut1D(reader, *cachedFile->lut1D);
+            ReadLut3D(reader, *cachedFile->lut3D);
+            return cachedFile;
+        }
     }
     
     FileFormat * CreateFileFormatResolveCube()
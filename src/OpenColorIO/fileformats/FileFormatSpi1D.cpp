@@ -3,12 +3,15 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "fileformats/BinaryCache.h"
 #include "transforms/FileTransform.h"
 #include "ops/Lut1D/Lut1DOp.h"
+#include "ParseUtils.h"
 #include "Platform.h"
 #include "pystring/pystring.h"
 
 #include <cstdio>
+#include <cstring>
 #include <sstream>
 
 /*
@@ -40,6 +43,11 @@ OCIO_NAMESPACE_ENTER
             };
             ~LocalCachedFile() {};
             
+            size_t getMemorySize() const override
+            {
+                return sizeof(LocalCachedFile) + lut->getMemorySize();
+            }
+            
             // TODO: Switch to the OpData class.
             Lut1DRcPtr lut;
         };
@@ -58,6 +66,16 @@ OCIO_NAMESPACE_ENTER
             CachedFileRcPtr read(
                 std::istream & istream,
                 const std::string & fileName) const override;
+
+            int probe(const char * data, size_t size) const override
+            {
+                if(!ProbeIsText(data, size))
+                {
+                    return FORMAT_PROBE_NO;
+                }
+                return ProbeStartsWith(data, size, "version") ? FORMAT_PROBE_LIKELY
+                                                              : FORMAT_PROBE_MAYBE;
+            }
             
             void buildFileOps(OpRcPtrVec & ops,
                               const Config& config,
@@ -65,6 +83,11 @@ OCIO_NAMESPACE_ENTER
                               CachedFileRcPtr untypedCachedFile,
                               const FileTransform& fileTransform,
                               TransformDirection dir) const override;
+
+            bool writeBinaryCache(const CachedFileRcPtr & untypedCachedFile,
+                                  BinaryCacheWriter & writer) const override;
+
+            CachedFileRcPtr readBinaryCache(BinaryCacheReader & reader) const override;
         private:
             static void ThrowErrorMessage(const std::string & error,
                 const std::string & fileName,
@@ -128,7 +151,8 @@ OCIO_NAMESPACE_ENTER
                     }
                     else if(pystring::startswith(headerLine, "From"))
                     {
-                        if (sscanf(lineBuffer, "From %f %f", &from_min, &from_max) != 2)
+                        LineTokenizer tokens(headerLine.c_str() + 4, headerLine.size() - 4);
+                        if (!tokens.nextFloat(from_min) || !tokens.nextFloat(from_max))
                         {
                             ThrowErrorMessage("Invalid 'From' Tag.",
                                 fileName, currentLine, headerLine);
@@ -191,8 +215,10 @@ OCIO_NAMESPACE_ENTER
 
                 while (istream.good())
                 {
+                    LineTokenizer tokens(lineBuffer, strlen(lineBuffer));
+
                     // If 1 component is specificed, use x1 x1 x1 defaultA
-                    if(components==1 && sscanf(lineBuffer,"%f",&values[0])==1)
+                    if(components==1 && tokens.nextFloat(values[0]))
                     {
                         lut1d->luts[0].push_back(values[0]);
                         lut1d->luts[1].push_back(values[0]);
@@ -200,7 +226,8 @@ OCIO_NAMESPACE_ENTER
                         ++lineCount;
                     }
                     // If 2 components are specificed, use x1 x2 0.0
-                    else if(components==2 && sscanf(lineBuffer,"%f %f",&values[0],&values[1])==2)
+                    else if(components==2
+                            && tokens.nextFloat(values[0]) && tokens.nextFloat(values[1]))
                     {
                         lut1d->luts[0].push_back(values[0]);
                         lut1d->luts[1].push_back(values[1]);
@@ -208,7 +235,9 @@ OCIO_NAMESPACE_ENTER
                         ++lineCount;
                     }
                     // If 3 component is specificed, use x1 x2 x3 defaultA
-                    else if(components==3 && sscanf(lineBuffer,"%f %f %f",&values[0],&values[1],&values[2])==3)
+                    else if(components==3
+                            && tokens.nextFloat(values[0]) && tokens.nextFloat(values[1])
+                            && tokens.nextFloat(values[2]))
                     {
                         lut1d->luts[0].push_back(values[0]);
                         lut1d->luts[1].push_back(values[1]);
@@ -290,6 +319,24 @@ OCIO_NAMESPACE_ENTER
 
             throw Exception(os.str().c_str());
         }
+
+        bool LocalFileFormat::writeBinaryCache(const CachedFileRcPtr & untypedCachedFile,
+                                               BinaryCacheWriter & writer) const
+        {
+            LocalCachedFileRcPtr cachedFile = DynamicPtrCast<LocalCachedFile>(untypedCachedFile);
+            if(!cachedFile) return false;
+
+            WriteLut1D(writer, *cachedFile->lut);
+            return true;
+        }
+
+        CachedFileRcPtr LocalFileFormat::readBinaryCache(BinaryCacheReader & reader) const
+        {
+            LocalCachedFileRcPtr cachedFile = LocalCachedFileRcPtr(new LocalCachedFile());
+
+            ReadLut1D(reader, *cachedFile->lut);
+            return cachedFile;
+        }
     }
     
     FileFormat * CreateFileFormatSpi1D()
@@ -6,6 +6,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "fileformats/BinaryCache.h"
 #include "ops/Lut3D/Lut3DOp.h"
 #include "Platform.h"
 #include "pystring/pystring.h"
@@ -40,6 +41,11 @@ OCIO_NAMESPACE_ENTER
             };
             ~LocalCachedFile() {};
             
+            size_t getMemorySize() const override
+            {
+                return sizeof(LocalCachedFile) + lut->getMemorySize();
+            }
+            
             // TODO: Switch to the OpData class.
             Lut3DRcPtr lut;
         };
@@ -59,6 +65,12 @@ OCIO_NAMESPACE_ENTER
             CachedFileRcPtr read(
                 std::istream & istream,
                 const std::string & fileName) const override;
+
+            int probe(const char * data, size_t size) const override
+            {
+                return ProbeStartsWith(data, size, "spilut") ? FORMAT_PROBE_LIKELY
+                                                            : FORMAT_PROBE_NO;
+            }
             
             void buildFileOps(OpRcPtrVec & ops,
                               const Config& config,
@@ -66,6 +78,11 @@ OCIO_NAMESPACE_ENTER
                               CachedFileRcPtr untypedCachedFile,
                               const FileTransform& fileTransform,
                               TransformDirection dir) const override;
+
+            bool writeBinaryCache(const CachedFileRcPtr & untypedCachedFile,
+                                  BinaryCacheWriter & writer) const override;
+
+            CachedFileRcPtr readBinaryCache(BinaryCacheReader & reader) const override;
         };
         
         
@@ -217,6 +234,24 @@ OCIO_NAMESPACE_ENTER
                           fileTransform.getInterpolation(),
                           newDir);
         }
+
+        bool LocalFileFormat::writeBinaryCache(const CachedFileRcPtr & untypedCachedFile,
+                                               BinaryCacheWriter & writer) const
+        {
+            LocalCachedFileRcPtr cachedFile = DynamicPtrCast<LocalCachedFile>(untypedCachedFile);
+            if(!cachedFile) return false;
+
+            WriteLut3D(writer, *cachedFile->lut);
+            return true;
+        }
+
+        CachedFileRcPtr LocalFileFormat::readBinaryCache(BinaryCacheReader & reader) const
+        {
+            LocalCachedFileRcPtr cachedFile = LocalCachedFileRcPtr(new LocalCachedFile());
+
+            ReadLut3D(reader, *cachedFile->lut);
+            return cachedFile;
+        }
     }
     
     FileFormat * CreateFileFormatSpi3D()
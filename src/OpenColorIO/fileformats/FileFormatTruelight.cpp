@@ -9,6 +9,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "Baker.h"
 #include "ops/Lut1D/Lut1DOp.h"
 #include "ops/Lut3D/Lut3DOp.h"
 #include "ParseUtils.h"
@@ -47,6 +48,11 @@ OCIO_NAMESPACE_ENTER
             };
             ~LocalCachedFile() {};
             
+            size_t getMemorySize() const override
+            {
+                return sizeof(LocalCachedFile) + lut1D->getMemorySize() + lut3D->getMemorySize();
+            }
+            
             bool has1D;
             bool has3D;
             // TODO: Switch to the OpData class.
@@ -69,6 +75,12 @@ OCIO_NAMESPACE_ENTER
             CachedFileRcPtr read(
                 std::istream & istream,
                 const std::string & fileName) const override;
+
+            int probe(const char * data, size_t size) const override
+            {
+                return ProbeStartsWith(data, size, "# truelight cube") ? FORMAT_PROBE_LIKELY
+                                                                      : FORMAT_PROBE_NO;
+            }
             
             void bake(const Baker & baker,
                       const std::string & formatName,
@@ -289,17 +301,12 @@ OCIO_NAMESPACE_ENTER
             if (cubeSize==-1) cubeSize = DEFAULT_CUBE_SIZE;
             cubeSize = std::max(2, cubeSize); // smallest cube is 2x2x2
 
-            std::vector<float> cubeData;
-            cubeData.resize(cubeSize*cubeSize*cubeSize*3);
-            GenerateIdentityLut3D(&cubeData[0], cubeSize, 3, LUT3DORDER_FAST_RED);
-            PackedImageDesc cubeImg(&cubeData[0], cubeSize*cubeSize*cubeSize, 1, 3);
-            
             // Apply processor to LUT data
-            ConstCPUProcessorRcPtr inputToTarget;
-            inputToTarget
-                = config->getProcessor(baker.getInputSpace(), 
-                                       baker.getTargetSpace())->getDefaultCPUProcessor();
-            inputToTarget->apply(cubeImg);
+            ConstProcessorRcPtr inputToTarget
+                = config->getProcessor(baker.getInputSpace(), baker.getTargetSpace());
+            ConstBakedSamplesRcPtr samples
+                = BakeLut3DSamples({ inputToTarget }, cubeSize, LUT3DORDER_FAST_RED);
+            const std::vector<float> & cubeData = *samples;
             
             int shaperSize = baker.getShaperSize();
             if (shaperSize==-1) shaperSize = DEFAULT_SHAPER_SIZE;
@@ -331,10 +338,17 @@ OCIO_NAMESPACE_ENTER
 
             // Write the cube
             ostream << "# Cube\n";
+            NumberWriter writer(ostream);
             for (int i=0; i<cubeSize*cubeSize*cubeSize; ++i)
             {
-                ostream << cubeData[3*i+0] << " " << cubeData[3*i+1] << " " << cubeData[3*i+2] << "\n";
+                writer.writeFixed(cubeData[3*i+0], 6);
+                writer.write(' ');
+                writer.writeFixed(cubeData[3*i+1], 6);
+                writer.write(' ');
+                writer.writeFixed(cubeData[3*i+2], 6);
+                writer.write('\n');
             }
+            writer.flush();
             
             ostream << "# end\n";
         }
@@ -29,6 +29,11 @@ OCIO_NAMESPACE_ENTER
             };
             ~LocalCachedFile() {};
             
+            size_t getMemorySize() const override
+            {
+                return sizeof(LocalCachedFile) + lut3D->getMemorySize();
+            }
+            
             // TODO: Switch to the OpData classes.
             Lut3DRcPtr lut3D;
             double m44[16];
@@ -50,6 +55,12 @@ OCIO_NAMESPACE_ENTER
             CachedFileRcPtr read(
                 std::istream & istream,
                 const std::string & fileName) const override;
+
+            int probe(const char * data, size_t size) const override
+            {
+                return ProbeStartsWith(data, size, "#inventor") ? FORMAT_PROBE_LIKELY
+                                                               : FORMAT_PROBE_NO;
+            }
             
             void buildFileOps(OpRcPtrVec & ops,
                               const Config& config,
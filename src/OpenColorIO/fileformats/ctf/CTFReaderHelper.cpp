@@ -241,10 +241,13 @@ const CTFVersion & CTFReaderTransformElt::getVersion() const
 CTFReaderArrayElt::CTFReaderArrayElt(const std::string & name,
                                      ContainerEltRcPtr pParent,
                                      unsigned int xmlLineNumber,
-                                     const std::string & xmlFile)
+                                     const std::string & xmlFile,
+                                     bool isCLF)
     : XmlReaderPlainElt(name, pParent, xmlLineNumber, xmlFile)
     , m_array(nullptr)
     , m_position(0)
+    , m_encoding(ARRAY_ENCODING_TEXT)
+    , m_isCLF(isCLF)
 {
 }
 
@@ -302,6 +305,23 @@ void CTFReaderArrayElt::start(const char ** atts)
                 }
             }
         }
+        else if (0 == Platform::Strcasecmp(ATTR_ENCODING, atts[i]))
+        {
+            try
+            {
+                m_encoding = GetArrayEncoding(atts[i + 1]);
+            }
+            catch (Exception& ce)
+            {
+                ThrowM(*this, "'", getTypeName(), "' ", ce.what());
+            }
+
+            if (isCLF() && m_encoding != ARRAY_ENCODING_TEXT)
+            {
+                ThrowM(*this, "'", getTypeName(), "' encoding '", atts[i + 1],
+                       "' is not allowed in a CLF file.");
+            }
+        }
 
         i += 2;
     }
@@ -313,6 +333,7 @@ void CTFReaderArrayElt::start(const char ** atts)
     }
 
     m_position = 0;
+    m_encodedValues.clear();
 }
 
 void CTFReaderArrayElt::end()
@@ -321,6 +342,28 @@ void CTFReaderArrayElt::end()
     // no need to validate it.
     if (getParent()->isDummy()) return;
 
+    if (m_encoding != ARRAY_ENCODING_TEXT)
+    {
+        std::vector<float> values;
+        try
+        {
+            DecodeArrayValues(m_encodedValues.c_str(), m_encodedValues.size(),
+                              m_encoding, values);
+        }
+        catch (Exception& ce)
+        {
+            ThrowM(*this, "Illegal values in '", getTypeName(), "': ", ce.what());
+        }
+
+        for (const float value : values)
+        {
+            setValue(value);
+        }
+
+        m_encodedValues.clear();
+        m_encodedValues.shrink_to_fit();
+    }
+
     CTFArrayMgt* pArr = dynamic_cast<CTFArrayMgt*>(getParent().get());
     pArr->endArray(m_position);
 }
@@ -329,7 +372,12 @@ void CTFReaderArrayElt::setRawData(const char * s,
                                    size_t len,
                                    unsigned int/*xmlLine*/)
 {
-    const unsigned long maxValues = m_array->getNumValues();
+    if (m_encoding != ARRAY_ENCODING_TEXT)
+    {
+        m_encodedValues.append(s, len);
+        return;
+    }
+
     size_t pos(0);
 
     //
@@ -353,35 +401,40 @@ void CTFReaderArrayElt::setRawData(const char * s,
                    "' in ", getTypeName());
         }
 
-        if (m_position<maxValues)
+        setValue(data);
+    }
+}
+
+void CTFReaderArrayElt::setValue(double value)
+{
+    if (m_position<m_array->getNumValues())
+    {
+        m_array->setDoubleValue(m_position++, value);
+    }
+    else
+    {
+        const CTFReaderOpElt* p = static_cast<const CTFReaderOpElt*>(getParent().get());
+
+        std::ostringstream arg;
+        if (p->getOp()->getType() == OpData::Lut1DType)
         {
-            m_array->setDoubleValue(m_position++, data);
+            arg << m_array->getLength();
+            arg << "x" << m_array->getNumColorComponents();
         }
-        else
+        else if (p->getOp()->getType() == OpData::Lut3DType)
         {
-            const CTFReaderOpElt* p = static_cast<const CTFReaderOpElt*>(getParent().get());
-
-            std::ostringstream arg;
-            if (p->getOp()->getType() == OpData::Lut1DType)
-            {
-                arg << m_array->getLength();
-                arg << "x" << m_array->getNumColorComponents();
-            }
-            else if (p->getOp()->getType() == OpData::Lut3DType)
-            {
-                arg << m_array->getLength() << "x" << m_array->getLength();
-                arg << "x" << m_array->getLength();
-                arg << "x" << m_array->getNumColorComponents();
-            }
-            else  // Matrix
-            {
-                arg << m_array->getLength();
-                arg << "x" << m_array->getLength();
-            }
-
-            ThrowM(*this, "Expected ", arg.str(),
-                   " Array, found too many values in '", getTypeName(), "'.");
+            arg << m_array->getLength() << "x" << m_array->getLength();
+            arg << "x" << m_array->getLength();
+            arg << "x" << m_array->getNumColorComponents();
         }
+        else  // Matrix
+        {
+            arg << m_array->getLength();
+            arg << "x" << m_array->getLength();
+        }
+
+        ThrowM(*this, "Expected ", arg.str(),
+               " Array, found too many values in '", getTypeName(), "'.");
     }
 }
 
@@ -564,7 +617,7 @@ void GetNextIndexPair(const char *s, size_t len, size_t& pos, float& num1, float
         }
 
         // Extract a number at pos.
-        ParseNumber(s, pos, endPos, num1);
+        ParseNumber(s, pos, endPos, len, num1);
 
         // Set pos to the start of the next number, advancing over white space or an @.
         pos = FindNextTokenStart_IndexMap(s, len, endPos);
@@ -573,7 +626,7 @@ void GetNextIndexPair(const char *s, size_t len, size_t& pos, float& num1, float
 
         // Extract the other half of the index pair.
         // Set pos to advance over the numbers we just parsed.
-        ParseNumber(s, pos, endPos, num2);
+        ParseNumber(s, pos, endPos, len, num2);
 
         pos = endPos;
         if (pos != len)
@@ -5,6 +5,7 @@
 #define INCLUDED_OCIO_FILEFORMATS_CTF_CTFREADERHELPER_H
 
 #include "fileformats/xmlutils/XMLReaderHelper.h"
+#include "fileformats/ctf/CTFReaderUtils.h"
 #include "fileformats/ctf/CTFTransform.h"
 #include "fileformats/FormatMetadata.h"
 #include "ops/OpArray.h"
@@ -198,7 +199,8 @@ public:
     CTFReaderArrayElt(const std::string & name,
                       ContainerEltRcPtr pParent,
                       unsigned int xmlLineNumber,
-                      const std::string & xmlFile);
+                      const std::string & xmlFile,
+                      bool isCLF);
     ~CTFReaderArrayElt();
 
     void start(const char ** atts) override;
@@ -209,15 +211,27 @@ public:
 
     const char * getTypeName() const override;
 
+    // Is it a clf file?
+    bool isCLF() const { return m_isCLF; }
+
 private:
     CTFReaderArrayElt() = delete;
 
+    void setValue(double value);
+
     // The array to fill (pointer not owned).
     // Array is managed as a member object of an OpData.
     ArrayBase * m_array;
 
     // The current position to fill.
     unsigned int m_position;
+
+    // The base64 encoded values are decoded once all read.
+    ArrayEncoding m_encoding;
+    std::string m_encodedValues;
+
+    // The CLF arrays only hold text values.
+    bool m_isCLF;
 };
 
 class CTFArrayMgt
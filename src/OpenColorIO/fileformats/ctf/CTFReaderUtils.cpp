@@ -5,6 +5,7 @@
 #include <sstream>
 
 #include "fileformats/ctf/CTFReaderUtils.h"
+#include "MathUtils.h"
 #include "Platform.h"
 
 OCIO_NAMESPACE_ENTER
@@ -19,6 +20,38 @@ static constexpr const char * INTERPOLATION_DEFAULT = "default";
 static constexpr const char * INTERPOLATION_3D_LINEAR = "trilinear";
 static constexpr const char * INTERPOLATION_3D_TETRAHEDRAL = "tetrahedral";
 
+static constexpr const char * ENCODING_TEXT = "text";
+static constexpr const char * ENCODING_BASE64_F16 = "base64Float16";
+static constexpr const char * ENCODING_BASE64_F32 = "base64Float32";
+
+static constexpr const char * BASE64_CHARS
+    = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Return the 6-bit value of a base64 character, or -1 if the character is invalid.
+int GetBase64Value(char c)
+{
+    if (c >= 'A' && c <= 'Z') return c - 'A';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+    if (c >= '0' && c <= '9') return c - '0' + 52;
+    if (c == '+') return 62;
+    if (c == '/') return 63;
+    return -1;
+}
+
+size_t GetEncodedValueSize(ArrayEncoding encoding)
+{
+    switch (encoding)
+    {
+    case ARRAY_ENCODING_BASE64_F16:
+        return 2;
+    case ARRAY_ENCODING_BASE64_F32:
+        return 4;
+    case ARRAY_ENCODING_TEXT:
+    default:
+        throw Exception("Array values are not base64 encoded.");
+    }
+}
+
 }
 
 Interpolation GetInterpolation1D(const char * str)
@@ -103,5 +136,172 @@ const char * GetInterpolation3DName(Interpolation interp)
     return INTERPOLATION_DEFAULT;
 }
 
+ArrayEncoding GetArrayEncoding(const char * str)
+{
+    if (str && *str)
+    {
+        if (0 == Platform::Strcasecmp(str, ENCODING_TEXT))
+        {
+            return ARRAY_ENCODING_TEXT;
+        }
+        else if (0 == Platform::Strcasecmp(str, ENCODING_BASE64_F16))
+        {
+            return ARRAY_ENCODING_BASE64_F16;
+        }
+        else if (0 == Platform::Strcasecmp(str, ENCODING_BASE64_F32))
+        {
+            return ARRAY_ENCODING_BASE64_F32;
+        }
+
+        std::ostringstream oss;
+        oss << "Array encoding not recognized: '" << str << "'.";
+        throw Exception(oss.str().c_str());
+    }
+
+    throw Exception("Array missing encoding value.");
+}
+
+const char * GetArrayEncodingName(ArrayEncoding encoding)
+{
+    switch (encoding)
+    {
+    case ARRAY_ENCODING_BASE64_F16:
+        return ENCODING_BASE64_F16;
+    case ARRAY_ENCODING_BASE64_F32:
+        return ENCODING_BASE64_F32;
+    case ARRAY_ENCODING_TEXT:
+    default:
+        return ENCODING_TEXT;
+    };
+    return ENCODING_TEXT;
+}
+
+void EncodeArrayValues(const float * values, size_t numValues,
+                       ArrayEncoding encoding, std::string & encoded)
+{
+    const size_t valueSize = GetEncodedValueSize(encoding);
+
+    // Serialize the values in little-endian.
+    std::vector<unsigned char> bytes(numValues * valueSize);
+    for (size_t idx = 0; idx < numValues; ++idx)
+    {
+        uint32_t bits = 0;
+        if (encoding == ARRAY_ENCODING_BASE64_F16)
+        {
+            bits = half(values[idx]).bits();
+        }
+        else
+        {
+            memcpy(&bits, &values[idx], sizeof(float));
+        }
+
+        for (size_t b = 0; b < valueSize; ++b)
+        {
+            bytes[idx * valueSize + b] = (unsigned char)((bits >> (8 * b)) & 0xFF);
+        }
+    }
+
+    encoded.reserve(encoded.size() + (bytes.size() + 2) / 3 * 4);
+
+    size_t pos = 0;
+    for (; pos + 3 <= bytes.size(); pos += 3)
+    {
+        const uint32_t group = (bytes[pos] << 16) | (bytes[pos + 1] << 8) | bytes[pos + 2];
+        encoded += BASE64_CHARS[(group >> 18) & 0x3F];
+        encoded += BASE64_CHARS[(group >> 12) & 0x3F];
+        encoded += BASE64_CHARS[(group >> 6) & 0x3F];
+        encoded += BASE64_CHARS[group & 0x3F];
+    }
+
+    const size_t remaining = bytes.size() - pos;
+    if (remaining)
+    {
+        const uint32_t group = (bytes[pos] << 16) | (remaining == 2 ? (bytes[pos + 1] << 8) : 0);
+        encoded += BASE64_CHARS[(group >> 18) & 0x3F];
+        encoded += BASE64_CHARS[(group >> 12) & 0x3F];
+        encoded += remaining == 2 ? BASE64_CHARS[(group >> 6) & 0x3F] : '=';
+        encoded += '=';
+    }
+}
+
+void DecodeArrayValues(const char * str, size_t len,
+                       ArrayEncoding encoding, std::vector<float> & values)
+{
+    const size_t valueSize = GetEncodedValueSize(encoding);
+
+    std::vector<unsigned char> bytes;
+    bytes.reserve(len / 4 * 3);
+
+    uint32_t group = 0;
+    unsigned numChars = 0;
+    unsigned numPaddings = 0;
+
+    for (size_t idx = 0; idx < len; ++idx)
+    {
+        const char c = str[idx];
+        if (c == ' ' || c == '\n' || c == '\r' || c == '\t')
+        {
+            continue;
+        }
+
+        if (c == '=')
+        {
+            // The padding completes the last group.
+            if (numChars < 2 || ++numPaddings > 2)
+            {
+                throw Exception("Invalid base64 padding in the array values.");
+            }
+            group <<= 6;
+            ++numChars;
+        }
+        else
+        {
+            const int value = GetBase64Value(c);
+            if (value < 0 || numPaddings)
+            {
+                std::ostringstream oss;
+                oss << "Invalid base64 character '" << c << "' in the array values.";
+                throw Exception(oss.str().c_str());
+            }
+            group = (group << 6) | (uint32_t)value;
+            ++numChars;
+        }
+
+        if (numChars == 4)
+        {
+            bytes.push_back((unsigned char)((group >> 16) & 0xFF));
+            if (numPaddings < 2) bytes.push_back((unsigned char)((group >> 8) & 0xFF));
+            if (numPaddings < 1) bytes.push_back((unsigned char)(group & 0xFF));
+            group = 0;
+            numChars = 0;
+        }
+    }
+
+    if (numChars != 0 || bytes.size() % valueSize != 0)
+    {
+        throw Exception("Truncated base64 array values.");
+    }
+
+    const size_t numValues = bytes.size() / valueSize;
+    values.resize(numValues);
+    for (size_t idx = 0; idx < numValues; ++idx)
+    {
+        uint32_t bits = 0;
+        for (size_t b = 0; b < valueSize; ++b)
+        {
+            bits |= (uint32_t)bytes[idx * valueSize + b] << (8 * b);
+        }
+
+        if (encoding == ARRAY_ENCODING_BASE64_F16)
+        {
+            values[idx] = ConvertHalfBitsToFloat((unsigned short)bits);
+        }
+        else
+        {
+            memcpy(&values[idx], &bits, sizeof(float));
+        }
+    }
+}
+
 }
 OCIO_NAMESPACE_EXIT
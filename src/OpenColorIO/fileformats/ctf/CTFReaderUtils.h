@@ -4,6 +4,9 @@
 #ifndef INCLUDED_OCIO_FILEFORMATS_CTF_CTFREADERUTILS_H
 #define INCLUDED_OCIO_FILEFORMATS_CTF_CTFREADERUTILS_H
 
+#include <string>
+#include <vector>
+
 #include <OpenColorIO/OpenColorIO.h>
 
 OCIO_NAMESPACE_ENTER
@@ -14,6 +17,29 @@ const char * GetInterpolation1DName(Interpolation interp);
 Interpolation GetInterpolation3D(const char * str);
 const char * GetInterpolation3DName(Interpolation interp);
 
+// The values of an Array are written as text by default. A CTF file may instead
+// encode them as base64 of the little-endian half or float values, which is much
+// faster to read and write for the large LUTs. CLF only allows the text.
+enum ArrayEncoding
+{
+    ARRAY_ENCODING_TEXT = 0,
+    ARRAY_ENCODING_BASE64_F16,
+    ARRAY_ENCODING_BASE64_F32
+};
+
+// Throw if the encoding is unknown.
+ArrayEncoding GetArrayEncoding(const char * str);
+const char * GetArrayEncodingName(ArrayEncoding encoding);
+
+// Append the base64 encoded values (without any line break) to the string.
+void EncodeArrayValues(const float * values, size_t numValues,
+                       ArrayEncoding encoding, std::string & encoded);
+
+// Decode the base64 values, the whitespaces are ignored. Throw if the string is not
+// a valid base64 encoding of the values.
+void DecodeArrayValues(const char * str, size_t len,
+                       ArrayEncoding encoding, std::vector<float> & values);
+
 static constexpr const char * TAG_ACES = "ACES";
 static constexpr const char * TAG_ACES_PARAMS = "ACESParams";
 static constexpr const char * TAG_ARRAY = "Array";
@@ -55,6 +81,7 @@ static constexpr const char * ATTR_CHAN = "channel";
 static constexpr const char * ATTR_COMP_CLF_VERSION = "compCLFversion";
 static constexpr const char * ATTR_CONTRAST = "contrast";
 static constexpr const char * ATTR_DIMENSION = "dim";
+static constexpr const char * ATTR_ENCODING = "encoding";
 static constexpr const char * ATTR_EXPOSURE = "exposure";
 static constexpr const char * ATTR_GAMMA = "gamma";
 static constexpr const char * ATTR_HALF_DOMAIN = "halfDomain";
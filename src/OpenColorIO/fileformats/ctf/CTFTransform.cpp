@@ -19,6 +19,7 @@
 #include "ops/Matrix/MatrixOpData.h"
 #include "ops/Range/RangeOpData.h"
 #include "ops/reference/ReferenceOpData.h"
+#include "ParseUtils.h"
 #include "Platform.h"
 
 OCIO_NAMESPACE_ENTER
@@ -183,6 +184,11 @@ const CTFVersion & CTFReaderTransform::getCTFVersion() const
     return m_version;
 }
 
+const CTFVersion & CTFReaderTransform::getCLFVersion() const
+{
+    return m_versionCLF;
+}
+
 void CTFReaderTransform::validate()
 {
     BitDepth bitdepth = BIT_DEPTH_UNKNOWN;
@@ -483,16 +489,16 @@ typename std::enable_if<!std::is_floating_point<T>::value, void>::type WriteValu
 }
 
 template <typename T>
-void SetOStream(T, std::ostream & xml)
+void SetOStream(T, std::ostream & xml, int & width)
 {
-    xml.width(11);
+    width = 11;
     xml.precision(8);
 }
 
 template <>
-void SetOStream<double>(double, std::ostream & xml)
+void SetOStream<double>(double, std::ostream & xml, int & width)
 {
-    xml.width(19);
+    width = 19;
     xml.precision(15);
 }
 
@@ -507,69 +513,96 @@ void WriteValues(XmlFormatter & formatter,
 {
     std::ostream& xml = formatter.getStream();
 
-    for (Iter it(valuesBegin); it != valuesEnd; it += iterStep)
+    // The values are formatted like the stream would do (the stream precision is
+    // still set for the elements written after the array) but buffered, as the
+    // stream formatting dominates the writing of large LUTs.
+    int width = 0;
+    switch (bitDepth)
     {
-        switch (bitDepth)
-        {
-        case BIT_DEPTH_UINT8:
-        {
-            xml.width(3);
-            xml << (*it) * scale;
-            break;
-        }
-        case BIT_DEPTH_UINT10:
-        {
-            xml.width(4);
-            xml << (*it) * scale;
-            break;
-        }
+    case BIT_DEPTH_UINT8:
+        width = 3;
+        break;
 
-        case BIT_DEPTH_UINT12:
-        {
-            xml.width(4);
-            xml << (*it) * scale;
-            break;
-        }
+    case BIT_DEPTH_UINT10:
+    case BIT_DEPTH_UINT12:
+        width = 4;
+        break;
 
-        case BIT_DEPTH_UINT16:
-        {
-            xml.width(5);
-            xml << (*it) * scale;
-            break;
-        }
+    case BIT_DEPTH_UINT16:
+        width = 5;
+        break;
 
-        case BIT_DEPTH_F16:
-        {
-            xml.width(11);
-            xml.precision(5);
-            WriteValue((*it) * scale, xml);
-            break;
-        }
+    case BIT_DEPTH_F16:
+        width = 11;
+        xml.precision(5);
+        break;
 
-        case BIT_DEPTH_F32:
+    case BIT_DEPTH_F32:
+        if (valuesBegin != valuesEnd)
         {
-            SetOStream(*it, xml);
-            WriteValue((*it) * scale, xml);
-            break;
+            SetOStream(*valuesBegin, xml, width);
         }
+        break;
 
-        default:
-        {
-            throw Exception("Unknown bitdepth.");
-            break;
-        }
-        }
+    default:
+        throw Exception("Unknown bitdepth.");
+        break;
+    }
+
+    const int precision = int(xml.precision());
+    const bool isFloat = bitDepth == BIT_DEPTH_F16 || bitDepth == BIT_DEPTH_F32;
+
+    NumberWriter writer(xml);
+
+    for (Iter it(valuesBegin); it != valuesEnd; it += iterStep)
+    {
+        const auto value = (*it) * scale;
+        // Refer to WriteValue().
+        writer.writeGeneral(isFloat && IsNan(value) ? std::numeric_limits<double>::quiet_NaN()
+                                                    : double(value),
+                            precision, width);
 
         if (std::distance(valuesBegin, it) % valuesPerLine
             == valuesPerLine - 1)
         {
-            xml << std::endl;
+            writer.write('\n');
         }
         else
         {
-            xml << " ";
+            writer.write(' ');
         }
     }
+
+    writer.flush();
+}
+
+// Write the values as base64 lines instead of text (refer to ArrayEncoding).
+template<typename Iter, typename scaleType>
+void WriteEncodedValues(XmlFormatter & formatter,
+                        Iter valuesBegin,
+                        Iter valuesEnd,
+                        ArrayEncoding encoding,
+                        unsigned iterStep,
+                        scaleType scale)
+{
+    std::vector<float> values;
+    values.reserve(std::distance(valuesBegin, valuesEnd) / iterStep);
+    for (Iter it(valuesBegin); it != valuesEnd; it += iterStep)
+    {
+        values.push_back((float)((*it) * scale));
+    }
+
+    std::string encoded;
+    EncodeArrayValues(values.data(), values.size(), encoding, encoded);
+
+    static constexpr size_t CHARS_PER_LINE = 76;
+
+    std::ostream& xml = formatter.getStream();
+    for (size_t pos = 0; pos < encoded.size(); pos += CHARS_PER_LINE)
+    {
+        xml.write(encoded.data() + pos, std::min(CHARS_PER_LINE, encoded.size() - pos));
+        xml << "\n";
+    }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -589,6 +622,9 @@ public:
     inline void setInputBitdepth(BitDepth in) { m_inBitDepth = in; }
     inline void setOutputBitdepth(BitDepth out) { m_outBitDepth = out; }
 
+    // Only the LUT arrays are base64 encoded, the other values stay as text.
+    inline void setBinaryArrays(bool binary) { m_binaryArrays = binary; }
+
 protected:
     virtual ConstOpDataRcPtr getOp() const = 0;
     virtual const char * getTagName() const = 0;
@@ -597,6 +633,7 @@ protected:
     
     BitDepth m_inBitDepth = BIT_DEPTH_UNKNOWN;
     BitDepth m_outBitDepth = BIT_DEPTH_UNKNOWN;
+    bool m_binaryArrays = false;
 };
 
 OpWriter::OpWriter(XmlFormatter & formatter)
@@ -1366,19 +1403,60 @@ void Lut1DWriter::writeContent() const
     dimension << array.getLength() << " "
               << array.getNumColorComponents();
 
+    // The raw halfs are encoded as float values to keep their bits.
+    const auto fbd = m_outBitDepth;
+    const ArrayEncoding encoding
+        = !m_binaryArrays ? ARRAY_ENCODING_TEXT
+                          : (fbd == BIT_DEPTH_F16 && !m_lut->isOutputRawHalfs())
+                                ? ARRAY_ENCODING_BASE64_F16 : ARRAY_ENCODING_BASE64_F32;
+
     XmlFormatter::Attributes attributes;
     attributes.push_back(XmlFormatter::Attribute(ATTR_DIMENSION,
                                                  dimension.str()));
+    if (encoding != ARRAY_ENCODING_TEXT)
+    {
+        attributes.push_back(XmlFormatter::Attribute(ATTR_ENCODING,
+                                                     GetArrayEncodingName(encoding)));
+    }
 
     m_formatter.writeStartTag(TAG_ARRAY, attributes);
 
     // To avoid needing to duplicate the const objects,
     // we scale the values on-the-fly while writing.
-    const auto fbd = m_outBitDepth;
     const auto bd = m_lut->getOutputBitDepth();
     const float scale = (float)(GetBitDepthMaxValue(fbd) / GetBitDepthMaxValue(bd));
 
-    if (m_lut->isOutputRawHalfs())
+    if (encoding != ARRAY_ENCODING_TEXT && m_lut->isOutputRawHalfs())
+    {
+        std::vector<unsigned> values;
+
+        const size_t maxValues = array.getNumValues();
+        values.resize(maxValues);
+
+        for (size_t i = 0; i<maxValues; ++i)
+        {
+            half h = (array.getValues()[i] * scale);
+            values[i] = h.bits();
+        }
+
+        WriteEncodedValues(m_formatter,
+                           values.begin(),
+                           values.end(),
+                           encoding,
+                           array.getNumColorComponents() == 1 ? 3 : 1,
+                           1.0f);
+    }
+    else if (encoding != ARRAY_ENCODING_TEXT)
+    {
+        const Array::Values & values = array.getValues();
+        WriteEncodedValues(m_formatter,
+                           values.begin(),
+                           values.end(),
+                           encoding,
+                           array.getNumColorComponents() == 1 ? 3 : 1,
+                           scale);
+    }
+    else if (m_lut->isOutputRawHalfs())
     {
         std::vector<unsigned> values;
 
@@ -1490,24 +1568,46 @@ void Lut3DWriter::writeContent() const
               << array.getLength() << " "
               << array.getNumColorComponents();
 
+    const auto fbd = m_outBitDepth;
+    const ArrayEncoding encoding
+        = !m_binaryArrays ? ARRAY_ENCODING_TEXT
+                          : fbd == BIT_DEPTH_F16 ? ARRAY_ENCODING_BASE64_F16
+                                                 : ARRAY_ENCODING_BASE64_F32;
+
     XmlFormatter::Attributes attributes;
     attributes.push_back(XmlFormatter::Attribute(ATTR_DIMENSION,
                          dimension.str()));
+    if (encoding != ARRAY_ENCODING_TEXT)
+    {
+        attributes.push_back(XmlFormatter::Attribute(ATTR_ENCODING,
+                                                     GetArrayEncodingName(encoding)));
+    }
 
     m_formatter.writeStartTag(TAG_ARRAY, attributes);
 
     // To avoid needing to duplicate the const objects,
     // we scale the values on-the-fly while writing.
-    const auto fbd = m_outBitDepth;
     const auto bd = m_lut->getOutputBitDepth();
     const float scale = (float)(GetBitDepthMaxValue(fbd) / GetBitDepthMaxValue(bd));
-    WriteValues(m_formatter,
-                array.getValues().begin(),
-                array.getValues().end(),
-                3,
-                fbd,
-                1,
-                scale);
+    if (encoding != ARRAY_ENCODING_TEXT)
+    {
+        WriteEncodedValues(m_formatter,
+                           array.getValues().begin(),
+                           array.getValues().end(),
+                           encoding,
+                           1,
+                           scale);
+    }
+    else
+    {
+        WriteValues(m_formatter,
+                    array.getValues().begin(),
+                    array.getValues().end(),
+                    3,
+                    fbd,
+                    1,
+                    scale);
+    }
 
     m_formatter.writeEndTag(TAG_ARRAY);
 }
@@ -1728,10 +1828,12 @@ void RangeWriter::writeContent() const
 
 TransformWriter::TransformWriter(XmlFormatter & formatter,
                                  ConstCTFReaderTransformPtr transform,
-                                 bool isCLF)
+                                 bool isCLF,
+                                 bool binaryArrays)
     : XmlElementWriter(formatter)
     , m_transform(transform)
     , m_isCLF(isCLF)
+    , m_binaryArrays(binaryArrays && !isCLF)
 {
 }
 
@@ -2011,6 +2113,7 @@ void TransformWriter::writeOps() const
             outBD = GetValidatedFileBitDepth(lut->getFileOutputBitDepth(), type);
             opWriter.setInputBitdepth(inBD);
             opWriter.setOutputBitdepth(outBD);
+            opWriter.setBinaryArrays(m_binaryArrays);
 
             opWriter.write();
             break;
@@ -2031,6 +2134,7 @@ void TransformWriter::writeOps() const
             outBD = GetValidatedFileBitDepth(lut->getFileOutputBitDepth(), type);
             opWriter.setInputBitdepth(inBD);
             opWriter.setOutputBitdepth(outBD);
+            opWriter.setBinaryArrays(m_binaryArrays);
 
             opWriter.write();
             break;
@@ -209,6 +209,7 @@ public:
     void setCLFVersion(const CTFVersion & ver);
 
     const CTFVersion & getCTFVersion() const;
+    const CTFVersion & getCLFVersion() const;
 
     void validate();
 
@@ -245,9 +246,11 @@ public:
     TransformWriter(const TransformWriter &) = delete;
     TransformWriter& operator=(const TransformWriter &) = delete;
 
+    // The binary arrays are only allowed in CTF (refer to ArrayEncoding).
     TransformWriter(XmlFormatter & formatter,
                     ConstCTFReaderTransformPtr transform,
-                    bool isCLF);
+                    bool isCLF,
+                    bool binaryArrays);
 
     virtual ~TransformWriter();
 
@@ -261,6 +264,7 @@ private:
 private:
     ConstCTFReaderTransformPtr m_transform;
     bool                       m_isCLF;
+    bool                       m_binaryArrays;
 };
 
 
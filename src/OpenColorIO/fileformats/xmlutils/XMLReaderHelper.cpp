@@ -209,7 +209,8 @@ void XmlReaderSOPValueElt::setRawData(const char * str,
                                       size_t len,
                                       unsigned int xmlLine)
 {
-    m_contentData += std::string(str, len) + " ";
+    m_contentData.append(str, len);
+    m_contentData.push_back(' ');
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -267,7 +268,8 @@ void XmlReaderSaturationElt::end()
 
 void XmlReaderSaturationElt::setRawData(const char* str, size_t len, unsigned int)
 {
-    m_contentData += std::string(str, len) + " ";
+    m_contentData.append(str, len);
+    m_contentData.push_back(' ');
 }
 
 }
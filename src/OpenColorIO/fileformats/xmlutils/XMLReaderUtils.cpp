@@ -160,8 +160,8 @@ OCIO_ADD_TEST(XMLReaderHelper, string_to_float_failure)
     const char str2[] = "12345";
     const size_t len2 = strlen(str2);
     // All characters are parsed and this is more than the required length.
-    // The string to double function strtod does not stop at a given length,
-    // but we detect that strtod did read too many characters.
+    // The number is parsed up to the length of the string to detect that it
+    // continues after the required length.
     OCIO_CHECK_THROW_WHAT(OCIO::ParseNumber(str2, 0, len2 - 2, value),
                           OCIO::Exception,
                           "followed by unexpected characters");
@@ -169,9 +169,27 @@ OCIO_ADD_TEST(XMLReaderHelper, string_to_float_failure)
 
     const char str3[] = "123XX";
     const size_t len3 = strlen(str3);
-    // Strtod will stop after parsing 123 and this happens to be the
+    // The parsing stops after 123 and this happens to be the
     // excact length that is required to be parsed.
     OCIO_CHECK_NO_THROW(OCIO::ParseNumber(str3, 0, len3 - 2, value));
+
+    // The characters after the length of the string are never read (e.g. the
+    // character data of the XML parser are not null terminated).
+    OCIO_CHECK_NO_THROW(OCIO::ParseNumber(str2, 0, len2 - 2, len2 - 2, value));
+    OCIO_CHECK_EQUAL(value, 123.0f);
+    OCIO_CHECK_THROW_WHAT(OCIO::ParseNumber(str2, 0, len2 - 2, len2 - 1, value),
+                          OCIO::Exception,
+                          "followed by unexpected characters");
+
+    // The hexadecimal numbers are accepted, without reading past the end.
+    const char str4[] = "0x10 -0x1.8p1";
+    OCIO_CHECK_NO_THROW(OCIO::ParseNumber(str4, 0, 4, value));
+    OCIO_CHECK_EQUAL(value, 16.0);
+    OCIO_CHECK_NO_THROW(OCIO::ParseNumber(str4, 5, strlen(str4), value));
+    OCIO_CHECK_EQUAL(value, -3.0);
+    OCIO_CHECK_THROW_WHAT(OCIO::ParseNumber(str4, 0, 3, value),
+                          OCIO::Exception,
+                          "followed by unexpected characters");
 }
 
 OCIO_ADD_TEST(XMLReaderHelper, get_numbers)
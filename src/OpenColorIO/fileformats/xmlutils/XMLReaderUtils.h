@@ -4,6 +4,8 @@
 #ifndef INCLUDED_OCIO_FILEFORMATS_XML_XMLREADERUTILS_H
 #define INCLUDED_OCIO_FILEFORMATS_XML_XMLREADERUTILS_H
 
+#include <cmath>
+#include <cstring>
 #include <string>
 #include <sstream>
 #include <vector>
@@ -11,6 +13,7 @@
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "MathUtils.h"
+#include "ParseUtils.h"
 #include "Platform.h"
 
 OCIO_NAMESPACE_ENTER
@@ -126,34 +129,113 @@ template<>
 bool IsValid(float, double) { return true; }
 template<>
 bool IsValid(double, double) { return true; }
+
+inline int HexDigitValue(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// Parse the hexadecimal numbers (e.g. "0x42", "-0x1.8p3") accepted by strtod,
+// without reading past end. Return the position following the number, or str
+// if the string does not start with a hexadecimal number.
+inline const char * ParseHexNumber(const char * str, const char * end, double & value)
+{
+    const char * ptr = str;
+
+    bool negative = false;
+    if (ptr != end && (*ptr == '-' || *ptr == '+'))
+    {
+        negative = (*ptr == '-');
+        ++ptr;
+    }
+
+    if (end - ptr < 3 || ptr[0] != '0' || (ptr[1] != 'x' && ptr[1] != 'X'))
+    {
+        return str;
+    }
+    ptr += 2;
+
+    double val = 0.0;
+    bool hasDigits = false;
+    for (; ptr != end && HexDigitValue(*ptr) >= 0; ++ptr)
+    {
+        val = val * 16.0 + HexDigitValue(*ptr);
+        hasDigits = true;
+    }
+
+    if (ptr != end && *ptr == '.')
+    {
+        ++ptr;
+        double scale = 1.0 / 16.0;
+        for (; ptr != end && HexDigitValue(*ptr) >= 0; ++ptr)
+        {
+            val += scale * HexDigitValue(*ptr);
+            scale /= 16.0;
+            hasDigits = true;
+        }
+    }
+
+    if (!hasDigits)
+    {
+        return str;
+    }
+
+    // The binary exponent is optional.
+    if (ptr != end && (*ptr == 'p' || *ptr == 'P'))
+    {
+        int exponent = 0;
+        const char * endExp = ParseInt(ptr + 1, end, exponent);
+        if (endExp != ptr + 1)
+        {
+            val = std::ldexp(val, exponent);
+            ptr = endExp;
+        }
+    }
+
+    value = negative ? -val : val;
+    return ptr;
+}
 }
 
 // Get first number from a string between startPos & endPos.
-// EndPos should not be greater than length of the string.
-// Will throw if str[endPos-1] is not part of the number.
-// The character after the last one that is part of the number has to be
-// accessible (most likely str[endPos]).
+// EndPos should not be greater than len, the length of the string.
+// Will throw if str[endPos-1] is not part of the number, or if the number
+// continues after endPos.
 // Note: For performance reasons, this function does not copy the string
 //       unless an exception needs to be thrown.
 template<typename T>
-void ParseNumber(const char * str, size_t startPos, size_t endPos, T & value)
+void ParseNumber(const char * str, size_t startPos, size_t endPos, size_t len, T & value)
 {
     if (endPos == startPos)
     {
         throw Exception("ParseNumber: nothing to parse.");
     }
 
+    // Skip the leading white spaces as strtod does.
+    size_t numPos = startPos;
+    while (numPos < endPos && IsSpace(str[numPos]))
+    {
+        ++numPos;
+    }
+
     const char * startParse = str + startPos;
 
+    // The number is parsed up to the end of the string (and not endPos) to detect
+    // the numbers continuing after endPos. The parsing does not depend on the locale
+    // and never reads past len. The hexadecimal numbers are still accepted as with strtod.
     double val = 0.0f;
-    char * endParse = nullptr;
-
-    // The strtod expects a C string and str might not be null terminated.
-    // However since strtod will stop parsing when it encounters characters
-    // that it cannot convert to a number, in practice it does not need to
-    // be null terminated.
-    // C++11 version of strtod processes NAN & INF ASCII values.
-    val = strtod(startParse, &endParse);
+    const char * endParse = ParseHexNumber(str + numPos, str + len, val);
+    if (endParse == str + numPos)
+    {
+        endParse = ParseDouble(str + numPos, str + len, val);
+    }
+    if (endParse == str + numPos)
+    {
+        endParse = startParse;
+    }
     value = (T)val;
     if (endParse == startParse)
     {
@@ -191,6 +273,13 @@ void ParseNumber(const char * str, size_t startPos, size_t endPos, T & value)
     }
 }
 
+// Same as above for a null terminated string.
+template<typename T>
+void ParseNumber(const char * str, size_t startPos, size_t endPos, T & value)
+{
+    ParseNumber(str, startPos, endPos, endPos + strlen(str + endPos), value);
+}
+
 // Extract the next number contained in the string.
 // Note that pos gets updated to the position of the next delimiter, or to
 // std::string::npos if the value returned is the last one in the string.
@@ -202,7 +291,7 @@ void GetNextNumber(const char * s, size_t len, size_t & pos, T & num)
     if (pos != len)
     {
         size_t nextPos = FindDelim(s, len, pos);
-        ParseNumber(s, pos, nextPos, num);
+        ParseNumber(s, pos, nextPos, len, num);
         pos = nextPos;
 
         if (pos != len)
@@ -170,7 +170,6 @@ OCIO_ADD_TEST(AllocationOps, Create)
     OCIO::ConstOpRcPtr op1 = ops[1];
     // second op is a fit transform
     OCIO_CHECK_EQUAL(forwardFitOp->isSameType(op1), true);
-    OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(ops, OCIO::OPTIMIZATION_DEFAULT));
     OCIO_CHECK_NO_THROW(OCIO::FinalizeOpVec(ops, OCIO::FINALIZATION_EXACT));
     OCIO_REQUIRE_EQUAL(ops.size(), 2);
     ConstOpRcPtr defaultLogOp = ops[0];
@@ -216,6 +215,29 @@ OCIO_ADD_TEST(AllocationOps, Create)
         OCIO_CHECK_CLOSE(dstFit[idx], tmp[idx], error);
     }
 
+    // The optimizer folds the fit into the log.
+    OpRcPtrVec optOps;
+    optOps.push_back(ops[0]->clone());
+    optOps.push_back(ops[1]->clone());
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(optOps, OCIO::OPTIMIZATION_DEFAULT));
+    OCIO_CHECK_NO_THROW(OCIO::FinalizeOpVec(optOps, OCIO::FINALIZATION_EXACT));
+    OCIO_REQUIRE_EQUAL(optOps.size(), 1);
+    OCIO::ConstOpRcPtr optOp = optOps[0];
+    OCIO_CHECK_EQUAL(defaultLogOp->isSameType(optOp), true);
+
+    float tmpOpt[NB_PIXELS * 4];
+    memcpy(tmp, &src[0], 4 * NB_PIXELS * sizeof(float));
+    memcpy(tmpOpt, &src[0], 4 * NB_PIXELS * sizeof(float));
+
+    ops[0]->apply(tmp, NB_PIXELS);
+    ops[1]->apply(tmp, NB_PIXELS);
+    optOps[0]->apply(tmpOpt, NB_PIXELS);
+
+    for (unsigned idx = 0; idx<(NB_PIXELS * 4); ++idx)
+    {
+        OCIO_CHECK_CLOSE(tmp[idx], tmpOpt[idx], error);
+    }
+
     ops.clear();
 
     OCIO_CHECK_NO_THROW(
@@ -341,6 +341,71 @@ bool LogOpData::isInverse(ConstLogOpDataRcPtr & r) const
     return false;
 }
 
+LogOpDataRcPtr LogOpData::composeScaleOffset(const double(&scale)[3],
+                                             const double(&offset)[3],
+                                             bool scaleFirst) const
+{
+    // Only the affine parameters change, either on the linear side or on the log side:
+    //
+    //   lin to log:  logSlope * log(linSlope * x + linOffset) + logOffset
+    //   log to lin:  (pow(base, (x - logOffset) / logSlope) - linOffset) / linSlope
+    //
+    // so the composition is exact (except for the rounding of the new parameters) and
+    // the clamping of the lin to log direction still applies to the same values.
+
+    LogOpDataRcPtr res = clone();
+
+    Params * params[3] = { &res->m_redParams, &res->m_greenParams, &res->m_blueParams };
+
+    for (unsigned c = 0; c < 3; ++c)
+    {
+        if (scale[c] == 0.0)
+        {
+            throw Exception("Log: Cannot compose with a null scale.");
+        }
+
+        Params & p = *params[c];
+        const double s = scale[c];
+        const double o = offset[c];
+
+        const bool linSide = (m_direction == TRANSFORM_DIR_FORWARD) == scaleFirst;
+        if (m_direction == TRANSFORM_DIR_FORWARD)
+        {
+            if (linSide)
+            {
+                // log(linSlope * (s * x + o) + linOffset).
+                p[LIN_SIDE_OFFSET] += p[LIN_SIDE_SLOPE] * o;
+                p[LIN_SIDE_SLOPE]  *= s;
+            }
+            else
+            {
+                // s * (logSlope * log(...) + logOffset) + o.
+                p[LOG_SIDE_SLOPE]  *= s;
+                p[LOG_SIDE_OFFSET]  = p[LOG_SIDE_OFFSET] * s + o;
+            }
+        }
+        else
+        {
+            if (!linSide)
+            {
+                // pow(base, ((s * x + o) - logOffset) / logSlope).
+                p[LOG_SIDE_SLOPE]  /= s;
+                p[LOG_SIDE_OFFSET]  = (p[LOG_SIDE_OFFSET] - o) / s;
+            }
+            else
+            {
+                // s * (pow(...) - linOffset) / linSlope + o.
+                p[LIN_SIDE_OFFSET] -= o * p[LIN_SIDE_SLOPE] / s;
+                p[LIN_SIDE_SLOPE]  /= s;
+            }
+        }
+    }
+
+    res->validate();
+
+    return res;
+}
+
 bool LogOpData::allComponentsEqual() const
 {
     // Comparing doubles is generally not a good idea, but in this case
@@ -80,6 +80,13 @@ public:
 
     bool isInverse(ConstLogOpDataRcPtr & r) const;
 
+    // Compose with a per-channel scale & offset (i.e. a diagonal matrix) applied either
+    // before (scaleFirst is true) or after the log.  The result is exact and still
+    // evaluates one log (or one power) per channel.  Throws if a scale is null.
+    LogOpDataRcPtr composeScaleOffset(const double(&scale)[3],
+                                      const double(&offset)[3],
+                                      bool scaleFirst) const;
+
     inline const Params & getRedParams() const { return m_redParams; }
     inline void setRedParams(const Params & p) { m_redParams = p; }
 
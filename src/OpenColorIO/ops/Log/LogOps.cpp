@@ -4,6 +4,7 @@
 #include <cmath>
 #include <cstring>
 #include <iostream>
+#include <sstream>
 #include <algorithm>
 
 #include <OpenColorIO/OpenColorIO.h>
@@ -14,6 +15,7 @@
 #include "ops/Log/LogOpData.h"
 #include "ops/Log/LogOpGPU.h"
 #include "ops/Log/LogOps.h"
+#include "ops/Matrix/MatrixOps.h"
 #include "MathUtils.h"
 
 
@@ -38,6 +40,8 @@ OCIO_NAMESPACE_ENTER
             
             bool isSameType(ConstOpRcPtr & op) const override;
             bool isInverse(ConstOpRcPtr & op) const override;
+            bool canCombineWith(ConstOpRcPtr & op) const override;
+            void combineWith(OpRcPtrVec & ops, ConstOpRcPtr & secondOp) const override;
             void finalize(FinalizationFlags fFlags) override;
 
             ConstOpCPURcPtr getCPUOp() const override;
@@ -91,6 +95,32 @@ OCIO_NAMESPACE_ENTER
             return logData()->isInverse(logOpData);
         }
         
+        bool LogOp::canCombineWith(ConstOpRcPtr & op) const
+        {
+            // A following per-channel scale & offset is folded into the log parameters.
+            double scale[3], offset[3];
+            return getInputBitDepth() == BIT_DEPTH_F32
+                && getOutputBitDepth() == BIT_DEPTH_F32
+                && GetRGBScaleOffset(op, scale, offset);
+        }
+
+        void LogOp::combineWith(OpRcPtrVec & ops, ConstOpRcPtr & secondOp) const
+        {
+            if (!canCombineWith(secondOp))
+            {
+                std::ostringstream os;
+                os << "LogOp can only be combined with a 32f diagonal MatrixOffsetOp.  secondOp:";
+                os << secondOp->getInfo();
+                throw Exception(os.str().c_str());
+            }
+
+            double scale[3], offset[3];
+            GetRGBScaleOffset(secondOp, scale, offset);
+
+            LogOpDataRcPtr composed = logData()->composeScaleOffset(scale, offset, false);
+            ops.push_back(std::make_shared<LogOp>(composed));
+        }
+
         void LogOp::finalize(FinalizationFlags /*fFlags*/)
         {
             logData()->finalize();
@@ -544,4 +574,104 @@ OCIO_ADD_TEST(LogOps, create_transform)
     OCIO_CHECK_EQUAL(values[2], linOffset[2]);
 }
 
+namespace
+{
+void ComposeWithMatrixTest(OCIO::TransformDirection logDir, unsigned line)
+{
+    const double base = 2.0;
+    const double logSlope[3]  = { 0.3, 0.4, 0.5 };
+    const double logOffset[3] = { 0.6, 0.5, 0.4 };
+    const double linSlope[3]  = { 1.1, 1.2, 1.3 };
+    const double linOffset[3] = { 0.1, 0.05, 0.02 };
+
+    const double scale1[4]  = { 1.5, 0.75, 2.0, 1.0 };
+    const double offset1[4] = { 0.01, 0.02, 0.03, 0.0 };
+    const double scale2[4]  = { 0.5, -1.25, 3.0, 1.0 };
+    const double offset2[4] = { -0.1, 0.2, 0.05, 0.0 };
+
+    OCIO::OpRcPtrVec ops;
+    OCIO::CreateScaleOffsetOp(ops, scale1, offset1, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateLogOp(ops, base, logSlope, logOffset, linSlope, linOffset, logDir);
+    // The inverse direction of the matrix is also handled.
+    OCIO::CreateScaleOffsetOp(ops, scale2, offset2, OCIO::TRANSFORM_DIR_INVERSE);
+
+    OCIO::OpRcPtrVec refOps;
+    for (const auto & op : ops)
+    {
+        refOps.push_back(op->clone());
+    }
+    OCIO_CHECK_NO_THROW(FinalizeOpVec(refOps, OCIO::FINALIZATION_EXACT));
+
+    OCIO_CHECK_NO_THROW(OptimizeOpVec(ops, OCIO::OPTIMIZATION_DEFAULT));
+    OCIO_REQUIRE_EQUAL_FROM(ops.size(), 1, line);
+    OCIO_CHECK_EQUAL_FROM(ops[0]->getInfo(), "<LogOp>", line);
+    OCIO_CHECK_NO_THROW(FinalizeOpVec(ops, OCIO::FINALIZATION_EXACT));
+
+    const float src[12] = { 0.01f, 0.1f, 0.2f, 0.0f,
+                            0.3f,  0.5f, 0.8f, 0.5f,
+                            1.0f,  2.0f, 4.0f, 1.0f };
+
+    float res[12], ref[12];
+    memcpy(res, src, 12 * sizeof(float));
+    memcpy(ref, src, 12 * sizeof(float));
+
+    ops[0]->apply(res, 3);
+    for (const auto & op : refOps)
+    {
+        op->apply(ref, 3);
+    }
+
+    for (unsigned idx = 0; idx < 12; ++idx)
+    {
+        // Relative error as the log to lin direction produces large values.
+        const float tol = 1e-5f * std::max(1.0f, std::fabs(ref[idx]));
+        OCIO_CHECK_CLOSE_FROM(res[idx], ref[idx], tol, line);
+    }
+}
+}
+
+OCIO_ADD_TEST(LogOps, compose_with_matrix)
+{
+    ComposeWithMatrixTest(OCIO::TRANSFORM_DIR_FORWARD, __LINE__);
+    ComposeWithMatrixTest(OCIO::TRANSFORM_DIR_INVERSE, __LINE__);
+}
+
+OCIO_ADD_TEST(LogOps, compose_with_matrix_not_allowed)
+{
+    const double scale[4]  = { 1.5, 0.75, 2.0, 1.0 };
+    const double offset[4] = { 0.01, 0.02, 0.03, 0.1 };
+    const double m44[16] = { 1.0, 0.1, 0.0, 0.0,
+                             0.0, 1.0, 0.0, 0.0,
+                             0.0, 0.0, 1.0, 0.0,
+                             0.0, 0.0, 0.0, 1.0 };
+
+    OCIO::OpRcPtrVec ops;
+    OCIO::CreateLogOp(ops, 2.0, OCIO::TRANSFORM_DIR_FORWARD);
+    // Alpha is modified.
+    OCIO::CreateScaleOffsetOp(ops, scale, offset, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateLogOp(ops, 2.0, OCIO::TRANSFORM_DIR_FORWARD);
+    // Not a diagonal matrix.
+    OCIO::CreateMatrixOp(ops, m44, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO_REQUIRE_EQUAL(ops.size(), 4);
+
+    OCIO::ConstOpRcPtr op1 = ops[1];
+    OCIO::ConstOpRcPtr op2 = ops[2];
+    OCIO::ConstOpRcPtr op3 = ops[3];
+    OCIO_CHECK_ASSERT(!ops[0]->canCombineWith(op1));
+    OCIO_CHECK_ASSERT(!ops[1]->canCombineWith(op2));
+    OCIO_CHECK_ASSERT(!ops[2]->canCombineWith(op3));
+
+    OCIO::OpRcPtrVec combined;
+    OCIO_CHECK_THROW_WHAT(ops[2]->combineWith(combined, op3), OCIO::Exception,
+                          "LogOp can only be combined with a 32f diagonal MatrixOffsetOp");
+
+    // Only the 32f ops are combined.
+    const double scale2[4] = { 1.5, 0.75, 2.0, 1.0 };
+    OCIO::CreateScaleOp(ops, scale2, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::ConstOpRcPtr op4 = ops[4];
+    OCIO_CHECK_ASSERT(ops[0]->canCombineWith(op4));
+    ops[0]->setOutputBitDepth(OCIO::BIT_DEPTH_UINT10);
+    OCIO_CHECK_ASSERT(!ops[0]->canCombineWith(op4));
+}
+
 #endif // OCIO_UNIT_TEST
@@ -144,6 +144,16 @@ OCIO_NAMESPACE_ENTER
         }
     }
     
+    size_t Lut1D::getMemorySize() const
+    {
+        size_t size = sizeof(Lut1D);
+        for(int i=0; i<3; ++i)
+        {
+            size += luts[i].capacity() * sizeof(float);
+        }
+        return size;
+    }
+
     std::string Lut1D::getCacheID() const
     {
         AutoMutex lock(m_mutex);
@@ -503,6 +513,8 @@ OCIO_NAMESPACE_ENTER
 
             bool isSameType(ConstOpRcPtr & op) const override;
             bool isInverse(ConstOpRcPtr & op) const override;
+            bool canCombineWith(ConstOpRcPtr & op) const override;
+            void combineWith(OpRcPtrVec & ops, ConstOpRcPtr & secondOp) const override;
             bool hasChannelCrosstalk() const override;
             void finalize(FinalizationFlags fFlags) override;
 
@@ -553,6 +565,40 @@ OCIO_NAMESPACE_ENTER
             return false;
         }
 
+        // Only the forward LUTs are composed, the inverse LUTs keep their exact inversion.
+        bool Lut1DOp::canCombineWith(ConstOpRcPtr & op) const
+        {
+            ConstLut1DOpRcPtr typedRcPtr = DynamicPtrCast<const Lut1DOp>(op);
+            if (!typedRcPtr
+                || getDirection() != TRANSFORM_DIR_FORWARD
+                || typedRcPtr->getDirection() != TRANSFORM_DIR_FORWARD
+                || getOutputBitDepth() != typedRcPtr->getInputBitDepth())
+            {
+                return false;
+            }
+
+            ConstLut1DOpDataRcPtr lutData = typedRcPtr->lut1DData();
+            return lut1DData()->mayCompose(lutData);
+        }
+
+        void Lut1DOp::combineWith(OpRcPtrVec & ops, ConstOpRcPtr & secondOp) const
+        {
+            if (!canCombineWith(secondOp))
+            {
+                std::ostringstream os;
+                os << "Lut1DOp can only be combined with other forward ";
+                os << "Lut1DOps.  secondOp:" << secondOp->getInfo();
+                throw Exception(os.str().c_str());
+            }
+
+            ConstLut1DOpRcPtr typedRcPtr = DynamicPtrCast<const Lut1DOp>(secondOp);
+            ConstLut1DOpDataRcPtr secondData = typedRcPtr->lut1DData();
+
+            Lut1DOpDataRcPtr res = lut1DData()->clone();
+            Lut1DOpData::Compose(res, secondData, Lut1DOpData::COMPOSE_RESAMPLE_ADAPTIVE);
+            CreateLut1DOp(ops, res, TRANSFORM_DIR_FORWARD);
+        }
+
         bool Lut1DOp::hasChannelCrosstalk() const
         {
             return lut1DData()->hasChannelCrosstalk();
@@ -1896,6 +1942,64 @@ OCIO_ADD_TEST(Lut1D, lut_1d_compose_with_bit_depth)
     }
 }
 
+OCIO_ADD_TEST(Lut1D, combine_adaptive)
+{
+    OCIO::Lut1DOpDataRcPtr lut1 = std::make_shared<OCIO::Lut1DOpData>(5);
+    OCIO::Lut1DOpDataRcPtr lut2 = std::make_shared<OCIO::Lut1DOpData>(3);
+    const float values1[5] = { 0.0f, 0.4f, 0.6f, 0.75f, 1.0f };
+    const float values2[3] = { 0.1f, 0.2f, 0.9f };
+    for (unsigned long i = 0; i < 5; ++i)
+    {
+        lut1->getArray()[3 * i] = lut1->getArray()[3 * i + 1] = lut1->getArray()[3 * i + 2]
+            = values1[i];
+    }
+    for (unsigned long i = 0; i < 3; ++i)
+    {
+        lut2->getArray()[3 * i] = lut2->getArray()[3 * i + 1] = lut2->getArray()[3 * i + 2]
+            = values2[i];
+    }
+
+    OCIO::OpRcPtrVec ops;
+    OCIO_CHECK_NO_THROW(OCIO::CreateLut1DOp(ops, lut1, OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_CHECK_NO_THROW(OCIO::CreateLut1DOp(ops, lut2, OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO::OpRcPtrVec optOps = ops.clone();
+
+    // The lossless optimizations do not resample the LUTs.
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(optOps, OCIO::OPTIMIZATION_LOSSLESS));
+    OCIO_CHECK_EQUAL(optOps.size(), 2);
+
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(optOps, OCIO::OPTIMIZATION_DEFAULT));
+    OCIO_REQUIRE_EQUAL(optOps.size(), 1);
+    OCIO::ConstOpRcPtr op = optOps[0];
+    auto lut = OCIO::DynamicPtrCast<const OCIO::Lut1DOpData>(op->data());
+    OCIO_REQUIRE_ASSERT(lut);
+    OCIO_CHECK_ASSERT(!lut->isInputHalfDomain());
+    OCIO_CHECK_ASSERT(lut->getArray().getLength() < 65536);
+
+    float image[4 * 11];
+    float expected[4 * 11];
+    for (unsigned i = 0; i < 11; ++i)
+    {
+        image[4 * i] = image[4 * i + 1] = image[4 * i + 2] = i * 0.1f - 0.02f;
+        image[4 * i + 3] = 1.0f;
+    }
+    memcpy(expected, image, sizeof(image));
+
+    OCIO_CHECK_NO_THROW(OCIO::FinalizeOpVec(ops, OCIO::FINALIZATION_EXACT));
+    OCIO_CHECK_NO_THROW(Apply(ops, expected, 11));
+    OCIO_CHECK_NO_THROW(OCIO::FinalizeOpVec(optOps, OCIO::FINALIZATION_EXACT));
+    OCIO_CHECK_NO_THROW(Apply(optOps, image, 11));
+    for (unsigned i = 0; i < 4 * 11; ++i)
+    {
+        OCIO_CHECK_CLOSE(image[i], expected[i], 1e-5f);
+    }
+
+    // The inverse LUTs are not combined.
+    OCIO_CHECK_NO_THROW(OCIO::CreateLut1DOp(ops, lut1, OCIO::TRANSFORM_DIR_INVERSE));
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(ops, OCIO::OPTIMIZATION_DEFAULT));
+    OCIO_CHECK_EQUAL(ops.size(), 2);
+}
+
 OCIO_ADD_TEST(Lut1D, inverse_twice)
 {
     // Make a LUT that squares the input.
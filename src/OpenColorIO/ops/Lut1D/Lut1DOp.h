@@ -57,6 +57,9 @@ OCIO_NAMESPACE_ENTER
         std::string getCacheID() const;
         bool isNoOp() const;
 
+        // Approximate memory footprint in bytes.
+        size_t getMemorySize() const;
+
         void unfinalize();
 
         Lut1D & operator=(const Lut1D & l);
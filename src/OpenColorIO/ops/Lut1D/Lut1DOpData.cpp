@@ -1,6 +1,8 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <algorithm>
+#include <cmath>
 #include <sstream>
 #include <string.h>
 
@@ -21,6 +23,12 @@ OCIO_NAMESPACE_ENTER
 // Number of possible values for the Half domain.
 static const unsigned long HALF_DOMAIN_REQUIRED_ENTRIES = 65536;
 
+// Default maximum error of COMPOSE_RESAMPLE_ADAPTIVE (relative to the output range).
+static const double ADAPTIVE_COMPOSE_TOLERANCE = 1e-5;
+
+// Smallest LUT size tried by the adaptive composition (i.e. 2^5 + 1).
+static const unsigned long ADAPTIVE_COMPOSE_MIN_SIZE = 33;
+
 Lut1DOpData::Lut3by1DArray::Lut3by1DArray(BitDepth inBitDepth,
                                           BitDepth outBitDepth,
                                           HalfFlags halfFlags)
@@ -708,10 +716,13 @@ void Lut1DOpData::finalize()
     md5_state_t state;
     md5_byte_t digest[16];
 
+    // Read-only access, so interned values are not copied.
+    const Array::Values & values = static_cast<const Array &>(m_array).getValues();
+
     md5_init(&state);
     md5_append(&state,
-        (const md5_byte_t *)&(getArray().getValues()[0]),
-        (int)(getArray().getValues().size() * sizeof(float)));
+        (const md5_byte_t *)&(values[0]),
+        (int)(values.size() * sizeof(float)));
     md5_finish(&state, digest);
 
     std::ostringstream cacheIDStream;
@@ -876,6 +887,11 @@ void Lut1DOpData::Compose(Lut1DOpDataRcPtr & A,
         min_size = (unsigned long)GetBitDepthMaxValue(resampleDepth) + 1;
         break;
     }
+    case COMPOSE_RESAMPLE_ADAPTIVE:
+    {
+        ComposeAdaptive(A, B, ADAPTIVE_COMPOSE_TOLERANCE);
+        return;
+    }
 
     // TODO: May want to add another style which is the maximum of
     //       B size (careful of half domain), and in-depth ideal size.
@@ -919,6 +935,194 @@ void Lut1DOpData::Compose(Lut1DOpDataRcPtr & A,
     A->setHueAdjust(B->getHueAdjust());
 }
 
+namespace
+{
+Lut1DOpDataRcPtr MakeStandardDomain(ConstLut1DOpDataRcPtr & A, unsigned long size)
+{
+    // Identity LUT scaled to the input bit-depth of A so it could be composed with A.
+    return std::make_shared<Lut1DOpData>(A->getInputBitDepth(),
+                                         A->getInputBitDepth(),
+                                         A->getFormatMetadata(),
+                                         A->getInterpolation(),
+                                         Lut1DOpData::LUT_STANDARD,
+                                         size);
+}
+
+Lut1DOpDataRcPtr MakeHalfDomain(ConstLut1DOpDataRcPtr & A)
+{
+    Lut1DOpDataRcPtr domain
+        = std::make_shared<Lut1DOpData>(BIT_DEPTH_F16,
+                                        BIT_DEPTH_F16,
+                                        A->getFormatMetadata(),
+                                        A->getInterpolation(),
+                                        Lut1DOpData::LUT_INPUT_HALF_CODE);
+
+    // Scale the domain to the input bit-depth of A.
+    domain->setInputBitDepth(A->getInputBitDepth());
+    domain->setOutputBitDepth(A->getInputBitDepth());
+    return domain;
+}
+
+// Return true if the linear interpolation of the values at the even indices differs
+// from the values at the odd indices (i.e. the mid-points) by at most the tolerance.
+bool IsWithinTolerance(const Array::Values & values, unsigned long fineSize,
+                       double outScale, double tolerance)
+{
+    for (unsigned long idx = 1; idx < fineSize; idx += 2)
+    {
+        for (unsigned long c = 0; c < 3; ++c)
+        {
+            const double prev  = values[(idx - 1) * 3 + c];
+            const double next  = values[(idx + 1) * 3 + c];
+            const double error = std::fabs(values[idx * 3 + c] - (prev + next) * 0.5);
+
+            // Note: Also rejects NaNs.
+            if (!(error * outScale <= tolerance))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// A half domain samples [0, 1] more finely near 0 (e.g. for log or gamma curves) so it
+// may meet the tolerance where the biggest standard domain does not. Only [0, 1] is
+// checked as a standard domain A clamps its input. A must have a float input bit-depth.
+bool IsHalfDomainWithinTolerance(ConstLut1DOpDataRcPtr & A, const OpRcPtrVec & ops,
+                                 double outScale, double tolerance)
+{
+    // Half code of 1.0.
+    const unsigned long numCodes = 0x3C00 + 1;
+    const unsigned long fineSize = 2 * numCodes - 1;
+
+    Lut1DOpDataRcPtr fine = MakeStandardDomain(A, fineSize);
+
+    Array::Values & domain = fine->getArray().getValues();
+    for (unsigned long code = 0; code < numCodes; ++code)
+    {
+        half value; value.setBits((unsigned short)code);
+        const float in = (float)value;
+        for (unsigned long c = 0; c < 3; ++c)
+        {
+            domain[code * 6 + c] = in;
+            if (code > 0)
+            {
+                domain[code * 6 - 3 + c] = (domain[code * 6 - 6 + c] + in) * 0.5f;
+            }
+        }
+    }
+
+    Lut1DOpData::ComposeVec(fine, ops.clone());
+
+    const Array & fineArray = fine->getArray();
+    return IsWithinTolerance(fineArray.getValues(), fineSize, outScale, tolerance);
+}
+}
+
+// The error of the linear interpolation is estimated at the mid-points between the
+// entries: a domain of size 2*N-1 holds the N entries of the candidate LUT at its even
+// indices and the mid-points at its odd indices, so a single evaluation of the ops
+// gives both. The size is then almost doubled until the error meets the tolerance.
+void Lut1DOpData::ComposeAdaptive(Lut1DOpDataRcPtr & A,
+                                  ConstLut1DOpDataRcPtr & B,
+                                  double tolerance,
+                                  unsigned long maxSize)
+{
+    if (A->getOutputBitDepth() != B->getInputBitDepth())
+    {
+        throw Exception("A bit-depth mismatch forbids the composition of 1D LUTs");
+    }
+
+    OpRcPtrVec ops;
+
+    // Interpolate through both LUTs.
+    // Note: The ops are cloned for each evaluation as it resets their bit-depths.
+    Lut1DOpDataRcPtr aCloned = A->clone();
+    CreateLut1DOp(ops, aCloned, TRANSFORM_DIR_FORWARD);
+    Lut1DOpDataRcPtr bCloned = B->clone();
+    CreateLut1DOp(ops, bCloned, TRANSFORM_DIR_FORWARD);
+
+    ConstLut1DOpDataRcPtr constA = A;
+
+    const double outScale = 1.0 / GetBitDepthMaxValue(B->getOutputBitDepth());
+
+    Lut1DOpDataRcPtr result;
+
+    if (A->isInputHalfDomain())
+    {
+        // A standard domain would clamp the extended range of A.
+        result = MakeHalfDomain(constA);
+        ComposeVec(result, ops);
+
+        result->getFormatMetadata().combine(B->getFormatMetadata());
+        result->setHueAdjust(B->getHueAdjust());
+
+        A = result;
+        return;
+    }
+
+    // Beyond the look-up size of an integer input bit-depth, a bigger LUT is useless.
+    const unsigned long defaultMaxSize = IsFloatBitDepth(A->getInputBitDepth())
+        ? HALF_DOMAIN_REQUIRED_ENTRIES
+        : GetLutIdealSize(A->getInputBitDepth());
+    if (maxSize == 0 || maxSize > defaultMaxSize)
+    {
+        maxSize = defaultMaxSize;
+    }
+
+    // The half domain has the size of the biggest standard domain of a float input.
+    const bool mayUseHalfDomain = IsFloatBitDepth(A->getInputBitDepth())
+                                  && maxSize == HALF_DOMAIN_REQUIRED_ENTRIES;
+
+    for (unsigned long size = ADAPTIVE_COMPOSE_MIN_SIZE; !result; size = 2 * size - 1)
+    {
+        const bool lastSize = size >= maxSize;
+        if (lastSize && !mayUseHalfDomain)
+        {
+            result = MakeStandardDomain(constA, maxSize);
+            ComposeVec(result, ops.clone());
+            break;
+        }
+        size = std::min(size, maxSize);
+
+        const unsigned long fineSize = 2 * size - 1;
+        Lut1DOpDataRcPtr fine = MakeStandardDomain(constA, fineSize);
+        ComposeVec(fine, ops.clone());
+
+        const Array & fineArray = fine->getArray();
+        const Array::Values & values = fineArray.getValues();
+
+        if (IsWithinTolerance(values, fineSize, outScale, tolerance))
+        {
+            // Keep the even indices i.e. the candidate LUT.
+            result = MakeStandardDomain(constA, size);
+            Array::Values & resValues = result->getArray().getValues();
+            for (unsigned long idx = 0; idx < size; ++idx)
+            {
+                for (unsigned long c = 0; c < 3; ++c)
+                {
+                    resValues[idx * 3 + c] = values[idx * 6 + c];
+                }
+            }
+            result->OpData::setOutputBitDepth(fine->getOutputBitDepth());
+        }
+        else if (lastSize)
+        {
+            // A half domain is only used when needed, as its entries are unevenly spaced.
+            result = IsHalfDomainWithinTolerance(constA, ops, outScale, tolerance)
+                     ? MakeHalfDomain(constA)
+                     : MakeStandardDomain(constA, maxSize);
+            ComposeVec(result, ops.clone());
+        }
+    }
+
+    result->getFormatMetadata().combine(B->getFormatMetadata());
+    result->setHueAdjust(B->getHueAdjust());
+
+    A = result;
+}
+
 // The domain to use for the FastLut is a challenging problem since we don't
 // know the input and output color space of the LUT.  In particular, we don't
 // know if a half or normal domain would be better.  For now, we use a
@@ -975,7 +1179,19 @@ Lut1DOpDataRcPtr Lut1DOpData::MakeFastLut1DFromInverse(ConstLut1DOpDataRcPtr & l
     // Change inv style to INV_EXACT to avoid recursion.
     LutStyleGuard<Lut1DOpData> guard(*lut);
 
-    Compose(newDomainLut, lut, COMPOSE_RESAMPLE_NO);
+    // The CPU interpolates a 32f input through the fast LUT (any other input bit-depth
+    // is resampled for a look-up by the renderer), so the domain only needs to be fine
+    // enough to meet the tolerance, but never bigger than the heuristic one.
+    if (!forGPU && !lut->hasExtendedDomain() && lut->getInputBitDepth() == BIT_DEPTH_F32)
+    {
+        ComposeAdaptive(newDomainLut, lut,
+                        ADAPTIVE_COMPOSE_TOLERANCE,
+                        newDomainLut->getArray().getLength());
+    }
+    else
+    {
+        Compose(newDomainLut, lut, COMPOSE_RESAMPLE_NO);
+    }
 
     return newDomainLut;
 }
@@ -1871,6 +2087,235 @@ OCIO_ADD_TEST(Lut1DOpData, lut_1d_compose_sc)
     }
 }
 
+namespace
+{
+OCIO::Lut1DOpDataRcPtr MakeCurveLut(OCIO::BitDepth inBD, unsigned long size, double power)
+{
+    auto lut = std::make_shared<OCIO::Lut1DOpData>(inBD,
+                                                   OCIO::BIT_DEPTH_F32,
+                                                   OCIO::FormatMetadataImpl(OCIO::METADATA_ROOT),
+                                                   OCIO::INTERP_LINEAR,
+                                                   OCIO::Lut1DOpData::LUT_STANDARD,
+                                                   size);
+    auto & values = lut->getArray().getValues();
+    for (unsigned long idx = 0; idx < size; ++idx)
+    {
+        const float val = (float)std::pow((double)idx / (size - 1), power);
+        values[idx * 3 + 0] = val;
+        values[idx * 3 + 1] = val * 0.5f;
+        values[idx * 3 + 2] = 1.0f - val;
+    }
+    return lut;
+}
+}
+
+OCIO_ADD_TEST(Lut1DOpData, lut_1d_compose_adaptive)
+{
+    {
+        // Linear LUTs only need the smallest size.
+        OCIO::Lut1DOpDataRcPtr lut1 = MakeCurveLut(OCIO::BIT_DEPTH_F32, 2, 1.0);
+        OCIO::ConstLut1DOpDataRcPtr lut2 = MakeCurveLut(OCIO::BIT_DEPTH_F32, 2, 1.0);
+
+        OCIO_CHECK_NO_THROW(OCIO::Lut1DOpData::Compose(
+            lut1, lut2, OCIO::Lut1DOpData::COMPOSE_RESAMPLE_ADAPTIVE));
+        OCIO_CHECK_EQUAL(lut1->getArray().getLength(), 33);
+        OCIO_CHECK_EQUAL(lut1->getInputBitDepth(), OCIO::BIT_DEPTH_F32);
+        OCIO_CHECK_EQUAL(lut1->getOutputBitDepth(), OCIO::BIT_DEPTH_F32);
+
+        const auto & values = lut1->getArray().getValues();
+        OCIO_CHECK_CLOSE(values[16 * 3 + 0], 0.5f, 1e-6f);
+        OCIO_CHECK_CLOSE(values[16 * 3 + 1], 0.125f, 1e-6f);
+        OCIO_CHECK_CLOSE(values[32 * 3 + 0], 1.0f, 1e-6f);
+        OCIO_CHECK_CLOSE(values[32 * 3 + 2], 1.0f, 1e-6f);
+    }
+
+    {
+        // A curve needs a bigger LUT but far from the 65536 entries of
+        // COMPOSE_RESAMPLE_BIG, and still meets the tolerance.
+        OCIO::Lut1DOpDataRcPtr lut1 = MakeCurveLut(OCIO::BIT_DEPTH_F32, 2, 1.0);
+        OCIO::Lut1DOpDataRcPtr lut2 = MakeCurveLut(OCIO::BIT_DEPTH_F32, 4096, 3.0);
+
+        OCIO::OpRcPtrVec refOps;
+        OCIO::CreateLut1DOp(refOps, lut1, OCIO::TRANSFORM_DIR_FORWARD);
+        OCIO::CreateLut1DOp(refOps, lut2, OCIO::TRANSFORM_DIR_FORWARD);
+        refOps = refOps.clone();
+
+        OCIO::ConstLut1DOpDataRcPtr lut2C = lut2;
+        OCIO_CHECK_NO_THROW(OCIO::Lut1DOpData::ComposeAdaptive(lut1, lut2C, 1e-5));
+        OCIO_CHECK_LT(lut1->getArray().getLength(), 2048);
+        OCIO_CHECK_GT(lut1->getArray().getLength(), 33);
+
+        OCIO::OpRcPtrVec ops;
+        OCIO::CreateLut1DOp(ops, lut1, OCIO::TRANSFORM_DIR_FORWARD);
+
+        const long numPixels = 1000;
+        // EvalTransform processes RGB values.
+        std::vector<float> src(numPixels * 3), res(numPixels * 3), ref(numPixels * 3);
+        for (long idx = 0; idx < numPixels * 3; ++idx)
+        {
+            src[idx] = (float)idx / (numPixels * 3 - 1);
+        }
+
+        OCIO::EvalTransform(src.data(), res.data(), numPixels, ops);
+        OCIO::EvalTransform(src.data(), ref.data(), numPixels, refOps);
+
+        for (long idx = 0; idx < numPixels * 3; ++idx)
+        {
+            OCIO_CHECK_CLOSE(res[idx], ref[idx], 2e-5f);
+        }
+    }
+
+    {
+        // For an integer input bit-depth, the size is capped by the look-up size.
+        OCIO::Lut1DOpDataRcPtr lut1 =
+            std::make_shared<OCIO::Lut1DOpData>(OCIO::BIT_DEPTH_UINT10,
+                                                OCIO::BIT_DEPTH_F32,
+                                                OCIO::Lut1DOpData::LUT_STANDARD);
+        OCIO::ConstLut1DOpDataRcPtr lut2 = MakeCurveLut(OCIO::BIT_DEPTH_F32, 4096, 1.0 / 2.2);
+
+        OCIO_CHECK_NO_THROW(OCIO::Lut1DOpData::Compose(
+            lut1, lut2, OCIO::Lut1DOpData::COMPOSE_RESAMPLE_ADAPTIVE));
+        OCIO_CHECK_EQUAL(lut1->getArray().getLength(), 1024);
+        OCIO_CHECK_EQUAL(lut1->getInputBitDepth(), OCIO::BIT_DEPTH_UINT10);
+        OCIO_CHECK_ASSERT(lut1->mayLookup(OCIO::BIT_DEPTH_UINT10));
+    }
+
+    {
+        // A half-domain LUT keeps its domain.
+        OCIO::Lut1DOpDataRcPtr lut1 =
+            std::make_shared<OCIO::Lut1DOpData>(OCIO::BIT_DEPTH_F16,
+                                                OCIO::BIT_DEPTH_F32,
+                                                OCIO::Lut1DOpData::LUT_INPUT_HALF_CODE);
+        OCIO::ConstLut1DOpDataRcPtr lut2 = MakeCurveLut(OCIO::BIT_DEPTH_F32, 2, 1.0);
+
+        OCIO_CHECK_NO_THROW(OCIO::Lut1DOpData::Compose(
+            lut1, lut2, OCIO::Lut1DOpData::COMPOSE_RESAMPLE_ADAPTIVE));
+        OCIO_CHECK_EQUAL(lut1->getArray().getLength(), 65536);
+        OCIO_CHECK_ASSERT(lut1->isInputHalfDomain());
+        OCIO_CHECK_EQUAL(lut1->getInputBitDepth(), OCIO::BIT_DEPTH_F16);
+    }
+
+    {
+        // A curve too steep near 0 for the biggest standard domain gets a half domain
+        // (i.e. a square root, linear below 2^-16 to have a finite slope).
+        OCIO::Lut1DOpDataRcPtr lut1 =
+            std::make_shared<OCIO::Lut1DOpData>(OCIO::BIT_DEPTH_F32,
+                                                OCIO::BIT_DEPTH_F32,
+                                                OCIO::FormatMetadataImpl(OCIO::METADATA_ROOT),
+                                                OCIO::INTERP_LINEAR,
+                                                OCIO::Lut1DOpData::LUT_STANDARD,
+                                                2);
+        OCIO::Lut1DOpDataRcPtr lut2 =
+            std::make_shared<OCIO::Lut1DOpData>(OCIO::BIT_DEPTH_F32,
+                                                OCIO::BIT_DEPTH_F32,
+                                                OCIO::FormatMetadataImpl(OCIO::METADATA_ROOT),
+                                                OCIO::INTERP_LINEAR,
+                                                OCIO::Lut1DOpData::LUT_INPUT_HALF_CODE);
+        auto & values = lut2->getArray().getValues();
+        for (unsigned long code = 0; code < 65536; ++code)
+        {
+            half h; h.setBits((unsigned short)code);
+            const float in = (float)h;
+            const float val = in > 1.0f ? 1.0f
+                              : in > 0.0000152587890625f ? std::sqrt(in)
+                              : in > 0.0f ? in * 256.0f : 0.0f;
+            values[code * 3 + 0] = values[code * 3 + 1] = values[code * 3 + 2] = val;
+        }
+
+        OCIO::OpRcPtrVec refOps;
+        OCIO::CreateLut1DOp(refOps, lut1, OCIO::TRANSFORM_DIR_FORWARD);
+        OCIO::CreateLut1DOp(refOps, lut2, OCIO::TRANSFORM_DIR_FORWARD);
+        refOps = refOps.clone();
+
+        OCIO::ConstLut1DOpDataRcPtr lut2C = lut2;
+        OCIO_CHECK_NO_THROW(OCIO::Lut1DOpData::Compose(
+            lut1, lut2C, OCIO::Lut1DOpData::COMPOSE_RESAMPLE_ADAPTIVE));
+        OCIO_CHECK_ASSERT(lut1->isInputHalfDomain());
+        OCIO_CHECK_EQUAL(lut1->getInputBitDepth(), OCIO::BIT_DEPTH_F32);
+
+        OCIO::OpRcPtrVec ops;
+        OCIO::CreateLut1DOp(ops, lut1, OCIO::TRANSFORM_DIR_FORWARD);
+
+        const long numPixels = 1000;
+        std::vector<float> src(numPixels * 3), res(numPixels * 3), ref(numPixels * 3);
+        for (long idx = 0; idx < numPixels * 3; ++idx)
+        {
+            // Also check the clamping of the input outside [0, 1].
+            src[idx] = std::pow((float)idx / (numPixels * 3 - 1), 4.0f) * 1.2f - 0.1f;
+        }
+
+        OCIO::EvalTransform(src.data(), res.data(), numPixels, ops);
+        OCIO::EvalTransform(src.data(), ref.data(), numPixels, refOps);
+
+        for (long idx = 0; idx < numPixels * 3; ++idx)
+        {
+            OCIO_CHECK_CLOSE(res[idx], ref[idx], 1e-5f);
+        }
+    }
+}
+
+OCIO_ADD_TEST(Lut1DOpData, fast_lut_1d_from_inverse_adaptive)
+{
+    // A smooth increasing curve (i.e. 0.5x + 0.5x^2).
+    const unsigned long size = 1024;
+    auto lut = std::make_shared<OCIO::Lut1DOpData>(OCIO::BIT_DEPTH_F32,
+                                                   OCIO::BIT_DEPTH_F32,
+                                                   OCIO::FormatMetadataImpl(OCIO::METADATA_ROOT),
+                                                   OCIO::INTERP_LINEAR,
+                                                   OCIO::Lut1DOpData::LUT_STANDARD,
+                                                   size);
+    auto & values = lut->getArray().getValues();
+    for (unsigned long idx = 0; idx < size; ++idx)
+    {
+        const double x = (double)idx / (size - 1);
+        const float val = (float)(0.5 * x + 0.5 * x * x);
+        values[idx * 3 + 0] = val;
+        values[idx * 3 + 1] = val;
+        values[idx * 3 + 2] = val;
+    }
+
+    OCIO::Lut1DOpDataRcPtr invLut = lut->inverse();
+    // The heuristic domain of a 16i LUT has 65536 entries.
+    invLut->setFileOutputBitDepth(OCIO::BIT_DEPTH_UINT16);
+    OCIO::ConstLut1DOpDataRcPtr invLutC = invLut;
+
+    OCIO::Lut1DOpDataRcPtr fastLut;
+    OCIO_CHECK_NO_THROW(fastLut = OCIO::Lut1DOpData::MakeFastLut1DFromInverse(invLutC, true));
+    OCIO_CHECK_EQUAL(fastLut->getArray().getLength(), 65536);
+
+    // The CPU uses a much smaller domain.
+    OCIO_CHECK_NO_THROW(fastLut = OCIO::Lut1DOpData::MakeFastLut1DFromInverse(invLutC, false));
+    OCIO_CHECK_LT(fastLut->getArray().getLength(), 4096);
+    OCIO_CHECK_EQUAL(fastLut->getInputBitDepth(), OCIO::BIT_DEPTH_F32);
+    OCIO_CHECK_EQUAL(fastLut->getOutputBitDepth(), OCIO::BIT_DEPTH_F32);
+    OCIO_CHECK_EQUAL(fastLut->getDirection(), OCIO::TRANSFORM_DIR_FORWARD);
+
+    // Compare to the exact inverse.
+    OCIO::Lut1DOpDataRcPtr exactLut = invLut->clone();
+    exactLut->setInversionQuality(OCIO::LUT_INVERSION_EXACT);
+
+    OCIO::OpRcPtrVec refOps;
+    OCIO::CreateLut1DOp(refOps, exactLut, OCIO::TRANSFORM_DIR_FORWARD);
+
+    OCIO::OpRcPtrVec ops;
+    OCIO::CreateLut1DOp(ops, fastLut, OCIO::TRANSFORM_DIR_FORWARD);
+
+    const long numPixels = 1000;
+    std::vector<float> src(numPixels * 3), res(numPixels * 3), ref(numPixels * 3);
+    for (long idx = 0; idx < numPixels * 3; ++idx)
+    {
+        src[idx] = (float)idx / (numPixels * 3 - 1);
+    }
+
+    OCIO::EvalTransform(src.data(), res.data(), numPixels, ops);
+    OCIO::EvalTransform(src.data(), ref.data(), numPixels, refOps);
+
+    for (long idx = 0; idx < numPixels * 3; ++idx)
+    {
+        OCIO_CHECK_CLOSE(res[idx], ref[idx], 2e-5f);
+    }
+}
+
 namespace
 {
 const char uid[] = "uid";
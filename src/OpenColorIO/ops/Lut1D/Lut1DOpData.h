@@ -64,7 +64,8 @@ public:
     {
         COMPOSE_RESAMPLE_NO = 0,      // Preserve original domain.
         COMPOSE_RESAMPLE_INDEPTH = 1, // InDepth controls min size.
-        COMPOSE_RESAMPLE_BIG = 2      // Min size is 65536.
+        COMPOSE_RESAMPLE_BIG = 2,     // Min size is 65536.
+        COMPOSE_RESAMPLE_ADAPTIVE = 3 // Smallest size meeting the default tolerance.
     };
 
     // Calculate a new LUT by evaluating a new domain (A) through a set of ops (B).
@@ -82,6 +83,19 @@ public:
                         ConstLut1DOpDataRcPtr & B,
                         ComposeMethod compFlag);
 
+    // Same as above but the result LUT has the smallest standard domain for which
+    // interpolating the result differs from the evaluation of the pair of ops by at most
+    // the tolerance (relative to the output range). The size is capped by the size needed
+    // to do a look-up for integer input bit-depths and by 65536 otherwise, or by maxSize
+    // when it is smaller and not zero. For a float input bit-depth without maxSize, a half
+    // domain is used instead when it meets the tolerance and the biggest standard domain
+    // does not. The result of a half-domain LUT A always has a half domain since a
+    // standard domain could not represent it.
+    static void ComposeAdaptive(Lut1DOpDataRcPtr & A,
+                                ConstLut1DOpDataRcPtr & B,
+                                double tolerance,
+                                unsigned long maxSize = 0);
+
     // Return the size to use for an identity LUT of the specified bit-depth.
     static unsigned long GetLutIdealSize(BitDepth incomingBitDepth);
 
@@ -203,6 +217,8 @@ public:
     // Make a forward Lut1DOpData that approximates the exact inverse
     // Lut1DOpData to be used for the fast rendering style.
     // LUT has to be inverse or the function will throw.
+    // For the CPU and a 32f input, the domain is the smallest one meeting the default
+    // tolerance of the adaptive composition (see ComposeAdaptive).
     static Lut1DOpDataRcPtr MakeFastLut1DFromInverse(ConstLut1DOpDataRcPtr & lut, bool forGPU);
 
     inline const ComponentProperties & getRedProperties() const
@@ -36,6 +36,11 @@ Lut3DRcPtr Lut3D::Create()
     return Lut3DRcPtr(new Lut3D());
 }
 
+size_t Lut3D::getMemorySize() const
+{
+    return sizeof(Lut3D) + lut.capacity() * sizeof(float);
+}
+
 std::string Lut3D::getCacheID() const
 {
     AutoMutex lock(m_cacheidMutex);
@@ -30,6 +30,9 @@ OCIO_NAMESPACE_ENTER
 
         std::string getCacheID() const;
 
+        // Approximate memory footprint in bytes.
+        size_t getMemorySize() const;
+
     private:
         Lut3D();
         mutable std::string m_cacheID;
@@ -2,6 +2,7 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 #include <algorithm>
+#include <map>
 #include <math.h>
 #include <stdint.h>
 #include <vector>
@@ -10,6 +11,7 @@
 
 #include "BitDepthUtils.h"
 #include "MathUtils.h"
+#include "Mutex.h"
 #include "ops/Lut3D/Lut3DOpCPU.h"
 #include "OpTools.h"
 #include "Platform.h"
@@ -33,11 +35,15 @@ protected:
     // in order to be able to load the LUT using _mm_load_ps.
     float* createOptLut(const Array::Values& lut) const;
 
+    // The renderers of the interned LUTs share their optimized LUT.
+    OCIO_SHARED_PTR<const float> getSharedOptLut(ConstLut3DOpDataRcPtr & lut) const;
+
 protected:
     // Keep all these values because they are invariant during the
     // processing. So to slim the processing code, these variables
     // are computed in the constructor.
-    float*        m_optLut;
+    const float*  m_optLut;
+    OCIO_SHARED_PTR<const float> m_optLutStorage;
     unsigned long m_dim;
     float         m_step;
     float         m_maxIdx;
@@ -246,7 +252,7 @@ inline __m128i GetLut3DIndices(const __m128i &idxR,
     return _mm_slli_epi32(r, 2);
 }
 
-inline void LookupNearest4(float* optLut,
+inline void LookupNearest4(const float* optLut,
                            const __m128i &rIndices,
                            const __m128i &gIndices,
                            const __m128i &bIndices,
@@ -311,13 +317,73 @@ BaseLut3DRenderer::BaseLut3DRenderer(ConstLut3DOpDataRcPtr & lut)
 
 BaseLut3DRenderer::~BaseLut3DRenderer()
 {
+}
+
+namespace
+{
+void FreeOptLut(const float * optLut)
+{
 #ifdef USE_SSE
-    Platform::AlignedFree(m_optLut);
+    Platform::AlignedFree(const_cast<float *>(optLut));
 #else
-    free(m_optLut);
+    free(const_cast<float *>(optLut));
 #endif
 }
 
+// Optimized LUT of the interned LUT values (i.e. immutable while alive).
+struct SharedOptLut
+{
+    std::weak_ptr<const Array::Values> m_values;
+    std::weak_ptr<const float> m_optLut;
+};
+
+Mutex g_sharedOptLutsMutex;
+std::map<const Array::Values *, SharedOptLut> g_sharedOptLuts;
+// Number of entries after the last removal of the released values.
+size_t g_sharedOptLutsSweepSize = 64;
+}
+
+OCIO_SHARED_PTR<const float> BaseLut3DRenderer::getSharedOptLut(ConstLut3DOpDataRcPtr & lut) const
+{
+    const Array & array = lut->getArray();
+    if (!array.isInterned())
+    {
+        return OCIO_SHARED_PTR<const float>(createOptLut(array.getValues()), FreeOptLut);
+    }
+
+    OCIO_SHARED_PTR<const Array::Values> values = array.getSharedValues();
+
+    AutoMutex lock(g_sharedOptLutsMutex);
+
+    // As the values are still alive, the address was not reused by other values.
+    SharedOptLut & shared = g_sharedOptLuts[values.get()];
+    if (shared.m_values.lock() == values)
+    {
+        OCIO_SHARED_PTR<const float> optLut = shared.m_optLut.lock();
+        if (optLut)
+        {
+            return optLut;
+        }
+    }
+
+    OCIO_SHARED_PTR<const float> optLut(createOptLut(*values), FreeOptLut);
+    shared.m_values = values;
+    shared.m_optLut = optLut;
+
+    // Remove the entries of the released values once the map doubled in size, so the
+    // cost of the sweep is amortized over the misses.
+    if (g_sharedOptLuts.size() > 2 * g_sharedOptLutsSweepSize)
+    {
+        for (auto it = g_sharedOptLuts.begin(); it != g_sharedOptLuts.end(); )
+        {
+            it = it->second.m_values.expired() ? g_sharedOptLuts.erase(it) : ++it;
+        }
+        g_sharedOptLutsSweepSize = std::max(g_sharedOptLuts.size(), size_t(64));
+    }
+
+    return optLut;
+}
+
 void BaseLut3DRenderer::updateData(ConstLut3DOpDataRcPtr & lut)
 {
     m_alphaScale = (float)(GetBitDepthMaxValue(lut->getOutputBitDepth()))
@@ -330,12 +396,8 @@ void BaseLut3DRenderer::updateData(ConstLut3DOpDataRcPtr & lut)
     m_step = ((float)m_dim - 1.0f)
              / (float)GetBitDepthMaxValue(lut->getInputBitDepth());
 
-#ifdef USE_SSE
-    Platform::AlignedFree(m_optLut);
-#else
-    free(m_optLut);
-#endif
-    m_optLut = createOptLut(lut->getArray().getValues());
+    m_optLutStorage = getSharedOptLut(lut);
+    m_optLut = m_optLutStorage.get();
 }
 
 #ifdef USE_SSE
@@ -2015,4 +2077,29 @@ OCIO_ADD_TEST(Lut3DRenderer, nan_tetra_test)
     Lut3DRendererNaNTest(OCIO::INTERP_TETRAHEDRAL);
 }
 
+OCIO_ADD_TEST(Lut3DRenderer, shared_opt_lut)
+{
+    OCIO::FormatMetadataImpl metadata(OCIO::METADATA_ROOT);
+
+    // The entries of the released LUTs do not accumulate.
+    for (int i = 0; i < 1000; ++i)
+    {
+        OCIO::Lut3DOpDataRcPtr lut =
+            std::make_shared<OCIO::Lut3DOpData>(OCIO::BIT_DEPTH_F32,
+                                                OCIO::BIT_DEPTH_F32,
+                                                metadata,
+                                                OCIO::INTERP_LINEAR,
+                                                2);
+        lut->getArray()[0] = (float)i;
+        lut->getArray().intern();
+
+        OCIO::ConstLut3DOpDataRcPtr lutConst = lut;
+        OCIO::GetLut3DRenderer(lutConst);
+    }
+
+    OCIO::AutoMutex lock(OCIO::g_sharedOptLutsMutex);
+    OCIO_CHECK_ASSERT(OCIO::g_sharedOptLuts.size() <= 2 * OCIO::g_sharedOptLutsSweepSize);
+    OCIO_CHECK_ASSERT(OCIO::g_sharedOptLutsSweepSize < 1000);
+}
+
 #endif
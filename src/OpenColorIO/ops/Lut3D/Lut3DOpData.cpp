@@ -588,10 +588,13 @@ void Lut3DOpData::finalize()
     md5_state_t state;
     md5_byte_t digest[16];
 
+    // Read-only access, so interned values are not copied.
+    const Array::Values & values = static_cast<const Array &>(m_array).getValues();
+
     md5_init(&state);
     md5_append(&state,
-               (const md5_byte_t *)&(getArray().getValues()[0]),
-               (int)(getArray().getValues().size() * sizeof(float)));
+               (const md5_byte_t *)&(values[0]),
+               (int)(values.size() * sizeof(float)));
     md5_finish(&state, digest);
 
     std::ostringstream cacheIDStream;
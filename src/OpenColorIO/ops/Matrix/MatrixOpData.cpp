@@ -121,8 +121,8 @@ MatrixOpData::MatrixArrayPtr
 {
     // Use operator= to make sure we have a 4x4 copy
     // of the original matrices.
-    MatrixArray A_4x4 = *this;
-    MatrixArray B_4x4 = B;
+    const MatrixArray A_4x4 = *this;
+    const MatrixArray B_4x4 = B;
     const ArrayDouble::Values & Avals = A_4x4.getValues();
     const ArrayDouble::Values & Bvals = B_4x4.getValues();
     const unsigned long dim = 4;
@@ -383,7 +383,7 @@ void MatrixOpData::MatrixArray::fill()
 
 void MatrixOpData::MatrixArray::expandFrom3x3To4x4()
 {
-    const Values oldValues = getValues();
+    const Values oldValues = static_cast<const ArrayDouble &>(*this).getValues();
 
     resize(4, 4);
 
@@ -632,6 +632,21 @@ bool MatrixOpData::isDiagonal() const
     return true;
 }
 
+void MatrixOpData::getDiagonalValues(double(&scale)[4], double(&offset)[4]) const
+{
+    if (!isDiagonal() || getArray().getLength() != 4)
+    {
+        throw Exception("MatrixOpData: the matrix is not a 4x4 diagonal matrix.");
+    }
+
+    const ArrayDouble::Values & m = getArray().getValues();
+    for (unsigned long idx = 0; idx<4; ++idx)
+    {
+        scale[idx]  = m[idx * 5];
+        offset[idx] = m_offsets[idx];
+    }
+}
+
 bool MatrixOpData::hasAlpha() const
 {
     const ArrayDouble & a = getArray();
@@ -936,9 +951,10 @@ void MatrixOpData::finalize()
     md5_byte_t digest[16];
 
     // TODO: array and offset do not require double precison in cache.
+    const ArrayDouble & array = m_array;
     md5_init(&state);
     md5_append(&state,
-        (const md5_byte_t *)&(getArray().getValues()[0]),
+        (const md5_byte_t *)&(array.getValues()[0]),
         (int)(16 * sizeof(double)));
     md5_append(&state,
         (const md5_byte_t *)getOffsets().getValues(),
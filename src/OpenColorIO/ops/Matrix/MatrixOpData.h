@@ -175,6 +175,10 @@ public:
     // Is it a diagonal matrix (off-diagonal coefs are 0)?
     bool isDiagonal() const;
 
+    // Get the per-channel scale & offset of a diagonal matrix.
+    // Note: Throws if the matrix is not diagonal.
+    void getDiagonalValues(double(&scale)[4], double(&offset)[4]) const;
+
     inline bool hasOffsets() const { return m_offsets.isNotNull(); }
 
     bool hasAlpha() const;
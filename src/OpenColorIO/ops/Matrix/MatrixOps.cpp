@@ -2,6 +2,7 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 
+#include <cmath>
 #include <cstring>
 #include <sstream>
 
@@ -11,6 +12,11 @@
 #include "GpuShaderUtils.h"
 #include "HashUtils.h"
 #include "MathUtils.h"
+#include "ops/Exponent/ExponentOps.h"
+#include "ops/Gamma/GammaOpData.h"
+#include "ops/Gamma/GammaOps.h"
+#include "ops/Log/LogOpData.h"
+#include "ops/Log/LogOps.h"
 #include "ops/Matrix/MatrixOpCPU.h"
 #include "ops/Matrix/MatrixOps.h"
 
@@ -65,11 +71,24 @@ OCIO_NAMESPACE_ENTER
 
             void extractGpuShaderInfo(GpuShaderDescRcPtr & shaderDesc) const override;
 
+            // Get the per-channel scale & offset, in the forward direction, of a diagonal
+            // matrix processing 32f values. Returns false if the matrix is not such a matrix.
+            bool getDiagonalValues(double(&scale)[4], double(&offset)[4]) const;
+
+            // Same as above but for a matrix leaving alpha unchanged and with non-null
+            // RGB scales i.e. a matrix which could be folded into a log.
+            bool getRGBScaleOffset(double(&scale)[3], double(&offset)[3]) const;
+
         protected:
             ConstMatrixOpDataRcPtr matrixData() const { return DynamicPtrCast<const MatrixOpData>(data()); }
             MatrixOpDataRcPtr matrixData() { return DynamicPtrCast<MatrixOpData>(data()); }
 
         private:
+            // A diagonal matrix followed by a power function (i.e. an exponent or a basic gamma)
+            // is swapped so that the scale is applied after the power function. Returns false
+            // if the op is not a power function or if the swap would not be exact.
+            bool getPowerExponents(ConstOpRcPtr & op, double(&exp4)[4]) const;
+
             TransformDirection m_direction;
         };
 
@@ -145,13 +164,169 @@ OCIO_NAMESPACE_ENTER
             return false;
         }
 
+        bool MatrixOffsetOp::getDiagonalValues(double(&scale)[4], double(&offset)[4]) const
+        {
+            if (getInputBitDepth() != BIT_DEPTH_F32 || getOutputBitDepth() != BIT_DEPTH_F32
+                || !matrixData()->isDiagonal())
+            {
+                return false;
+            }
+
+            matrixData()->getDiagonalValues(scale, offset);
+
+            if (m_direction == TRANSFORM_DIR_INVERSE)
+            {
+                for (unsigned idx = 0; idx < 4; ++idx)
+                {
+                    if (scale[idx] == 0.0)
+                    {
+                        return false;
+                    }
+                    scale[idx]  = 1.0 / scale[idx];
+                    offset[idx] = -offset[idx] * scale[idx];
+                }
+            }
+
+            return true;
+        }
+
+        bool MatrixOffsetOp::getRGBScaleOffset(double(&scale)[3], double(&offset)[3]) const
+        {
+            double scale4[4], offset4[4];
+            if (!getDiagonalValues(scale4, offset4) || scale4[3] != 1.0 || offset4[3] != 0.0)
+            {
+                return false;
+            }
+
+            for (unsigned idx = 0; idx < 3; ++idx)
+            {
+                if (scale4[idx] == 0.0)
+                {
+                    return false;
+                }
+                scale[idx]  = scale4[idx];
+                offset[idx] = offset4[idx];
+            }
+
+            return true;
+        }
+
+        bool MatrixOffsetOp::getPowerExponents(ConstOpRcPtr & op, double(&exp4)[4]) const
+        {
+            if (op->getInputBitDepth() != BIT_DEPTH_F32 || op->getOutputBitDepth() != BIT_DEPTH_F32)
+            {
+                return false;
+            }
+
+            double scale[4], offset[4];
+            if (!getDiagonalValues(scale, offset))
+            {
+                return false;
+            }
+
+            // As pow(max(0, s*x), e) == pow(s, e) * pow(max(0, x), e) only holds for
+            // a positive scale, the matrix must be a pure positive scale.
+            for (unsigned idx = 0; idx < 4; ++idx)
+            {
+                if (offset[idx] != 0.0 || scale[idx] <= 0.0)
+                {
+                    return false;
+                }
+            }
+
+            ConstOpDataRcPtr opData = op->data();
+            if (opData->getType() == OpData::ExponentType)
+            {
+                auto expData = DynamicPtrCast<const ExponentOpData>(opData);
+                for (unsigned idx = 0; idx < 4; ++idx)
+                {
+                    exp4[idx] = expData->m_exp4[idx];
+                }
+                return true;
+            }
+            else if (opData->getType() == OpData::GammaType)
+            {
+                auto gammaData = DynamicPtrCast<const GammaOpData>(opData);
+                const GammaOpData::Style style = gammaData->getStyle();
+                if (style != GammaOpData::BASIC_FWD && style != GammaOpData::BASIC_REV)
+                {
+                    return false;
+                }
+
+                exp4[0] = gammaData->getRedParams()[0];
+                exp4[1] = gammaData->getGreenParams()[0];
+                exp4[2] = gammaData->getBlueParams()[0];
+                exp4[3] = gammaData->getAlphaParams()[0];
+
+                if (style == GammaOpData::BASIC_REV)
+                {
+                    for (unsigned idx = 0; idx < 4; ++idx)
+                    {
+                        exp4[idx] = 1.0 / exp4[idx];
+                    }
+                }
+                return true;
+            }
+
+            return false;
+        }
+
         bool MatrixOffsetOp::canCombineWith(ConstOpRcPtr & op) const
         {
-            return isSameType(op);
+            if (isSameType(op))
+            {
+                return true;
+            }
+
+            ConstOpDataRcPtr opData = op->data();
+            if (opData->getType() == OpData::LogType)
+            {
+                double scale[3], offset[3];
+                return getRGBScaleOffset(scale, offset)
+                    && op->getInputBitDepth() == BIT_DEPTH_F32
+                    && op->getOutputBitDepth() == BIT_DEPTH_F32;
+            }
+
+            double exp4[4];
+            return getPowerExponents(op, exp4);
         }
 
         void MatrixOffsetOp::combineWith(OpRcPtrVec & ops, ConstOpRcPtr & secondOp) const
         {
+            if (!isSameType(secondOp) && canCombineWith(secondOp))
+            {
+                ConstOpDataRcPtr secondData = secondOp->data();
+                if (secondData->getType() == OpData::LogType)
+                {
+                    // The scale & offset are folded into the log parameters.
+                    double scale[3], offset[3];
+                    getRGBScaleOffset(scale, offset);
+
+                    auto logData = DynamicPtrCast<const LogOpData>(secondData);
+                    LogOpDataRcPtr composed = logData->composeScaleOffset(scale, offset, true);
+                    CreateLogOp(ops, composed, TRANSFORM_DIR_FORWARD);
+                }
+                else
+                {
+                    // The scale is moved after the power function so that it could be
+                    // combined with the following ops.
+                    double exp4[4], scale[4], offset[4];
+                    getPowerExponents(secondOp, exp4);
+                    getDiagonalValues(scale, offset);
+
+                    OpRcPtr power = secondOp->clone();
+                    ops.push_back(power);
+
+                    double newScale[4];
+                    for (unsigned idx = 0; idx < 4; ++idx)
+                    {
+                        newScale[idx] = std::pow(scale[idx], exp4[idx]);
+                    }
+                    CreateScaleOp(ops, newScale, TRANSFORM_DIR_FORWARD);
+                }
+                return;
+            }
+
             ConstMatrixOffsetOpRcPtr typedRcPtr = DynamicPtrCast<const MatrixOffsetOp>(secondOp);
             if(!typedRcPtr)
             {
@@ -411,6 +586,12 @@ OCIO_NAMESPACE_ENTER
         ops.push_back(std::make_shared<MatrixOffsetOp>(matrix, direction));
     }
 
+    bool GetRGBScaleOffset(ConstOpRcPtr & op, double(&scale)[3], double(&offset)[3])
+    {
+        ConstMatrixOffsetOpRcPtr typedRcPtr = DynamicPtrCast<const MatrixOffsetOp>(op);
+        return typedRcPtr && typedRcPtr->getRGBScaleOffset(scale, offset);
+    }
+
     void CreateIdentityMatrixOp(OpRcPtrVec & ops)
     {
         MatrixOpDataRcPtr mat
@@ -457,7 +638,8 @@ OCIO_NAMESPACE_ENTER
             throw Exception(os.str().c_str());
         }
 
-        matTransform->setMatrix(matData->getArray().getValues().data());
+        const ArrayDouble & matArray = matData->getArray();
+        matTransform->setMatrix(matArray.getValues().data());
         matTransform->setOffset(matData->getOffsets().getValues());
 
         group->push_back(matTransform);
@@ -499,6 +681,8 @@ OCIO_NAMESPACE_EXIT
 
 #ifdef OCIO_UNIT_TEST
 
+#include "ops/Exponent/ExponentOps.h"
+#include "ops/Gamma/GammaOps.h"
 #include "ops/Log/LogOps.h"
 #include "ops/NoOp/NoOps.h"
 #include "UnitTest.h"
@@ -1474,4 +1658,99 @@ OCIO_ADD_TEST(MatrixOffsetOp, create_transform)
     OCIO_CHECK_EQUAL(mval[15], mat->getArray()[15]);
 }
 
+OCIO_ADD_TEST(MatrixOffsetOp, combine_with_power)
+{
+    // Each positive scale is swapped with the next power function so that both scales
+    // end up adjacent and are combined. The exponent and the gamma ops are different
+    // op types so they remain, hence an exponent, a gamma and a single matrix op.
+
+    const double scale1[4] = { 1.5, 0.75, 2.0, 0.5 };
+    const double exp1[4]   = { 2.2, 2.0, 1.8, 1.2 };
+    const double scale2[4] = { 0.8, 1.6, 1.2, 1.1 };
+    const double exp2[4]   = { 1.1, 1.3, 1.2, 0.9 };
+
+    OCIO::OpRcPtrVec ops;
+    OCIO::CreateScaleOp(ops, scale1, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateExponentOp(ops, exp1, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateScaleOp(ops, scale2, OCIO::TRANSFORM_DIR_INVERSE);
+
+    OCIO::FormatMetadataImpl info(OCIO::METADATA_ROOT);
+    auto gamma = std::make_shared<OCIO::GammaOpData>(OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32,
+                                                     info, OCIO::GammaOpData::BASIC_REV,
+                                                     OCIO::GammaOpData::Params(1, exp2[0]),
+                                                     OCIO::GammaOpData::Params(1, exp2[1]),
+                                                     OCIO::GammaOpData::Params(1, exp2[2]),
+                                                     OCIO::GammaOpData::Params(1, exp2[3]));
+    OCIO::CreateGammaOp(ops, gamma, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO_REQUIRE_EQUAL(ops.size(), 4);
+
+    OCIO::ConstOpRcPtr op1 = ops[1];
+    OCIO::ConstOpRcPtr op3 = ops[3];
+    OCIO_CHECK_ASSERT(ops[0]->canCombineWith(op1));
+    OCIO_CHECK_ASSERT(ops[2]->canCombineWith(op3));
+
+    OCIO::OpRcPtrVec refOps;
+    for (const auto & op : ops)
+    {
+        refOps.push_back(op->clone());
+    }
+    OCIO_CHECK_NO_THROW(FinalizeOpVec(refOps, OCIO::FINALIZATION_EXACT));
+
+    OCIO_CHECK_NO_THROW(OptimizeOpVec(ops, OCIO::OPTIMIZATION_DEFAULT));
+    OCIO_REQUIRE_EQUAL(ops.size(), 3);
+    OCIO_CHECK_EQUAL(ops[0]->getInfo(), "<ExponentOp>");
+    OCIO_CHECK_EQUAL(ops[1]->getInfo(), "<GammaOp>");
+    OCIO_CHECK_EQUAL(ops[2]->getInfo(), "<MatrixOffsetOp>");
+    OCIO_CHECK_NO_THROW(FinalizeOpVec(ops, OCIO::FINALIZATION_EXACT));
+
+    const float src[12] = { 0.01f, 0.1f, 0.2f, 0.0f,
+                            0.3f,  0.5f, 0.8f, 0.5f,
+                            1.0f,  2.0f, 4.0f, 1.0f };
+
+    float res[12], ref[12];
+    memcpy(res, src, 12 * sizeof(float));
+    memcpy(ref, src, 12 * sizeof(float));
+
+    for (const auto & op : ops)
+    {
+        op->apply(res, 3);
+    }
+    for (const auto & op : refOps)
+    {
+        op->apply(ref, 3);
+    }
+
+    for (unsigned idx = 0; idx < 12; ++idx)
+    {
+        // The power functions use a fast approximation.
+        const float tol = 1e-4f * std::max(1.0f, std::fabs(ref[idx]));
+        OCIO_CHECK_CLOSE(res[idx], ref[idx], tol);
+    }
+}
+
+OCIO_ADD_TEST(MatrixOffsetOp, combine_with_power_not_allowed)
+{
+    const double scale[4]  = { 1.5, -0.75, 2.0, 0.5 };
+    const double offset[4] = { 0.1, 0.0, 0.0, 0.0 };
+    const double exp4[4]   = { 2.2, 2.0, 1.8, 1.2 };
+
+    OCIO::OpRcPtrVec ops;
+    // A negative scale.
+    OCIO::CreateScaleOp(ops, scale, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateExponentOp(ops, exp4, OCIO::TRANSFORM_DIR_FORWARD);
+    // An offset.
+    OCIO::CreateOffsetOp(ops, offset, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateExponentOp(ops, exp4, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO_REQUIRE_EQUAL(ops.size(), 4);
+
+    OCIO::ConstOpRcPtr op1 = ops[1];
+    OCIO::ConstOpRcPtr op3 = ops[3];
+    OCIO_CHECK_ASSERT(!ops[0]->canCombineWith(op1));
+    OCIO_CHECK_ASSERT(!ops[2]->canCombineWith(op3));
+
+    OCIO::OpRcPtrVec combined;
+    OCIO_CHECK_THROW_WHAT(ops[0]->combineWith(combined, op1), OCIO::Exception,
+                          "MatrixOffsetOp can only be combined with other MatrixOffsetOps");
+}
+
 #endif
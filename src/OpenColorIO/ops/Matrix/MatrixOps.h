@@ -68,6 +68,10 @@ OCIO_NAMESPACE_ENTER
 
     void CreateIdentityMatrixOp(OpRcPtrVec & ops);
 
+    // Get the per-channel RGB scale & offset if the op is a diagonal matrix processing 32f
+    // values, leaving alpha unchanged and with non-null RGB scales. Returns false otherwise.
+    bool GetRGBScaleOffset(ConstOpRcPtr & op, double(&scale)[3], double(&offset)[3]);
+
     // Create a copy of the matrix transform in the op and append it to the GroupTransform.
     void CreateMatrixTransform(GroupTransformRcPtr & group, ConstOpRcPtr & op);
 
@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "Mutex.h"
+#include "ops/OpArray.h"
+
+OCIO_NAMESPACE_ENTER
+{
+
+namespace
+{
+typedef std::vector<float> FloatValues;
+typedef std::multimap<unsigned long long, std::weak_ptr<FloatValues>> InternedValuesMap;
+
+Mutex g_internedValuesMutex;
+InternedValuesMap g_internedValues;
+// Size of the map after the last removal of the expired values.
+size_t g_internedValuesSweepSize = 64;
+
+// FNV-1a hash of the raw values.
+unsigned long long HashValues(const FloatValues & values)
+{
+    unsigned long long hash = 14695981039346656037ULL;
+    for (const float value : values)
+    {
+        unsigned int bits;
+        memcpy(&bits, &value, sizeof(bits));
+        hash = (hash ^ bits) * 1099511628211ULL;
+    }
+    return hash ^ values.size();
+}
+}
+
+void InternArrayValues(OCIO_SHARED_PTR<FloatValues> & values)
+{
+    const unsigned long long hash = HashValues(*values);
+
+    AutoMutex lock(g_internedValuesMutex);
+
+    auto range = g_internedValues.equal_range(hash);
+    for (auto it = range.first; it != range.second; )
+    {
+        OCIO_SHARED_PTR<FloatValues> interned = it->second.lock();
+        if (!interned)
+        {
+            it = g_internedValues.erase(it);
+        }
+        else if (interned == values || *interned == *values)
+        {
+            values = interned;
+            return;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    g_internedValues.insert(std::make_pair(hash, std::weak_ptr<FloatValues>(values)));
+
+    // The values are released by their last array, so regularly remove the expired entries.
+    if (g_internedValues.size() > 2 * g_internedValuesSweepSize)
+    {
+        for (auto it = g_internedValues.begin(); it != g_internedValues.end(); )
+        {
+            it = it->second.expired() ? g_internedValues.erase(it) : ++it;
+        }
+        g_internedValuesSweepSize = std::max(g_internedValues.size(), size_t(64));
+    }
+}
+
+}
+OCIO_NAMESPACE_EXIT
+
+
+#ifdef OCIO_UNIT_TEST
+
+namespace OCIO = OCIO_NAMESPACE;
+#include "UnitTest.h"
+
+namespace
+{
+class TestArray : public OCIO::Array
+{
+public:
+    unsigned long getNumValues() const override
+    {
+        return getLength() * getNumColorComponents();
+    }
+};
+}
+
+OCIO_ADD_TEST(OpArray, copy_on_write)
+{
+    TestArray a;
+    a.resize(2, 3);
+    a[0] = 1.0f;
+
+    TestArray b(a);
+    OCIO_CHECK_EQUAL(a.getSharedValues().get(), b.getSharedValues().get());
+
+    // The first modification copies the values.
+    b[0] = 2.0f;
+    OCIO_CHECK_NE(a.getSharedValues().get(), b.getSharedValues().get());
+    OCIO_CHECK_EQUAL(a[0], 1.0f);
+    OCIO_CHECK_EQUAL(b[0], 2.0f);
+}
+
+OCIO_ADD_TEST(OpArray, intern)
+{
+    TestArray a;
+    a.resize(2, 3);
+    a[1] = 0.5f;
+
+    TestArray b;
+    b.resize(2, 3);
+    b[1] = 0.5f;
+
+    TestArray c;
+    c.resize(2, 3);
+    c[1] = 0.25f;
+
+    a.intern();
+    b.intern();
+    c.intern();
+    OCIO_CHECK_ASSERT(a.isInterned());
+    OCIO_CHECK_EQUAL(a.getSharedValues().get(), b.getSharedValues().get());
+    OCIO_CHECK_NE(a.getSharedValues().get(), c.getSharedValues().get());
+    OCIO_CHECK_ASSERT(a == b);
+
+    // Interned values are never modified in place.
+    const OCIO::Array::Values * values = a.getSharedValues().get();
+    a[1] = 0.25f;
+    OCIO_CHECK_ASSERT(!a.isInterned());
+    OCIO_CHECK_NE(a.getSharedValues().get(), values);
+    OCIO_CHECK_EQUAL(static_cast<const TestArray &>(b)[1], 0.5f);
+
+    // New arrays share the values while an interned array keeps them alive.
+    {
+        TestArray d;
+        d.resize(2, 3);
+        d[1] = 0.5f;
+        d.intern();
+        OCIO_CHECK_EQUAL(d.getSharedValues().get(), values);
+    }
+}
+
+#endif // OCIO_UNIT_TEST
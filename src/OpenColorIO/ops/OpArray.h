@@ -12,6 +12,9 @@
 OCIO_NAMESPACE_ENTER
 {
 
+// Replace the values by the identical values already interned (if any), or intern them.
+void InternArrayValues(OCIO_SHARED_PTR<std::vector<float>> & values);
+
 class ArrayBase
 {
 public:
@@ -32,6 +35,8 @@ public:
 // other classes. Since the dimensionality of the underlying array of those 
 // classes varies, the interpretation of "length" is defined by child classes.
 // The class represents the array for a 3by1D LUT and a 3D LUT or a matrix.
+// The values are shared between the copies of an array, and only copied on the
+// first modification of one of them.
 template<typename T> class ArrayT : public ArrayBase
 {
 public:
@@ -41,6 +46,8 @@ public:
     ArrayT()
         : m_length(0)
         , m_numColorComponents(0)
+        , m_data(std::make_shared<Values>())
+        , m_interned(false)
     {
     }
 
@@ -55,7 +62,7 @@ public:
     {
         m_length = length;
         m_numColorComponents = numColorComponents;
-        m_data.resize(getNumValues());
+        values().resize(getNumValues());
     }
 
     void setLength(unsigned long length)
@@ -63,13 +70,13 @@ public:
         if (m_length != length)
         {
             m_length = length;
-            m_data.resize(getNumValues());
+            values().resize(getNumValues());
         }
     }
 
     void setDoubleValue(unsigned long index, double value) override
     {
-        m_data[index] = (T)value;
+        values()[index] = (T)value;
     }
 
     unsigned long getLength() const override
@@ -82,7 +89,7 @@ public:
         if (m_numColorComponents != getMaxColorComponents())
         {
             m_numColorComponents = getMaxColorComponents();
-            m_data.resize(getNumValues());
+            values().resize(getNumValues());
         }
     }
 
@@ -96,7 +103,7 @@ public:
         if (m_numColorComponents != numColorComponents)
         {
             m_numColorComponents = numColorComponents;
-            m_data.resize(getNumValues());
+            values().resize(getNumValues());
         }
     }
 
@@ -104,11 +111,12 @@ public:
     {
         if (m_numColorComponents == 3)
         {
+            const Values & data = *m_data;
             bool sameCoeff = true;
             for (unsigned long idx = 0; idx < m_length && sameCoeff; ++idx)
             {
-                if (m_data[idx * 3] != m_data[idx * 3 + 1]
-                    || m_data[idx * 3] != m_data[idx * 3 + 2])
+                if (data[idx * 3] != data[idx * 3 + 1]
+                    || data[idx * 3] != data[idx * 3 + 2])
                 {
                     sameCoeff = false;
                     break;
@@ -129,24 +137,42 @@ public:
 
     inline const Values& getValues() const
     {
-        return m_data;
+        return *m_data;
     }
 
+    // The non-const accessors are meant for the modifications: the values are copied first
+    // if shared or interned. Read through a const array to avoid the copy.
     inline Values& getValues()
     {
-        return m_data;
+        return values();
     }
 
     inline const T& operator[](unsigned long index) const
     {
-        return m_data[index];
+        return (*m_data)[index];
     }
 
     inline T& operator[](unsigned long index)
     {
-        return m_data[index];
+        return values()[index];
+    }
+
+    // Share the values with the other interned arrays having identical values, so the
+    // memory scales with the number of unique arrays (e.g. the same LUT referenced by
+    // many files or processors). Interned values are never modified in place. The array
+    // must not be accessed by other threads during the call.
+    void intern()
+    {
+        InternArrayValues(m_data);
+        m_interned = true;
     }
 
+    bool isInterned() const { return m_interned; }
+
+    // The values can be kept alive after the array is destroyed. Note that the values
+    // may be modified by their array if not interned.
+    OCIO_SHARED_PTR<const Values> getSharedValues() const { return m_data; }
+
     virtual void validate() const
     {
         if (getLength() == 0)
@@ -156,10 +182,10 @@ public:
 
         // getNumValues is based on the dimensions claimed in the file.  Check
         // that this matches the number of values that were actually set.
-        if (m_data.size() != getNumValues())
+        if (m_data->size() != getNumValues())
         {
             std::ostringstream os;
-            os << "Array contains: " << m_data.size() << " values, ";
+            os << "Array contains: " << m_data->size() << " values, ";
             os << "but " << getNumValues() << " are expected.";
             throw Exception(os.str().c_str());
         }
@@ -170,13 +196,27 @@ public:
         if (this == &a) return true;
         return (m_length == a.m_length)
             && (m_numColorComponents == a.m_numColorComponents)
-            && (m_data == a.m_data);
+            && (m_data == a.m_data || *m_data == *a.m_data);
     }
 
 protected:
+    // Access the values for a modification. The values are copied first if shared.
+    Values & values()
+    {
+        if (m_interned || m_data.use_count() > 1)
+        {
+            m_data = std::make_shared<Values>(*m_data);
+            m_interned = false;
+        }
+        return *m_data;
+    }
+
     unsigned long m_length;
     unsigned long m_numColorComponents;
-    Values        m_data;
+
+private:
+    OCIO_SHARED_PTR<Values> m_data;
+    bool m_interned;
 };
 
 typedef ArrayT<double> ArrayDouble;
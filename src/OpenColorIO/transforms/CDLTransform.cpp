@@ -7,6 +7,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "CacheStatistics.h"
 #include "fileformats/cdl/CDLParser.h"
 #include "CDLTransform.h"
 #include "MathUtils.h"
@@ -124,16 +125,47 @@ OCIO_NAMESPACE_ENTER
             return os.str();
         }
         
-        CDLTransformMap g_cache;
-        StringBoolMap g_cacheSrcIsCC;
-        Mutex g_cacheMutex;
+        // The cache is sharded by source file so loading a file does not
+        // block the lookups in the other files.
+        struct CDLCacheShard
+        {
+            Mutex mutex;
+            CDLTransformMap cache;
+            StringBoolMap srcIsCC;
+            size_t memorySize = 0;
+        };
+
+        CacheShards<CDLCacheShard> g_cacheShards;
+
+        void AddCDLCacheEntry(CDLCacheShard & shard,
+                              const std::string & key,
+                              const CDLTransformRcPtr & cdl)
+        {
+            auto result = shard.cache.insert(std::make_pair(key, cdl));
+            if(!result.second)
+            {
+                result.first->second = cdl;
+            }
+            else
+            {
+                const size_t entrySize = sizeof(CDLTransformMap::value_type) + key.size();
+                shard.memorySize += entrySize;
+                GetCacheCounters(CACHE_CDL_FILE).addEntries(1, entrySize);
+            }
+        }
     }
     
     void ClearCDLTransformFileCache()
     {
-        AutoMutex lock(g_cacheMutex);
-        g_cache.clear();
-        g_cacheSrcIsCC.clear();
+        for(size_t i=0; i<g_cacheShards.size(); ++i)
+        {
+            CDLCacheShard & shard = g_cacheShards[i];
+            AutoMutex lock(shard.mutex);
+            GetCacheCounters(CACHE_CDL_FILE).removeEntries(shard.cache.size(), shard.memorySize);
+            shard.cache.clear();
+            shard.srcIsCC.clear();
+            shard.memorySize = 0;
+        }
     }
     
     // TODO: Expose functions for introspecting in ccc file
@@ -153,22 +185,27 @@ OCIO_NAMESPACE_ENTER
         if(cccid_) cccid = cccid_;
         
         // Check cache
-        AutoMutex lock(g_cacheMutex);
+        CDLCacheShard & shard = g_cacheShards.get(src);
+        CDLTransformMap & cache = shard.cache;
+        StringBoolMap & cacheSrcIsCC = shard.srcIsCC;
+        AutoMutex lock(shard.mutex);
         
-        // Use g_cacheSrcIsCC as a proxy for if we have loaded this source
+        // Use cacheSrcIsCC as a proxy for if we have loaded this source
         // file already (in which case it must be in cache, or an error)
         
-        StringBoolMap::iterator srcIsCCiter = g_cacheSrcIsCC.find(src);
-        if(srcIsCCiter != g_cacheSrcIsCC.end())
+        StringBoolMap::iterator srcIsCCiter = cacheSrcIsCC.find(src);
+        if(srcIsCCiter != cacheSrcIsCC.end())
         {
+            GetCacheCounters(CACHE_CDL_FILE).addHit();
+
             // If the source file is known to be a pure ColorCorrection element,
             // null out the cccid so its ignored.
             if(srcIsCCiter->second) cccid = "";
             
             // Search for the cccid by name
             CDLTransformMap::iterator iter = 
-                g_cache.find(GetCDLLocalCacheKey(src, cccid));
-            if(iter != g_cache.end())
+                cache.find(GetCDLLocalCacheKey(src, cccid));
+            if(iter != cache.end())
             {
                 return iter->second;
             }
@@ -177,8 +214,8 @@ OCIO_NAMESPACE_ENTER
             int cccindex=0;
             if(StringToInt(&cccindex, cccid.c_str(), true))
             {
-                iter = g_cache.find(GetCDLLocalCacheKey(src, cccindex));
-                if(iter != g_cache.end())
+                iter = cache.find(GetCDLLocalCacheKey(src, cccindex));
+                if(iter != cache.end())
                 {
                     return iter->second;
                 }
@@ -193,6 +230,9 @@ OCIO_NAMESPACE_ENTER
         }
         
         
+        GetCacheCounters(CACHE_CDL_FILE).addMiss();
+        CacheMissTimer missTimer(CACHE_CDL_FILE);
+
         // Try to read all ccs from the file, into cache
         std::ifstream istream(src);
         if(istream.fail()) {
@@ -213,8 +253,8 @@ OCIO_NAMESPACE_ENTER
             parser.getCDLTransform(cdl);
 
             cccid = "";
-            g_cacheSrcIsCC[src] = true;
-            g_cache[GetCDLLocalCacheKey(src, cccid)] = cdl;
+            cacheSrcIsCC[src] = true;
+            AddCDLCacheEntry(shard, GetCDLLocalCacheKey(src, cccid), cdl);
         }
         else if(parser.isCCC())
         {
@@ -233,20 +273,20 @@ OCIO_NAMESPACE_ENTER
                 throw Exception(os.str().c_str());
             }
             
-            g_cacheSrcIsCC[src] = false;
+            cacheSrcIsCC[src] = false;
             
             // Add all by transforms to cache
             // First by index, then by id
             for(unsigned int i=0; i<transformVec.size(); ++i)
             {
-                g_cache[GetCDLLocalCacheKey(src, i)] = transformVec[i];
+                AddCDLCacheEntry(shard, GetCDLLocalCacheKey(src, i), transformVec[i]);
             }
             
             for(CDLTransformMap::iterator iter = transformMap.begin();
                 iter != transformMap.end();
                 ++iter)
             {
-                g_cache[GetCDLLocalCacheKey(src, iter->first)] = iter->second;
+                AddCDLCacheEntry(shard, GetCDLLocalCacheKey(src, iter->first), iter->second);
             }
         }
         
@@ -255,8 +295,8 @@ OCIO_NAMESPACE_ENTER
         {
             // Search for the cccid by name
             CDLTransformMap::iterator iter = 
-                g_cache.find(GetCDLLocalCacheKey(src, cccid));
-            if(iter != g_cache.end())
+                cache.find(GetCDLLocalCacheKey(src, cccid));
+            if(iter != cache.end())
             {
                 return iter->second;
             }
@@ -265,8 +305,8 @@ OCIO_NAMESPACE_ENTER
             int cccindex=0;
             if(StringToInt(&cccindex, cccid.c_str(), true))
             {
-                iter = g_cache.find(GetCDLLocalCacheKey(src, cccindex));
-                if(iter != g_cache.end())
+                iter = cache.find(GetCDLLocalCacheKey(src, cccindex));
+                if(iter != cache.end())
                 {
                     return iter->second;
                 }
@@ -2,12 +2,22 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 #include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstring>
 #include <fstream>
+#include <list>
 #include <map>
+#include <memory>
 #include <sstream>
+#include <system_error>
+#include <thread>
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "CacheStatistics.h"
+#include "fileformats/BinaryCache.h"
 #include "FileTransform.h"
 #include "Logging.h"
 #include "Mutex.h"
@@ -280,7 +290,12 @@ OCIO_NAMESPACE_ENTER
             
             m_formatsByName[pystring::lower(formatInfoVec[i].name)] = format;
             
-            m_formatsByExtension[formatInfoVec[i].extension].push_back(format);
+            // A format declaring several names for an extension is only tried once.
+            FileFormatVector & formats = m_formatsByExtension[formatInfoVec[i].extension];
+            if(std::find(formats.begin(), formats.end(), format) == formats.end())
+            {
+                formats.push_back(format);
+            }
             
             if(formatInfoVec[i].capabilities & FORMAT_CAPABILITY_READ)
             {
@@ -406,6 +421,121 @@ OCIO_NAMESPACE_ENTER
     
     }
     
+    MemoryStreamBuf::MemoryStreamBuf(const char * data, size_t size)
+    {
+        char * begin = const_cast<char *>(data);
+        setg(begin, begin, begin + size);
+    }
+
+    MemoryStreamBuf::pos_type MemoryStreamBuf::seekoff(off_type off,
+                                                       std::ios_base::seekdir dir,
+                                                       std::ios_base::openmode which)
+    {
+        if(!(which & std::ios_base::in))
+        {
+            return pos_type(off_type(-1));
+        }
+
+        off_type pos = off;
+        if(dir == std::ios_base::cur)
+        {
+            pos += gptr() - eback();
+        }
+        else if(dir == std::ios_base::end)
+        {
+            pos += egptr() - eback();
+        }
+
+        if(pos < 0 || pos > egptr() - eback())
+        {
+            return pos_type(off_type(-1));
+        }
+
+        setg(eback(), eback() + pos, egptr());
+        return pos_type(pos);
+    }
+
+    MemoryStreamBuf::pos_type MemoryStreamBuf::seekpos(pos_type pos,
+                                                       std::ios_base::openmode which)
+    {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+
+    InputMemoryStream::InputMemoryStream(const char * data, size_t size)
+        :   std::istream(nullptr)
+        ,   m_buffer(data, size)
+    {
+        rdbuf(&m_buffer);
+    }
+
+    CachedFileRcPtr FileFormat::readBuffer(const char * data,
+                                           size_t size,
+                                           const std::string & originalFileName) const
+    {
+        InputMemoryStream istream(data, size);
+        return read(istream, originalFileName);
+    }
+
+    int FileFormat::probe(const char * data, size_t size) const
+    {
+        return isBinary() || ProbeIsText(data, size) ? FORMAT_PROBE_MAYBE : FORMAT_PROBE_NO;
+    }
+
+    namespace
+    {
+        void SkipByteOrderMark(const char * & data, size_t & size)
+        {
+            if(size >= 3 && data[0] == '\xEF' && data[1] == '\xBB' && data[2] == '\xBF')
+            {
+                data += 3;
+                size -= 3;
+            }
+        }
+    }
+
+    bool ProbeIsText(const char * data, size_t size)
+    {
+        if(size >= 2 && ((data[0] == '\xFF' && data[1] == '\xFE')
+                         || (data[0] == '\xFE' && data[1] == '\xFF')))
+        {
+            return true;
+        }
+        return memchr(data, 0, size) == nullptr;
+    }
+
+    bool ProbeStartsWith(const char * data, size_t size, const char * prefix)
+    {
+        SkipByteOrderMark(data, size);
+
+        const char * end = data + size;
+        while(data != end && isspace((unsigned char)*data)) ++data;
+
+        for(; *prefix; ++prefix, ++data)
+        {
+            if(data == end || tolower((unsigned char)*data) != tolower((unsigned char)*prefix))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool ProbeContains(const char * data, size_t size, const char * str)
+    {
+        const char * end = data + size;
+        return std::search(data, end, str, str + strlen(str)) != end;
+    }
+
+    int ProbeXMLElement(const char * data, size_t size, const char * element)
+    {
+        if(!ProbeStartsWith(data, size, "<"))
+        {
+            return FORMAT_PROBE_NO;
+        }
+        const std::string tag = std::string("<") + element;
+        return ProbeContains(data, size, tag.c_str()) ? FORMAT_PROBE_LIKELY : FORMAT_PROBE_MAYBE;
+    }
+
     std::string FileFormat::getName() const
     {
         FormatInfoVec infoVec;
@@ -440,6 +570,39 @@ OCIO_NAMESPACE_ENTER
 
     namespace
     {
+        // Size of the beginning of the file given to FileFormat::probe().
+        const size_t FORMAT_PROBE_SIZE = 4096;
+
+        // Sort the formats from the most to the least likely to read the content. Returns
+        // the number of formats not rejecting the content, which come first.
+        size_t SortFormatsByProbe(FileFormatVector & formats, const char * data, size_t size)
+        {
+            size = std::min(size, FORMAT_PROBE_SIZE);
+
+            std::vector<std::pair<int, FileFormat *>> probes;
+            for(FileFormat * format : formats)
+            {
+                probes.push_back(std::make_pair(format->probe(data, size), format));
+            }
+
+            std::stable_sort(probes.begin(), probes.end(),
+                             [](const std::pair<int, FileFormat *> & a,
+                                const std::pair<int, FileFormat *> & b)
+                             {
+                                 return a.first > b.first;
+                             });
+
+            size_t numMatches = 0;
+            for(size_t i = 0; i < probes.size(); ++i)
+            {
+                formats[i] = probes[i].second;
+                if(probes[i].first != FORMAT_PROBE_NO)
+                {
+                    ++numMatches;
+                }
+            }
+            return numMatches;
+        }
     
         void LoadFileUncached(FileFormat * & returnFormat,
             CachedFileRcPtr & returnCachedFile,
@@ -452,6 +615,23 @@ OCIO_NAMESPACE_ENTER
                 os << "Opening " << filepath;
                 LogDebug(os.str());
             }
+
+            // The file is read only once, all the tried formats parse the same content.
+            // Note: The file is not memory-mapped as it could be modified while parsed.
+            std::vector<char> content;
+            try
+            {
+                Platform::ReadFile(filepath, content);
+            }
+            catch(Exception &)
+            {
+                std::ostringstream os;
+                os << "The specified FileTransform srcfile, '";
+                os << filepath << "', could not be opened. ";
+                os << "Please confirm the file exists with ";
+                os << "appropriate read permissions.";
+                throw Exception(os.str().c_str());
+            }
             
             // Try the initial format.
             std::string primaryErrorText;
@@ -465,6 +645,9 @@ OCIO_NAMESPACE_ENTER
             FileFormatVector possibleFormats;
             formatRegistry.getFileFormatForExtension(
                 extension, possibleFormats);
+            // The formats of the extension are all tried, even if the content does not
+            // match, to report their errors.
+            SortFormatsByProbe(possibleFormats, content.data(), content.size());
             FileFormatVector::const_iterator endFormat = possibleFormats.end();
             FileFormatVector::const_iterator itFormat =
                 possibleFormats.begin();
@@ -472,26 +655,11 @@ OCIO_NAMESPACE_ENTER
             {
 
                 FileFormat * tryFormat = *itFormat;
-                std::ifstream filestream;
                 try
                 {
-                    // Open the filePath
-                    filestream.open(
-                        filepath.c_str(),
-                        tryFormat->isBinary()
-                            ? std::ios_base::binary : std::ios_base::in);
-                    if (!filestream.good())
-                    {
-                        std::ostringstream os;
-                        os << "The specified FileTransform srcfile, '";
-                        os << filepath << "', could not be opened. ";
-                        os << "Please confirm the file exists with ";
-                        os << "appropriate read permissions.";
-                        throw Exception(os.str().c_str());
-                    }
-
-                    CachedFileRcPtr cachedFile = tryFormat->read(
-                        filestream,
+                    CachedFileRcPtr cachedFile = tryFormat->readBuffer(
+                        content.data(),
+                        content.size(),
                         filepath);
                     
                     if(IsDebugLoggingEnabled())
@@ -504,16 +672,10 @@ OCIO_NAMESPACE_ENTER
                     
                     returnFormat = tryFormat;
                     returnCachedFile = cachedFile;
-                    filestream.close();
                     return;
                 }
                 catch(std::exception & e)
                 {
-                    if (filestream.is_open())
-                    {
-                        filestream.close();
-                    }
-
                     primaryErrorText += tryFormat->getName();
                     primaryErrorText += " failed with: '";
                     primaryErrorText = e.what();
@@ -531,39 +693,46 @@ OCIO_NAMESPACE_ENTER
                 ++itFormat;
             }
             
-            // If this fails, try all other formats
-            CachedFileRcPtr cachedFile;
-            FileFormat * altFormat = NULL;
-            
+            // If this fails, try the other formats matching the content.
+            FileFormatVector altFormats;
             for(int findex = 0;
                 findex<formatRegistry.getNumRawFormats();
                 ++findex)
             {
-                altFormat = formatRegistry.getRawFormatByIndex(findex);
+                FileFormat * altFormat = formatRegistry.getRawFormatByIndex(findex);
                 
                 // Do not try primary formats twice.
                 FileFormatVector::const_iterator itAlt = std::find(
                     possibleFormats.begin(), possibleFormats.end(), altFormat);
-                if(itAlt != endFormat)
-                    continue;
-                
-                std::ifstream filestream;
-                try
+                if(itAlt == endFormat)
                 {
-                    filestream.open(filepath.c_str(), altFormat->isBinary()
-                        ? std::ios_base::binary : std::ios_base::in);
-                    if (!filestream.good())
-                    {
-                        std::ostringstream os;
-                        os << "The specified FileTransform srcfile, '";
-                        os << filepath << "', could not be opened. ";
-                        os << "Please confirm the file exists with ";
-                        os << "appropriate read";
-                        os << " permissions.";
-                        throw Exception(os.str().c_str());
-                    }
+                    altFormats.push_back(altFormat);
+                }
+            }
+
+            const size_t numAltFormats
+                = SortFormatsByProbe(altFormats, content.data(), content.size());
+
+            if(IsDebugLoggingEnabled())
+            {
+                for(size_t findex = numAltFormats; findex < altFormats.size(); ++findex)
+                {
+                    std::ostringstream os;
+                    os << "    Skipped alt format ";
+                    os << altFormats[findex]->getName();
+                    os << ":  the content does not match.";
+                    LogDebug(os.str());
+                }
+            }
+
+            CachedFileRcPtr cachedFile;
+            for(size_t findex = 0; findex < numAltFormats; ++findex)
+            {
+                FileFormat * altFormat = altFormats[findex];
 
-                    cachedFile = altFormat->read(filestream, filepath);
+                try
+                {
+                    cachedFile = altFormat->readBuffer(content.data(), content.size(), filepath);
                     
                     if(IsDebugLoggingEnabled())
                     {
@@ -575,16 +744,10 @@ OCIO_NAMESPACE_ENTER
                     
                     returnFormat = altFormat;
                     returnCachedFile = cachedFile;
-                    filestream.close();
                     return;
                 }
                 catch(std::exception & e)
                 {
-                    if (filestream.is_open())
-                    {
-                        filestream.close();
-                    }
-
                     if(IsDebugLoggingEnabled())
                     {
                         std::ostringstream os;
@@ -612,7 +775,7 @@ OCIO_NAMESPACE_ENTER
 
             if(!possibleFormats.empty())
             {
-                os << "All formats have been tried including ";
+                os << "All formats matching the content have been tried including ";
                 os << "formats registered for the given extension. ";
                 os << "These formats gave the following errors: ";
                 os << primaryErrorText;
@@ -624,28 +787,138 @@ OCIO_NAMESPACE_ENTER
         // We mutex both the main map and each item individually, so that
         // the potentially slow file access wont block other lookups to already
         // existing items. (Loads of the *same* file will mutually block though)
+        // The map is sharded to limit the contention, and the lookups of an
+        // already loaded file do not lock the item.
         
         struct FileCacheResult
         {
             Mutex mutex;
             FileFormat * format;
             bool ready;
+            // Set once the load is completed, the result is then never modified.
+            std::atomic<bool> loaded;
             bool error;
             CachedFileRcPtr cachedFile;
             std::string exceptionText;
+            // Accounted in the cache memory usage once the file is loaded.
+            size_t memorySize;
+            // Fast hash of the file when it was loaded, and time of the last check.
+            std::string fileHash;
+            std::chrono::steady_clock::time_point lastCheck;
+            // Logical time of the last access.
+            std::atomic<unsigned long long> lastUse;
+            // Position in the LRU list of the shard, guarded by the shard mutex.
+            std::list<std::string>::iterator lruPos;
             
             FileCacheResult():
                 format(NULL),
                 ready(false),
-                error(false)
+                loaded(false),
+                error(false),
+                memorySize(0),
+                lastUse(0)
             {}
         };
         
         typedef OCIO_SHARED_PTR<FileCacheResult> FileCacheResultPtr;
         typedef std::map<std::string, FileCacheResultPtr> FileCacheMap;
-        
-        FileCacheMap g_fileCache;
-        Mutex g_fileCacheLock;
+
+        struct FileCacheShard
+        {
+            Mutex mutex;
+            FileCacheMap cache;
+            // The file paths from the most to the least recently used.
+            std::list<std::string> lru;
+        };
+
+        CacheShards<FileCacheShard> g_fileCache;
+
+        // The cache is bounded by a memory budget and discards the least recently used
+        // files first i.e. the oldest of the least recently used files of the shards.
+        Mutex g_fileCacheBudgetLock;
+        std::atomic<unsigned long long> g_fileCacheClock(0);
+        std::atomic<size_t> g_fileCacheBudget(size_t(1) << 30);
+        std::atomic<double> g_fileCacheCheckInterval(-1.0);
+        std::atomic<unsigned> g_fileLoadingThreads(0);
+
+        // Each file found modified on disk gets a new version from the clock, the other
+        // files keep their version (i.e. 0 when never modified).
+        Mutex g_fileVersionsLock;
+        std::atomic<unsigned long long> g_fileVersionClock(0);
+        typedef std::map<std::string, unsigned long long> FileVersionMap;
+        FileVersionMap g_fileVersions;
+
+        CacheCounters & g_fileCacheCounters = GetCacheCounters(CACHE_FILE);
+
+        // Add an entry for a file to load, the caller must hold the shard lock.
+        FileCacheResultPtr AddFileCacheEntry(FileCacheShard & shard, const std::string & filepath)
+        {
+            FileCacheResultPtr result(new FileCacheResult);
+            // The memory size is known once the file is loaded.
+            g_fileCacheCounters.addEntries(1, 0);
+            shard.cache[filepath] = result;
+            shard.lru.push_front(filepath);
+            result->lruPos = shard.lru.begin();
+            return result;
+        }
+
+        // Remove the entry, if still present, and release its memory usage.
+        bool RemoveFileCacheEntry(const std::string & filepath, const FileCacheResultPtr & result)
+        {
+            FileCacheShard & shard = g_fileCache.get(filepath);
+            AutoMutex lock(shard.mutex);
+            FileCacheMap::iterator iter = shard.cache.find(filepath);
+            if (iter != shard.cache.end() && iter->second == result)
+            {
+                g_fileCacheCounters.removeEntries(1, result->memorySize);
+                shard.lru.erase(result->lruPos);
+                shard.cache.erase(iter);
+                return true;
+            }
+            return false;
+        }
+
+        // Discard the least recently used files until the budget is met. The most recently
+        // used file is always kept. The caller must not hold any shard lock.
+        void EnforceFileCacheBudget()
+        {
+            AutoMutex lock(g_fileCacheBudgetLock);
+
+            while (g_fileCacheBudget != 0
+                   && g_fileCacheCounters.getMemoryUsage() > g_fileCacheBudget)
+            {
+                std::string oldestPath;
+                FileCacheResultPtr oldest;
+                size_t numEntries = 0;
+
+                // Only the least recently used file of each shard is a candidate.
+                for (size_t i = 0; i < g_fileCache.size(); ++i)
+                {
+                    FileCacheShard & shard = g_fileCache[i];
+                    AutoMutex shardLock(shard.mutex);
+                    numEntries += shard.cache.size();
+                    if (!shard.lru.empty())
+                    {
+                        const FileCacheResultPtr & entry = shard.cache.find(shard.lru.back())->second;
+                        if (!oldest || entry->lastUse < oldest->lastUse)
+                        {
+                            oldestPath = shard.lru.back();
+                            oldest = entry;
+                        }
+                    }
+                }
+
+                if (numEntries <= 1)
+                {
+                    break;
+                }
+
+                if (RemoveFileCacheEntry(oldestPath, oldest))
+                {
+                    g_fileCacheCounters.addEvictions(1);
+                }
+            }
+        }
         
     } // namespace
 
@@ -653,49 +926,97 @@ OCIO_NAMESPACE_ENTER
                                 CachedFileRcPtr & cachedFile,
                                 const std::string & filepath)
     {
+        // A file modified on disk is discarded so it is read again.
+        IsCachedFileStale(filepath);
+
         // Load the file cache ptr from the global map
         FileCacheResultPtr result;
         {
-            AutoMutex lock(g_fileCacheLock);
-            FileCacheMap::iterator iter = g_fileCache.find(filepath);
-            if (iter != g_fileCache.end())
+            FileCacheShard & shard = g_fileCache.get(filepath);
+            AutoMutex lock(shard.mutex);
+            FileCacheMap::iterator iter = shard.cache.find(filepath);
+            if (iter != shard.cache.end())
             {
+                g_fileCacheCounters.addHit();
                 result = iter->second;
+                shard.lru.splice(shard.lru.begin(), shard.lru, result->lruPos);
             }
             else
             {
-                result = FileCacheResultPtr(new FileCacheResult);
-                g_fileCache[filepath] = result;
+                g_fileCacheCounters.addMiss();
+                result = AddFileCacheEntry(shard, filepath);
             }
+            result->lastUse = ++g_fileCacheClock;
         }
 
         // If this file has already been loaded, return
         // the result immediately
 
-        AutoMutex lock(result->mutex);
-        if (!result->ready)
+        if (!result->loaded.load(std::memory_order_acquire))
         {
-            result->ready = true;
-            result->error = false;
-
-            try
-            {
-                LoadFileUncached(result->format,
-                    result->cachedFile,
-                    filepath);
-            }
-            catch (std::exception & e)
-            {
-                result->error = true;
-                result->exceptionText = e.what();
-            }
-            catch (...)
+            AutoMutex lock(result->mutex);
+            if (!result->ready)
             {
-                result->error = true;
-                std::ostringstream os;
-                os << "An unknown error occurred in LoadFileUncached, ";
-                os << filepath;
-                result->exceptionText = os.str();
+                CacheMissTimer missTimer(CACHE_FILE);
+
+                result->ready = true;
+                result->error = false;
+                // Computed before reading so a modification during the read is detected.
+                result->fileHash = ComputeFastFileHash(filepath);
+                result->lastCheck = std::chrono::steady_clock::now();
+
+                try
+                {
+                    if (!LoadFileFromBinaryCache(result->format, result->cachedFile,
+                                                 filepath, result->fileHash))
+                    {
+                        LoadFileUncached(result->format,
+                            result->cachedFile,
+                            filepath);
+
+                        SaveFileToBinaryCache(result->format, result->cachedFile,
+                                              filepath, result->fileHash);
+                    }
+                }
+                catch (std::exception & e)
+                {
+                    result->error = true;
+                    result->exceptionText = e.what();
+                }
+                catch (...)
+                {
+                    result->error = true;
+                    std::ostringstream os;
+                    os << "An unknown error occurred in LoadFileUncached, ";
+                    os << filepath;
+                    result->exceptionText = os.str();
+                }
+
+                const size_t memorySize = sizeof(FileCacheResult) + filepath.size()
+                    + result->exceptionText.size()
+                    + (result->cachedFile ? result->cachedFile->getMemorySize() : 0);
+
+                bool cached = false;
+                {
+                    FileCacheShard & shard = g_fileCache.get(filepath);
+                    AutoMutex cacheLock(shard.mutex);
+                    // The entry may have been discarded (e.g. by ClearAllCaches()) while
+                    // loading.
+                    FileCacheMap::iterator iter = shard.cache.find(filepath);
+                    if (iter != shard.cache.end() && iter->second == result)
+                    {
+                        result->memorySize = memorySize;
+                        g_fileCacheCounters.addEntries(0, memorySize);
+                        cached = true;
+                    }
+                }
+
+                result->loaded.store(true, std::memory_order_release);
+
+                if (cached)
+                {
+                    EnforceFileCacheBudget();
+                }
             }
         }
 
@@ -728,12 +1049,341 @@ OCIO_NAMESPACE_ENTER
         }
     }
 
+    bool IsCachedFileStale(const std::string & filepath)
+    {
+        const double interval = g_fileCacheCheckInterval;
+        if (interval < 0.0)
+        {
+            return false;
+        }
+
+        FileCacheResultPtr result;
+        {
+            FileCacheShard & shard = g_fileCache.get(filepath);
+            AutoMutex lock(shard.mutex);
+            FileCacheMap::iterator iter = shard.cache.find(filepath);
+            if (iter == shard.cache.end())
+            {
+                return false;
+            }
+            result = iter->second;
+        }
+
+        {
+            AutoMutex lock(result->mutex);
+            if (!result->loaded)
+            {
+                return false;
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+            if (std::chrono::duration<double>(now - result->lastCheck).count() < interval)
+            {
+                return false;
+            }
+            result->lastCheck = now;
+
+            if (ComputeFastFileHash(filepath) == result->fileHash)
+            {
+                return false;
+            }
+        }
+
+        RemoveFileCacheEntry(filepath, result);
+        ClearFastFileHash(filepath);
+
+        // The new version is set once the entry is removed, so a processor built after
+        // reading the clock holds the new content of the file.
+        {
+            AutoMutex lock(g_fileVersionsLock);
+            g_fileVersions[filepath] = ++g_fileVersionClock;
+        }
+
+        return true;
+    }
+
+    unsigned long long GetFileVersionClock()
+    {
+        return g_fileVersionClock;
+    }
+
+    bool IsFileNewerThan(const std::string & filepath, unsigned long long version)
+    {
+        AutoMutex lock(g_fileVersionsLock);
+        FileVersionMap::const_iterator iter = g_fileVersions.find(filepath);
+        return iter != g_fileVersions.end() && iter->second > version;
+    }
+
     void ClearFileTransformCaches()
     {
-        AutoMutex lock(g_fileCacheLock);
-        g_fileCache.clear();
+        for (size_t i = 0; i < g_fileCache.size(); ++i)
+        {
+            FileCacheShard & shard = g_fileCache[i];
+            AutoMutex lock(shard.mutex);
+            for (const auto & entry : shard.cache)
+            {
+                g_fileCacheCounters.removeEntries(1, entry.second->memorySize);
+            }
+            shard.cache.clear();
+            shard.lru.clear();
+        }
+    }
+
+    void SetFileCacheMemoryBudget(size_t budget)
+    {
+        g_fileCacheBudget = budget;
+        EnforceFileCacheBudget();
+    }
+
+    size_t GetFileCacheMemoryBudget()
+    {
+        return g_fileCacheBudget;
+    }
+
+    size_t GetFileCacheMemoryUsage()
+    {
+        return g_fileCacheCounters.getMemoryUsage();
+    }
+
+    size_t GetFileCacheNumEntries()
+    {
+        return g_fileCacheCounters.getNumEntries();
+    }
+
+    unsigned long GetFileCacheNumHits()
+    {
+        return g_fileCacheCounters.getNumHits();
+    }
+
+    unsigned long GetFileCacheNumMisses()
+    {
+        return g_fileCacheCounters.getNumMisses();
+    }
+
+    void SetFileCacheCheckInterval(double seconds)
+    {
+        g_fileCacheCheckInterval = seconds;
+    }
+
+    double GetFileCacheCheckInterval()
+    {
+        return g_fileCacheCheckInterval;
     }
     
+    namespace
+    {
+        std::atomic<bool> g_lazyFileLoadingEnabled(false);
+
+        void LoadFileTransformOps(OpRcPtrVec & ops,
+                                  const Config & config,
+                                  const ConstContextRcPtr & context,
+                                  const FileTransform & fileTransform,
+                                  const std::string & filepath,
+                                  TransformDirection dir);
+
+        // What is needed to build the ops of a file transform later on. The processor may
+        // outlive its config, or the config may be modified in between, so the file is
+        // loaded with a snapshot of the config taken when the processor was created.
+        struct LazyFile
+        {
+            LazyFile(const Config & sourceConfig_,
+                     const ConstConfigRcPtr & config_,
+                     const ConstContextRcPtr & context_,
+                     const FileTransform & fileTransform_,
+                     const std::string & filepath_,
+                     TransformDirection dir_)
+                :   sourceConfig(&sourceConfig_)
+                ,   config(config_)
+                ,   context(context_)
+                ,   fileTransform(DynamicPtrCast<const FileTransform>(
+                        fileTransform_.createEditableCopy()))
+                ,   filepath(filepath_)
+                ,   dir(dir_)
+                ,   combinedDir(CombineTransformDirections(dir_, fileTransform_.getDirection()))
+                ,   loaded(false)
+            {
+            }
+
+            // Only identifies the config the snapshot was taken from, never dereferenced.
+            const Config * const sourceConfig;
+            const ConstConfigRcPtr config;
+            const ConstContextRcPtr context;
+            const ConstFileTransformRcPtr fileTransform;
+            const std::string filepath;
+            const TransformDirection dir;
+            const TransformDirection combinedDir;
+
+            Mutex mutex;
+            bool loaded;
+            OpRcPtrVec ops;
+        };
+
+        typedef OCIO_SHARED_PTR<LazyFile> LazyFileRcPtr;
+
+        // Placeholder of the ops of a file transform until its file is loaded. It only
+        // lives in the op list of a processor, the processor loads the file before
+        // optimizing, applying or exposing its ops.
+        class LazyFileOp : public Op
+        {
+        public:
+            LazyFileOp() = delete;
+            LazyFileOp(const LazyFileOp &) = delete;
+            LazyFileOp& operator=(const LazyFileOp &) = delete;
+
+            explicit LazyFileOp(const LazyFileRcPtr & file)
+                :   Op()
+                ,   m_file(file)
+            {
+                data().reset(new NoOpData());
+            }
+
+            virtual ~LazyFileOp() {}
+
+            TransformDirection getDirection() const noexcept override { return m_file->combinedDir; }
+
+            OpRcPtr clone() const override { return std::make_shared<LazyFileOp>(m_file); }
+
+            std::string getInfo() const override { return "<LazyFileOp>"; }
+
+            // Nothing is known about the content of the file until it is loaded.
+            bool isNoOp() const override { return false; }
+            bool isIdentity() const override { return false; }
+            bool hasChannelCrosstalk() const override { return true; }
+
+            bool isSameType(ConstOpRcPtr & op) const override;
+            bool isInverse(ConstOpRcPtr & op) const override;
+            void dumpMetadata(ProcessorMetadataRcPtr & metadata) const override;
+
+            void finalize(FinalizationFlags /*fFlags*/) override {}
+
+            ConstOpCPURcPtr getCPUOp() const override;
+
+            void extractGpuShaderInfo(GpuShaderDescRcPtr & shaderDesc) const override;
+
+            // Load the file once, and return its finalized ops (shared by the clones).
+            const OpRcPtrVec & load() const;
+
+            const LazyFileRcPtr & getFile() const { return m_file; }
+
+        private:
+            LazyFileRcPtr m_file;
+        };
+
+        typedef OCIO_SHARED_PTR<const LazyFileOp> ConstLazyFileOpRcPtr;
+
+        bool LazyFileOp::isSameType(ConstOpRcPtr & op) const
+        {
+            ConstLazyFileOpRcPtr typedRcPtr = DynamicPtrCast<const LazyFileOp>(op);
+            if(!typedRcPtr) return false;
+            return true;
+        }
+
+        bool LazyFileOp::isInverse(ConstOpRcPtr & op) const
+        {
+            ConstLazyFileOpRcPtr typedRcPtr = DynamicPtrCast<const LazyFileOp>(op);
+            if(!typedRcPtr) return false;
+
+            const LazyFile & file = *m_file;
+            const LazyFile & other = *typedRcPtr->m_file;
+
+            if (file.combinedDir == TRANSFORM_DIR_UNKNOWN
+                || other.combinedDir == TRANSFORM_DIR_UNKNOWN
+                || file.combinedDir == other.combinedDir)
+            {
+                return false;
+            }
+
+            return file.filepath == other.filepath
+                && file.fileTransform->getInterpolation()
+                       == other.fileTransform->getInterpolation()
+                && std::string(file.fileTransform->getCCCId())
+                       == other.fileTransform->getCCCId();
+        }
+
+        void LazyFileOp::dumpMetadata(ProcessorMetadataRcPtr & metadata) const
+        {
+            metadata->addFile(m_file->filepath.c_str());
+        }
+
+        ConstOpCPURcPtr LazyFileOp::getCPUOp() const
+        {
+            std::ostringstream os;
+            os << "The transform file: " << m_file->filepath << " is not loaded.";
+            throw Exception(os.str().c_str());
+        }
+
+        void LazyFileOp::extractGpuShaderInfo(GpuShaderDescRcPtr & /*shaderDesc*/) const
+        {
+            std::ostringstream os;
+            os << "The transform file: " << m_file->filepath << " is not loaded.";
+            throw Exception(os.str().c_str());
+        }
+
+        const OpRcPtrVec & LazyFileOp::load() const
+        {
+            AutoMutex lock(m_file->mutex);
+
+            if (!m_file->loaded)
+            {
+                OpRcPtrVec ops;
+                LoadFileTransformOps(ops, *m_file->config, m_file->context,
+                                     *m_file->fileTransform, m_file->filepath, m_file->dir);
+
+                // Same preparation as the ops of the processor.
+                FinalizeOpVec(ops, FINALIZATION_EXACT);
+                InternOpArrays(ops);
+
+                m_file->ops = ops;
+                m_file->loaded = true;
+            }
+
+            return m_file->ops;
+        }
+
+        void LoadFileTransformOps(OpRcPtrVec & ops,
+                                  const Config & config,
+                                  const ConstContextRcPtr & context,
+                                  const FileTransform & fileTransform,
+                                  const std::string & filepath,
+                                  TransformDirection dir)
+        {
+            FileFormat* format = NULL;
+            CachedFileRcPtr cachedFile;
+
+            try
+            {
+                GetCachedFileAndFormat(format, cachedFile, filepath);
+                // Add FileNoOp and keep track of it.
+                CreateFileNoOp(ops, filepath);
+                ConstOpRcPtr fileNoOpConst = ops.back();
+                OpRcPtr fileNoOp = ops.back();
+
+                // CTF implementation of FileFormat::buildFileOps might call
+                // BuildFileTransformOps for References.
+                format->buildFileOps(ops,
+                                     config, context,
+                                     cachedFile, fileTransform,
+                                     dir);
+
+                // File has been loaded completely. It may now be referenced again.
+                ConstOpDataRcPtr data = fileNoOpConst->data();
+                auto fileData = DynamicPtrCast<const FileNoOpData>(data);
+                if (fileData)
+                {
+                    fileData->setComplete();
+                }
+            }
+            catch (Exception & e)
+            {
+                std::ostringstream err;
+                err << "The transform file: " << filepath;
+                err << " failed while loading ops with this error: ";
+                err << e.what();
+                throw Exception(err.str().c_str());
+            }
+        }
+    }
+
     void BuildFileTransformOps(OpRcPtrVec & ops,
                                const Config& config,
                                const ConstContextRcPtr & context,
@@ -751,16 +1401,18 @@ OCIO_NAMESPACE_ENTER
         std::string filepath = context->resolveFileLocation(src.c_str());
 
         // Verify the recursion is valid, FileNoOp is added for each file.
+        bool isReference = false;
         for (ConstOpRcPtr&& op : ops)
         {
             ConstOpDataRcPtr data = op->data();
             auto fileData = DynamicPtrCast<const FileNoOpData>(data);
-            if (fileData)
+            if (fileData && !fileData->getComplete())
             {
+                isReference = true;
+
                 // Error if file is still being loaded and is the same as the
                 // one about to be loaded.
-                if (!fileData->getComplete() &&
-                    Platform::Strcasecmp(fileData->getPath().c_str(),
+                if (Platform::Strcasecmp(fileData->getPath().c_str(),
                                          filepath.c_str()) == 0)
                 {
                     std::ostringstream os;
@@ -772,39 +1424,196 @@ OCIO_NAMESPACE_ENTER
             }
         }
 
-        FileFormat* format = NULL;
-        CachedFileRcPtr cachedFile;
+        // Only the files of the transforms are deferred, the files referenced from
+        // inside a file being loaded are loaded with it.
+        if (g_lazyFileLoadingEnabled && !isReference)
+        {
+            // The lazy files of a processor share the snapshot of its config.
+            ConstConfigRcPtr configSnapshot;
+            for (ConstOpRcPtr op : ops)
+            {
+                ConstLazyFileOpRcPtr lazyOp = DynamicPtrCast<const LazyFileOp>(op);
+                if (lazyOp && lazyOp->getFile()->sourceConfig == &config)
+                {
+                    configSnapshot = lazyOp->getFile()->config;
+                    break;
+                }
+            }
+            if (!configSnapshot)
+            {
+                configSnapshot = config.createEditableCopy();
+            }
+
+            ops.push_back(std::make_shared<LazyFileOp>(
+                std::make_shared<LazyFile>(config, configSnapshot, context, fileTransform,
+                                           filepath, dir)));
+            return;
+        }
+
+        LoadFileTransformOps(ops, config, context, fileTransform, filepath, dir);
+    }
+
+    void SetLazyFileLoadingEnabled(bool enabled)
+    {
+        g_lazyFileLoadingEnabled = enabled;
+    }
 
-        try
+    bool IsLazyFileLoadingEnabled()
+    {
+        return g_lazyFileLoadingEnabled;
+    }
+
+    bool HasLazyFileOps(const OpRcPtrVec & ops)
+    {
+        for (ConstOpRcPtr op : ops)
         {
-            GetCachedFileAndFormat(format, cachedFile, filepath);
-            // Add FileNoOp and keep track of it.
-            CreateFileNoOp(ops, filepath);
-            ConstOpRcPtr fileNoOpConst = ops.back();
-            OpRcPtr fileNoOp = ops.back();
+            if (DynamicPtrCast<const LazyFileOp>(op))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
 
-            // CTF implementation of FileFormat::buildFileOps might call
-            // BuildFileTransformOps for References.
-            format->buildFileOps(ops,
-                                 config, context,
-                                 cachedFile, fileTransform,
-                                 dir);
+    int RemoveInverseLazyFileOps(OpRcPtrVec & ops)
+    {
+        int count = 0;
+        int firstindex = 0; // this must be a signed int
 
-            // File has been loaded completely. It may now be referenced again.
-            ConstOpDataRcPtr data = fileNoOpConst->data();
-            auto fileData = DynamicPtrCast<const FileNoOpData>(data);
-            if (fileData)
+        // Same backstepping as RemoveInverseOps() to handle the nested pairs
+        // (i.e. A, B, B', A').
+        while (firstindex < static_cast<int>(ops.size()) - 1)
+        {
+            ConstOpRcPtr first = ops[firstindex];
+            ConstOpRcPtr second = ops[firstindex + 1];
+
+            if (DynamicPtrCast<const LazyFileOp>(first)
+                && first->isSameType(second) && first->isInverse(second))
+            {
+                ops.erase(ops.begin() + firstindex, ops.begin() + firstindex + 2);
+                ++count;
+
+                firstindex = std::max(0, firstindex - 1);
+            }
+            else
+            {
+                ++firstindex;
+            }
+        }
+
+        return count;
+    }
+
+    void LoadLazyFileOps(OpRcPtrVec & ops)
+    {
+        OpRcPtrVec loadedOps;
+        loadedOps.getFormatMetadata() = ops.getFormatMetadata();
+
+        for (const auto & op : ops)
+        {
+            ConstOpRcPtr constOp = op;
+            ConstLazyFileOpRcPtr lazyOp = DynamicPtrCast<const LazyFileOp>(constOp);
+            if (lazyOp)
+            {
+                // Also combines the format metadata of the file.
+                loadedOps += lazyOp->load();
+            }
+            else
+            {
+                loadedOps.push_back(op);
+            }
+        }
+
+        ops = loadedOps;
+    }
+
+    void SetFileLoadingThreads(unsigned numThreads)
+    {
+        g_fileLoadingThreads = numThreads;
+    }
+
+    unsigned GetFileLoadingThreads()
+    {
+        return g_fileLoadingThreads;
+    }
+
+    void PrefetchFiles(const ConstContextRcPtr & context, const StringSet & fileReferences)
+    {
+        unsigned maxThreads = g_fileLoadingThreads;
+        if (maxThreads == 0)
+        {
+            maxThreads = std::thread::hardware_concurrency();
+        }
+
+        if (maxThreads <= 1 || fileReferences.size() < 2 || g_lazyFileLoadingEnabled)
+        {
+            return;
+        }
+
+        // Only the files to read are worth a thread. The errors (e.g. a missing file) are
+        // reported when building the ops.
+        StringVec filepaths;
+        for (const auto & fileReference : fileReferences)
+        {
+            try
+            {
+                const std::string filepath = context->resolveFileLocation(fileReference.c_str());
+
+                FileCacheShard & shard = g_fileCache.get(filepath);
+                AutoMutex lock(shard.mutex);
+                if (shard.cache.find(filepath) == shard.cache.end())
+                {
+                    filepaths.push_back(filepath);
+                }
+            }
+            catch (Exception &)
+            {
+            }
+        }
+
+        if (filepaths.size() < 2)
+        {
+            return;
+        }
+
+        std::atomic<size_t> next(0);
+        auto loadFiles = [&filepaths, &next]()
+        {
+            for (size_t idx = next++; idx < filepaths.size(); idx = next++)
+            {
+                try
+                {
+                    FileFormat * format = nullptr;
+                    CachedFileRcPtr cachedFile;
+                    GetCachedFileAndFormat(format, cachedFile, filepaths[idx]);
+                }
+                catch (Exception &)
+                {
+                    // The error is cached with the file.
+                }
+            }
+        };
+
+        // The calling thread also reads files.
+        const size_t numThreads = std::min(filepaths.size(), size_t(maxThreads));
+        std::vector<std::thread> threads;
+        for (size_t t = 1; t < numThreads; ++t)
+        {
+            try
+            {
+                threads.emplace_back(loadFiles);
+            }
+            catch (std::system_error &)
             {
-                fileData->setComplete();
+                break;
             }
         }
-        catch (Exception & e)
+
+        loadFiles();
+
+        for (auto & thread : threads)
         {
-            std::ostringstream err;
-            err << "The transform file: " << filepath;
-            err << " failed while loading ops with this error: ";
-            err << e.what();
-            throw Exception(err.str().c_str());
+            thread.join();
         }
     }
 }
@@ -814,6 +1623,7 @@ OCIO_NAMESPACE_EXIT
 
 namespace OCIO = OCIO_NAMESPACE;
 #include <algorithm>
+#include <cstdio>
 #include "UnitTest.h"
 #include "UnitTestUtils.h"
 
@@ -895,6 +1705,556 @@ OCIO_ADD_TEST(FileTransform, LoadFileOK)
     OCIO_CHECK_ASSERT(!proc->isNoOp());
 }
 
+OCIO_ADD_TEST(FileTransform, file_cache_budget)
+{
+    OCIO::ClearAllCaches();
+    const size_t defaultBudget = OCIO::GetFileCacheMemoryBudget();
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheNumEntries(), 0);
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheMemoryUsage(), 0);
+
+    const unsigned long hits = OCIO::GetFileCacheNumHits();
+    const unsigned long misses = OCIO::GetFileCacheNumMisses();
+
+    // A 33x33x33 3D LUT.
+    const std::string lustre3DtLut("lustre_33x33x33.3dl");
+    OCIO_CHECK_NO_THROW(OCIO::GetFileTransformProcessor(lustre3DtLut));
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheNumEntries(), 1);
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheNumMisses(), misses + 1);
+    const size_t lut3DSize = OCIO::GetFileCacheMemoryUsage();
+    OCIO_CHECK_GT(lut3DSize, 33 * 33 * 33 * 3 * sizeof(float));
+
+    OCIO_CHECK_NO_THROW(OCIO::GetFileTransformProcessor(lustre3DtLut));
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheNumEntries(), 1);
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheNumHits(), hits + 1);
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheMemoryUsage(), lut3DSize);
+
+    const std::string discreetLut("logtolin_8to8.lut");
+    OCIO_CHECK_NO_THROW(OCIO::GetFileTransformProcessor(discreetLut));
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheNumEntries(), 2);
+    const size_t lut1DSize = OCIO::GetFileCacheMemoryUsage() - lut3DSize;
+    OCIO_CHECK_LT(lut1DSize, lut3DSize);
+
+    // The least recently used file is discarded when the budget is exceeded.
+    OCIO::SetFileCacheMemoryBudget(lut3DSize);
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheNumEntries(), 1);
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheMemoryUsage(), lut1DSize);
+
+    OCIO_CHECK_NO_THROW(OCIO::GetFileTransformProcessor(lustre3DtLut));
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheNumEntries(), 1);
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheMemoryUsage(), lut3DSize);
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheNumMisses(), misses + 3);
+
+    // No limit.
+    OCIO::SetFileCacheMemoryBudget(0);
+    OCIO_CHECK_NO_THROW(OCIO::GetFileTransformProcessor(discreetLut));
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheNumEntries(), 2);
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheMemoryUsage(), lut3DSize + lut1DSize);
+
+    OCIO::SetFileCacheMemoryBudget(defaultBudget);
+    OCIO::ClearAllCaches();
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheNumEntries(), 0);
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheMemoryUsage(), 0);
+}
+
+OCIO_ADD_TEST(FileTransform, file_cache_shards)
+{
+    OCIO::ClearAllCaches();
+    const size_t defaultBudget = OCIO::GetFileCacheMemoryBudget();
+
+    std::vector<std::string> filenames(32);
+    for (auto & filename : filenames)
+    {
+        OCIO_CHECK_NO_THROW(OCIO::Platform::CreateTempFilename(filename, ".spi1d"));
+
+        std::fstream stream(filename, std::ios_base::out|std::ios_base::trunc);
+        stream << "Version 1\nFrom 0.0 1.0\nLength 2\nComponents 1\n{\n0.0\n1.0\n}\n";
+        stream.close();
+    }
+
+    // Return the memory size of the cached file, 0 if the file is not cached.
+    auto cachedSize = [](const std::string & filename) -> size_t
+    {
+        OCIO::FileCacheShard & shard = OCIO::g_fileCache.get(filename);
+        OCIO::AutoMutex lock(shard.mutex);
+        OCIO::FileCacheMap::const_iterator iter = shard.cache.find(filename);
+        return iter == shard.cache.end() ? 0 : iter->second->memorySize;
+    };
+
+    OCIO::FileFormat * format = nullptr;
+    OCIO::CachedFileRcPtr cachedFile;
+    for (const auto & filename : filenames)
+    {
+        OCIO_CHECK_NO_THROW(OCIO::GetCachedFileAndFormat(format, cachedFile, filename));
+    }
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheNumEntries(), filenames.size());
+
+    // The entries are spread across the shards.
+    size_t numEntries = 0;
+    size_t numUsedShards = 0;
+    for (size_t i = 0; i < OCIO::g_fileCache.size(); ++i)
+    {
+        OCIO::FileCacheShard & shard = OCIO::g_fileCache[i];
+        OCIO_CHECK_EQUAL(shard.lru.size(), shard.cache.size());
+        numEntries += shard.cache.size();
+        numUsedShards += shard.cache.empty() ? 0 : 1;
+    }
+    OCIO_CHECK_EQUAL(numEntries, filenames.size());
+    OCIO_CHECK_GT(numUsedShards, 1);
+
+    // The least recently used files are discarded first, whatever their shard.
+    OCIO_CHECK_NO_THROW(OCIO::GetCachedFileAndFormat(format, cachedFile, filenames[0]));
+
+    OCIO::SetFileCacheMemoryBudget(OCIO::GetFileCacheMemoryUsage() - cachedSize(filenames[1]));
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheNumEntries(), filenames.size() - 1);
+    OCIO_CHECK_EQUAL(cachedSize(filenames[1]), 0);
+
+    OCIO::SetFileCacheMemoryBudget(OCIO::GetFileCacheMemoryUsage() - cachedSize(filenames[2]));
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheNumEntries(), filenames.size() - 2);
+    OCIO_CHECK_EQUAL(cachedSize(filenames[2]), 0);
+
+    OCIO_CHECK_GT(cachedSize(filenames[0]), 0);
+    OCIO_CHECK_GT(cachedSize(filenames[3]), 0);
+
+    OCIO::SetFileCacheMemoryBudget(defaultBudget);
+
+    // Clearing the cache while a file is loaded. The entry is added as the first lookup
+    // does and is locked as by the thread loading it.
+    OCIO::ClearAllCaches();
+    OCIO::FileCacheResultPtr result;
+    {
+        OCIO::FileCacheShard & shard = OCIO::g_fileCache.get(filenames[0]);
+        OCIO::AutoMutex lock(shard.mutex);
+        result = OCIO::AddFileCacheEntry(shard, filenames[0]);
+    }
+
+    OCIO::CachedFileRcPtr loadedFile;
+    std::thread loader;
+    {
+        OCIO::AutoMutex lock(result->mutex);
+        loader = std::thread([&filenames, &loadedFile]()
+        {
+            OCIO::FileFormat * loadedFormat = nullptr;
+            OCIO::GetCachedFileAndFormat(loadedFormat, loadedFile, filenames[0]);
+        });
+
+        // Wait for the loader to find the entry.
+        while (result.use_count() < 3)
+        {
+            std::this_thread::yield();
+        }
+
+        OCIO::ClearAllCaches();
+        OCIO_CHECK_EQUAL(OCIO::GetFileCacheNumEntries(), 0);
+    }
+    loader.join();
+
+    // The file is loaded but the discarded entry is not accounted.
+    OCIO_CHECK_ASSERT(loadedFile);
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheNumEntries(), 0);
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheMemoryUsage(), 0);
+
+    OCIO_CHECK_NO_THROW(OCIO::GetCachedFileAndFormat(format, cachedFile, filenames[0]));
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheNumEntries(), 1);
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheMemoryUsage(), cachedSize(filenames[0]));
+
+    OCIO::ClearAllCaches();
+    for (const auto & filename : filenames)
+    {
+        std::remove(filename.c_str());
+    }
+}
+
+OCIO_ADD_TEST(FileTransform, file_cache_check_interval)
+{
+    std::string filename;
+    OCIO_CHECK_NO_THROW(OCIO::Platform::CreateTempFilename(filename, ".spi1d"));
+
+    std::fstream stream(filename, std::ios_base::out|std::ios_base::trunc);
+    stream << "Version 1\nFrom 0.0 1.0\nLength 2\nComponents 1\n{\n0.0\n1.0\n}\n";
+    stream.close();
+
+    OCIO::ClearAllCaches();
+    OCIO::SetFileCacheCheckInterval(0.0);
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    OCIO::FileTransformRcPtr file = OCIO::FileTransform::Create();
+    file->setSrc(filename.c_str());
+    file->setInterpolation(OCIO::INTERP_LINEAR);
+
+    OCIO::ConstProcessorRcPtr proc;
+    OCIO_CHECK_NO_THROW(proc = config->getProcessor(file));
+    float pixel[3] = { 1.0f, 1.0f, 1.0f };
+    proc->getDefaultCPUProcessor()->applyRGB(pixel);
+    OCIO_CHECK_EQUAL(pixel[0], 1.0f);
+
+    // The file is unchanged.
+    OCIO_CHECK_EQUAL(config->getProcessor(file).get(), proc.get());
+    const unsigned long misses = OCIO::GetFileCacheNumMisses();
+
+    // Only the modified file is read again.
+    stream.open(filename, std::ios_base::out|std::ios_base::trunc);
+    stream << "Version 1\nFrom 0.0 1.0\nLength 3\nComponents 1\n{\n0.0\n0.25\n0.5\n}\n";
+    stream.close();
+
+    OCIO::ConstProcessorRcPtr proc2;
+    OCIO_CHECK_NO_THROW(proc2 = config->getProcessor(file));
+    OCIO_CHECK_NE(proc2.get(), proc.get());
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheNumMisses(), misses + 1);
+    pixel[0] = pixel[1] = pixel[2] = 1.0f;
+    proc2->getDefaultCPUProcessor()->applyRGB(pixel);
+    OCIO_CHECK_EQUAL(pixel[0], 0.5f);
+
+    // The new processor replaces the stale one in the processor cache.
+    OCIO_CHECK_EQUAL(config->getProcessor(file).get(), proc2.get());
+
+    OCIO::SetFileCacheCheckInterval(-1.0);
+    OCIO::ClearAllCaches();
+    std::remove(filename.c_str());
+}
+
+OCIO_ADD_TEST(FileTransform, file_cache_stale_processors)
+{
+    std::string filename1, filename2;
+    OCIO_CHECK_NO_THROW(OCIO::Platform::CreateTempFilename(filename1, ".spi1d"));
+    OCIO_CHECK_NO_THROW(OCIO::Platform::CreateTempFilename(filename2, ".spi1d"));
+
+    const char * content = "Version 1\nFrom 0.0 1.0\nLength 2\nComponents 1\n{\n0.0\n1.0\n}\n";
+    std::fstream stream(filename1, std::ios_base::out|std::ios_base::trunc);
+    stream << content;
+    stream.close();
+    stream.open(filename2, std::ios_base::out|std::ios_base::trunc);
+    stream << content;
+    stream.close();
+
+    OCIO::ClearAllCaches();
+    OCIO::SetFileCacheCheckInterval(0.0);
+
+    OCIO::ConfigRcPtr config1 = OCIO::Config::Create();
+    OCIO::ConfigRcPtr config2 = OCIO::Config::Create();
+    OCIO::FileTransformRcPtr file1 = OCIO::FileTransform::Create();
+    file1->setSrc(filename1.c_str());
+    file1->setInterpolation(OCIO::INTERP_LINEAR);
+    OCIO::FileTransformRcPtr file2 = OCIO::FileTransform::Create();
+    file2->setSrc(filename2.c_str());
+    file2->setInterpolation(OCIO::INTERP_LINEAR);
+
+    OCIO::ConstProcessorRcPtr proc11, proc12, proc21, proc22;
+    OCIO_CHECK_NO_THROW(proc11 = config1->getProcessor(file1));
+    OCIO_CHECK_NO_THROW(proc12 = config1->getProcessor(file2));
+    OCIO_CHECK_NO_THROW(proc21 = config2->getProcessor(file1));
+    OCIO_CHECK_NO_THROW(proc22 = config2->getProcessor(file2));
+
+    stream.open(filename1, std::ios_base::out|std::ios_base::trunc);
+    stream << "Version 1\nFrom 0.0 1.0\nLength 3\nComponents 1\n{\n0.0\n0.25\n0.5\n}\n";
+    stream.close();
+
+    // The modification is found by the first config.
+    OCIO::ConstProcessorRcPtr proc;
+    OCIO_CHECK_NO_THROW(proc = config1->getProcessor(file1));
+    OCIO_CHECK_NE(proc.get(), proc11.get());
+    OCIO_CHECK_EQUAL(config1->getProcessor(file1).get(), proc.get());
+
+    // The processors of the other file are still cached.
+    OCIO_CHECK_EQUAL(config1->getProcessor(file2).get(), proc12.get());
+    OCIO_CHECK_EQUAL(config2->getProcessor(file2).get(), proc22.get());
+
+    // The processor of the modified file is discarded by the other config too.
+    OCIO_CHECK_NO_THROW(proc = config2->getProcessor(file1));
+    OCIO_CHECK_NE(proc.get(), proc21.get());
+    float pixel[3] = { 1.0f, 1.0f, 1.0f };
+    proc->getDefaultCPUProcessor()->applyRGB(pixel);
+    OCIO_CHECK_EQUAL(pixel[0], 0.5f);
+    OCIO_CHECK_EQUAL(config2->getProcessor(file1).get(), proc.get());
+
+    OCIO::SetFileCacheCheckInterval(-1.0);
+    OCIO::ClearAllCaches();
+    std::remove(filename1.c_str());
+    std::remove(filename2.c_str());
+}
+
+OCIO_ADD_TEST(FileTransform, lazy_file_loading)
+{
+    std::string filename;
+    OCIO_CHECK_NO_THROW(OCIO::Platform::CreateTempFilename(filename, ".spi1d"));
+
+    // The content is invalid to prove that the file is not read.
+    std::fstream stream(filename, std::ios_base::out|std::ios_base::trunc);
+    stream << "Not a LUT\n";
+    stream.close();
+
+    OCIO::ClearAllCaches();
+    OCIO::SetLazyFileLoadingEnabled(true);
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    OCIO::FileTransformRcPtr file = OCIO::FileTransform::Create();
+    file->setSrc(filename.c_str());
+    file->setInterpolation(OCIO::INTERP_LINEAR);
+    OCIO::FileTransformRcPtr inverse = OCIO::DynamicPtrCast<OCIO::FileTransform>(
+        file->createEditableCopy());
+    inverse->setDirection(OCIO::TRANSFORM_DIR_INVERSE);
+
+    OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+    group->push_back(file);
+    group->push_back(inverse);
+
+    // The file followed by its inverse is never read.
+    OCIO::ConstProcessorRcPtr proc;
+    OCIO_CHECK_NO_THROW(proc = config->getProcessor(group));
+    OCIO::ConstCPUProcessorRcPtr cpu;
+    OCIO_CHECK_NO_THROW(cpu = proc->getDefaultCPUProcessor());
+    float pixel[3] = { 0.3f, 0.3f, 0.3f };
+    cpu->applyRGB(pixel);
+    OCIO_CHECK_EQUAL(pixel[0], 0.3f);
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheNumEntries(), 0);
+
+    // Otherwise the file is read when needed.
+    OCIO_CHECK_NO_THROW(proc = config->getProcessor(file));
+    OCIO_CHECK_THROW_WHAT(proc->getDefaultCPUProcessor(), OCIO::Exception,
+                          "failed while loading ops");
+    OCIO_CHECK_THROW_WHAT(proc->getCacheID(), OCIO::Exception, "failed while loading ops");
+
+    // A missing file is still reported when building the processor.
+    file->setSrc("missing_lazy_file.spi1d");
+    OCIO_CHECK_THROW_WHAT(config->getProcessor(file), OCIO::Exception, "could not be located");
+
+    // The loaded files give the same ops.
+    stream.open(filename, std::ios_base::out|std::ios_base::trunc);
+    stream << "Version 1\nFrom 0.0 1.0\nLength 3\nComponents 1\n{\n0.0\n0.25\n0.5\n}\n";
+    stream.close();
+    OCIO::ClearAllCaches();
+
+    file->setSrc(filename.c_str());
+    OCIO_CHECK_NO_THROW(proc = config->getProcessor(file));
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheNumEntries(), 0);
+
+    pixel[0] = pixel[1] = pixel[2] = 1.0f;
+    OCIO_CHECK_NO_THROW(cpu = proc->getDefaultCPUProcessor());
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheNumEntries(), 1);
+    cpu->applyRGB(pixel);
+    OCIO_CHECK_EQUAL(pixel[0], 0.5f);
+    OCIO_CHECK_EQUAL(proc->getProcessorMetadata()->getNumFiles(), 1);
+
+    OCIO::SetLazyFileLoadingEnabled(false);
+
+    OCIO::ConstProcessorRcPtr eagerProc;
+    OCIO_CHECK_NO_THROW(eagerProc = config->getProcessor(file));
+    OCIO_CHECK_NE(eagerProc.get(), proc.get());
+    OCIO_CHECK_EQUAL(std::string(eagerProc->getCacheID()), proc->getCacheID());
+    OCIO_CHECK_EQUAL(eagerProc->getNumTransforms(), proc->getNumTransforms());
+
+    OCIO::ClearAllCaches();
+    std::remove(filename.c_str());
+}
+
+OCIO_ADD_TEST(FileTransform, lazy_file_config)
+{
+    const std::string filename = std::string(OCIO::getTestFilesDir()) + "/cdl_test1.cc";
+
+    OCIO::ClearAllCaches();
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    config->setProcessorCacheEnabled(false);
+    config->setMajorVersion(1);
+
+    OCIO::FileTransformRcPtr file = OCIO::FileTransform::Create();
+    file->setSrc(filename.c_str());
+
+    // The CDL ops depend on the config version.
+    OCIO::ConstProcessorRcPtr eagerProc;
+    OCIO_CHECK_NO_THROW(eagerProc = config->getProcessor(file));
+    config->setMajorVersion(2);
+    OCIO::ConstProcessorRcPtr eagerProc2;
+    OCIO_CHECK_NO_THROW(eagerProc2 = config->getProcessor(file));
+    OCIO_CHECK_NE(std::string(eagerProc->getCacheID()), eagerProc2->getCacheID());
+
+    OCIO::SetLazyFileLoadingEnabled(true);
+    config->setMajorVersion(1);
+    OCIO::ConstProcessorRcPtr proc;
+    OCIO_CHECK_NO_THROW(proc = config->getProcessor(file));
+    OCIO::SetLazyFileLoadingEnabled(false);
+
+    // The file is loaded with the config of the processor creation, even once the config
+    // is modified or released.
+    config->setMajorVersion(2);
+    config.reset();
+    OCIO_CHECK_EQUAL(std::string(proc->getCacheID()), eagerProc->getCacheID());
+
+    OCIO::ClearAllCaches();
+}
+
+OCIO_ADD_TEST(FileTransform, prefetch_files)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+
+    std::vector<std::string> filenames(3);
+    for (size_t idx = 0; idx < filenames.size(); ++idx)
+    {
+        std::string & filename = filenames[idx];
+        OCIO_CHECK_NO_THROW(OCIO::Platform::CreateTempFilename(filename, ".spi1d"));
+
+        std::fstream stream(filename, std::ios_base::out|std::ios_base::trunc);
+        stream << "Version 1\nFrom 0.0 1.0\nLength 2\nComponents 1\n{\n0.0\n1.0\n}\n";
+        stream.close();
+
+        OCIO::FileTransformRcPtr file = OCIO::FileTransform::Create();
+        file->setSrc(filename.c_str());
+        file->setInterpolation(OCIO::INTERP_LINEAR);
+        group->push_back(file);
+
+        // The files of the color spaces are collected too.
+        OCIO::ColorSpaceRcPtr cs = OCIO::ColorSpace::Create();
+        cs->setName(("cs" + std::to_string(idx)).c_str());
+        cs->setTransform(file, OCIO::COLORSPACE_DIR_TO_REFERENCE);
+        config->addColorSpace(cs);
+    }
+
+    OCIO::SetFileLoadingThreads(4);
+
+    // The files are read ahead, the ops building then finds them in the cache.
+    OCIO::ClearAllCaches();
+    unsigned long hits = OCIO::GetFileCacheNumHits();
+    unsigned long misses = OCIO::GetFileCacheNumMisses();
+    OCIO_CHECK_NO_THROW(config->getProcessor(group));
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheNumEntries(), 3);
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheNumMisses(), misses + 3);
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheNumHits(), hits + 3);
+
+    OCIO::ClearAllCaches();
+    hits = OCIO::GetFileCacheNumHits();
+    misses = OCIO::GetFileCacheNumMisses();
+    OCIO_CHECK_NO_THROW(config->getProcessor("cs0", "cs1"));
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheNumMisses(), misses + 2);
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheNumHits(), hits + 2);
+
+    // A single thread only reads the files while building the ops.
+    OCIO::SetFileLoadingThreads(1);
+    OCIO::ClearAllCaches();
+    hits = OCIO::GetFileCacheNumHits();
+    misses = OCIO::GetFileCacheNumMisses();
+    OCIO_CHECK_NO_THROW(config->getProcessor(group));
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheNumMisses(), misses + 3);
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheNumHits(), hits);
+
+    // The errors are still reported by the ops building.
+    OCIO::SetFileLoadingThreads(4);
+    OCIO::ClearAllCaches();
+    std::fstream stream(filenames[1], std::ios_base::out|std::ios_base::trunc);
+    stream << "Not a LUT\n";
+    stream.close();
+    OCIO_CHECK_THROW_WHAT(config->getProcessor(group), OCIO::Exception,
+                          "failed while loading ops");
+
+    OCIO::FileTransformRcPtr missing = OCIO::FileTransform::Create();
+    missing->setSrc("missing_prefetched_file.spi1d");
+    group = OCIO::GroupTransform::Create();
+    group->push_back(missing);
+    group->push_back(config->getColorSpace("cs0")->getTransform(OCIO::COLORSPACE_DIR_TO_REFERENCE));
+    OCIO_CHECK_THROW_WHAT(config->getProcessor(group), OCIO::Exception, "could not be located");
+
+    OCIO::SetFileLoadingThreads(0);
+    OCIO::ClearAllCaches();
+    for (const auto & filename : filenames)
+    {
+        std::remove(filename.c_str());
+    }
+}
+
+OCIO_ADD_TEST(FileTransform, memory_stream)
+{
+    const std::string content("LUT_1D_SIZE 2\n0 0 0\n1 1 1\n");
+    OCIO::InputMemoryStream istream(content.data(), content.size());
+
+    std::string token;
+    OCIO_CHECK_ASSERT(istream >> token);
+    OCIO_CHECK_EQUAL(token, "LUT_1D_SIZE");
+    OCIO_CHECK_EQUAL(int(istream.tellg()), 11);
+
+    // Readers may rewind the stream to probe the content.
+    istream.seekg(0, istream.beg);
+    std::string line;
+    OCIO_CHECK_ASSERT(std::getline(istream, line));
+    OCIO_CHECK_EQUAL(line, "LUT_1D_SIZE 2");
+
+    istream.seekg(-6, istream.end);
+    OCIO_CHECK_ASSERT(std::getline(istream, line));
+    OCIO_CHECK_EQUAL(line, "1 1 1");
+    OCIO_CHECK_ASSERT(!std::getline(istream, line));
+
+    istream.clear();
+    istream.seekg(100);
+    OCIO_CHECK_ASSERT(istream.fail());
+
+    // The default buffer read goes through the stream read.
+    OCIO::FormatRegistry & registry = OCIO::FormatRegistry::GetInstance();
+    OCIO::FileFormat * spi1d = registry.getFileFormatByName("spi1d");
+    OCIO_REQUIRE_ASSERT(spi1d);
+    const std::string spi1dContent("Version 1\nFrom 0.0 1.0\nLength 2\nComponents 1\n"
+                                   "{\n0.0\n1.0\n}\n");
+    OCIO_CHECK_NO_THROW(spi1d->readBuffer(spi1dContent.data(), spi1dContent.size(), "a.spi1d"));
+    OCIO_CHECK_THROW_WHAT(spi1d->readBuffer(content.data(), content.size(), "a.spi1d"),
+                          OCIO::Exception, "a.spi1d");
+}
+
+OCIO_ADD_TEST(FileTransform, format_probe)
+{
+    OCIO::FormatRegistry & registry = OCIO::FormatRegistry::GetInstance();
+    auto probe = [&registry](const std::string & formatName, const std::string & content)
+    {
+        OCIO::FileFormat * format = registry.getFileFormatByName(formatName);
+        return format ? format->probe(content.data(), content.size()) : -1;
+    };
+
+    const std::string cube("# Comment\nLUT_3D_SIZE 2\n0 0 0\n");
+    OCIO_CHECK_EQUAL(probe("iridas_cube", cube), OCIO::FORMAT_PROBE_LIKELY);
+    OCIO_CHECK_EQUAL(probe("resolve_cube", cube), OCIO::FORMAT_PROBE_LIKELY);
+    OCIO_CHECK_EQUAL(probe("spi1d", cube), OCIO::FORMAT_PROBE_MAYBE);
+    OCIO_CHECK_EQUAL(probe("spi3d", cube), OCIO::FORMAT_PROBE_NO);
+    OCIO_CHECK_EQUAL(probe("cinespace", cube), OCIO::FORMAT_PROBE_NO);
+    OCIO_CHECK_EQUAL(probe("truelight", cube), OCIO::FORMAT_PROBE_NO);
+    OCIO_CHECK_EQUAL(probe(OCIO::FILEFORMAT_CLF, cube), OCIO::FORMAT_PROBE_NO);
+    OCIO_CHECK_EQUAL(probe("icc profile", cube), OCIO::FORMAT_PROBE_NO);
+
+    // The byte order mark, the leading spaces and the case are ignored.
+    const std::string spi3d("\xEF\xBB\xBF\n  SPILUT 1.0\n3 3\n");
+    OCIO_CHECK_EQUAL(probe("spi3d", spi3d), OCIO::FORMAT_PROBE_LIKELY);
+
+    const std::string clf("\xEF\xBB\xBF<?xml version=\"1.0\"?>\n<ProcessList id=\"1\">\n");
+    OCIO_CHECK_EQUAL(probe(OCIO::FILEFORMAT_CLF, clf), OCIO::FORMAT_PROBE_LIKELY);
+    OCIO_CHECK_EQUAL(probe("colorcorrection", clf), OCIO::FORMAT_PROBE_MAYBE);
+    OCIO_CHECK_EQUAL(probe("iridas_cube", clf), OCIO::FORMAT_PROBE_MAYBE);
+
+    // Binary content is rejected by the text formats.
+    const std::string png("\x89PNG\r\n\x1a\n\0\0\0\rIHDR", 16);
+    OCIO_CHECK_EQUAL(probe("iridas_cube", png), OCIO::FORMAT_PROBE_NO);
+    OCIO_CHECK_EQUAL(probe("spi1d", png), OCIO::FORMAT_PROBE_NO);
+    OCIO_CHECK_EQUAL(probe("houdini", png), OCIO::FORMAT_PROBE_NO);
+    OCIO_CHECK_EQUAL(probe(OCIO::FILEFORMAT_CLF, png), OCIO::FORMAT_PROBE_NO);
+    OCIO_CHECK_EQUAL(probe("icc profile", png), OCIO::FORMAT_PROBE_NO);
+
+    std::string icc(128, '\0');
+    icc.replace(36, 4, "acsp");
+    OCIO_CHECK_EQUAL(probe("icc profile", icc), OCIO::FORMAT_PROBE_LIKELY);
+
+    // A misnamed file is still loaded by the format matching its content.
+    std::string filename;
+    OCIO_CHECK_NO_THROW(OCIO::Platform::CreateTempFilename(filename, ".txt"));
+    {
+        std::fstream stream(filename, std::ios_base::out|std::ios_base::trunc);
+        stream << "Version 1\nFrom 0.0 1.0\nLength 2\nComponents 1\n{\n0.0\n0.5\n}\n";
+    }
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    OCIO::FileTransformRcPtr file = OCIO::FileTransform::Create();
+    file->setSrc(filename.c_str());
+    file->setInterpolation(OCIO::INTERP_LINEAR);
+
+    OCIO::ConstProcessorRcPtr proc;
+    OCIO_CHECK_NO_THROW(proc = config->getProcessor(file));
+    OCIO_CHECK_ASSERT(proc && !proc->isNoOp());
+    std::remove(filename.c_str());
+}
+
 OCIO_ADD_TEST(FileTransform, LoadFileFail)
 {
     // Legacy Lustre 1D LUT files. Similar to supported formats but actually
@@ -983,7 +2343,7 @@ OCIO_ADD_TEST(FileTransform, AllFormats)
     OCIO_CHECK_EQUAL(19, formatRegistry.getNumRawFormats());
     OCIO_CHECK_EQUAL(24, formatRegistry.getNumFormats(OCIO::FORMAT_CAPABILITY_READ));
     OCIO_CHECK_EQUAL(8, formatRegistry.getNumFormats(OCIO::FORMAT_CAPABILITY_BAKE));
-    OCIO_CHECK_EQUAL(2, formatRegistry.getNumFormats(OCIO::FORMAT_CAPABILITY_WRITE));
+    OCIO_CHECK_EQUAL(3, formatRegistry.getNumFormats(OCIO::FORMAT_CAPABILITY_WRITE));
 
     OCIO_CHECK_ASSERT(FormatNameFoundByExtension("3dl", "flame"));
     OCIO_CHECK_ASSERT(FormatNameFoundByExtension("cc", "ColorCorrection"));
@@ -1018,6 +2378,7 @@ OCIO_ADD_TEST(FileTransform, AllFormats)
     OCIO_CHECK_ASSERT(FormatExtensionFoundByName("cdl", "ColorDecisionList"));
     OCIO_CHECK_ASSERT(FormatExtensionFoundByName("clf", OCIO::FILEFORMAT_CLF));
     OCIO_CHECK_ASSERT(FormatExtensionFoundByName("ctf", OCIO::FILEFORMAT_CTF));
+    OCIO_CHECK_ASSERT(FormatExtensionFoundByName("ctf", OCIO::FILEFORMAT_CTF_BINARY));
     OCIO_CHECK_ASSERT(FormatExtensionFoundByName("csp", "cinespace"));
     OCIO_CHECK_ASSERT(FormatExtensionFoundByName("cub", "truelight"));
     OCIO_CHECK_ASSERT(FormatExtensionFoundByName("cube", "iridas_cube"));
@@ -5,7 +5,9 @@
 #ifndef INCLUDED_OCIO_FILETRANSFORM_H
 #define INCLUDED_OCIO_FILETRANSFORM_H
 
+#include <istream>
 #include <map>
+#include <streambuf>
 
 #include <OpenColorIO/OpenColorIO.h>
 
@@ -17,21 +19,65 @@
 OCIO_NAMESPACE_ENTER
 {
     void ClearFileTransformCaches();
-    
+
+    // When the file cache checks are enabled (see SetFileCacheCheckInterval()) and the check
+    // interval has elapsed, check that the cached file was not modified on disk. A modified
+    // file is discarded from the file cache and gets a new version (see IsFileNewerThan()).
+    bool IsCachedFileStale(const std::string & filepath);
+
+    // The versions of the files found modified on disk are taken from a global clock. A
+    // processor built after reading the clock is out of date when one of its files is newer,
+    // so only the processors referencing a modified file are discarded from the caches.
+    unsigned long long GetFileVersionClock();
+    bool IsFileNewerThan(const std::string & filepath, unsigned long long version);
+
+    // When the lazy file loading is enabled (see SetLazyFileLoadingEnabled()), the file
+    // transforms are built as placeholder ops which are replaced by the ops of their file
+    // on demand.
+    bool HasLazyFileOps(const OpRcPtrVec & ops);
+
+    // Remove the placeholder ops directly followed by their inverse (i.e. the same file in
+    // the opposite direction) without loading the files. Returns the number of removed pairs.
+    // Nothing is known about the content of a file before loading it, so only the adjacent
+    // pairs (or nested adjacent pairs) are removed. The other inverse pairs are left to the
+    // optimization of the loaded ops.
+    int RemoveInverseLazyFileOps(OpRcPtrVec & ops);
+
+    // Replace the placeholder ops by the finalized ops of their file. A file is only loaded
+    // once for all the copies of its placeholder op.
+    void LoadLazyFileOps(OpRcPtrVec & ops);
+
+    // Read concurrently the files which are not in the file cache yet, so the ops building
+    // then finds them in the cache (refer to SetFileLoadingThreads()). The references are
+    // resolved by the context, the errors are left to the ops building.
+    void PrefetchFiles(const ConstContextRcPtr & context, const StringSet & fileReferences);
+
     class CachedFile
     {
     public:
         CachedFile() {};
         virtual ~CachedFile() {};
+
+        // Approximate memory footprint in bytes, used to bound the file cache.
+        // Formats holding LUTs must account for their values.
+        virtual size_t getMemorySize() const { return sizeof(CachedFile); }
     };
     
     typedef OCIO_SHARED_PTR<CachedFile> CachedFileRcPtr;
+
+    class BinaryCacheReader;
+    class BinaryCacheWriter;
     
     const int FORMAT_CAPABILITY_NONE = 0;
     const int FORMAT_CAPABILITY_READ = 1;
     const int FORMAT_CAPABILITY_BAKE = 2;
     const int FORMAT_CAPABILITY_WRITE = 4;
 
+    // Result of FileFormat::probe().
+    const int FORMAT_PROBE_NO = 0;      // The content can not be read by the format.
+    const int FORMAT_PROBE_MAYBE = 1;   // Unknown until the content is parsed.
+    const int FORMAT_PROBE_LIKELY = 2;  // The content has the signature of the format.
+
     struct FormatInfo
     {
         std::string name;       // name must be globally unique
@@ -45,6 +91,31 @@ OCIO_NAMESPACE_ENTER
     
     typedef std::vector<FormatInfo> FormatInfoVec;
 
+    // Read-only stream buffer over a memory block, which is neither copied nor owned.
+    // Seeking is supported as some readers rewind the stream to probe its content.
+    class MemoryStreamBuf : public std::streambuf
+    {
+    public:
+        MemoryStreamBuf(const char * data, size_t size);
+
+    protected:
+        pos_type seekoff(off_type off,
+                         std::ios_base::seekdir dir,
+                         std::ios_base::openmode which) override;
+        pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+    };
+
+    // Input stream over a memory block, used to hand a file already in memory to the
+    // readers only parsing from a stream.
+    class InputMemoryStream : public std::istream
+    {
+    public:
+        InputMemoryStream(const char * data, size_t size);
+
+    private:
+        MemoryStreamBuf m_buffer;
+    };
+
     class FileFormat
     {
     public:
@@ -58,6 +129,15 @@ OCIO_NAMESPACE_ENTER
         virtual CachedFileRcPtr read(
             std::istream & istream,
             const std::string & originalFileName) const = 0;
+
+        // read the whole content of a file, which is memory-mapped (or read in one go)
+        // once and shared by all the formats tried for that file. The default wraps the
+        // buffer in a stream and calls read(), formats able to parse directly from
+        // memory override it to skip the stream layer.
+        virtual CachedFileRcPtr readBuffer(
+            const char * data,
+            size_t size,
+            const std::string & originalFileName) const;
         
         virtual void bake(const Baker & baker,
                           const std::string & formatName,
@@ -75,18 +155,52 @@ OCIO_NAMESPACE_ENTER
                                   const FileTransform & fileTransform,
                                   TransformDirection dir) const = 0;
         
+        // Cheap check of the beginning of a file (up to a few KB) used to rank the
+        // formats to try before parsing the whole file. It must never reject a content
+        // that read() accepts. The default only rejects binary content for the text
+        // formats.
+        virtual int probe(const char * data, size_t size) const;
+
         // True if the file is a binary rather than text-based format.
         virtual bool isBinary() const
         {
             return false;
         }
 
+        // Optional support of the persistent file cache (refer to BinaryCache.h). Write the
+        // content of the cached file in a compact binary form, returns false if unsupported.
+        virtual bool writeBinaryCache(const CachedFileRcPtr & /*cachedFile*/,
+                                      BinaryCacheWriter & /*writer*/) const
+        {
+            return false;
+        }
+
+        // Read back the content written by writeBinaryCache(). Throws if the content is
+        // corrupted.
+        virtual CachedFileRcPtr readBinaryCache(BinaryCacheReader & /*reader*/) const
+        {
+            return CachedFileRcPtr();
+        }
+
         // For logging purposes.
         std::string getName() const;
     private:
         FileFormat& operator= (const FileFormat &);
     };
     
+    // Helpers for the FileFormat::probe() implementations. A UTF-8 byte order mark
+    // is ignored.
+
+    // True if the content has no null character, unless it is UTF-16 text.
+    bool ProbeIsText(const char * data, size_t size);
+    // True if the first non-space characters match 'prefix', ignoring the case.
+    bool ProbeStartsWith(const char * data, size_t size, const char * prefix);
+    // True if the content contains 'str'.
+    bool ProbeContains(const char * data, size_t size, const char * str);
+    // Probe of the XML formats: the content must start with a tag, and is likely to
+    // match if the element is found.
+    int ProbeXMLElement(const char * data, size_t size, const char * element);
+
     typedef std::map<std::string, FileFormat*> FileFormatMap;
     typedef std::vector<FileFormat*> FileFormatVector;
     typedef std::map<std::string, FileFormatVector> FileFormatVectorMap;
@@ -151,6 +265,7 @@ OCIO_NAMESPACE_ENTER
 
     static constexpr const char * FILEFORMAT_CLF = "Academy/ASC Common LUT Format";
     static constexpr const char * FILEFORMAT_CTF = "Color Transform Format";
+    static constexpr const char * FILEFORMAT_CTF_BINARY = "Color Transform Format (binary arrays)";
 
 }
 OCIO_NAMESPACE_EXIT
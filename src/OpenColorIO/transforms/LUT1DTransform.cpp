@@ -209,9 +209,10 @@ unsigned long LUT1DTransform::getLength() const
 void LUT1DTransform::getValue(unsigned long index, float & r, float & g, float & b) const
 {
     CheckLUT1DIndex("getValue", index, getLength());
-    r = m_impl->getArray()[3 * index];
-    g = m_impl->getArray()[3 * index + 1];
-    b = m_impl->getArray()[3 * index + 2];
+    const Array & array = m_impl->getArray();
+    r = array[3 * index];
+    g = array[3 * index + 1];
+    b = array[3 * index + 2];
 }
 
 bool LUT1DTransform::getInputHalfDomain() const
@@ -207,9 +207,10 @@ void LUT3DTransform::getValue(unsigned long indexR,
 
     // Array is stored in blue-fastest order.
     const unsigned long arrayIdx = 3 * ((indexR*gs + indexG)*gs + indexB);
-    r = m_impl->getArray()[arrayIdx];
-    g = m_impl->getArray()[arrayIdx + 1];
-    b = m_impl->getArray()[arrayIdx + 2];
+    const Array & array = m_impl->getArray();
+    r = array[arrayIdx];
+    g = array[arrayIdx + 1];
+    b = array[arrayIdx + 2];
 }
 
 Interpolation LUT3DTransform::getInterpolation() const
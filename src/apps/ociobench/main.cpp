@@ -0,0 +1,269 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <OpenColorIO/OpenColorIO.h>
+namespace OCIO = OCIO_NAMESPACE;
+
+#include "argparse.h"
+
+
+class Measure
+{
+public:
+    Measure() = delete;
+    Measure(const Measure &) = delete;
+
+    explicit Measure(const char * explanation, unsigned iterations, unsigned operations)
+        :   m_explanations(explanation)
+        ,   m_iterations(iterations)
+        ,   m_operations(operations)
+    {
+        m_start = std::chrono::high_resolution_clock::now();
+    }
+
+    ~Measure()
+    {
+        std::chrono::high_resolution_clock::time_point end
+            = std::chrono::high_resolution_clock::now();
+
+        std::chrono::duration<float, std::milli> duration = end - m_start;
+
+        std::cout << std::endl;
+        std::cout << m_explanations << std::endl;
+        std::cout << "  Iteration took: "
+                  << (duration.count()/float(m_iterations))
+                  <<  " ms" << std::endl;
+        std::cout << "  Throughput: "
+                  << (float(m_iterations) * float(m_operations) * 1000.0f / duration.count())
+                  <<  " per second" << std::endl;
+    }
+private:
+    const std::string m_explanations;
+    const unsigned m_iterations;
+    const unsigned m_operations;
+
+    std::chrono::high_resolution_clock::time_point m_start;
+};
+
+// Build the processors from many threads at once, to measure the contention
+// on the caches shared by the threads (i.e. files, paths, processors).
+void BuildProcessors(OCIO::ConstConfigRcPtr config,
+                     OCIO::ConstTransformRcPtr transform,
+                     const std::string & inputColorSpace,
+                     const std::string & outputColorSpace,
+                     unsigned numThreads,
+                     unsigned numProcessors,
+                     std::atomic<bool> & failed)
+{
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < numThreads; ++t)
+    {
+        threads.push_back(std::thread([&]()
+        {
+            try
+            {
+                for (unsigned p = 0; p < numProcessors; ++p)
+                {
+                    OCIO::ConstProcessorRcPtr processor
+                        = transform ? config->getProcessor(transform)
+                                    : config->getProcessor(inputColorSpace.c_str(),
+                                                           outputColorSpace.c_str());
+                    processor->getDefaultCPUProcessor();
+                }
+            }
+            catch (OCIO::Exception & ex)
+            {
+                if (!failed.exchange(true))
+                {
+                    std::cerr << std::endl << ex.what() << std::endl;
+                }
+            }
+        }));
+    }
+
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+}
+
+
+int main(int argc, const char **argv)
+{
+    bool verbose = false;
+    bool cold = false;
+    bool noProcessorCache = false;
+    bool parse = false;
+    std::string configFile;
+    std::string transformFile;
+    std::string inputColorSpace, outputColorSpace;
+    int numThreads = int(std::thread::hardware_concurrency());
+    int numProcessors = 100;
+    int iterations = 10;
+
+    bool help = false;
+
+    ArgParse ap;
+    ap.options("ociobench -- measure the creation of processors from many threads at once\n\n"
+               "usage: ociobench [options] --colorspaces inputcolorspace outputcolorspace\n"
+               "   or: ociobench [options] --transform transformfile\n"
+               "   or: ociobench [options] --parse --transform transformfile\n\n",
+               "--h", &help, "Display the help and exit",
+               "--v", &verbose, "Display some general information",
+               "--config %s", &configFile, "Provide the config file to use. Default is $OCIO",
+               "--transform %s", &transformFile, "Provide the transform file to build processors from",
+               "--colorspaces %s %s", &inputColorSpace, &outputColorSpace,
+                                      "Provide the input and output color spaces to build processors from",
+               "--threads %d", &numThreads, "Provide the number of threads. Default is the number of cores",
+               "--processors %d", &numProcessors, "Provide the number of processors built per thread. Default is 100",
+               "--iter %d", &iterations, "Provide the number of iterations. Default is 10",
+               "--cold", &cold, "Clear all the caches before each iteration",
+               "--noprocessorcache", &noProcessorCache, "Disable the config processor cache",
+               "--parse", &parse, "Measure the reading of the transform file (i.e. its file format parser)",
+               NULL);
+
+    if(ap.parse (argc, argv) < 0) {
+        std::cerr << ap.geterror() << std::endl;
+        ap.usage();
+        exit(1);
+    }
+
+    if(help)
+    {
+        ap.usage();
+        exit(1);
+    }
+
+    if(numThreads <= 0 || numProcessors <= 0 || iterations <= 0)
+    {
+        std::cerr << std::endl;
+        std::cerr << "The number of threads, processors and iterations must be positive." << std::endl;
+        exit(1);
+    }
+
+    if(parse && transformFile.empty())
+    {
+        std::cerr << std::endl;
+        std::cerr << "Missing the transform file to parse." << std::endl;
+        ap.usage();
+        exit(1);
+    }
+
+    if(transformFile.empty() && (inputColorSpace.empty() || outputColorSpace.empty()))
+    {
+        std::cerr << std::endl;
+        std::cerr << "Missing the transform file or the color spaces." << std::endl;
+        ap.usage();
+        exit(1);
+    }
+
+    try
+    {
+        OCIO::ConfigRcPtr config;
+        if(!configFile.empty())
+        {
+            config = OCIO::Config::CreateFromFile(configFile.c_str())->createEditableCopy();
+        }
+        else if(!transformFile.empty() && !getenv("OCIO"))
+        {
+            config = OCIO::Config::Create();
+        }
+        else
+        {
+            config = OCIO::GetCurrentConfig()->createEditableCopy();
+        }
+
+        if(noProcessorCache)
+        {
+            config->setProcessorCacheEnabled(false);
+        }
+
+        OCIO::ConstTransformRcPtr transform;
+        if(!transformFile.empty())
+        {
+            OCIO::FileTransformRcPtr fileTransform = OCIO::FileTransform::Create();
+            fileTransform->setSrc(transformFile.c_str());
+            fileTransform->setInterpolation(OCIO::INTERP_BEST);
+            transform = fileTransform;
+        }
+
+        if(verbose)
+        {
+            std::cout << std::endl;
+            std::cout << "OCIO Version: " << OCIO::GetVersion() << std::endl;
+            std::cout << "Threads:      " << numThreads << std::endl;
+            std::cout << "Processors:   " << numProcessors << " per thread" << std::endl;
+        }
+
+        std::atomic<bool> failed(false);
+
+        if(parse)
+        {
+            // The file is read again by each iteration as all the caches are empty.
+            config->setProcessorCacheEnabled(false);
+
+            Measure m("Read the transform file with empty caches",
+                      unsigned(iterations), 1);
+
+            for(int iter = 0; iter < iterations; ++iter)
+            {
+                OCIO::ClearAllCaches();
+                config->getProcessor(transform);
+            }
+        }
+        else if(cold)
+        {
+            std::chrono::duration<float, std::milli> duration(0.0f);
+            for(int iter = 0; iter < iterations && !failed; ++iter)
+            {
+                OCIO::ClearAllCaches();
+
+                const auto start = std::chrono::high_resolution_clock::now();
+                BuildProcessors(config, transform, inputColorSpace, outputColorSpace,
+                                unsigned(numThreads), unsigned(numProcessors), failed);
+                duration += std::chrono::high_resolution_clock::now() - start;
+            }
+
+            std::cout << std::endl;
+            std::cout << "Build processors with empty caches" << std::endl;
+            std::cout << "  Iteration took: "
+                      << (duration.count()/float(iterations))
+                      <<  " ms" << std::endl;
+        }
+        else
+        {
+            // Populate the caches.
+            BuildProcessors(config, transform, inputColorSpace, outputColorSpace,
+                            1, 1, failed);
+
+            Measure m("Build processors with populated caches",
+                      unsigned(iterations), unsigned(numThreads * numProcessors));
+
+            for(int iter = 0; iter < iterations && !failed; ++iter)
+            {
+                BuildProcessors(config, transform, inputColorSpace, outputColorSpace,
+                                unsigned(numThreads), unsigned(numProcessors), failed);
+            }
+        }
+
+        if(failed)
+        {
+            exit(1);
+        }
+    }
+    catch(OCIO::Exception & ex)
+    {
+        std::cerr << std::endl;
+        std::cerr << ex.what() << std::endl;
+        exit(1);
+    }
+
+    return 0;
+}
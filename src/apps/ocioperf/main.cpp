@@ -57,6 +57,7 @@ private:
 int main(int argc, const char **argv)
 {
     bool verbose = false;
+    bool trace = false;
     signed int testType = 0;
     std::string transformFile;
     std::string inputColorSpace, outputColorSpace;
@@ -70,6 +71,7 @@ int main(int argc, const char **argv)
                "usage: ocioperf [options] --image inputimage\n\n",
                "--h", &help, "Display the help and exit",
                "--v", &verbose, "Display some general information",
+               "--trace", &trace, "Display the optimization passes of the CPU processor",
                "--test %d", &testType, "Define the type of processing to measure: "\
                                        "0 means on the complete image (the default), 1 is line-by-line, "\
                                        "2 is pixel-per-pixel and -1 performs all the test types",
@@ -236,11 +238,27 @@ int main(int argc, const char **argv)
 
         const OCIO::BitDepth bitDepth = OCIO::GetBitDepth(spec);
 
-        // Get the CPU processor.
-        OCIO::ConstCPUProcessorRcPtr cpuProcessor 
-            = processor->getOptimizedCPUProcessor(bitDepth, bitDepth,
-                                                  OCIO::OPTIMIZATION_DEFAULT,
-                                                  OCIO::FINALIZATION_DEFAULT);
+        // Get the CPU processor. Note that a traced request bypasses the caches, so the
+        // trace is only requested when asked for.
+        OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+        if(trace)
+        {
+            OCIO::OptimizationTraceRcPtr optimizationTrace = OCIO::OptimizationTrace::Create();
+            cpuProcessor = processor->getOptimizedCPUProcessor(bitDepth, bitDepth,
+                                                               OCIO::OPTIMIZATION_DEFAULT,
+                                                               OCIO::FINALIZATION_DEFAULT,
+                                                               optimizationTrace);
+
+            std::cout << std::endl;
+            std::cout << "Optimization passes:" << std::endl;
+            std::cout << *optimizationTrace;
+        }
+        else
+        {
+            cpuProcessor = processor->getOptimizedCPUProcessor(bitDepth, bitDepth,
+                                                               OCIO::OPTIMIZATION_DEFAULT,
+                                                               OCIO::FINALIZATION_DEFAULT);
+        }
 
         if(testType==0 || testType==-1)
         {
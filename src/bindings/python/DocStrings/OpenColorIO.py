@@ -9,6 +9,20 @@ class OpenColorIO:
         pass
     def ClearAllCaches(self):
         pass
+    def GetCacheNumEntries(self, cacheType):
+        pass
+    def GetCacheMemoryUsage(self, cacheType):
+        pass
+    def GetCacheNumHits(self, cacheType):
+        pass
+    def GetCacheNumMisses(self, cacheType):
+        pass
+    def GetCacheNumEvictions(self, cacheType):
+        pass
+    def GetCacheMissTime(self, cacheType):
+        pass
+    def ResetCacheStatistics(self):
+        pass
     def GetLoggingLevel(self):
         pass
     def SetLoggingLevel(self, level):
@@ -131,6 +131,25 @@ OCIO_NAMESPACE_ENTER
         PyModule_AddStringConstant(m, "ENV_ENVIRONMENT_LOAD_ALL",
             const_cast<char*>(EnvironmentModeToString(ENV_ENVIRONMENT_LOAD_ALL)));
         
+        PyModule_AddStringConstant(m, "CACHE_FILE",
+            const_cast<char*>(CacheTypeToString(CACHE_FILE)));
+        PyModule_AddStringConstant(m, "CACHE_FILE_HASH",
+            const_cast<char*>(CacheTypeToString(CACHE_FILE_HASH)));
+        PyModule_AddStringConstant(m, "CACHE_CDL_FILE",
+            const_cast<char*>(CacheTypeToString(CACHE_CDL_FILE)));
+        PyModule_AddStringConstant(m, "CACHE_CONTEXT_RESULTS",
+            const_cast<char*>(CacheTypeToString(CACHE_CONTEXT_RESULTS)));
+        PyModule_AddStringConstant(m, "CACHE_CONFIG_CACHE_ID",
+            const_cast<char*>(CacheTypeToString(CACHE_CONFIG_CACHE_ID)));
+        PyModule_AddStringConstant(m, "CACHE_PROCESSOR",
+            const_cast<char*>(CacheTypeToString(CACHE_PROCESSOR)));
+        PyModule_AddStringConstant(m, "CACHE_OPTIMIZED_PROCESSOR",
+            const_cast<char*>(CacheTypeToString(CACHE_OPTIMIZED_PROCESSOR)));
+        PyModule_AddStringConstant(m, "CACHE_CPU_ENGINE",
+            const_cast<char*>(CacheTypeToString(CACHE_CPU_ENGINE)));
+        PyModule_AddStringConstant(m, "CACHE_BAKED_SAMPLES",
+            const_cast<char*>(CacheTypeToString(CACHE_BAKED_SAMPLES)));
+        
         PyModule_AddStringConstant(m, "ROLE_DEFAULT", const_cast<char*>(ROLE_DEFAULT));
         PyModule_AddStringConstant(m, "ROLE_REFERENCE", const_cast<char*>(ROLE_REFERENCE));
         PyModule_AddStringConstant(m, "ROLE_DATA", const_cast<char*>(ROLE_DATA));
@@ -63,9 +63,85 @@ namespace
         OCIO_PYTRY_EXIT(NULL)
     }
     
+    PyObject * PyOCIO_GetCacheNumEntries(PyObject * /*self*/, PyObject * args)
+    {
+        OCIO_PYTRY_ENTER()
+        char * type = 0;
+        if (!PyArg_ParseTuple(args, "s:GetCacheNumEntries", &type)) return NULL;
+        return PyLong_FromSize_t(OCIO::GetCacheNumEntries(OCIO::CacheTypeFromString(type)));
+        OCIO_PYTRY_EXIT(NULL)
+    }
+    
+    PyObject * PyOCIO_GetCacheMemoryUsage(PyObject * /*self*/, PyObject * args)
+    {
+        OCIO_PYTRY_ENTER()
+        char * type = 0;
+        if (!PyArg_ParseTuple(args, "s:GetCacheMemoryUsage", &type)) return NULL;
+        return PyLong_FromSize_t(OCIO::GetCacheMemoryUsage(OCIO::CacheTypeFromString(type)));
+        OCIO_PYTRY_EXIT(NULL)
+    }
+    
+    PyObject * PyOCIO_GetCacheNumHits(PyObject * /*self*/, PyObject * args)
+    {
+        OCIO_PYTRY_ENTER()
+        char * type = 0;
+        if (!PyArg_ParseTuple(args, "s:GetCacheNumHits", &type)) return NULL;
+        return PyLong_FromUnsignedLong(OCIO::GetCacheNumHits(OCIO::CacheTypeFromString(type)));
+        OCIO_PYTRY_EXIT(NULL)
+    }
+    
+    PyObject * PyOCIO_GetCacheNumMisses(PyObject * /*self*/, PyObject * args)
+    {
+        OCIO_PYTRY_ENTER()
+        char * type = 0;
+        if (!PyArg_ParseTuple(args, "s:GetCacheNumMisses", &type)) return NULL;
+        return PyLong_FromUnsignedLong(OCIO::GetCacheNumMisses(OCIO::CacheTypeFromString(type)));
+        OCIO_PYTRY_EXIT(NULL)
+    }
+    
+    PyObject * PyOCIO_GetCacheNumEvictions(PyObject * /*self*/, PyObject * args)
+    {
+        OCIO_PYTRY_ENTER()
+        char * type = 0;
+        if (!PyArg_ParseTuple(args, "s:GetCacheNumEvictions", &type)) return NULL;
+        return PyLong_FromUnsignedLong(OCIO::GetCacheNumEvictions(OCIO::CacheTypeFromString(type)));
+        OCIO_PYTRY_EXIT(NULL)
+    }
+    
+    PyObject * PyOCIO_GetCacheMissTime(PyObject * /*self*/, PyObject * args)
+    {
+        OCIO_PYTRY_ENTER()
+        char * type = 0;
+        if (!PyArg_ParseTuple(args, "s:GetCacheMissTime", &type)) return NULL;
+        return PyFloat_FromDouble(OCIO::GetCacheMissTime(OCIO::CacheTypeFromString(type)));
+        OCIO_PYTRY_EXIT(NULL)
+    }
+    
+    PyObject * PyOCIO_ResetCacheStatistics(PyObject *, PyObject * /* self, args */)
+    {
+        OCIO_PYTRY_ENTER()
+        OCIO::ResetCacheStatistics();
+        Py_RETURN_NONE;
+        OCIO_PYTRY_EXIT(NULL)
+    }
+    
     PyMethodDef PyOCIO_methods[] = {
         { "ClearAllCaches",
         (PyCFunction) PyOCIO_ClearAllCaches, METH_NOARGS, OCIO::OPENCOLORIO_CLEARALLCACHES__DOC__ },
+        { "GetCacheNumEntries",
+        (PyCFunction) PyOCIO_GetCacheNumEntries, METH_VARARGS, OCIO::OPENCOLORIO_GETCACHENUMENTRIES__DOC__ },
+        { "GetCacheMemoryUsage",
+        (PyCFunction) PyOCIO_GetCacheMemoryUsage, METH_VARARGS, OCIO::OPENCOLORIO_GETCACHEMEMORYUSAGE__DOC__ },
+        { "GetCacheNumHits",
+        (PyCFunction) PyOCIO_GetCacheNumHits, METH_VARARGS, OCIO::OPENCOLORIO_GETCACHENUMHITS__DOC__ },
+        { "GetCacheNumMisses",
+        (PyCFunction) PyOCIO_GetCacheNumMisses, METH_VARARGS, OCIO::OPENCOLORIO_GETCACHENUMMISSES__DOC__ },
+        { "GetCacheNumEvictions",
+        (PyCFunction) PyOCIO_GetCacheNumEvictions, METH_VARARGS, OCIO::OPENCOLORIO_GETCACHENUMEVICTIONS__DOC__ },
+        { "GetCacheMissTime",
+        (PyCFunction) PyOCIO_GetCacheMissTime, METH_VARARGS, OCIO::OPENCOLORIO_GETCACHEMISSTIME__DOC__ },
+        { "ResetCacheStatistics",
+        (PyCFunction) PyOCIO_ResetCacheStatistics, METH_NOARGS, OCIO::OPENCOLORIO_RESETCACHESTATISTICS__DOC__ },
         { "GetLoggingLevel",
         (PyCFunction) PyOCIO_GetLoggingLevel, METH_NOARGS, OCIO::OPENCOLORIO_GETLOGGINGLEVEL__DOC__ },
         { "SetLoggingLevel",
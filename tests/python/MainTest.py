@@ -48,3 +48,15 @@ colorspaces:
         bar = OCIO.Config().CreateFromStream(foo.serialize())
         OCIO.SetCurrentConfig(bar)
         wee = OCIO.GetCurrentConfig()
+    
+    def test_cache_statistics(self):
+        
+        OCIO.ResetCacheStatistics()
+        self.assertEqual(0, OCIO.GetCacheNumHits(OCIO.Constants.CACHE_FILE))
+        self.assertEqual(0, OCIO.GetCacheNumMisses(OCIO.Constants.CACHE_FILE))
+        self.assertEqual(0, OCIO.GetCacheNumEvictions(OCIO.Constants.CACHE_PROCESSOR))
+        self.assertEqual(0.0, OCIO.GetCacheMissTime(OCIO.Constants.CACHE_CPU_ENGINE))
+        self.assertTrue(OCIO.GetCacheNumEntries(OCIO.Constants.CACHE_CONFIG_CACHE_ID) >= 0)
+        self.assertTrue(OCIO.GetCacheMemoryUsage(OCIO.Constants.CACHE_FILE_HASH) >= 0)
+        with self.assertRaises(OCIO.Exception):
+            OCIO.GetCacheNumEntries("unknown")